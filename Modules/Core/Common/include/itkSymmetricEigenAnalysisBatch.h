@@ -0,0 +1,133 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSymmetricEigenAnalysisBatch_h
+#define itkSymmetricEigenAnalysisBatch_h
+
+#include "itkSymmetricEigenAnalysis.h"
+#include "itkMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace itk
+{
+/** \class SymmetricEigenAnalysisBatch
+ * \brief Computes the eigenvalues of a block of 2x2 or 3x3 symmetric matrices.
+ *
+ * The matrices of a block are set one by one with SetMatrix, which stores
+ * their upper triangle component by component. ComputeEigenValues then
+ * solves the characteristic polynomial of all the matrices in closed form,
+ * in loops over the matrices which the compiler can vectorize. In 3D, the
+ * trigonometric solution loses accuracy when two eigenvalues are close
+ * without being equal; the eigenvalues of these matrices are computed again
+ * with SymmetricEigenAnalysisFixedDimension.
+ *
+ * This class is meant to be used in the threaded loops of the filters which
+ * compute eigenvalues for every pixel: each work unit has its own instance,
+ * and fills and solves it for up to BlockSize pixels at a time.
+ *
+ * \sa SymmetricEigenAnalysisFixedDimension
+ * \ingroup ITKCommon
+ */
+template <unsigned int VDimension, typename TValue = double>
+class ITK_TEMPLATE_EXPORT SymmetricEigenAnalysisBatch
+{
+public:
+  static_assert(VDimension == 2 || VDimension == 3, "SymmetricEigenAnalysisBatch supports 2x2 and 3x3 matrices");
+
+  using ValueType = TValue;
+
+  static constexpr unsigned int Dimension = VDimension;
+
+  /** Number of components of the upper triangle of a matrix. */
+  static constexpr unsigned int NumberOfComponents = VDimension * (VDimension + 1) / 2;
+
+  /** Maximum number of matrices in a block. */
+  static constexpr unsigned int BlockSize = 64;
+
+  /** Store the upper triangle of the n-th matrix of the block. A is any type
+   * that provides the (row, column) operator, such as
+   * SymmetricSecondRankTensor, Matrix and vnl_matrix. */
+  template <typename TMatrix>
+  void
+  SetMatrix(unsigned int n, const TMatrix & A)
+  {
+    unsigned int component = 0;
+    for (unsigned int row = 0; row < VDimension; ++row)
+    {
+      for (unsigned int col = row; col < VDimension; ++col)
+      {
+        m_Components[component++][n] = static_cast<ValueType>(A(row, col));
+      }
+    }
+  }
+
+  /** Compute the eigenvalues of the first numberOfMatrices matrices of the
+   * block. */
+  void
+  ComputeEigenValues(unsigned int numberOfMatrices);
+
+  /** Get the eigenvalues of the n-th matrix of the block, in increasing
+   * order, or in increasing order of magnitude. DoNotOrder gives the
+   * increasing order, which is also the order of
+   * SymmetricEigenAnalysisFixedDimension. */
+  template <typename TVector>
+  void
+  GetEigenValues(unsigned int        n,
+                 TVector &           eigenValues,
+                 EigenValueOrderEnum order = EigenValueOrderEnum::OrderByValue) const
+  {
+    ValueType values[VDimension];
+    for (unsigned int i = 0; i < VDimension; ++i)
+    {
+      values[i] = m_EigenValues[i][n];
+    }
+    if (order == EigenValueOrderEnum::OrderByMagnitude)
+    {
+      std::sort(
+        values, values + VDimension, [](ValueType a, ValueType b) { return itk::Math::abs(a) < itk::Math::abs(b); });
+    }
+    for (unsigned int i = 0; i < VDimension; ++i)
+    {
+      eigenValues[i] = values[i];
+    }
+  }
+
+private:
+  void
+  ComputeClosedFormEigenValues(unsigned int numberOfMatrices, std::integral_constant<unsigned int, 2>);
+  void
+  ComputeClosedFormEigenValues(unsigned int numberOfMatrices, std::integral_constant<unsigned int, 3>);
+
+  /** Compute the eigenvalues of the matrices flagged as ill-conditioned for
+   * the closed form solution with SymmetricEigenAnalysisFixedDimension. */
+  void
+  ComputeFlaggedEigenValues(unsigned int numberOfMatrices);
+
+  ValueType     m_Components[NumberOfComponents][BlockSize];
+  ValueType     m_EigenValues[VDimension][BlockSize];
+  unsigned char m_Flags[BlockSize];
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkSymmetricEigenAnalysisBatch.hxx"
+#endif
+
+#endif
@@ -0,0 +1,148 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSymmetricEigenAnalysisBatch_hxx
+#define itkSymmetricEigenAnalysisBatch_hxx
+
+#include "itkFixedArray.h"
+#include "itkMath.h"
+
+namespace itk
+{
+
+template <unsigned int VDimension, typename TValue>
+void
+SymmetricEigenAnalysisBatch<VDimension, TValue>::ComputeEigenValues(unsigned int numberOfMatrices)
+{
+  this->ComputeClosedFormEigenValues(numberOfMatrices, std::integral_constant<unsigned int, VDimension>());
+}
+
+
+template <unsigned int VDimension, typename TValue>
+void
+SymmetricEigenAnalysisBatch<VDimension, TValue>::ComputeClosedFormEigenValues(unsigned int numberOfMatrices,
+                                                                               std::integral_constant<unsigned int, 2>)
+{
+  const ValueType * a00 = m_Components[0];
+  const ValueType * a01 = m_Components[1];
+  const ValueType * a11 = m_Components[2];
+  ValueType *       e0 = m_EigenValues[0];
+  ValueType *       e1 = m_EigenValues[1];
+
+  // the eigenvalues are the mean of the diagonal plus or minus the radius of
+  // the Mohr circle, which never loses accuracy
+  for (unsigned int n = 0; n < numberOfMatrices; ++n)
+  {
+    const ValueType mean = 0.5 * (a00[n] + a11[n]);
+    const ValueType halfDifference = 0.5 * (a00[n] - a11[n]);
+    const ValueType radius = std::sqrt(halfDifference * halfDifference + a01[n] * a01[n]);
+    e0[n] = mean - radius;
+    e1[n] = mean + radius;
+  }
+}
+
+
+template <unsigned int VDimension, typename TValue>
+void
+SymmetricEigenAnalysisBatch<VDimension, TValue>::ComputeClosedFormEigenValues(unsigned int numberOfMatrices,
+                                                                               std::integral_constant<unsigned int, 3>)
+{
+  const ValueType * a00 = m_Components[0];
+  const ValueType * a01 = m_Components[1];
+  const ValueType * a02 = m_Components[2];
+  const ValueType * a11 = m_Components[3];
+  const ValueType * a12 = m_Components[4];
+  const ValueType * a22 = m_Components[5];
+  ValueType *       e0 = m_EigenValues[0];
+  ValueType *       e1 = m_EigenValues[1];
+  ValueType *       e2 = m_EigenValues[2];
+
+  // The eigenvalues of A are mean + 2 p cos(phi + 2 k pi / 3), where mean is
+  // the mean of the diagonal, p is the deviation of A from mean I, and
+  // cos(3 phi) is half of the determinant of (A - mean I) / p. The error on
+  // phi grows as 1 / sqrt(1 - cos(3 phi)^2) when two eigenvalues get close,
+  // so these matrices, including the ones where cos(3 phi) is rounded to
+  // +-1, are flagged for the iterative solver.
+  constexpr ValueType twoThirdsOfPi = 2.0 * itk::Math::pi / 3.0;
+  constexpr ValueType conditionTolerance = 1e-6;
+
+  unsigned int numberOfFlags = 0;
+  for (unsigned int n = 0; n < numberOfMatrices; ++n)
+  {
+    const ValueType mean = (a00[n] + a11[n] + a22[n]) / 3.0;
+    const ValueType b00 = a00[n] - mean;
+    const ValueType b11 = a11[n] - mean;
+    const ValueType b22 = a22[n] - mean;
+    const ValueType offDiagonal = a01[n] * a01[n] + a02[n] * a02[n] + a12[n] * a12[n];
+    const ValueType p = std::sqrt((b00 * b00 + b11 * b11 + b22 * b22 + 2.0 * offDiagonal) / 6.0);
+    const ValueType halfDeterminant = 0.5 * (b00 * (b11 * b22 - a12[n] * a12[n]) -
+                                             a01[n] * (a01[n] * b22 - a12[n] * a02[n]) +
+                                             a02[n] * (a01[n] * a12[n] - b11 * a02[n]));
+    const ValueType p3 = p * p * p;
+    const ValueType r = p3 > 0.0 ? std::min(std::max(halfDeterminant / p3, ValueType{ -1.0 }), ValueType{ 1.0 }) : 0.0;
+    const ValueType phi = std::acos(r) / 3.0;
+    e2[n] = mean + 2.0 * p * std::cos(phi);
+    e0[n] = mean + 2.0 * p * std::cos(phi + twoThirdsOfPi);
+    e1[n] = 3.0 * mean - e0[n] - e2[n];
+
+    const bool flag = 1.0 - r * r < conditionTolerance;
+    m_Flags[n] = flag;
+    numberOfFlags += flag;
+  }
+
+  if (numberOfFlags > 0)
+  {
+    this->ComputeFlaggedEigenValues(numberOfMatrices);
+  }
+}
+
+
+template <unsigned int VDimension, typename TValue>
+void
+SymmetricEigenAnalysisBatch<VDimension, TValue>::ComputeFlaggedEigenValues(unsigned int numberOfMatrices)
+{
+  using MatrixType = Matrix<ValueType, VDimension, VDimension>;
+  using VectorType = FixedArray<ValueType, VDimension>;
+
+  const SymmetricEigenAnalysisFixedDimension<VDimension, MatrixType, VectorType> calculator;
+
+  for (unsigned int n = 0; n < numberOfMatrices; ++n)
+  {
+    if (m_Flags[n])
+    {
+      MatrixType   A;
+      unsigned int component = 0;
+      for (unsigned int row = 0; row < VDimension; ++row)
+      {
+        for (unsigned int col = row; col < VDimension; ++col)
+        {
+          A(row, col) = m_Components[component][n];
+          A(col, row) = m_Components[component++][n];
+        }
+      }
+      VectorType eigenValues;
+      calculator.ComputeEigenValues(A, eigenValues);
+      for (unsigned int i = 0; i < VDimension; ++i)
+      {
+        m_EigenValues[i][n] = eigenValues[i];
+      }
+    }
+  }
+}
+} // end namespace itk
+
+#endif
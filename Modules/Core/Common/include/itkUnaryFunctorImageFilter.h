@@ -22,6 +22,10 @@
 #include "itkInPlaceImageFilter.h"
 #include "itkImageRegionIteratorWithIndex.h"
 
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
 namespace itk
 {
 /** \class UnaryFunctorImageFilter
@@ -36,6 +40,15 @@ namespace itk
  * UnaryFunctorImageFilter (like the CastImageFilter) can be used
  * to promote a 2D image to a 3D image, etc.
  *
+ * When UseLookupTable is on, the input pixel type is an integer type with
+ * at most 2^16 values, and the output has more pixels than the input pixel
+ * type has values, the functor is evaluated once for each value of the input
+ * pixel type, and the output pixels are read from this lookup table. The
+ * functor must then only depend on its argument, and accept all the values
+ * of the input pixel type, which is the case of the functors of ITK. The
+ * filters whose functor has side effects, or is only defined for some input
+ * values, should turn UseLookupTable off.
+ *
  * \sa UnaryGeneratorImageFilter
  * \sa BinaryFunctorImageFilter TernaryFunctorImageFilter
  *
@@ -108,10 +121,20 @@ public:
     }
   }
 
+  /** Set/Get whether the output may be read from a lookup table of the
+   * functor, for the integer input pixel types with at most 2^16 values.
+   * Defaults to true. */
+  itkSetMacro(UseLookupTable, bool);
+  itkGetConstMacro(UseLookupTable, bool);
+  itkBooleanMacro(UseLookupTable);
+
 protected:
   UnaryFunctorImageFilter();
   ~UnaryFunctorImageFilter() override = default;
 
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
   /** UnaryFunctorImageFilter can produce an image which is a different
    * resolution than its input image.  As such, UnaryFunctorImageFilter
    * needs to provide an implementation for
@@ -136,8 +159,35 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  /** Discard the lookup table of the previous update. */
+  void
+  GenerateData() override;
+
 private:
+  /** Whether the input pixel type has few enough values for a lookup
+   * table. */
+  using IsSmallIntegerInputType = std::integral_constant<bool,
+                                                         std::is_integral<InputImagePixelType>::value &&
+                                                           !std::is_same<InputImagePixelType, bool>::value &&
+                                                           sizeof(InputImagePixelType) <= 2>;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, std::true_type);
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, std::false_type);
+
+  /** Return the lookup table of the functor, indexed by the input value
+   * minus the lowest value of the input pixel type. The table is computed
+   * by the first thread which needs it. */
+  const std::vector<OutputImagePixelType> &
+  GetLookupTable();
+
   FunctorType m_Functor;
+
+  bool m_UseLookupTable{ true };
+
+  std::vector<OutputImagePixelType> m_LookupTable;
+  std::mutex                        m_LookupTableMutex;
 };
 } // end namespace itk
 
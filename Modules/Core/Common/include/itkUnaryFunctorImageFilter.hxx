@@ -21,6 +21,8 @@
 #include "itkImageScanlineIterator.h"
 #include "itkTotalProgressReporter.h"
 
+#include <limits>
+
 namespace itk
 {
 template <typename TInputImage, typename TOutputImage, typename TFunction>
@@ -68,10 +70,98 @@ UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::GenerateOutputInf
 }
 
 
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::GenerateData()
+{
+  m_LookupTable.clear();
+
+  Superclass::GenerateData();
+
+  m_LookupTable.clear();
+  m_LookupTable.shrink_to_fit();
+}
+
+
 template <typename TInputImage, typename TOutputImage, typename TFunction>
 void
 UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
+{
+  this->DynamicThreadedGenerateData(outputRegionForThread, IsSmallIntegerInputType());
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+auto
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::GetLookupTable()
+  -> const std::vector<OutputImagePixelType> &
+{
+  const std::lock_guard<std::mutex> lock(m_LookupTableMutex);
+  if (m_LookupTable.empty())
+  {
+    using LimitsType = std::numeric_limits<InputImagePixelType>;
+    m_LookupTable.reserve(static_cast<std::size_t>(LimitsType::max()) - LimitsType::lowest() + 1);
+    for (int value = LimitsType::lowest(); value <= LimitsType::max(); ++value)
+    {
+      m_LookupTable.push_back(m_Functor(static_cast<InputImagePixelType>(value)));
+    }
+  }
+  return m_LookupTable;
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread,
+  std::true_type)
+{
+  using LimitsType = std::numeric_limits<InputImagePixelType>;
+  constexpr SizeValueType numberOfValues = static_cast<SizeValueType>(LimitsType::max()) - LimitsType::lowest() + 1;
+
+  TOutputImage * outputPtr = this->GetOutput(0);
+
+  // the lookup table is not worth computing for the small images
+  if (!m_UseLookupTable || outputPtr->GetRequestedRegion().GetNumberOfPixels() <= numberOfValues)
+  {
+    this->DynamicThreadedGenerateData(outputRegionForThread, std::false_type());
+    return;
+  }
+
+  const TInputImage * inputPtr = this->GetInput();
+
+  InputImageRegionType inputRegionForThread;
+
+  this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
+
+  const std::vector<OutputImagePixelType> & lookupTable = this->GetLookupTable();
+
+  TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+  ImageScanlineConstIterator<TInputImage> inputIt(inputPtr, inputRegionForThread);
+  ImageScanlineIterator<TOutputImage>     outputIt(outputPtr, outputRegionForThread);
+
+  while (!inputIt.IsAtEnd())
+  {
+    while (!inputIt.IsAtEndOfLine())
+    {
+      outputIt.Set(lookupTable[static_cast<int>(inputIt.Get()) - static_cast<int>(LimitsType::lowest())]);
+      ++inputIt;
+      ++outputIt;
+    }
+    inputIt.NextLine();
+    outputIt.NextLine();
+    progress.Completed(outputRegionForThread.GetSize()[0]);
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread,
+  std::false_type)
 {
   const TInputImage * inputPtr = this->GetInput();
   TOutputImage *      outputPtr = this->GetOutput(0);
@@ -103,6 +193,16 @@ UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::DynamicThreadedGe
     progress.Completed(outputRegionForThread.GetSize()[0]);
   }
 }
+
+
+template <typename TInputImage, typename TOutputImage, typename TFunction>
+void
+UnaryFunctorImageFilter<TInputImage, TOutputImage, TFunction>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "UseLookupTable: " << (m_UseLookupTable ? "On" : "Off") << std::endl;
+}
 } // end namespace itk
 
 #endif
@@ -0,0 +1,122 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkSymmetricEigenAnalysisBatch.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkSymmetricSecondRankTensor.h"
+#include <gtest/gtest.h>
+
+
+// The eigenvalues computed by blocks are compared with the ones of
+// SymmetricEigenAnalysisFixedDimension, for random matrices and for
+// matrices with equal or nearly equal eigenvalues.
+
+namespace
+{
+template <unsigned int VDimension>
+void
+Expect_same_eigenvalues_as_SymmetricEigenAnalysisFixedDimension()
+{
+  using TensorType = itk::SymmetricSecondRankTensor<double, VDimension>;
+  using VectorType = itk::FixedArray<double, VDimension>;
+  using BatchType = itk::SymmetricEigenAnalysisBatch<VDimension>;
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(1357);
+
+  itk::SymmetricEigenAnalysisFixedDimension<VDimension, TensorType, VectorType> calculator;
+  BatchType                                                                     batch;
+
+  for (unsigned int block = 0; block < 100; ++block)
+  {
+    // the last block is not full
+    const unsigned int numberOfMatrices = block == 99 ? 37 : BatchType::BlockSize;
+
+    TensorType tensors[BatchType::BlockSize];
+    for (unsigned int n = 0; n < numberOfMatrices; ++n)
+    {
+      double vector[VDimension];
+      for (unsigned int i = 0; i < VDimension; ++i)
+      {
+        vector[i] = generator->GetNormalVariate();
+      }
+      for (unsigned int row = 0; row < VDimension; ++row)
+      {
+        for (unsigned int col = row; col < VDimension; ++col)
+        {
+          switch (n % 4)
+          {
+            case 0: // random
+              tensors[n](row, col) = 100.0 * generator->GetNormalVariate();
+              break;
+            case 1: // diagonal
+              tensors[n](row, col) = row == col ? generator->GetNormalVariate() : 0.0;
+              break;
+            case 2: // rank one, with two zero eigenvalues
+              tensors[n](row, col) = vector[row] * vector[col];
+              break;
+            default: // two nearly equal eigenvalues
+              tensors[n](row, col) = vector[row] * vector[col] + (row == col ? 1.0 + 1e-7 * row : 0.0);
+              break;
+          }
+        }
+      }
+      batch.SetMatrix(n, tensors[n]);
+    }
+
+    batch.ComputeEigenValues(numberOfMatrices);
+
+    for (unsigned int n = 0; n < numberOfMatrices; ++n)
+    {
+      VectorType expected;
+      calculator.ComputeEigenValues(tensors[n], expected);
+      double norm = 1e-300;
+      for (unsigned int i = 0; i < VDimension; ++i)
+      {
+        norm = std::max(norm, itk::Math::abs(expected[i]));
+      }
+
+      VectorType eigenValues;
+      batch.GetEigenValues(n, eigenValues);
+      for (unsigned int i = 0; i < VDimension; ++i)
+      {
+        EXPECT_NEAR(eigenValues[i], expected[i], 1e-11 * norm) << "matrix " << tensors[n];
+      }
+
+      batch.GetEigenValues(n, eigenValues, itk::EigenValueOrderEnum::OrderByMagnitude);
+      for (unsigned int i = 1; i < VDimension; ++i)
+      {
+        EXPECT_LE(itk::Math::abs(eigenValues[i - 1]), itk::Math::abs(eigenValues[i]));
+      }
+    }
+  }
+}
+} // namespace
+
+
+TEST(SymmetricEigenAnalysisBatch, SameEigenValuesAsSymmetricEigenAnalysisFixedDimension2D)
+{
+  Expect_same_eigenvalues_as_SymmetricEigenAnalysisFixedDimension<2>();
+}
+
+
+TEST(SymmetricEigenAnalysisBatch, SameEigenValuesAsSymmetricEigenAnalysisFixedDimension3D)
+{
+  Expect_same_eigenvalues_as_SymmetricEigenAnalysisFixedDimension<3>();
+}
@@ -177,6 +177,28 @@ public:
     return this->EvaluateAtContinuousIndexInternal(x, m_ThreadedEvaluateIndex[threadId], m_ThreadedWeights[threadId]);
   }
 
+  /** Evaluate the function at each point of a regular grid, aligned with
+   * the image axes.
+   *
+   * The grid point with grid index i is located at the continuous index
+   * gridOrigin[n] + i[n] * gridStep[n], for 0 <= i[n] < gridSize[n]. The
+   * B-spline weights and the (mirrored) coefficient indices are computed only
+   * once for each grid line along each axis, and the tensor product is
+   * evaluated separably, one dimension at a time. For scale/translation-only
+   * resampling (e.g., upsampling) this reduces the cost per grid point from
+   * (SplineOrder + 1)^ImageDimension to roughly
+   * (SplineOrder + 1) * ImageDimension operations.
+   *
+   * The values are stored in \c values, which must have room for
+   * gridSize.CalculateProductOfElements() values, with the first grid
+   * dimension varying fastest. As with EvaluateAtContinuousIndex, no bounds
+   * checking is done. This method is thread safe. */
+  void
+  EvaluateAtContinuousIndexGrid(const ContinuousIndexType &                      gridOrigin,
+                                const typename ContinuousIndexType::VectorType & gridStep,
+                                const SizeType &                                 gridSize,
+                                OutputType *                                     values) const;
+
   CovariantVectorType
   EvaluateDerivative(const PointType & point) const
   {
@@ -396,6 +418,24 @@ private:
   void
   ApplyMirrorBoundaryConditions(vnl_matrix<long> & evaluateIndex, unsigned int splineOrder) const;
 
+  /** Evaluates the grid points of EvaluateAtContinuousIndexGrid that have
+   * fixed grid indices along the dimensions above \c dimension, by
+   * reducing the values of \c source along \c dimension, one grid line at a
+   * time. The tables hold the mirrored coefficient indices (relative to
+   * their minimum) and the weights for each grid line along each axis. */
+  template <typename TSourceValue>
+  void
+  EvaluateGridAlongDimension(unsigned int                       dimension,
+                             const TSourceValue *               source,
+                             const OffsetValueType *            sourceStrides,
+                             const SizeType &                   gridSize,
+                             const SizeType &                   sourceSize,
+                             const std::vector<OffsetValueType> indexTables[],
+                             const std::vector<double>          weightTables[],
+                             std::vector<double>                buffers[],
+                             OutputType *                       values,
+                             const OffsetValueType *            valueStrides) const;
+
   Iterator m_CIterator;                         // Iterator for
                                                 // traversing spline
                                                 // coefficients.
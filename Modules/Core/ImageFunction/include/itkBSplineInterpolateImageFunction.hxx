@@ -36,6 +36,8 @@
 
 #include "itkMatrix.h"
 
+#include <algorithm> // For fill, max_element and minmax_element.
+
 namespace itk
 {
 /**
@@ -486,6 +488,187 @@ BSplineInterpolateImageFunction<TImageType, TCoordRep, TCoefficientType>::Evalua
   return (interpolated);
 }
 
+template <typename TImageType, typename TCoordRep, typename TCoefficientType>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordRep, TCoefficientType>::EvaluateAtContinuousIndexGrid(
+  const ContinuousIndexType &                      gridOrigin,
+  const typename ContinuousIndexType::VectorType & gridStep,
+  const SizeType &                                 gridSize,
+  OutputType *                                     values) const
+{
+  for (unsigned int n = 0; n < ImageDimension; ++n)
+  {
+    if (gridSize[n] == 0)
+    {
+      return;
+    }
+  }
+
+  const unsigned int numberOfWeights = m_SplineOrder + 1;
+
+  // For each axis, tabulate the coefficient indices and the weights of all
+  // the grid lines along that axis.
+  std::vector<OffsetValueType> indexTables[ImageDimension];
+  std::vector<double>          weightTables[ImageDimension];
+  for (unsigned int n = 0; n < ImageDimension; ++n)
+  {
+    indexTables[n].resize(gridSize[n] * numberOfWeights);
+    weightTables[n].resize(gridSize[n] * numberOfWeights);
+  }
+
+  vnl_matrix<long>   evaluateIndex(ImageDimension, numberOfWeights);
+  vnl_matrix<double> weights(ImageDimension, numberOfWeights);
+
+  const SizeValueType maximumGridSize = *std::max_element(gridSize.begin(), gridSize.end());
+  for (SizeValueType i = 0; i < maximumGridSize; ++i)
+  {
+    ContinuousIndexType x;
+    for (unsigned int n = 0; n < ImageDimension; ++n)
+    {
+      x[n] = (i < gridSize[n]) ? (gridOrigin[n] + i * gridStep[n]) : gridOrigin[n];
+    }
+    this->DetermineRegionOfSupport(evaluateIndex, x, m_SplineOrder);
+    this->SetInterpolationWeights(x, evaluateIndex, weights, m_SplineOrder);
+    this->ApplyMirrorBoundaryConditions(evaluateIndex, m_SplineOrder);
+
+    for (unsigned int n = 0; n < ImageDimension; ++n)
+    {
+      if (i < gridSize[n])
+      {
+        for (unsigned int k = 0; k < numberOfWeights; ++k)
+        {
+          indexTables[n][i * numberOfWeights + k] = evaluateIndex[n][k];
+          weightTables[n][i * numberOfWeights + k] = weights[n][k];
+        }
+      }
+    }
+  }
+
+  // Only the block of coefficients that is actually referenced by the grid
+  // needs to be traversed. Make the tabulated indices relative to this block.
+  const CoefficientDataType * source = m_Coefficients->GetBufferPointer();
+  const OffsetValueType *     offsetTable = m_Coefficients->GetOffsetTable();
+  const IndexType             bufferStart = m_Coefficients->GetBufferedRegion().GetIndex();
+
+  SizeType        sourceSize;
+  OffsetValueType valueStrides[ImageDimension];
+  for (unsigned int n = 0; n < ImageDimension; ++n)
+  {
+    const auto            minmax = std::minmax_element(indexTables[n].cbegin(), indexTables[n].cend());
+    const OffsetValueType minimumIndex = *minmax.first;
+    sourceSize[n] = static_cast<SizeValueType>(*minmax.second - minimumIndex + 1);
+    for (auto & index : indexTables[n])
+    {
+      index -= minimumIndex;
+    }
+    source += (minimumIndex - bufferStart[n]) * offsetTable[n];
+    valueStrides[n] = (n == 0) ? 1 : (valueStrides[n - 1] * static_cast<OffsetValueType>(gridSize[n - 1]));
+  }
+
+  std::vector<double> buffers[ImageDimension];
+  this->EvaluateGridAlongDimension(ImageDimension - 1,
+                                   source,
+                                   offsetTable,
+                                   gridSize,
+                                   sourceSize,
+                                   indexTables,
+                                   weightTables,
+                                   buffers,
+                                   values,
+                                   valueStrides);
+}
+
+template <typename TImageType, typename TCoordRep, typename TCoefficientType>
+template <typename TSourceValue>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordRep, TCoefficientType>::EvaluateGridAlongDimension(
+  unsigned int                       dimension,
+  const TSourceValue *               source,
+  const OffsetValueType *            sourceStrides,
+  const SizeType &                   gridSize,
+  const SizeType &                   sourceSize,
+  const std::vector<OffsetValueType> indexTables[],
+  const std::vector<double>          weightTables[],
+  std::vector<double>                buffers[],
+  OutputType *                       values,
+  const OffsetValueType *            valueStrides) const
+{
+  const unsigned int                   numberOfWeights = m_SplineOrder + 1;
+  const std::vector<OffsetValueType> & indexTable = indexTables[dimension];
+  const std::vector<double> &          weightTable = weightTables[dimension];
+
+  if (dimension == 0)
+  {
+    for (SizeValueType i = 0; i < gridSize[0]; ++i)
+    {
+      double interpolated = 0.0;
+      for (unsigned int k = 0; k < numberOfWeights; ++k)
+      {
+        interpolated +=
+          weightTable[i * numberOfWeights + k] * source[indexTable[i * numberOfWeights + k] * sourceStrides[0]];
+      }
+      values[i * valueStrides[0]] = static_cast<OutputType>(interpolated);
+    }
+    return;
+  }
+
+  // For each grid line along this dimension, the buffer is filled with the
+  // weighted sum of the source slices along this dimension, for each source
+  // position in the lower dimensions. The buffer is then reduced along the
+  // next lower dimension.
+  std::vector<double> & buffer = buffers[dimension - 1];
+  const SizeValueType   lineLength = sourceSize[0];
+  SizeValueType         numberOfLines = 1;
+  OffsetValueType       bufferStrides[ImageDimension];
+  bufferStrides[0] = 1;
+  for (unsigned int n = 1; n < dimension; ++n)
+  {
+    numberOfLines *= sourceSize[n];
+    bufferStrides[n] = bufferStrides[n - 1] * static_cast<OffsetValueType>(sourceSize[n - 1]);
+  }
+  buffer.resize(lineLength * numberOfLines);
+
+  for (SizeValueType i = 0; i < gridSize[dimension]; ++i)
+  {
+    std::fill(buffer.begin(), buffer.end(), 0.0);
+
+    for (unsigned int k = 0; k < numberOfWeights; ++k)
+    {
+      const double               weight = weightTable[i * numberOfWeights + k];
+      const TSourceValue * const slice =
+        source + indexTable[i * numberOfWeights + k] * sourceStrides[dimension];
+
+      for (SizeValueType line = 0; line < numberOfLines; ++line)
+      {
+        OffsetValueType sourceOffset = 0;
+        SizeValueType   remainder = line;
+        for (unsigned int n = 1; n < dimension; ++n)
+        {
+          sourceOffset += static_cast<OffsetValueType>(remainder % sourceSize[n]) * sourceStrides[n];
+          remainder /= sourceSize[n];
+        }
+        const TSourceValue * const sourceLine = slice + sourceOffset;
+        double * const             bufferLine = buffer.data() + line * lineLength;
+
+        for (SizeValueType x = 0; x < lineLength; ++x)
+        {
+          bufferLine[x] += weight * sourceLine[x * sourceStrides[0]];
+        }
+      }
+    }
+    this->EvaluateGridAlongDimension(dimension - 1,
+                                     buffer.data(),
+                                     bufferStrides,
+                                     gridSize,
+                                     sourceSize,
+                                     indexTables,
+                                     weightTables,
+                                     buffers,
+                                     values + i * valueStrides[dimension],
+                                     valueStrides);
+  }
+}
+
 template <typename TImageType, typename TCoordRep, typename TCoefficientType>
 void
 BSplineInterpolateImageFunction<TImageType, TCoordRep, TCoefficientType>::
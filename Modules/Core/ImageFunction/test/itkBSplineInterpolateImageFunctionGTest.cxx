@@ -0,0 +1,124 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkBSplineInterpolateImageFunction.h"
+
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itkIndexRange.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Creates a test image with the specified buffered region, filled with random pixel values.
+template <typename TImage>
+typename TImage::Pointer
+CreateRandomImage(const typename TImage::RegionType & region)
+{
+  const auto image = TImage::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  std::default_random_engine randomEngine;
+  for (auto & pixel : itk::ImageBufferRange<TImage>{ *image })
+  {
+    pixel = std::uniform_real_distribution<float>{ -50.0f, 50.0f }(randomEngine);
+  }
+  return image;
+}
+
+
+// Tests that EvaluateAtContinuousIndexGrid yields the same values as EvaluateAtContinuousIndex, for each grid point.
+template <typename TImage>
+void
+Expect_EvaluateAtContinuousIndexGrid_equals_EvaluateAtContinuousIndex(
+  const typename TImage::RegionType &                          imageRegion,
+  const unsigned int                                           splineOrder,
+  const itk::ContinuousIndex<double, TImage::ImageDimension> & gridOrigin,
+  const itk::Vector<double, TImage::ImageDimension> &          gridStep,
+  const typename TImage::SizeType &                            gridSize)
+{
+  using InterpolatorType = itk::BSplineInterpolateImageFunction<TImage>;
+  constexpr unsigned int ImageDimension = TImage::ImageDimension;
+
+  const auto interpolator = InterpolatorType::New();
+  interpolator->SetSplineOrder(splineOrder);
+  interpolator->SetInputImage(CreateRandomImage<TImage>(imageRegion));
+
+  std::vector<typename InterpolatorType::OutputType> values(typename TImage::RegionType(gridSize).GetNumberOfPixels());
+  interpolator->EvaluateAtContinuousIndexGrid(gridOrigin, gridStep, gridSize, values.data());
+
+  auto valueIt = values.cbegin();
+
+  for (const auto & gridIndex : itk::ZeroBasedIndexRange<ImageDimension>{ gridSize })
+  {
+    typename InterpolatorType::ContinuousIndexType continuousIndex;
+    for (unsigned int n = 0; n < ImageDimension; ++n)
+    {
+      continuousIndex[n] = gridOrigin[n] + gridIndex[n] * gridStep[n];
+    }
+    EXPECT_NEAR(*valueIt, interpolator->EvaluateAtContinuousIndex(continuousIndex), 1e-9)
+      << "Spline order: " << splineOrder << ", grid index: " << gridIndex;
+    ++valueIt;
+  }
+}
+} // namespace
+
+
+// Tests an upsampling grid that covers the entire image, including its borders (where mirroring applies).
+TEST(BSplineInterpolateImageFunction, EvaluateAtContinuousIndexGridOnUpsamplingGrid)
+{
+  using ImageType = itk::Image<float, 3>;
+
+  const ImageType::RegionType imageRegion{ itk::MakeSize(7, 6, 5) };
+  const double                gridOrigin[] = { -0.25, -0.25, -0.25 };
+
+  for (unsigned int splineOrder = 0; splineOrder <= 5; ++splineOrder)
+  {
+    Expect_EvaluateAtContinuousIndexGrid_equals_EvaluateAtContinuousIndex<ImageType>(
+      imageRegion,
+      splineOrder,
+      itk::ContinuousIndex<double, 3>(gridOrigin),
+      itk::MakeVector(0.5, 0.5, 0.5),
+      itk::MakeSize(14, 12, 10));
+  }
+}
+
+
+// Tests a grid with a different step along each axis, on an image whose buffered region does not start at zero.
+TEST(BSplineInterpolateImageFunction, EvaluateAtContinuousIndexGridWithNonZeroImageStartIndex)
+{
+  using ImageType = itk::Image<double, 2>;
+
+  const ImageType::RegionType imageRegion{ itk::MakeIndex(-3, 4), itk::MakeSize(9, 8) };
+  const double                gridOrigin[] = { -2.5, 5.125 };
+
+  for (unsigned int splineOrder = 0; splineOrder <= 5; ++splineOrder)
+  {
+    Expect_EvaluateAtContinuousIndexGrid_equals_EvaluateAtContinuousIndex<ImageType>(
+      imageRegion,
+      splineOrder,
+      itk::ContinuousIndex<double, 2>(gridOrigin),
+      itk::MakeVector(0.75, 1.5),
+      itk::MakeSize(10, 4));
+  }
+}
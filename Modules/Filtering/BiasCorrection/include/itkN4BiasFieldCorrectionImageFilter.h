@@ -27,6 +27,8 @@
 
 #include "vnl/vnl_vector.h"
 
+#include <vector>
+
 namespace itk
 {
 
@@ -72,6 +74,17 @@ namespace itk
  * the corrected input image and spatially smoothing those results with a
  * B-spline scalar field estimate of the bias field.
  *
+ * The B-spline fitting of BSplineScatteredDataPointSetToImageFilter is
+ * performed directly on the image grid: the B-spline weights of the pixels
+ * are products of weights along each dimension, which are computed once per
+ * fitting level, so that the fitting and the reconstruction of the bias field
+ * collapse the control point lattice one dimension at a time instead of
+ * building a point set at each iteration.  The image is split into slabs
+ * along its last dimension, which are processed by the work units of the
+ * filter; each slab is fitted to its own lattice, and the lattices are summed
+ * in the order of the slabs, so that the results are reproducible for a given
+ * number of work units.
+ *
  * \author Nicholas J. Tustison
  *
  * Contributed by Nicholas J. Tustison, James C. Gee in the Insight Journal
@@ -407,12 +420,42 @@ private:
   SharpenImage(const RealImageType * unsharpenedImage, RealImageType * sharpenedImage) const;
 
   /**
-   * Given the unsmoothed estimate of the bias field, this function smooths
-   * the estimate and adds the resulting control point values to the total
-   * bias field estimate.
+   * Given the unsmoothed estimate of the bias field, i.e., the difference
+   * between the uncorrected and the sharpened images, this function smooths
+   * the estimate, adds the resulting control point values to the total bias
+   * field estimate, and evaluates the total bias field estimate on the image
+   * grid.
    */
-  RealImagePointer
-  UpdateBiasFieldEstimate(RealImageType *, std::size_t);
+  void
+  UpdateBiasFieldEstimate(const RealImageType * logUncorrectedImage,
+                          const RealImageType * logSharpenedImage,
+                          RealImageType *       logBiasField);
+
+  /**
+   * Evaluate the B-spline of the current control point lattice on the image
+   * grid.
+   */
+  void
+  EvaluateBiasFieldOnImageGrid(RealImageType * logBiasField) const;
+
+  /**
+   * Compute the B-spline weights of the pixels along each dimension for the
+   * given number of control points.
+   */
+  void
+  ComputeGridWeights(const ArrayType & numberOfControlPoints);
+
+  /** Get the number of slabs along the last dimension in which the image is
+   * split. */
+  SizeValueType
+  GetNumberOfSlabs() const;
+
+  /** Call function(slab, firstPixel, endPixel) for each slab in parallel,
+   * where [firstPixel, endPixel) is the range of the buffer offsets of the
+   * slab. */
+  template <typename TFunction>
+  void
+  ParallelizeOverSlabs(const TFunction & function) const;
 
   /**
    * Convergence is determined by the coefficient of variation of the difference
@@ -445,6 +488,25 @@ private:
   unsigned int m_SplineOrder{ 3 };
   ArrayType    m_NumberOfControlPoints;
   ArrayType    m_NumberOfFittingLevels;
+
+  // B-spline weights of the pixels along one dimension: the first of the
+  // SplineOrder + 1 control points which support each pixel, their weights,
+  // the squared weights, and the cubed weights divided by the sum of the
+  // squared weights.
+  struct GridWeightsType
+  {
+    unsigned int              NumberOfControlPoints{ 0 };
+    std::vector<unsigned int> FirstControlPoint;
+    std::vector<double>       Weights;
+    std::vector<double>       SquaredWeights;
+    std::vector<double>       FittingWeights;
+  };
+
+  GridWeightsType m_GridWeights[ImageDimension];
+
+  // Numerators and denominators of the fitted control points of each slab.
+  std::vector<std::vector<double>> m_DeltaLatticePerSlab;
+  std::vector<std::vector<double>> m_OmegaLatticePerSlab;
 };
 
 } // end namespace itk
@@ -19,19 +19,21 @@
 #define itkN4BiasFieldCorrectionImageFilter_hxx
 
 
-#include "itkAddImageFilter.h"
+#include "itkBinaryGeneratorImageFilter.h"
 #include "itkBSplineControlPointImageFilter.h"
+#include "itkCoxDeBoorBSplineKernelFunction.h"
 #include "itkDivideImageFilter.h"
 #include "itkExpImageFilter.h"
 #include "itkImageBufferRange.h"
+#include "itkImageDuplicator.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionIteratorWithIndex.h"
-#include "itkImportImageFilter.h"
 #include "itkIterationReporter.h"
-#include "itkSubtractImageFilter.h"
 #include "itkVectorIndexSelectionCastImageFilter.h"
 
+#include <algorithm>
+
 CLANG_PRAGMA_PUSH
 CLANG_SUPPRESS_Wfloat_equal
 #include "vnl/algo/vnl_fft_1d.h"
@@ -107,6 +109,8 @@ CLANG_SUPPRESS_Wfloat_equal
       itkExceptionMacro("If a confidence image is specified, its size should be equal to the input image size");
     }
 
+    this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
     // Calculate the log of the input image.
     RealImagePointer logInputImage = RealImageType::New();
     logInputImage->CopyInformation(inputImage);
@@ -121,26 +125,23 @@ CLANG_SUPPRESS_Wfloat_equal
     const bool          useMaskLabel = this->GetUseMaskLabel();
 
     const ImageBufferRange<RealImageType> logInputImageBufferRange{ *logInputImage };
-    const std::size_t                     numberOfPixels = logInputImageBufferRange.size();
-
-    // Number of pixels of the input image that are included with the filter.
-    std::size_t numberOfIncludedPixels = 0;
 
-    for (std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-    {
-      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-           (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
-          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+    this->ParallelizeOverSlabs([&](SizeValueType, SizeValueType firstPixel, SizeValueType endPixel) {
+      for (SizeValueType indexValue = firstPixel; indexValue < endPixel; ++indexValue)
       {
-        ++numberOfIncludedPixels;
-        auto && logInputPixel = logInputImageBufferRange[indexValue];
-
-        if (logInputPixel > NumericTraits<typename InputImageType::PixelType>::ZeroValue())
+        if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+             (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
+            (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
         {
-          logInputPixel = std::log(static_cast<RealType>(logInputPixel));
+          auto && logInputPixel = logInputImageBufferRange[indexValue];
+
+          if (logInputPixel > NumericTraits<typename InputImageType::PixelType>::ZeroValue())
+          {
+            logInputPixel = std::log(static_cast<RealType>(logInputPixel));
+          }
         }
       }
-    }
+    });
 
     // Duplicate logInputImage since we reuse the original at each iteration.
 
@@ -151,18 +152,27 @@ CLANG_SUPPRESS_Wfloat_equal
 
     RealImagePointer logUncorrectedImage = duplicator->GetOutput();
 
-    // Provide an initial log bias field of zeros
+    // Provide an initial log bias field of zeros.  The bias field estimates of
+    // two successive iterations are needed for the convergence measurement, so
+    // two buffers are allocated once and swapped at each iteration.
 
     RealImagePointer logBiasField = RealImageType::New();
     logBiasField->CopyInformation(inputImage);
     logBiasField->SetRegions(inputImage->GetLargestPossibleRegion());
     logBiasField->Allocate(true); // initialize buffer to zero
 
+    RealImagePointer newLogBiasField = RealImageType::New();
+    newLogBiasField->CopyInformation(inputImage);
+    newLogBiasField->SetRegions(inputImage->GetLargestPossibleRegion());
+    newLogBiasField->Allocate(false);
+
     RealImagePointer logSharpenedImage = RealImageType::New();
     logSharpenedImage->CopyInformation(inputImage);
     logSharpenedImage->SetRegions(inputImage->GetLargestPossibleRegion());
     logSharpenedImage->Allocate(false);
 
+    const ImageBufferRange<RealImageType> logUncorrectedImageBufferRange{ *logUncorrectedImage };
+
     // Iterate until convergence or iterative exhaustion.
     unsigned int maximumNumberOfLevels = 1;
     for (unsigned int d = 0; d < this->m_NumberOfFittingLevels.Size(); ++d)
@@ -181,6 +191,18 @@ CLANG_SUPPRESS_Wfloat_equal
     {
       IterationReporter reporter(this, 0, 1);
 
+      // The B-spline weights of the pixels only depend on the number of
+      // control points, which changes with the fitting level.
+      ArrayType numberOfControlPoints = this->m_NumberOfControlPoints;
+      if (this->m_LogBiasFieldControlPointLattice)
+      {
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          numberOfControlPoints[d] = this->m_LogBiasFieldControlPointLattice->GetLargestPossibleRegion().GetSize()[d];
+        }
+      }
+      this->ComputeGridWeights(numberOfControlPoints);
+
       this->m_ElapsedIterations = 0;
       this->m_CurrentConvergenceMeasurement = NumericTraits<RealType>::max();
       while (this->m_ElapsedIterations++ < this->m_MaximumNumberOfIterations[this->m_CurrentLevel] &&
@@ -189,32 +211,29 @@ CLANG_SUPPRESS_Wfloat_equal
         // Sharpen the current estimate of the uncorrected image.
         this->SharpenImage(logUncorrectedImage, logSharpenedImage);
 
-        using SubtracterType = SubtractImageFilter<RealImageType, RealImageType, RealImageType>;
-        auto subtracter1 = SubtracterType::New();
-        subtracter1->SetInput1(logUncorrectedImage);
-        subtracter1->SetInput2(logSharpenedImage);
-
-        RealImagePointer residualBiasField = subtracter1->GetOutput();
-        residualBiasField->Update();
-
-        // Smooth the residual bias field estimate and add the resulting
-        // control point grid to get the new total bias field estimate.
-
-        RealImagePointer newLogBiasField = this->UpdateBiasFieldEstimate(residualBiasField, numberOfIncludedPixels);
+        // Smooth the residual bias field estimate, which is the difference
+        // between the uncorrected and the sharpened images, and add the
+        // resulting control point grid to get the new total bias field
+        // estimate.
+        this->UpdateBiasFieldEstimate(logUncorrectedImage, logSharpenedImage, newLogBiasField);
 
         this->m_CurrentConvergenceMeasurement = this->CalculateConvergenceMeasurement(logBiasField, newLogBiasField);
-        logBiasField = newLogBiasField;
+        std::swap(logBiasField, newLogBiasField);
 
-        auto subtracter2 = SubtracterType::New();
-        subtracter2->SetInput1(logInputImage);
-        subtracter2->SetInput2(logBiasField);
-
-        logUncorrectedImage = subtracter2->GetOutput();
-        logUncorrectedImage->Update();
+        const ImageBufferRange<RealImageType> logBiasFieldBufferRange{ *logBiasField };
+        this->ParallelizeOverSlabs([&](SizeValueType, SizeValueType firstPixel, SizeValueType endPixel) {
+          for (SizeValueType indexValue = firstPixel; indexValue < endPixel; ++indexValue)
+          {
+            logUncorrectedImageBufferRange[indexValue] =
+              logInputImageBufferRange[indexValue] - logBiasFieldBufferRange[indexValue];
+          }
+        });
 
         reporter.CompletedStep();
       }
 
+      // Only the refinement of the control point lattice is needed, which
+      // does not require the reconstruction of the bias field.
       using BSplineReconstructerType =
         BSplineControlPointImageFilter<BiasFieldControlPointLatticeType, ScalarImageType>;
       auto reconstructer = BSplineReconstructerType::New();
@@ -224,7 +243,6 @@ CLANG_SUPPRESS_Wfloat_equal
       reconstructer->SetDirection(logBiasField->GetDirection());
       reconstructer->SetSize(logBiasField->GetLargestPossibleRegion().GetSize());
       reconstructer->SetSplineOrder(this->m_SplineOrder);
-      reconstructer->Update();
 
       typename BSplineReconstructerType::ArrayType numberOfLevels;
       numberOfLevels.Fill(1);
@@ -239,6 +257,10 @@ CLANG_SUPPRESS_Wfloat_equal
       this->m_LogBiasFieldControlPointLattice = reconstructer->RefineControlPointLattice(numberOfLevels);
     }
 
+    // Release the buffers of the fitting.
+    this->m_DeltaLatticePerSlab.clear();
+    this->m_OmegaLatticePerSlab.clear();
+
     using CustomBinaryFilter = itk::BinaryGeneratorImageFilter<InputImageType, RealImageType, OutputImageType>;
     auto expAndDivFilter = CustomBinaryFilter::New();
     auto expAndDivLambda =
@@ -250,6 +272,7 @@ CLANG_SUPPRESS_Wfloat_equal
     expAndDivFilter->SetFunctor(expAndDivLambda);
     expAndDivFilter->SetInput1(inputImage);
     expAndDivFilter->SetInput2(logBiasField);
+    expAndDivFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
     expAndDivFilter->Update();
 
     this->GraftOutput(expAndDivFilter->GetOutput());
@@ -268,59 +291,75 @@ CLANG_SUPPRESS_Wfloat_equal
     // in a vnl_vector to utilize vnl FFT routines.  Note that variables
     // in real space are denoted by a single uppercase letter whereas their
     // frequency counterparts are indicated by a trailing lowercase 'f'.
+    // The range and the histogram are computed for each slab of the image in
+    // parallel, and reduced in the order of the slabs.
 
-    RealType binMaximum = NumericTraits<RealType>::NonpositiveMin();
-    RealType binMinimum = NumericTraits<RealType>::max();
+    const SizeValueType   numberOfSlabs = this->GetNumberOfSlabs();
+    std::vector<RealType> slabMaximum(numberOfSlabs, NumericTraits<RealType>::NonpositiveMin());
+    std::vector<RealType> slabMinimum(numberOfSlabs, NumericTraits<RealType>::max());
 
-    const auto        unsharpenedImageBufferRange = MakeImageBufferRange(unsharpenedImage);
-    const std::size_t numberOfPixels = unsharpenedImageBufferRange.size();
+    const auto unsharpenedImageBufferRange = MakeImageBufferRange(unsharpenedImage);
 
-    for (std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-    {
-      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-           (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
-          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+    this->ParallelizeOverSlabs([&](SizeValueType slab, SizeValueType firstPixel, SizeValueType endPixel) {
+      RealType maximum = NumericTraits<RealType>::NonpositiveMin();
+      RealType minimum = NumericTraits<RealType>::max();
+      for (SizeValueType indexValue = firstPixel; indexValue < endPixel; ++indexValue)
       {
-        RealType pixel = unsharpenedImageBufferRange[indexValue];
-        if (pixel > binMaximum)
-        {
-          binMaximum = pixel;
-        }
-        else if (pixel < binMinimum)
+        if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+             (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
+            (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
         {
-          binMinimum = pixel;
+          const RealType pixel = unsharpenedImageBufferRange[indexValue];
+          maximum = std::max(maximum, pixel);
+          minimum = std::min(minimum, pixel);
         }
       }
-    }
+      slabMaximum[slab] = maximum;
+      slabMinimum[slab] = minimum;
+    });
+
+    const RealType binMaximum = *std::max_element(slabMaximum.begin(), slabMaximum.end());
+    const RealType binMinimum = *std::min_element(slabMinimum.begin(), slabMinimum.end());
     RealType histogramSlope = (binMaximum - binMinimum) / static_cast<RealType>(this->m_NumberOfHistogramBins - 1);
 
     // Create the intensity profile (within the masked region, if applicable)
     // using a triangular parzen windowing scheme.
 
-    vnl_vector<RealType> H(this->m_NumberOfHistogramBins, 0.0);
+    std::vector<vnl_vector<RealType>> slabHistograms(numberOfSlabs);
 
-    for (std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-    {
-      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-           (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
-          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+    this->ParallelizeOverSlabs([&](SizeValueType slab, SizeValueType firstPixel, SizeValueType endPixel) {
+      vnl_vector<RealType> & H = slabHistograms[slab];
+      H.set_size(this->m_NumberOfHistogramBins);
+      H.fill(0.0);
+      for (SizeValueType indexValue = firstPixel; indexValue < endPixel; ++indexValue)
       {
-        RealType pixel = unsharpenedImageBufferRange[indexValue];
-
-        RealType     cidx = (static_cast<RealType>(pixel) - binMinimum) / histogramSlope;
-        unsigned int idx = itk::Math::floor(cidx);
-        RealType     offset = cidx - static_cast<RealType>(idx);
-
-        if (offset == 0.0)
-        {
-          H[idx] += 1.0;
-        }
-        else if (idx < this->m_NumberOfHistogramBins - 1)
+        if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+             (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
+            (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
         {
-          H[idx] += 1.0 - offset;
-          H[idx + 1] += offset;
+          RealType pixel = unsharpenedImageBufferRange[indexValue];
+
+          RealType     cidx = (static_cast<RealType>(pixel) - binMinimum) / histogramSlope;
+          unsigned int idx = itk::Math::floor(cidx);
+          RealType     offset = cidx - static_cast<RealType>(idx);
+
+          if (offset == 0.0)
+          {
+            H[idx] += 1.0;
+          }
+          else if (idx < this->m_NumberOfHistogramBins - 1)
+          {
+            H[idx] += 1.0 - offset;
+            H[idx + 1] += offset;
+          }
         }
       }
+    });
+
+    vnl_vector<RealType> H(slabHistograms[0]);
+    for (SizeValueType slab = 1; slab < numberOfSlabs; ++slab)
+    {
+      H += slabHistograms[slab];
     }
 
     // Determine information about the intensity histogram and zero-pad
@@ -442,167 +481,446 @@ CLANG_SUPPRESS_Wfloat_equal
 
     E = E.extract(this->m_NumberOfHistogramBins, histogramOffset);
 
-    // Sharpen the image with the new mapping, E(u|v)
-    sharpenedImage->FillBuffer(0);
+    // Sharpen the image with the new mapping, E(u|v).  The pixels which are
+    // excluded by the mask or the confidence image are set to zero.
 
     const ImageBufferRange<RealImageType> sharpenedImageBufferRange{ *sharpenedImage };
 
-    for (std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-    {
-      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-           (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
-          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+    this->ParallelizeOverSlabs([&](SizeValueType, SizeValueType firstPixel, SizeValueType endPixel) {
+      for (SizeValueType indexValue = firstPixel; indexValue < endPixel; ++indexValue)
       {
-        RealType     cidx = (unsharpenedImageBufferRange[indexValue] - binMinimum) / histogramSlope;
-        unsigned int idx = itk::Math::floor(cidx);
-
         RealType correctedPixel = 0;
-        if (idx < E.size() - 1)
+        if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+             (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
+            (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
         {
-          correctedPixel = E[idx] + (E[idx + 1] - E[idx]) * (cidx - static_cast<RealType>(idx));
-        }
-        else
-        {
-          correctedPixel = E.back();
+          RealType     cidx = (unsharpenedImageBufferRange[indexValue] - binMinimum) / histogramSlope;
+          unsigned int idx = itk::Math::floor(cidx);
+
+          if (idx < E.size() - 1)
+          {
+            correctedPixel = E[idx] + (E[idx + 1] - E[idx]) * (cidx - static_cast<RealType>(idx));
+          }
+          else
+          {
+            correctedPixel = E.back();
+          }
         }
         sharpenedImageBufferRange[indexValue] = correctedPixel;
       }
-    }
+    });
   }
 
   template <typename TInputImage, typename TMaskImage, typename TOutputImage>
-  typename N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RealImagePointer
-  N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::UpdateBiasFieldEstimate(
-    RealImageType * fieldEstimate, const std::size_t numberOfIncludedPixels)
+  void N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::UpdateBiasFieldEstimate(
+    const RealImageType * logUncorrectedImage, const RealImageType * logSharpenedImage, RealImageType * logBiasField)
   {
-    // Temporarily set the direction cosine to identity since the B-spline
-    // approximation algorithm works in parametric space and not physical
-    // space.
-    typename ScalarImageType::DirectionType identity;
-    identity.SetIdentity();
-
-    const typename ScalarImageType::RegionType & bufferedRegion = fieldEstimate->GetBufferedRegion();
-    const SizeValueType                          numberOfPixels = bufferedRegion.GetNumberOfPixels();
-    const bool                                   filterHandlesMemory = false;
-
-    using ImporterType = ImportImageFilter<RealType, ImageDimension>;
-    auto importer = ImporterType::New();
-    importer->SetImportPointer(fieldEstimate->GetBufferPointer(), numberOfPixels, filterHandlesMemory);
-    importer->SetRegion(fieldEstimate->GetBufferedRegion());
-    importer->SetOrigin(fieldEstimate->GetOrigin());
-    importer->SetSpacing(fieldEstimate->GetSpacing());
-    importer->SetDirection(identity);
-    importer->Update();
-
-    const typename ImporterType::OutputImageType * parametricFieldEstimate = importer->GetOutput();
-
-    PointSetPointer fieldPoints = PointSetType::New();
-    fieldPoints->Initialize();
-    auto & pointSTLContainer = fieldPoints->GetPoints()->CastToSTLContainer();
-    pointSTLContainer.reserve(numberOfIncludedPixels);
-    auto & pointDataSTLContainer = fieldPoints->GetPointData()->CastToSTLContainer();
-    pointDataSTLContainer.reserve(numberOfIncludedPixels);
-
-    typename BSplineFilterType::WeightsContainerType::Pointer weights = BSplineFilterType::WeightsContainerType::New();
-    weights->Initialize();
-    auto & weightSTLContainer = weights->CastToSTLContainer();
-    weightSTLContainer.reserve(numberOfIncludedPixels);
+    // The residual bias field, i.e., the difference between the uncorrected
+    // and the sharpened images, is fitted with the B-spline approximation of
+    // BSplineScatteredDataPointSetToImageFilter, where the pixels are the
+    // points.  Since the pixels lie on a grid, their B-spline weights are
+    // products of weights along each dimension, and the contributions of the
+    // pixels are collapsed one dimension at a time: the contributions of a
+    // row of pixels are accumulated along the first dimension, those of a
+    // plane of rows along the second dimension, and so forth.
+
+    const typename InputImageType::SizeType size = logUncorrectedImage->GetBufferedRegion().GetSize();
+    const unsigned int                      numberOfWeights = this->m_SplineOrder + 1;
+
+    SizeValueType latticeStrides[ImageDimension + 1];
+    latticeStrides[0] = 1;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      latticeStrides[d + 1] = latticeStrides[d] * this->m_GridWeights[d].NumberOfControlPoints;
+    }
+    const SizeValueType numberOfControlPoints = latticeStrides[ImageDimension];
+
+    SizeValueType slabStride = 1;
+    for (unsigned int d = 0; d + 1 < ImageDimension; ++d)
+    {
+      slabStride *= size[d];
+    }
+
+    // Add the contributions of a collapsed lattice, computed for the index
+    // of the pixels along the given dimension, to the collapsed lattice of
+    // the next dimension.
+    const auto spreadAlongDimension = [&](const std::vector<double> & source,
+                                          std::vector<double> &       destination,
+                                          const std::vector<double> & weights,
+                                          unsigned int                dimension,
+                                          SizeValueType               index) {
+      const SizeValueType stride = latticeStrides[dimension];
+      const unsigned int  firstControlPoint = this->m_GridWeights[dimension].FirstControlPoint[index];
+      for (unsigned int j = 0; j < numberOfWeights; ++j)
+      {
+        const double weight = weights[index * numberOfWeights + j];
+        double *     destinationRow = destination.data() + (firstControlPoint + j) * stride;
+        for (SizeValueType q = 0; q < stride; ++q)
+        {
+          destinationRow[q] += weight * source[q];
+        }
+      }
+    };
 
     const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
     const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
     const MaskPixelType maskLabel = this->GetMaskLabel();
     const bool          useMaskLabel = this->GetUseMaskLabel();
 
-    ImageRegionConstIteratorWithIndex<RealImageType> It(parametricFieldEstimate,
-                                                        parametricFieldEstimate->GetRequestedRegion());
+    const auto logUncorrectedImageBufferRange = MakeImageBufferRange(logUncorrectedImage);
+    const auto logSharpenedImageBufferRange = MakeImageBufferRange(logSharpenedImage);
 
-    for (std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue, ++It)
-    {
-      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-           (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
-          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+    const GridWeightsType & firstDimensionWeights = this->m_GridWeights[0];
+
+    // Each slab of the image is fitted to its own pair of lattices, which
+    // are kept from one iteration to the next.
+    const SizeValueType numberOfSlabs = this->GetNumberOfSlabs();
+    this->m_DeltaLatticePerSlab.resize(numberOfSlabs);
+    this->m_OmegaLatticePerSlab.resize(numberOfSlabs);
+
+    this->ParallelizeOverSlabs([&](SizeValueType slab, SizeValueType firstPixel, SizeValueType endPixel) {
+      // The collapsed lattices of the dimensions 1 to ImageDimension - 1; the
+      // lattices of the slab are the collapsed lattices of the last dimension.
+      std::vector<double> collapsedDelta[ImageDimension + 1];
+      std::vector<double> collapsedOmega[ImageDimension + 1];
+      for (unsigned int d = 1; d < ImageDimension; ++d)
       {
-        PointType point;
-        parametricFieldEstimate->TransformIndexToPhysicalPoint(It.GetIndex(), point);
+        collapsedDelta[d].assign(latticeStrides[d], 0.0);
+        collapsedOmega[d].assign(latticeStrides[d], 0.0);
+      }
+      collapsedDelta[ImageDimension].swap(this->m_DeltaLatticePerSlab[slab]);
+      collapsedOmega[ImageDimension].swap(this->m_OmegaLatticePerSlab[slab]);
+      collapsedDelta[ImageDimension].assign(numberOfControlPoints, 0.0);
+      collapsedOmega[ImageDimension].assign(numberOfControlPoints, 0.0);
 
-        ScalarType scalar;
-        scalar[0] = It.Get();
+      SizeValueType index[ImageDimension] = {};
+      index[ImageDimension - 1] = firstPixel / slabStride;
+      const SizeValueType rowLength = (ImageDimension == 1) ? endPixel - firstPixel : size[0];
 
-        pointDataSTLContainer.push_back(scalar);
-        pointSTLContainer.push_back(point);
+      for (SizeValueType indexValue = firstPixel; indexValue < endPixel;)
+      {
+        double * delta = collapsedDelta[1].data();
+        double * omega = collapsedOmega[1].data();
+        for (SizeValueType i = index[0]; i < index[0] + rowLength; ++i, ++indexValue)
+        {
+          if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+               (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
+              (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
+          {
+            double confidenceWeight = 1.0;
+            if (!confidenceImageBufferRange.empty())
+            {
+              confidenceWeight = confidenceImageBufferRange[indexValue];
+            }
+            const double residual =
+              confidenceWeight * (logUncorrectedImageBufferRange[indexValue] - logSharpenedImageBufferRange[indexValue]);
+
+            const unsigned int firstControlPoint = firstDimensionWeights.FirstControlPoint[i];
+            const double *     fittingWeights = &firstDimensionWeights.FittingWeights[i * numberOfWeights];
+            const double *     squaredWeights = &firstDimensionWeights.SquaredWeights[i * numberOfWeights];
+            for (unsigned int j = 0; j < numberOfWeights; ++j)
+            {
+              delta[firstControlPoint + j] += residual * fittingWeights[j];
+              omega[firstControlPoint + j] += confidenceWeight * squaredWeights[j];
+            }
+          }
+        }
 
-        RealType confidenceWeight = 1.0;
-        if (!confidenceImageBufferRange.empty())
+        // Collapse the completed rows, planes, etc., along their dimension.
+        for (unsigned int d = 1; d < ImageDimension; ++d)
         {
-          confidenceWeight = confidenceImageBufferRange[indexValue];
+          spreadAlongDimension(
+            collapsedDelta[d], collapsedDelta[d + 1], this->m_GridWeights[d].FittingWeights, d, index[d]);
+          spreadAlongDimension(
+            collapsedOmega[d], collapsedOmega[d + 1], this->m_GridWeights[d].SquaredWeights, d, index[d]);
+          std::fill(collapsedDelta[d].begin(), collapsedDelta[d].end(), 0.0);
+          std::fill(collapsedOmega[d].begin(), collapsedOmega[d].end(), 0.0);
+          if (++index[d] < size[d])
+          {
+            break;
+          }
+          index[d] = 0;
         }
-        weightSTLContainer.push_back(confidenceWeight);
+      }
+
+      collapsedDelta[ImageDimension].swap(this->m_DeltaLatticePerSlab[slab]);
+      collapsedOmega[ImageDimension].swap(this->m_OmegaLatticePerSlab[slab]);
+    });
+
+    // Sum the lattices of the slabs in order, so that the result does not
+    // depend on the scheduling of the work units.
+    std::vector<double> & deltaLattice = this->m_DeltaLatticePerSlab[0];
+    std::vector<double> & omegaLattice = this->m_OmegaLatticePerSlab[0];
+    for (SizeValueType slab = 1; slab < numberOfSlabs; ++slab)
+    {
+      for (SizeValueType n = 0; n < numberOfControlPoints; ++n)
+      {
+        deltaLattice[n] += this->m_DeltaLatticePerSlab[slab][n];
+        omegaLattice[n] += this->m_OmegaLatticePerSlab[slab][n];
       }
     }
 
-    auto bspliner = BSplineFilterType::New();
+    // Add the control points of the residual bias field to the current
+    // estimate.  The lattice of the first iteration occupies the parametric
+    // domain of BSplineScatteredDataPointSetToImageFilter.
 
-    typename BSplineFilterType::ArrayType numberOfControlPoints;
-    typename BSplineFilterType::ArrayType numberOfFittingLevels;
-    numberOfFittingLevels.Fill(1);
-    for (unsigned int d = 0; d < ImageDimension; ++d)
+    const typename BiasFieldControlPointLatticeType::Pointer previousLattice = this->m_LogBiasFieldControlPointLattice;
+
+    auto lattice = BiasFieldControlPointLatticeType::New();
+    if (previousLattice)
+    {
+      lattice->CopyInformation(previousLattice);
+      lattice->SetRegions(previousLattice->GetLargestPossibleRegion());
+    }
+    else
     {
-      if (!this->m_LogBiasFieldControlPointLattice)
+      typename BiasFieldControlPointLatticeType::SizeType    latticeSize;
+      typename BiasFieldControlPointLatticeType::PointType   latticeOrigin;
+      typename BiasFieldControlPointLatticeType::SpacingType latticeSpacing;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
       {
-        numberOfControlPoints[d] = this->m_NumberOfControlPoints[d];
+        latticeSize[d] = this->m_GridWeights[d].NumberOfControlPoints;
+        const RealType domain = logBiasField->GetSpacing()[d] * static_cast<RealType>(size[d] - 1);
+        latticeSpacing[d] = domain / static_cast<RealType>(latticeSize[d] - this->m_SplineOrder);
+        latticeOrigin[d] = -0.5 * latticeSpacing[d] * (this->m_SplineOrder - 1);
       }
-      else
+      latticeOrigin = logBiasField->GetDirection() * latticeOrigin;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
       {
-        numberOfControlPoints[d] = this->m_LogBiasFieldControlPointLattice->GetLargestPossibleRegion().GetSize()[d];
+        latticeOrigin[d] += logBiasField->GetOrigin()[d] +
+                            logBiasField->GetSpacing()[d] * logBiasField->GetLargestPossibleRegion().GetIndex()[d];
       }
+      lattice->SetRegions(latticeSize);
+      lattice->SetOrigin(latticeOrigin);
+      lattice->SetSpacing(latticeSpacing);
+      lattice->SetDirection(logBiasField->GetDirection());
     }
+    lattice->Allocate();
 
-    typename ScalarImageType::PointType parametricOrigin = fieldEstimate->GetOrigin();
+    const ImageBufferRange<BiasFieldControlPointLatticeType> latticeBufferRange{ *lattice };
+    const auto previousLatticeBufferRange = MakeImageBufferRange(previousLattice.GetPointer());
+    for (SizeValueType n = 0; n < numberOfControlPoints; ++n)
+    {
+      RealType phi = 0.0;
+      if (Math::NotAlmostEquals(omegaLattice[n], 0.0))
+      {
+        phi = static_cast<RealType>(deltaLattice[n] / omegaLattice[n]);
+        if (itk::Math::isnan(phi) || itk::Math::isinf(phi))
+        {
+          phi = 0.0;
+        }
+      }
+      ScalarType controlPoint;
+      controlPoint[0] = phi;
+      if (!previousLatticeBufferRange.empty())
+      {
+        controlPoint += previousLatticeBufferRange[n];
+      }
+      latticeBufferRange[n] = controlPoint;
+    }
+
+    this->m_LogBiasFieldControlPointLattice = lattice;
+
+    this->EvaluateBiasFieldOnImageGrid(logBiasField);
+  }
+
+  template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+  void N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::EvaluateBiasFieldOnImageGrid(
+    RealImageType * logBiasField) const
+  {
+    // As BSplineControlPointImageFilter, the lattice is collapsed one
+    // dimension at a time, from the last one to the first one, and only the
+    // dimensions whose pixel index changes are collapsed again from one row
+    // of pixels to the next.
+
+    const typename InputImageType::SizeType size = logBiasField->GetBufferedRegion().GetSize();
+    const unsigned int                      numberOfWeights = this->m_SplineOrder + 1;
+
+    SizeValueType latticeStrides[ImageDimension + 1];
+    latticeStrides[0] = 1;
     for (unsigned int d = 0; d < ImageDimension; ++d)
     {
-      parametricOrigin[d] += (fieldEstimate->GetSpacing()[d] * fieldEstimate->GetLargestPossibleRegion().GetIndex()[d]);
+      latticeStrides[d + 1] = latticeStrides[d] * this->m_GridWeights[d].NumberOfControlPoints;
     }
-    bspliner->SetOrigin(parametricOrigin);
-    bspliner->SetSpacing(fieldEstimate->GetSpacing());
-    bspliner->SetSize(fieldEstimate->GetLargestPossibleRegion().GetSize());
-    bspliner->SetDirection(fieldEstimate->GetDirection());
-    bspliner->SetGenerateOutputImage(false);
-    bspliner->SetNumberOfLevels(numberOfFittingLevels);
-    bspliner->SetSplineOrder(this->m_SplineOrder);
-    bspliner->SetNumberOfControlPoints(numberOfControlPoints);
-    bspliner->SetInput(fieldPoints);
-    bspliner->SetPointWeights(weights);
-    bspliner->Update();
-
-    typename BiasFieldControlPointLatticeType::Pointer phiLattice = bspliner->GetPhiLattice();
-
-    // Add the bias field control points to the current estimate.
-
-    if (!this->m_LogBiasFieldControlPointLattice)
+
+    SizeValueType slabStride = 1;
+    for (unsigned int d = 0; d + 1 < ImageDimension; ++d)
     {
-      this->m_LogBiasFieldControlPointLattice = phiLattice;
+      slabStride *= size[d];
     }
-    else
+
+    const auto          latticeBufferRange = MakeImageBufferRange(this->m_LogBiasFieldControlPointLattice.GetPointer());
+    std::vector<double> latticeValues(latticeBufferRange.size());
+    for (std::size_t n = 0; n < latticeValues.size(); ++n)
+    {
+      latticeValues[n] = latticeBufferRange[n][0];
+    }
+
+    const ImageBufferRange<RealImageType> logBiasFieldBufferRange{ *logBiasField };
+    const GridWeightsType &               firstDimensionWeights = this->m_GridWeights[0];
+
+    this->ParallelizeOverSlabs([&](SizeValueType, SizeValueType firstPixel, SizeValueType endPixel) {
+      std::vector<double> collapsedLattices[ImageDimension];
+      for (unsigned int d = 1; d < ImageDimension; ++d)
+      {
+        collapsedLattices[d].resize(latticeStrides[d]);
+      }
+      const auto collapsedLattice = [&](unsigned int d) -> const double * {
+        return (d == ImageDimension) ? latticeValues.data() : collapsedLattices[d].data();
+      };
+
+      SizeValueType index[ImageDimension] = {};
+      index[ImageDimension - 1] = firstPixel / slabStride;
+      const SizeValueType rowLength = (ImageDimension == 1) ? endPixel - firstPixel : size[0];
+
+      unsigned int changedDimension = ImageDimension - 1;
+      for (SizeValueType indexValue = firstPixel; indexValue < endPixel;)
+      {
+        for (unsigned int d = changedDimension; d >= 1; --d)
+        {
+          const SizeValueType     stride = latticeStrides[d];
+          const GridWeightsType & weights = this->m_GridWeights[d];
+          const double * const    source = collapsedLattice(d + 1);
+          double * const          destination = collapsedLattices[d].data();
+          std::fill(destination, destination + stride, 0.0);
+          for (unsigned int j = 0; j < numberOfWeights; ++j)
+          {
+            const double   weight = weights.Weights[index[d] * numberOfWeights + j];
+            const double * sourceRow = source + (weights.FirstControlPoint[index[d]] + j) * stride;
+            for (SizeValueType q = 0; q < stride; ++q)
+            {
+              destination[q] += weight * sourceRow[q];
+            }
+          }
+        }
+
+        const double * row = collapsedLattice(1);
+        for (SizeValueType i = index[0]; i < index[0] + rowLength; ++i, ++indexValue)
+        {
+          const double * weights = &firstDimensionWeights.Weights[i * numberOfWeights];
+          const double * controlPoints = row + firstDimensionWeights.FirstControlPoint[i];
+          double         value = 0.0;
+          for (unsigned int j = 0; j < numberOfWeights; ++j)
+          {
+            value += weights[j] * controlPoints[j];
+          }
+          logBiasFieldBufferRange[indexValue] = static_cast<RealType>(value);
+        }
+
+        for (unsigned int d = 1; d < ImageDimension; ++d)
+        {
+          changedDimension = d;
+          if (++index[d] < size[d])
+          {
+            break;
+          }
+          index[d] = 0;
+        }
+      }
+    });
+  }
+
+  template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+  void N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::ComputeGridWeights(
+    const ArrayType & numberOfControlPoints)
+  {
+    // The parametric coordinates of the pixels and their weights are those
+    // of BSplineScatteredDataPointSetToImageFilter and
+    // BSplineControlPointImageFilter.
+
+    const typename InputImageType::SizeType size = this->GetInput()->GetBufferedRegion().GetSize();
+    const unsigned int                      numberOfWeights = this->m_SplineOrder + 1;
+    constexpr double                        bsplineEpsilon = 1e-3;
+
+    using KernelType = CoxDeBoorBSplineKernelFunction<3, double>;
+    auto kernel = KernelType::New();
+    kernel->SetSplineOrder(this->m_SplineOrder);
+
+    for (unsigned int d = 0; d < ImageDimension; ++d)
     {
-      // Ensure that the two lattices occupy the same physical space.  Not
-      // necessary for performance since the parameters of the reconstructed
-      // bias field are specified later in this function in the reconstructer.
-      phiLattice->CopyInformation(this->m_LogBiasFieldControlPointLattice);
-
-      using AdderType = AddImageFilter<BiasFieldControlPointLatticeType,
-                                       BiasFieldControlPointLatticeType,
-                                       BiasFieldControlPointLatticeType>;
-      auto adder = AdderType::New();
-      adder->SetInput1(this->m_LogBiasFieldControlPointLattice);
-      adder->SetInput2(phiLattice);
-      adder->Update();
-
-      this->m_LogBiasFieldControlPointLattice = adder->GetOutput();
+      if (numberOfControlPoints[d] < this->m_SplineOrder + 1)
+      {
+        itkExceptionMacro("The number of control points must be greater than the spline order.");
+      }
+
+      GridWeightsType & weights = this->m_GridWeights[d];
+      weights.NumberOfControlPoints = numberOfControlPoints[d];
+      weights.FirstControlPoint.resize(size[d]);
+      weights.Weights.resize(size[d] * numberOfWeights);
+      weights.FittingWeights.resize(size[d] * numberOfWeights);
+      weights.SquaredWeights.resize(size[d] * numberOfWeights);
+
+      const unsigned int totalNumberOfSpans = numberOfControlPoints[d] - this->m_SplineOrder;
+      const double       r = static_cast<double>(totalNumberOfSpans) / static_cast<double>(size[d] - 1);
+      const double       epsilon = r * bsplineEpsilon;
+
+      for (SizeValueType i = 0; i < size[d]; ++i)
+      {
+        double p = r * static_cast<double>(i);
+        if (itk::Math::abs(p - static_cast<double>(totalNumberOfSpans)) <= epsilon)
+        {
+          p = static_cast<double>(totalNumberOfSpans) - epsilon;
+        }
+        if (!(p >= 0.0 && p < static_cast<double>(totalNumberOfSpans)))
+        {
+          itkExceptionMacro("The reparameterized point component "
+                            << p << " is outside the corresponding parametric domain of [0, " << totalNumberOfSpans
+                            << ").");
+        }
+
+        const auto firstControlPoint = static_cast<unsigned int>(p);
+        weights.FirstControlPoint[i] = firstControlPoint;
+
+        double sumOfSquaredWeights = 0.0;
+        for (unsigned int j = 0; j < numberOfWeights; ++j)
+        {
+          const double B = kernel->Evaluate(p - static_cast<double>(firstControlPoint + j) +
+                                            0.5 * static_cast<double>(this->m_SplineOrder - 1));
+          weights.Weights[i * numberOfWeights + j] = B;
+          weights.SquaredWeights[i * numberOfWeights + j] = B * B;
+          sumOfSquaredWeights += B * B;
+        }
+        for (unsigned int j = 0; j < numberOfWeights; ++j)
+        {
+          const double B = weights.Weights[i * numberOfWeights + j];
+          weights.FittingWeights[i * numberOfWeights + j] = B * B * B / sumOfSquaredWeights;
+        }
+      }
     }
+  }
 
-    RealImagePointer smoothField = this->ReconstructBiasField(this->m_LogBiasFieldControlPointLattice);
+  template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+  SizeValueType N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::GetNumberOfSlabs() const
+  {
+    const SizeValueType slabDimensionSize = this->GetInput()->GetBufferedRegion().GetSize(ImageDimension - 1);
+    return std::max(std::min(static_cast<SizeValueType>(this->GetNumberOfWorkUnits()), slabDimensionSize),
+                    SizeValueType{ 1 });
+  }
 
-    return smoothField;
+  template <typename TInputImage, typename TMaskImage, typename TOutputImage>
+  template <typename TFunction>
+  void N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::ParallelizeOverSlabs(
+    const TFunction & function) const
+  {
+    const typename InputImageType::SizeType size = this->GetInput()->GetBufferedRegion().GetSize();
+
+    SizeValueType slabStride = 1;
+    for (unsigned int d = 0; d + 1 < ImageDimension; ++d)
+    {
+      slabStride *= size[d];
+    }
+    const SizeValueType slabDimensionSize = size[ImageDimension - 1];
+    const SizeValueType numberOfSlabs = this->GetNumberOfSlabs();
+
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfSlabs,
+      [&](SizeValueType slab) {
+        function(slab,
+                 slab * slabDimensionSize / numberOfSlabs * slabStride,
+                 (slab + 1) * slabDimensionSize / numberOfSlabs * slabStride);
+      },
+      nullptr);
   }
 
   template <typename TInputImage, typename TMaskImage, typename TOutputImage>
@@ -638,50 +956,71 @@ CLANG_SUPPRESS_Wfloat_equal
     return biasField;
   }
 
+
   template <typename TInputImage, typename TMaskImage, typename TOutputImage>
   typename N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::RealType
   N4BiasFieldCorrectionImageFilter<TInputImage, TMaskImage, TOutputImage>::CalculateConvergenceMeasurement(
     const RealImageType * fieldEstimate1, const RealImageType * fieldEstimate2) const
   {
-    using SubtracterType = SubtractImageFilter<RealImageType, RealImageType, RealImageType>;
-    auto subtracter = SubtracterType::New();
-    subtracter->SetInput1(fieldEstimate1);
-    subtracter->SetInput2(fieldEstimate2);
-    subtracter->Update();
-
-    // Calculate statistics over the mask region
-
-    RealType mu = 0.0;
-    RealType sigma = 0.0;
-    RealType N = 0.0;
+    // Calculate statistics over the mask region.  The mean and the sum of
+    // squared deviations of each slab are updated pixel by pixel, and the
+    // statistics of the slabs are combined in order.
 
     const auto          maskImageBufferRange = MakeImageBufferRange(this->GetMaskImage());
     const auto          confidenceImageBufferRange = MakeImageBufferRange(this->GetConfidenceImage());
     const MaskPixelType maskLabel = this->GetMaskLabel();
     const bool          useMaskLabel = this->GetUseMaskLabel();
 
-    const auto        subtracterImageBufferRange = MakeImageBufferRange(subtracter->GetOutput());
-    const std::size_t numberOfPixels = subtracterImageBufferRange.size();
+    const auto fieldEstimate1BufferRange = MakeImageBufferRange(fieldEstimate1);
+    const auto fieldEstimate2BufferRange = MakeImageBufferRange(fieldEstimate2);
 
-    for (std::size_t indexValue = 0; indexValue < numberOfPixels; ++indexValue)
-    {
-      if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
-           (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
-          (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
-      {
-        RealType pixel = std::exp(subtracterImageBufferRange[indexValue]);
-        N += 1.0;
+    const SizeValueType numberOfSlabs = this->GetNumberOfSlabs();
+    std::vector<double> slabN(numberOfSlabs);
+    std::vector<double> slabMu(numberOfSlabs);
+    std::vector<double> slabSigma(numberOfSlabs);
 
-        if (N > 1.0)
+    this->ParallelizeOverSlabs([&](SizeValueType slab, SizeValueType firstPixel, SizeValueType endPixel) {
+      double mu = 0.0;
+      double sigma = 0.0;
+      double N = 0.0;
+      for (SizeValueType indexValue = firstPixel; indexValue < endPixel; ++indexValue)
+      {
+        if ((maskImageBufferRange.empty() || (useMaskLabel && maskImageBufferRange[indexValue] == maskLabel) ||
+             (!useMaskLabel && maskImageBufferRange[indexValue] != NumericTraits<MaskPixelType>::ZeroValue())) &&
+            (confidenceImageBufferRange.empty() || confidenceImageBufferRange[indexValue] > 0.0))
         {
-          sigma = sigma + itk::Math::sqr(pixel - mu) * (N - 1.0) / N;
+          const double pixel = std::exp(fieldEstimate1BufferRange[indexValue] - fieldEstimate2BufferRange[indexValue]);
+          N += 1.0;
+
+          if (N > 1.0)
+          {
+            sigma = sigma + itk::Math::sqr(pixel - mu) * (N - 1.0) / N;
+          }
+          mu = mu * (1.0 - 1.0 / N) + pixel / N;
         }
-        mu = mu * (1.0 - 1.0 / N) + pixel / N;
+      }
+      slabN[slab] = N;
+      slabMu[slab] = mu;
+      slabSigma[slab] = sigma;
+    });
+
+    double mu = 0.0;
+    double sigma = 0.0;
+    double N = 0.0;
+    for (SizeValueType slab = 0; slab < numberOfSlabs; ++slab)
+    {
+      if (slabN[slab] > 0.0)
+      {
+        const double totalN = N + slabN[slab];
+        const double difference = slabMu[slab] - mu;
+        sigma += slabSigma[slab] + itk::Math::sqr(difference) * N * slabN[slab] / totalN;
+        mu += difference * slabN[slab] / totalN;
+        N = totalN;
       }
     }
     sigma = std::sqrt(sigma / (N - 1.0));
 
-    return (sigma / mu);
+    return static_cast<RealType>(sigma / mu);
   }
 
   template <typename TInputImage, typename TMaskImage, typename TOutputImage>
@@ -0,0 +1,169 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkN4BiasFieldCorrectionImageFilter.h"
+#include "itkTestingMacros.h"
+
+// The bias field of a synthetic volume, made of two classes of tissue with a
+// smooth multiplicative bias, is estimated with several numbers of work
+// units. The corrected images are compared, and the bias field reconstructed
+// from the control point lattice is compared with the correction.
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using ImageType = itk::Image<float, Dimension>;
+using MaskImageType = itk::Image<unsigned char, Dimension>;
+using CorrecterType = itk::N4BiasFieldCorrectionImageFilter<ImageType, MaskImageType, ImageType>;
+
+// Coefficient of variation of the pixels of the given class.
+double
+CoefficientOfVariation(const ImageType * image, const MaskImageType * classes, unsigned char label)
+{
+  double                                       sum = 0.0;
+  double                                       sumOfSquares = 0.0;
+  double                                       count = 0.0;
+  itk::ImageRegionConstIterator<ImageType>     it(image, image->GetBufferedRegion());
+  itk::ImageRegionConstIterator<MaskImageType> classIt(classes, classes->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it, ++classIt)
+  {
+    if (classIt.Get() == label)
+    {
+      sum += it.Get();
+      sumOfSquares += itk::Math::sqr(it.Get());
+      count += 1.0;
+    }
+  }
+  const double mean = sum / count;
+  return std::sqrt(sumOfSquares / count - mean * mean) / mean;
+}
+} // namespace
+
+int
+itkN4BiasFieldCorrectionImageFilterWorkUnitsTest(int, char *[])
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 41, 36, 23 } });
+  image->SetSpacing(itk::MakeVector(1.0, 1.2, 2.0));
+  image->SetOrigin(itk::MakePoint(-10.0, 5.0, 2.5));
+  image->Allocate();
+
+  auto mask = MaskImageType::New();
+  mask->CopyInformation(image);
+  mask->SetRegions(image->GetBufferedRegion());
+  mask->Allocate();
+
+  auto classes = MaskImageType::New();
+  classes->CopyInformation(image);
+  classes->SetRegions(image->GetBufferedRegion());
+  classes->Allocate();
+
+  // a slab pattern of two classes in an ellipsoid, with a bias field which
+  // varies along every dimension
+  const ImageType::SizeType size = image->GetBufferedRegion().GetSize();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    double                     radius = 0.0;
+    double                     logBias = 0.0;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      const double x = (index[d] + 0.5) / size[d] - 0.5;
+      radius += itk::Math::sqr(2.0 * x);
+      logBias += 0.3 * (d + 1) * x * (1.0 - x);
+    }
+    const unsigned char label = ((index[0] / 6 + index[1] / 5 + index[2] / 4) % 2) + 1;
+    const double        texture = (index[0] * 7919 + index[1] * 104729 + index[2] * 15485863) % 11;
+    it.Set(static_cast<float>((label == 1 ? 100.0 : 160.0) + texture) * std::exp(logBias));
+    mask->SetPixel(index, radius < 0.9 ? 1 : 0);
+    classes->SetPixel(index, radius < 0.9 ? label : 0);
+  }
+
+  CorrecterType::VariableSizeArrayType maximumNumberOfIterations(2);
+  maximumNumberOfIterations.Fill(10);
+  CorrecterType::ArrayType numberOfFittingLevels;
+  numberOfFittingLevels.Fill(2);
+
+  ImageType::Pointer reference;
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3, 8 })
+  {
+    auto correcter = CorrecterType::New();
+    correcter->SetInput(image);
+    correcter->SetMaskImage(mask);
+    correcter->SetMaximumNumberOfIterations(maximumNumberOfIterations);
+    correcter->SetNumberOfFittingLevels(numberOfFittingLevels);
+    correcter->SetConvergenceThreshold(0.0);
+    correcter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    ITK_TRY_EXPECT_NO_EXCEPTION(correcter->Update());
+
+    const ImageType * output = correcter->GetOutput();
+    std::cout << numberOfWorkUnits << " work units: coefficients of variation "
+              << CoefficientOfVariation(output, classes, 1) << " and " << CoefficientOfVariation(output, classes, 2)
+              << " instead of " << CoefficientOfVariation(image, classes, 1) << " and "
+              << CoefficientOfVariation(image, classes, 2) << std::endl;
+    for (unsigned char label = 1; label <= 2; ++label)
+    {
+      ITK_TEST_EXPECT_TRUE(CoefficientOfVariation(output, classes, label) <
+                           0.8 * CoefficientOfVariation(image, classes, label));
+    }
+
+    // The lattice of the last level reconstructs the bias field of the
+    // correction.
+    const CorrecterType::RealImagePointer logBiasField =
+      correcter->ReconstructBiasField(correcter->GetLogBiasFieldControlPointLattice());
+
+    itk::ImageRegionConstIterator<ImageType>                      inputIt(image, image->GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType>                      outputIt(output, output->GetBufferedRegion());
+    itk::ImageRegionConstIterator<CorrecterType::RealImageType> biasIt(logBiasField,
+                                                                        logBiasField->GetBufferedRegion());
+    double maximumBiasError = 0.0;
+    for (; !inputIt.IsAtEnd(); ++inputIt, ++outputIt, ++biasIt)
+    {
+      const double biasError = itk::Math::abs(outputIt.Get() * std::exp(biasIt.Get()) / inputIt.Get() - 1.0);
+      maximumBiasError = std::max(maximumBiasError, biasError);
+    }
+    std::cout << "  maximum relative error of the reconstructed bias field: " << maximumBiasError << std::endl;
+    ITK_TEST_EXPECT_TRUE(maximumBiasError < 1e-4);
+
+    if (numberOfWorkUnits == 1)
+    {
+      reference = correcter->GetOutput();
+      reference->DisconnectPipeline();
+      continue;
+    }
+
+    // The sums of the slabs are rounded differently.
+    double maximumDifference = 0.0;
+    for (itk::ImageRegionConstIterator<ImageType> it(output, output->GetBufferedRegion()),
+         referenceIt(reference, reference->GetBufferedRegion());
+         !it.IsAtEnd();
+         ++it, ++referenceIt)
+    {
+      const double difference = itk::Math::abs(it.Get() - referenceIt.Get()) / referenceIt.Get();
+      maximumDifference = std::max(maximumDifference, difference);
+    }
+    std::cout << "  maximum relative difference with 1 work unit: " << maximumDifference << std::endl;
+    ITK_TEST_EXPECT_TRUE(maximumDifference < 1e-4);
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBinaryImageToBitPackedImageFilter_h
+#define itkBinaryImageToBitPackedImageFilter_h
+
+#include "itkBitPackedImage.h"
+#include "itkImageRegionSplitterDirection.h"
+#include "itkImageToImageFilter.h"
+
+namespace itk
+{
+/**
+ * \class BinaryImageToBitPackedImageFilter
+ * \brief Convert a binary image to a BitPackedImage.
+ *
+ * The pixels equal to the ForegroundValue are set to true in the output,
+ * the other ones to false. ForegroundValue defaults to the maximum value of
+ * the input PixelType.
+ *
+ * \sa BitPackedImage BitPackedImageToBinaryImageFilter
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template <typename TInputImage, typename TOutputImage = BitPackedImage<TInputImage::ImageDimension>>
+class ITK_TEMPLATE_EXPORT BinaryImageToBitPackedImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BinaryImageToBitPackedImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = BinaryImageToBitPackedImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BinaryImageToBitPackedImageFilter, ImageToImageFilter);
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using WordType = typename OutputImageType::WordType;
+
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  /** Set/Get the value in the input image considered as foreground. */
+  itkSetMacro(ForegroundValue, InputPixelType);
+  itkGetConstMacro(ForegroundValue, InputPixelType);
+
+protected:
+  BinaryImageToBitPackedImageFilter();
+  ~BinaryImageToBitPackedImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  /** The words of a row are written by a single thread: the output region
+   * is not split along the rows. */
+  const ImageRegionSplitterBase *
+  GetImageRegionSplitter() const override;
+
+private:
+  InputPixelType m_ForegroundValue;
+
+  ImageRegionSplitterDirection::Pointer m_ImageRegionSplitter;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBinaryImageToBitPackedImageFilter.hxx"
+#endif
+
+#endif
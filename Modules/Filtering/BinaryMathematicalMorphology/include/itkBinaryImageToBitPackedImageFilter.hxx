@@ -0,0 +1,86 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBinaryImageToBitPackedImageFilter_hxx
+#define itkBinaryImageToBitPackedImageFilter_hxx
+
+#include "itkImageScanlineConstIterator.h"
+#include "itkTotalProgressReporter.h"
+
+#include <vector>
+
+namespace itk
+{
+template <typename TInputImage, typename TOutputImage>
+BinaryImageToBitPackedImageFilter<TInputImage, TOutputImage>::BinaryImageToBitPackedImageFilter()
+  : m_ForegroundValue(NumericTraits<InputPixelType>::max())
+{
+  m_ImageRegionSplitter = ImageRegionSplitterDirection::New();
+  this->DynamicMultiThreadingOn();
+  this->ThreaderUpdateProgressOff();
+}
+
+template <typename TInputImage, typename TOutputImage>
+const ImageRegionSplitterBase *
+BinaryImageToBitPackedImageFilter<TInputImage, TOutputImage>::GetImageRegionSplitter() const
+{
+  return m_ImageRegionSplitter.GetPointer();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+BinaryImageToBitPackedImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  const SizeValueType   length = outputRegionForThread.GetSize(0);
+  std::vector<WordType> words((length + OutputImageType::BitsPerWord - 1) / OutputImageType::BitsPerWord);
+
+  ImageScanlineConstIterator<InputImageType> it(input, outputRegionForThread);
+  while (!it.IsAtEnd())
+  {
+    std::fill(words.begin(), words.end(), WordType{ 0 });
+    const auto index = it.GetIndex();
+    for (SizeValueType i = 0; !it.IsAtEndOfLine(); ++it, ++i)
+    {
+      if (it.Get() == m_ForegroundValue)
+      {
+        words[i / OutputImageType::BitsPerWord] |= WordType{ 1 } << (i % OutputImageType::BitsPerWord);
+      }
+    }
+    output->SetRowWords(index, length, words.data());
+    it.NextLine();
+    progress.Completed(length);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+BinaryImageToBitPackedImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  using PrintType = typename NumericTraits<InputPixelType>::PrintType;
+  os << indent << "ForegroundValue: " << static_cast<PrintType>(m_ForegroundValue) << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,72 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedBinaryErodeImageFilter_h
+#define itkBitPackedBinaryErodeImageFilter_h
+
+#include "itkBitPackedBinaryMorphologyImageFilter.h"
+
+#include <functional>
+
+namespace itk
+{
+/**
+ * \class BitPackedBinaryErodeImageFilter
+ * \brief Fast binary erosion of a BitPackedImage.
+ *
+ * The output pixel at index x is true if all the input pixels at x + k are
+ * true, for the offsets k of the structuring element. The pixels outside of
+ * the image are foreground by default, as in BinaryErodeImageFilter.
+ *
+ * \sa BitPackedBinaryMorphologyImageFilter BitPackedBinaryDilateImageFilter
+ * \sa BinaryErodeImageFilter
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template <typename TImage, typename TKernel = FlatStructuringElement<TImage::ImageDimension>>
+class ITK_TEMPLATE_EXPORT BitPackedBinaryErodeImageFilter : public BitPackedBinaryMorphologyImageFilter<TImage, TKernel>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BitPackedBinaryErodeImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = BitPackedBinaryErodeImageFilter;
+  using Superclass = BitPackedBinaryMorphologyImageFilter<TImage, TKernel>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BitPackedBinaryErodeImageFilter, BitPackedBinaryMorphologyImageFilter);
+
+  using WordType = typename Superclass::WordType;
+  using OutputImageRegionType = typename Superclass::OutputImageRegionType;
+
+protected:
+  BitPackedBinaryErodeImageFilter() { this->m_BoundaryToForeground = true; }
+  ~BitPackedBinaryErodeImageFilter() override = default;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override
+  {
+    this->template ComputeRows<std::bit_and<WordType>>(outputRegionForThread, ~WordType{ 0 });
+  }
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,183 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedBinaryMorphologyImageFilter_hxx
+#define itkBitPackedBinaryMorphologyImageFilter_hxx
+
+#include "itkIndexRange.h"
+#include "itkTotalProgressReporter.h"
+
+#include <map>
+#include <utility>
+
+namespace itk
+{
+template <typename TImage, typename TKernel>
+BitPackedBinaryMorphologyImageFilter<TImage, TKernel>::BitPackedBinaryMorphologyImageFilter()
+{
+  m_ImageRegionSplitter = ImageRegionSplitterDirection::New();
+  this->DynamicMultiThreadingOn();
+  this->ThreaderUpdateProgressOff();
+}
+
+template <typename TImage, typename TKernel>
+const ImageRegionSplitterBase *
+BitPackedBinaryMorphologyImageFilter<TImage, TKernel>::GetImageRegionSplitter() const
+{
+  return m_ImageRegionSplitter.GetPointer();
+}
+
+template <typename TImage, typename TKernel>
+void
+BitPackedBinaryMorphologyImageFilter<TImage, TKernel>::BeforeThreadedGenerateData()
+{
+  // The pixels of the kernel are stored row after row, so the runs are
+  // the sequences of consecutive active pixels of a row.
+  const KernelType &  kernel = this->GetKernel();
+  const SizeValueType rowLength = kernel.GetSize(0);
+  const SizeValueType numberOfPixels = kernel.Size();
+  using RunType = std::pair<OffsetValueType, OffsetValueType>;
+  std::map<RunType, std::vector<OffsetType>> runGroups;
+  for (SizeValueType i = 0; i < numberOfPixels; ++i)
+  {
+    if (!kernel[i])
+    {
+      continue;
+    }
+    const SizeValueType first = i;
+    while (i + 1 < numberOfPixels && (i + 1) % rowLength != 0 && kernel[i + 1])
+    {
+      ++i;
+    }
+    OffsetType rowOffset = kernel.GetOffset(first);
+    const RunType run(rowOffset[0], kernel.GetOffset(i)[0]);
+    rowOffset[0] = 0;
+    runGroups[run].push_back(rowOffset);
+  }
+
+  m_KernelRunGroups.clear();
+  for (const auto & runGroup : runGroups)
+  {
+    m_KernelRunGroups.push_back({ runGroup.first.first, runGroup.first.second, runGroup.second });
+  }
+}
+
+template <typename TImage, typename TKernel>
+template <typename TOperation>
+void
+BitPackedBinaryMorphologyImageFilter<TImage, TKernel>::CombineWindow(std::vector<WordType> & words,
+                                                                     OffsetValueType         width)
+{
+  constexpr OffsetValueType bitsPerWord = ImageType::BitsPerWord;
+  const TOperation          operation;
+  const OffsetValueType     numberOfWords = words.size();
+
+  // combine each bit with the bit at the given distance, in place: the
+  // words are processed in increasing order, and only read the next ones
+  const auto combineShifted = [&](OffsetValueType distance) {
+    const OffsetValueType q = distance / bitsPerWord;
+    const OffsetValueType r = distance % bitsPerWord;
+    for (OffsetValueType k = 0; k + q < numberOfWords; ++k)
+    {
+      WordType shifted = words[k + q] >> r;
+      if (r > 0 && k + q + 1 < numberOfWords)
+      {
+        shifted |= words[k + q + 1] << (bitsPerWord - r);
+      }
+      words[k] = operation(words[k], shifted);
+    }
+  };
+
+  // each bit combines the windows of 1, 2, 4, ... bits starting at it, up
+  // to the largest power of two not larger than the width, and then the two
+  // overlapping windows covering the width. The last bits, for which the
+  // window is past the end of the words, are not used.
+  OffsetValueType window = 1;
+  while (2 * window <= width)
+  {
+    combineShifted(window);
+    window *= 2;
+  }
+  if (width > window)
+  {
+    combineShifted(width - window);
+  }
+}
+
+template <typename TImage, typename TKernel>
+template <typename TOperation>
+void
+BitPackedBinaryMorphologyImageFilter<TImage, TKernel>::ComputeRows(const OutputImageRegionType & region,
+                                                                   WordType                      identity)
+{
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  constexpr SizeValueType bitsPerWord = ImageType::BitsPerWord;
+  const TOperation        operation;
+  const SizeValueType     length = region.GetSize(0);
+  std::vector<WordType>   result((length + bitsPerWord - 1) / bitsPerWord);
+  std::vector<WordType>   runWords;
+  std::vector<WordType>   rowWords;
+
+  OutputImageRegionType rows = region;
+  rows.SetSize(0, 1);
+  for (const IndexType & index : ImageRegionIndexRange<ImageDimension>(rows))
+  {
+    std::fill(result.begin(), result.end(), identity);
+    for (const KernelRunGroup & runGroup : m_KernelRunGroups)
+    {
+      // the output pixel at position i of the row combines the input pixels
+      // from index[0] + i + begin to index[0] + i + end
+      const OffsetValueType width = runGroup.end - runGroup.begin + 1;
+      const SizeValueType   numberOfWords = (length + width - 1 + bitsPerWord - 1) / bitsPerWord;
+      runWords.assign(numberOfWords, identity);
+      rowWords.resize(numberOfWords);
+      for (const OffsetType & rowOffset : runGroup.rowOffsets)
+      {
+        IndexType rowIndex = index + rowOffset;
+        rowIndex[0] += runGroup.begin;
+        input->GetRowWords(rowIndex, numberOfWords, m_BoundaryToForeground, rowWords.data());
+        for (SizeValueType k = 0; k < numberOfWords; ++k)
+        {
+          runWords[k] = operation(runWords[k], rowWords[k]);
+        }
+      }
+      CombineWindow<TOperation>(runWords, width);
+      for (SizeValueType k = 0; k < result.size(); ++k)
+      {
+        result[k] = operation(result[k], runWords[k]);
+      }
+    }
+    output->SetRowWords(index, length, result.data());
+    progress.Completed(length);
+  }
+}
+
+template <typename TImage, typename TKernel>
+void
+BitPackedBinaryMorphologyImageFilter<TImage, TKernel>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "BoundaryToForeground: " << m_BoundaryToForeground << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,290 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedImage_h
+#define itkBitPackedImage_h
+
+#include "itkImageBase.h"
+#include "itkImportImageContainer.h"
+
+#include <cstdint>
+
+namespace itk
+{
+/**
+ * \class BitPackedImage
+ * \brief Binary image storing one bit per pixel.
+ *
+ * The pixels of each row of the buffered region, along the first
+ * dimension, are packed in 64-bit words: the pixel at position i of the
+ * row is the bit i % 64 of the word i / 64 of the row. Each row starts on
+ * a new word, and the bits of the last word of a row past the end of the
+ * row are always zero. The image takes eight times less memory than an
+ * image of unsigned char, and filters can process 64 pixels at once with
+ * bitwise operations on the words.
+ *
+ * GetRowWords() and SetRowWords() read and write the words of a row
+ * starting at any pixel, and are the building blocks of the filters
+ * processing bit-packed images. BitPackedImageRegionConstIterator and
+ * BitPackedImageRegionIterator give access to the pixels one by one.
+ *
+ * \sa BinaryImageToBitPackedImageFilter BitPackedImageToBinaryImageFilter
+ * \sa BitPackedBinaryDilateImageFilter BitPackedBinaryErodeImageFilter
+ * \ingroup ImageObjects
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template <unsigned int VImageDimension = 2>
+class ITK_TEMPLATE_EXPORT BitPackedImage : public ImageBase<VImageDimension>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BitPackedImage);
+
+  /** Standard class type aliases */
+  using Self = BitPackedImage;
+  using Superclass = ImageBase<VImageDimension>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using ConstWeakPointer = WeakPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BitPackedImage, ImageBase);
+
+  /** Pixel type alias support. */
+  using PixelType = bool;
+  using ValueType = bool;
+
+  /** Type of the words storing the pixels, and number of pixels per word. */
+  using WordType = std::uint64_t;
+  static constexpr unsigned int BitsPerWord = 64;
+
+  using typename Superclass::ImageDimensionType;
+  using typename Superclass::IndexType;
+  using typename Superclass::IndexValueType;
+  using typename Superclass::OffsetType;
+  using typename Superclass::OffsetValueType;
+  using typename Superclass::SizeType;
+  using typename Superclass::SizeValueType;
+  using typename Superclass::RegionType;
+  using typename Superclass::DirectionType;
+  using typename Superclass::SpacingType;
+  using typename Superclass::SpacingValueType;
+  using typename Superclass::PointType;
+
+  /** Container used to store the words of the image. */
+  using PixelContainer = ImportImageContainer<SizeValueType, WordType>;
+  using PixelContainerPointer = typename PixelContainer::Pointer;
+  using PixelContainerConstPointer = typename PixelContainer::ConstPointer;
+
+  /** Allocate the image memory. The size of the image must already be set,
+   * e.g. by calling SetRegions(). The pixels are always initialized to
+   * false, so that the bits past the end of the rows are zero. */
+  void
+  Allocate(bool initializePixels = false) override;
+
+  /** Restore the data object to its initial state. This means releasing
+   * memory. */
+  void
+  Initialize() override;
+
+  /** Fill the image buffer with a value.  Be sure to call Allocate()
+   * first. */
+  void
+  FillBuffer(bool value);
+
+  /** Set a pixel value. For efficiency, this function does not check that
+   * the index is in the buffered region. */
+  void
+  SetPixel(const IndexType & index, bool value)
+  {
+    WordType *            row = this->GetRowBufferPointer(index);
+    const OffsetValueType position = index[0] - this->GetBufferedRegion().GetIndex(0);
+    const WordType        mask = WordType{ 1 } << (position % BitsPerWord);
+    if (value)
+    {
+      row[position / BitsPerWord] |= mask;
+    }
+    else
+    {
+      row[position / BitsPerWord] &= ~mask;
+    }
+  }
+
+  /** Get a pixel value. For efficiency, this function does not check that
+   * the index is in the buffered region. */
+  bool
+  GetPixel(const IndexType & index) const
+  {
+    const WordType *      row = this->GetRowBufferPointer(index);
+    const OffsetValueType position = index[0] - this->GetBufferedRegion().GetIndex(0);
+    return (row[position / BitsPerWord] >> (position % BitsPerWord)) & 1;
+  }
+
+  /** Get the number of words storing each row of the buffered region. */
+  SizeValueType
+  GetNumberOfWordsPerRow() const
+  {
+    return m_NumberOfWordsPerRow;
+  }
+
+  /** Get a pointer to the first word of the row holding the given index.
+   * The first component of the index is ignored. */
+  WordType *
+  GetRowBufferPointer(const IndexType & index)
+  {
+    return this->GetBufferPointer() + this->ComputeRowOffset(index);
+  }
+  const WordType *
+  GetRowBufferPointer(const IndexType & index) const
+  {
+    return this->GetBufferPointer() + this->ComputeRowOffset(index);
+  }
+
+  /** Read the given number of words of pixels along the row of the given
+   * index, starting at the index: the bit j of the word k is the pixel at
+   * index[0] + 64 * k + j. The pixels outside the buffered region, before
+   * or after the row or in rows outside the buffered region, are read as
+   * outsideValue. */
+  void
+  GetRowWords(const IndexType & index, SizeValueType numberOfWords, bool outsideValue, WordType * words) const;
+
+  /** Write the given number of pixels along the row of the given index,
+   * starting at the index, from the words laid out as in GetRowWords().
+   * The pixels must be in the buffered region. The other pixels of the row
+   * are not modified, so that several threads can write distinct rows. The
+   * words at both ends of the written pixels are read, modified and written
+   * back when the pixels do not start or end on a word boundary of the row,
+   * so threads writing parts of the same row must not share such words. */
+  void
+  SetRowWords(const IndexType & index, SizeValueType numberOfPixels, const WordType * words);
+
+  /** Return a pointer to the beginning of the buffer. */
+  WordType *
+  GetBufferPointer()
+  {
+    return m_Buffer ? m_Buffer->GetBufferPointer() : nullptr;
+  }
+  const WordType *
+  GetBufferPointer() const
+  {
+    return m_Buffer ? m_Buffer->GetBufferPointer() : nullptr;
+  }
+
+  /** Return a pointer to the container. */
+  PixelContainer *
+  GetPixelContainer()
+  {
+    return m_Buffer.GetPointer();
+  }
+
+  const PixelContainer *
+  GetPixelContainer() const
+  {
+    return m_Buffer.GetPointer();
+  }
+
+  /** Set the container to use. Note that this does not cause the
+   * DataObject to be modified. */
+  void
+  SetPixelContainer(PixelContainer * container);
+
+  /** Graft the data and information from one image to another. The
+   * implementation here refers to the superclass' implementation and then
+   * copies over the pixel container. */
+  virtual void
+  Graft(const Self * image);
+
+  /** Count the pixels which are true in the buffered region. */
+  SizeValueType
+  GetNumberOfForegroundPixels() const;
+
+protected:
+  BitPackedImage();
+  ~BitPackedImage() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  Graft(const DataObject * data) override;
+
+  using Superclass::Graft;
+
+private:
+  /** Offset, in words, of the row holding the given index. */
+  OffsetValueType
+  ComputeRowOffset(const IndexType & index) const
+  {
+    const RegionType & region = this->GetBufferedRegion();
+    OffsetValueType    rowOffset = 0;
+    OffsetValueType    stride = static_cast<OffsetValueType>(m_NumberOfWordsPerRow);
+    for (unsigned int i = 1; i < VImageDimension; ++i)
+    {
+      rowOffset += (index[i] - region.GetIndex(i)) * stride;
+      stride *= static_cast<OffsetValueType>(region.GetSize(i));
+    }
+    return rowOffset;
+  }
+
+  /** Get count bits, with 0 < count <= 64, of the row starting at the
+   * pixel at position, in the lowest bits of a word. */
+  static WordType
+  ExtractRowBits(const WordType * row, OffsetValueType position, OffsetValueType count)
+  {
+    const OffsetValueType q = position / BitsPerWord;
+    const OffsetValueType r = position % BitsPerWord;
+    WordType              bits = row[q] >> r;
+    if (r > 0 && r + count > BitsPerWord)
+    {
+      bits |= row[q + 1] << (BitsPerWord - r);
+    }
+    if (count < BitsPerWord)
+    {
+      bits &= (WordType{ 1 } << count) - 1;
+    }
+    return bits;
+  }
+
+  /** Set count bits, with 0 < count <= 64, of the row starting at the
+   * pixel at position, from the lowest bits of a word. */
+  static void
+  DepositRowBits(WordType * row, OffsetValueType position, OffsetValueType count, WordType bits)
+  {
+    const OffsetValueType q = position / BitsPerWord;
+    const OffsetValueType r = position % BitsPerWord;
+    const WordType        mask = count < BitsPerWord ? (WordType{ 1 } << count) - 1 : ~WordType{ 0 };
+    bits &= mask;
+    row[q] = (row[q] & ~(mask << r)) | (bits << r);
+    if (r > 0 && r + count > BitsPerWord)
+    {
+      row[q + 1] = (row[q + 1] & ~(mask >> (BitsPerWord - r))) | (bits >> (BitsPerWord - r));
+    }
+  }
+
+  /** Memory for the words of the image. */
+  PixelContainerPointer m_Buffer;
+  SizeValueType         m_NumberOfWordsPerRow{ 0 };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBitPackedImage.hxx"
+#endif
+
+#endif
@@ -0,0 +1,235 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedImage_hxx
+#define itkBitPackedImage_hxx
+
+#include <algorithm>
+#include <vector>
+
+namespace itk
+{
+template <unsigned int VImageDimension>
+BitPackedImage<VImageDimension>::BitPackedImage()
+{
+  m_Buffer = PixelContainer::New();
+}
+
+template <unsigned int VImageDimension>
+void
+BitPackedImage<VImageDimension>::Allocate(bool itkNotUsed(initializePixels))
+{
+  this->ComputeOffsetTable();
+
+  const RegionType & region = this->GetBufferedRegion();
+  m_NumberOfWordsPerRow = (region.GetSize(0) + BitsPerWord - 1) / BitsPerWord;
+  SizeValueType numberOfWords = m_NumberOfWordsPerRow;
+  for (unsigned int i = 1; i < VImageDimension; ++i)
+  {
+    numberOfWords *= region.GetSize(i);
+  }
+  m_Buffer->Reserve(numberOfWords);
+  std::fill_n(m_Buffer->GetBufferPointer(), numberOfWords, WordType{ 0 });
+}
+
+template <unsigned int VImageDimension>
+void
+BitPackedImage<VImageDimension>::Initialize()
+{
+  //
+  // We don't modify ourselves because the "ReleaseData" methods depend upon
+  // no modification when initialized.
+  //
+
+  // Call the superclass which should initialize the BufferedRegion ivar.
+  Superclass::Initialize();
+
+  // Replace the handle to the buffer. This is the safest thing to do,
+  // since the same container can be shared by multiple images (e.g.
+  // Grafted outputs and in place filters).
+  m_Buffer = PixelContainer::New();
+  m_NumberOfWordsPerRow = 0;
+}
+
+template <unsigned int VImageDimension>
+void
+BitPackedImage<VImageDimension>::FillBuffer(bool value)
+{
+  const RegionType & region = this->GetBufferedRegion();
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // keep the bits past the end of the rows to zero
+  std::vector<WordType> row(m_NumberOfWordsPerRow, value ? ~WordType{ 0 } : WordType{ 0 });
+  const SizeValueType   remainder = region.GetSize(0) % BitsPerWord;
+  if (remainder > 0)
+  {
+    row.back() &= (WordType{ 1 } << remainder) - 1;
+  }
+
+  WordType *          buffer = this->GetBufferPointer();
+  const SizeValueType numberOfRows = region.GetNumberOfPixels() / region.GetSize(0);
+  for (SizeValueType i = 0; i < numberOfRows; ++i)
+  {
+    std::copy(row.begin(), row.end(), buffer + i * m_NumberOfWordsPerRow);
+  }
+}
+
+template <unsigned int VImageDimension>
+void
+BitPackedImage<VImageDimension>::GetRowWords(const IndexType & index,
+                                             SizeValueType     numberOfWords,
+                                             bool              outsideValue,
+                                             WordType *        words) const
+{
+  const WordType     outsideWord = outsideValue ? ~WordType{ 0 } : WordType{ 0 };
+  const RegionType & region = this->GetBufferedRegion();
+  for (unsigned int i = 1; i < VImageDimension; ++i)
+  {
+    if (index[i] < region.GetIndex(i) ||
+        index[i] >= region.GetIndex(i) + static_cast<OffsetValueType>(region.GetSize(i)))
+    {
+      std::fill_n(words, numberOfWords, outsideWord);
+      return;
+    }
+  }
+
+  const OffsetValueType length = region.GetSize(0);
+  const WordType *      row = this->GetRowBufferPointer(index);
+  OffsetValueType       position = index[0] - region.GetIndex(0);
+  for (SizeValueType k = 0; k < numberOfWords; ++k, position += BitsPerWord)
+  {
+    if (position >= 0 && position + BitsPerWord <= length)
+    {
+      words[k] = ExtractRowBits(row, position, BitsPerWord);
+    }
+    else if (position >= length || position + BitsPerWord <= 0)
+    {
+      words[k] = outsideWord;
+    }
+    else
+    {
+      // the word is partly outside of the row
+      const OffsetValueType begin = std::max(position, OffsetValueType{ 0 });
+      const OffsetValueType end = std::min(position + OffsetValueType{ BitsPerWord }, length);
+      const OffsetValueType count = end - begin;
+      const WordType        mask = count < BitsPerWord ? (WordType{ 1 } << count) - 1 : ~WordType{ 0 };
+      const OffsetValueType shift = begin - position;
+      words[k] = (ExtractRowBits(row, begin, count) << shift) | (outsideWord & ~(mask << shift));
+    }
+  }
+}
+
+template <unsigned int VImageDimension>
+void
+BitPackedImage<VImageDimension>::SetRowWords(const IndexType & index,
+                                             SizeValueType     numberOfPixels,
+                                             const WordType *  words)
+{
+  WordType *      row = this->GetRowBufferPointer(index);
+  OffsetValueType position = index[0] - this->GetBufferedRegion().GetIndex(0);
+  for (SizeValueType k = 0; k * BitsPerWord < numberOfPixels; ++k, position += BitsPerWord)
+  {
+    const OffsetValueType count = std::min(numberOfPixels - k * BitsPerWord, SizeValueType{ BitsPerWord });
+    DepositRowBits(row, position, count, words[k]);
+  }
+}
+
+template <unsigned int VImageDimension>
+void
+BitPackedImage<VImageDimension>::SetPixelContainer(PixelContainer * container)
+{
+  if (m_Buffer != container)
+  {
+    m_Buffer = container;
+    this->Modified();
+  }
+}
+
+template <unsigned int VImageDimension>
+void
+BitPackedImage<VImageDimension>::Graft(const Self * image)
+{
+  // call the superclass' implementation
+  Superclass::Graft(image);
+
+  if (image)
+  {
+    // Now copy anything remaining that is needed
+    this->SetPixelContainer(const_cast<PixelContainer *>(image->GetPixelContainer()));
+    m_NumberOfWordsPerRow = image->m_NumberOfWordsPerRow;
+  }
+}
+
+template <unsigned int VImageDimension>
+void
+BitPackedImage<VImageDimension>::Graft(const DataObject * data)
+{
+  if (data)
+  {
+    // Attempt to cast data to a BitPackedImage
+    const auto * const imgData = dynamic_cast<const Self *>(data);
+
+    if (imgData != nullptr)
+    {
+      this->Graft(imgData);
+    }
+    else
+    {
+      // pointer could not be cast back down
+      itkExceptionMacro(<< "itk::BitPackedImage::Graft() cannot cast " << typeid(data).name() << " to "
+                        << typeid(const Self *).name());
+    }
+  }
+}
+
+template <unsigned int VImageDimension>
+auto
+BitPackedImage<VImageDimension>::GetNumberOfForegroundPixels() const -> SizeValueType
+{
+  // the bits past the end of the rows are zero, so all the words can be
+  // counted
+  const WordType *    buffer = this->GetBufferPointer();
+  const SizeValueType numberOfWords = m_Buffer->Size();
+  SizeValueType       count = 0;
+  for (SizeValueType i = 0; i < numberOfWords; ++i)
+  {
+    // population count of the word, summed by pairs, nibbles and bytes
+    WordType word = buffer[i];
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    count += static_cast<SizeValueType>((word * 0x0101010101010101ULL) >> 56);
+  }
+  return count;
+}
+
+template <unsigned int VImageDimension>
+void
+BitPackedImage<VImageDimension>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfWordsPerRow: " << m_NumberOfWordsPerRow << std::endl;
+  os << indent << "PixelContainer: " << std::endl;
+  m_Buffer->Print(os, indent.GetNextIndent());
+}
+} // end namespace itk
+
+#endif
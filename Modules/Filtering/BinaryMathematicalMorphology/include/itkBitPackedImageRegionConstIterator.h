@@ -0,0 +1,149 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedImageRegionConstIterator_h
+#define itkBitPackedImageRegionConstIterator_h
+
+#include "itkBitPackedImage.h"
+
+namespace itk
+{
+/**
+ * \class BitPackedImageRegionConstIterator
+ * \brief A read-only iterator over the pixels of a region of a BitPackedImage.
+ *
+ * The iterator walks the region in the same order as
+ * ImageRegionConstIteratorWithIndex: along the first dimension, then along
+ * the second, and so on. It keeps track of the index of the current pixel,
+ * so GetIndex() is cheap.
+ *
+ * \sa BitPackedImage BitPackedImageRegionIterator
+ * \ingroup ImageIterators
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template <typename TImage>
+class ITK_TEMPLATE_EXPORT BitPackedImageRegionConstIterator
+{
+public:
+  /** Standard class type aliases. */
+  using Self = BitPackedImageRegionConstIterator;
+
+  using ImageType = TImage;
+  using PixelType = typename ImageType::PixelType;
+  using WordType = typename ImageType::WordType;
+  using IndexType = typename ImageType::IndexType;
+  using RegionType = typename ImageType::RegionType;
+  using OffsetValueType = typename ImageType::OffsetValueType;
+
+  static constexpr unsigned int ImageIteratorDimension = ImageType::ImageDimension;
+
+  /** Default constructor. */
+  BitPackedImageRegionConstIterator() = default;
+
+  /** Constructor establishes an iterator to walk a particular image and a
+   * particular region of that image. The region must be in the buffered
+   * region of the image. */
+  BitPackedImageRegionConstIterator(const ImageType * image, const RegionType & region)
+    : m_Image(image)
+    , m_Region(region)
+  {
+    this->GoToBegin();
+  }
+
+  /** Move the iterator to the beginning of the region. */
+  void
+  GoToBegin()
+  {
+    m_Index = m_Region.GetIndex();
+    m_IsAtEnd = m_Region.GetNumberOfPixels() == 0;
+    if (!m_IsAtEnd)
+    {
+      this->UpdateRow();
+    }
+  }
+
+  /** Is the iterator at the end of the region? */
+  bool
+  IsAtEnd() const
+  {
+    return m_IsAtEnd;
+  }
+
+  /** Get the index of the current pixel. */
+  const IndexType &
+  GetIndex() const
+  {
+    return m_Index;
+  }
+
+  /** Get the region iterated over. */
+  const RegionType &
+  GetRegion() const
+  {
+    return m_Region;
+  }
+
+  /** Get the value of the current pixel. */
+  PixelType
+  Get() const
+  {
+    return (m_Row[m_Position / ImageType::BitsPerWord] >> (m_Position % ImageType::BitsPerWord)) & 1;
+  }
+
+  /** Move to the next pixel of the region. */
+  Self &
+  operator++()
+  {
+    ++m_Position;
+    if (++m_Index[0] < m_Region.GetIndex(0) + static_cast<OffsetValueType>(m_Region.GetSize(0)))
+    {
+      return *this;
+    }
+
+    // move to the next row
+    m_Index[0] = m_Region.GetIndex(0);
+    for (unsigned int i = 1; i < ImageIteratorDimension; ++i)
+    {
+      if (++m_Index[i] < m_Region.GetIndex(i) + static_cast<OffsetValueType>(m_Region.GetSize(i)))
+      {
+        this->UpdateRow();
+        return *this;
+      }
+      m_Index[i] = m_Region.GetIndex(i);
+    }
+    m_IsAtEnd = true;
+    return *this;
+  }
+
+protected:
+  void
+  UpdateRow()
+  {
+    m_Row = m_Image->GetRowBufferPointer(m_Index);
+    m_Position = m_Index[0] - m_Image->GetBufferedRegion().GetIndex(0);
+  }
+
+  const ImageType * m_Image{ nullptr };
+  RegionType        m_Region;
+  IndexType         m_Index{ { 0 } };
+  const WordType *  m_Row{ nullptr };
+  OffsetValueType   m_Position{ 0 };
+  bool              m_IsAtEnd{ true };
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,75 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedImageRegionIterator_h
+#define itkBitPackedImageRegionIterator_h
+
+#include "itkBitPackedImageRegionConstIterator.h"
+
+namespace itk
+{
+/**
+ * \class BitPackedImageRegionIterator
+ * \brief An iterator over the pixels of a region of a BitPackedImage,
+ * which can modify them.
+ *
+ * \sa BitPackedImage BitPackedImageRegionConstIterator
+ * \ingroup ImageIterators
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template <typename TImage>
+class ITK_TEMPLATE_EXPORT BitPackedImageRegionIterator : public BitPackedImageRegionConstIterator<TImage>
+{
+public:
+  /** Standard class type aliases. */
+  using Self = BitPackedImageRegionIterator;
+  using Superclass = BitPackedImageRegionConstIterator<TImage>;
+
+  using typename Superclass::ImageType;
+  using typename Superclass::PixelType;
+  using typename Superclass::WordType;
+  using typename Superclass::RegionType;
+
+  /** Default constructor. */
+  BitPackedImageRegionIterator() = default;
+
+  /** Constructor establishes an iterator to walk a particular image and a
+   * particular region of that image. The region must be in the buffered
+   * region of the image. */
+  BitPackedImageRegionIterator(ImageType * image, const RegionType & region)
+    : Superclass(image, region)
+  {}
+
+  /** Set the value of the current pixel. */
+  void
+  Set(PixelType value) const
+  {
+    auto &         word = const_cast<WordType *>(this->m_Row)[this->m_Position / ImageType::BitsPerWord];
+    const WordType mask = WordType{ 1 } << (this->m_Position % ImageType::BitsPerWord);
+    if (value)
+    {
+      word |= mask;
+    }
+    else
+    {
+      word &= ~mask;
+    }
+  }
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,92 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedImageToBinaryImageFilter_h
+#define itkBitPackedImageToBinaryImageFilter_h
+
+#include "itkBitPackedImage.h"
+#include "itkImageToImageFilter.h"
+
+namespace itk
+{
+/**
+ * \class BitPackedImageToBinaryImageFilter
+ * \brief Convert a BitPackedImage to a binary image.
+ *
+ * The pixels which are true in the input are set to the ForegroundValue in
+ * the output, the other ones to the BackgroundValue. ForegroundValue
+ * defaults to the maximum value of the output PixelType, and
+ * BackgroundValue to zero.
+ *
+ * \sa BitPackedImage BinaryImageToBitPackedImageFilter
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template <typename TInputImage, typename TOutputImage>
+class ITK_TEMPLATE_EXPORT BitPackedImageToBinaryImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BitPackedImageToBinaryImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = BitPackedImageToBinaryImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BitPackedImageToBinaryImageFilter, ImageToImageFilter);
+
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using WordType = typename InputImageType::WordType;
+
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  /** Set/Get the value of the foreground pixels in the output image. */
+  itkSetMacro(ForegroundValue, OutputPixelType);
+  itkGetConstMacro(ForegroundValue, OutputPixelType);
+
+  /** Set/Get the value of the background pixels in the output image. */
+  itkSetMacro(BackgroundValue, OutputPixelType);
+  itkGetConstMacro(BackgroundValue, OutputPixelType);
+
+protected:
+  BitPackedImageToBinaryImageFilter();
+  ~BitPackedImageToBinaryImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  OutputPixelType m_ForegroundValue;
+  OutputPixelType m_BackgroundValue;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBitPackedImageToBinaryImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedImageToBinaryImageFilter_hxx
+#define itkBitPackedImageToBinaryImageFilter_hxx
+
+#include "itkImageScanlineIterator.h"
+#include "itkTotalProgressReporter.h"
+
+#include <vector>
+
+namespace itk
+{
+template <typename TInputImage, typename TOutputImage>
+BitPackedImageToBinaryImageFilter<TInputImage, TOutputImage>::BitPackedImageToBinaryImageFilter()
+  : m_ForegroundValue(NumericTraits<OutputPixelType>::max())
+  , m_BackgroundValue(NumericTraits<OutputPixelType>::ZeroValue())
+{
+  this->DynamicMultiThreadingOn();
+  this->ThreaderUpdateProgressOff();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+BitPackedImageToBinaryImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  const SizeValueType   length = outputRegionForThread.GetSize(0);
+  std::vector<WordType> words((length + InputImageType::BitsPerWord - 1) / InputImageType::BitsPerWord);
+
+  ImageScanlineIterator<OutputImageType> it(output, outputRegionForThread);
+  while (!it.IsAtEnd())
+  {
+    input->GetRowWords(it.GetIndex(), words.size(), false, words.data());
+    for (SizeValueType i = 0; !it.IsAtEndOfLine(); ++it, ++i)
+    {
+      const bool value = (words[i / InputImageType::BitsPerWord] >> (i % InputImageType::BitsPerWord)) & 1;
+      it.Set(value ? m_ForegroundValue : m_BackgroundValue);
+    }
+    it.NextLine();
+    progress.Completed(length);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+BitPackedImageToBinaryImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  using PrintType = typename NumericTraits<OutputPixelType>::PrintType;
+  os << indent << "ForegroundValue: " << static_cast<PrintType>(m_ForegroundValue) << std::endl;
+  os << indent << "BackgroundValue: " << static_cast<PrintType>(m_BackgroundValue) << std::endl;
+}
+} // end namespace itk
+
+#endif
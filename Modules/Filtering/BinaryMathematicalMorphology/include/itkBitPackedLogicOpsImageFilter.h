@@ -0,0 +1,121 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedLogicOpsImageFilter_h
+#define itkBitPackedLogicOpsImageFilter_h
+
+#include "itkBitPackedImage.h"
+#include "itkImageRegionSplitterDirection.h"
+#include "itkImageToImageFilter.h"
+
+#include <functional>
+
+namespace itk
+{
+namespace Functor
+{
+/**
+ * \class BitPackedAndNot
+ * \brief Bitwise A AND NOT B of two words of a BitPackedImage.
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template <typename TWord>
+class BitPackedAndNot
+{
+public:
+  TWord
+  operator()(const TWord & a, const TWord & b) const
+  {
+    return a & ~b;
+  }
+};
+} // namespace Functor
+
+/**
+ * \class BitPackedLogicOpsImageFilter
+ * \brief Combine two BitPackedImage pixel-wise with a bitwise operation.
+ *
+ * The operation is a functor combining two words of the images, such as
+ * std::bit_and (the default), std::bit_or, std::bit_xor or
+ * Functor::BitPackedAndNot, so that 64 pixels are processed at once. The
+ * two inputs must occupy the same physical space, and the pixels of the
+ * second input outside of its buffered region are background.
+ *
+ * \sa BitPackedImage AndImageFilter OrImageFilter XorImageFilter
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template <typename TImage, typename TFunction = std::bit_and<typename TImage::WordType>>
+class ITK_TEMPLATE_EXPORT BitPackedLogicOpsImageFilter : public ImageToImageFilter<TImage, TImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BitPackedLogicOpsImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = BitPackedLogicOpsImageFilter;
+  using Superclass = ImageToImageFilter<TImage, TImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BitPackedLogicOpsImageFilter, ImageToImageFilter);
+
+  using ImageType = TImage;
+  using FunctorType = TFunction;
+  using WordType = typename ImageType::WordType;
+  using OutputImageRegionType = typename ImageType::RegionType;
+
+  static constexpr unsigned int ImageDimension = TImage::ImageDimension;
+
+  /** Set the first operand. */
+  void
+  SetInput1(const ImageType * image1)
+  {
+    this->SetNthInput(0, const_cast<ImageType *>(image1));
+  }
+
+  /** Set the second operand. */
+  void
+  SetInput2(const ImageType * image2)
+  {
+    this->SetNthInput(1, const_cast<ImageType *>(image2));
+  }
+
+protected:
+  BitPackedLogicOpsImageFilter();
+  ~BitPackedLogicOpsImageFilter() override = default;
+
+  /** The words of a row are written by a single thread: the output region
+   * is not split along the rows. */
+  const ImageRegionSplitterBase *
+  GetImageRegionSplitter() const override;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  ImageRegionSplitterDirection::Pointer m_ImageRegionSplitter;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBitPackedLogicOpsImageFilter.hxx"
+#endif
+
+#endif
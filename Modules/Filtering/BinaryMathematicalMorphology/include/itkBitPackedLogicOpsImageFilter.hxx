@@ -0,0 +1,77 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedLogicOpsImageFilter_hxx
+#define itkBitPackedLogicOpsImageFilter_hxx
+
+#include "itkIndexRange.h"
+#include "itkTotalProgressReporter.h"
+
+#include <vector>
+
+namespace itk
+{
+template <typename TImage, typename TFunction>
+BitPackedLogicOpsImageFilter<TImage, TFunction>::BitPackedLogicOpsImageFilter()
+{
+  this->SetNumberOfRequiredInputs(2);
+  m_ImageRegionSplitter = ImageRegionSplitterDirection::New();
+  this->DynamicMultiThreadingOn();
+  this->ThreaderUpdateProgressOff();
+}
+
+template <typename TImage, typename TFunction>
+const ImageRegionSplitterBase *
+BitPackedLogicOpsImageFilter<TImage, TFunction>::GetImageRegionSplitter() const
+{
+  return m_ImageRegionSplitter.GetPointer();
+}
+
+template <typename TImage, typename TFunction>
+void
+BitPackedLogicOpsImageFilter<TImage, TFunction>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  const ImageType * input1 = this->GetInput(0);
+  const ImageType * input2 = this->GetInput(1);
+  ImageType *       output = this->GetOutput();
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  const FunctorType     functor;
+  const SizeValueType   length = outputRegionForThread.GetSize(0);
+  const SizeValueType   numberOfWords = (length + ImageType::BitsPerWord - 1) / ImageType::BitsPerWord;
+  std::vector<WordType> words1(numberOfWords);
+  std::vector<WordType> words2(numberOfWords);
+
+  OutputImageRegionType rows = outputRegionForThread;
+  rows.SetSize(0, 1);
+  for (const auto & index : ImageRegionIndexRange<ImageDimension>(rows))
+  {
+    input1->GetRowWords(index, numberOfWords, false, words1.data());
+    input2->GetRowWords(index, numberOfWords, false, words2.data());
+    for (SizeValueType k = 0; k < numberOfWords; ++k)
+    {
+      words1[k] = functor(words1[k], words2[k]);
+    }
+    output->SetRowWords(index, length, words1.data());
+    progress.Completed(length);
+  }
+}
+} // end namespace itk
+
+#endif
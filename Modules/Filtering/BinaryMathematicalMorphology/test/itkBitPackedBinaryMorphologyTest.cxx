@@ -0,0 +1,388 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBinaryDilateImageFilter.h"
+#include "itkBinaryErodeImageFilter.h"
+#include "itkBinaryImageToBitPackedImageFilter.h"
+#include "itkBitPackedBinaryDilateImageFilter.h"
+#include "itkBitPackedBinaryErodeImageFilter.h"
+#include "itkBitPackedImageRegionIterator.h"
+#include "itkBitPackedImageToBinaryImageFilter.h"
+#include "itkBitPackedLogicOpsImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+// Compare the binary morphology of a BitPackedImage with a brute force
+// computation and with BinaryDilateImageFilter and BinaryErodeImageFilter,
+// on images whose rows are not a multiple of the number of bits of a word.
+
+namespace
+{
+using PixelType = unsigned char;
+
+template <unsigned int VDimension>
+typename itk::Image<PixelType, VDimension>::Pointer
+CreateRandomImage(const itk::ImageRegion<VDimension> & region, double probability, unsigned int seed)
+{
+  using ImageType = itk::Image<PixelType, VDimension>;
+  auto image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(seed);
+  for (itk::ImageRegionIterator<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(generator->GetVariateWithClosedRange() < probability ? 1 : 0);
+  }
+  return image;
+}
+
+template <typename TImage>
+bool
+CompareImages(const TImage * image, const TImage * reference, const std::string & description)
+{
+  const auto & region = image->GetRequestedRegion();
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != reference->GetPixel(it.GetIndex()))
+    {
+      std::cerr << "Test failed for " << description << std::endl;
+      std::cerr << "Different values at " << it.GetIndex() << ": " << static_cast<int>(it.Get())
+                << " instead of " << static_cast<int>(reference->GetPixel(it.GetIndex())) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// out(x) combines in(x + k) for the active offsets k of the kernel
+template <typename TImage, typename TKernel>
+typename TImage::Pointer
+ComputeMorphology(const TImage * image, const TKernel & kernel, bool dilate)
+{
+  const auto & region = image->GetLargestPossibleRegion();
+  auto         output = TImage::New();
+  output->SetRegions(region);
+  output->Allocate();
+
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    bool value = !dilate;
+    for (unsigned int i = 0; i < kernel.Size(); ++i)
+    {
+      if (kernel[i])
+      {
+        const auto index = it.GetIndex() + kernel.GetOffset(i);
+        const bool inputValue = region.IsInside(index) ? image->GetPixel(index) != 0 : !dilate;
+        value = dilate ? (value || inputValue) : (value && inputValue);
+      }
+    }
+    output->SetPixel(it.GetIndex(), value ? 1 : 0);
+  }
+  return output;
+}
+
+template <unsigned int VDimension>
+bool
+TestImageAndIterators(const itk::ImageRegion<VDimension> & region)
+{
+  using BitPackedImageType = itk::BitPackedImage<VDimension>;
+  auto image = BitPackedImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  if (image->GetNumberOfForegroundPixels() != 0)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The allocated image is not empty" << std::endl;
+    return false;
+  }
+
+  image->FillBuffer(true);
+  if (image->GetNumberOfForegroundPixels() != region.GetNumberOfPixels())
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The filled image has " << image->GetNumberOfForegroundPixels() << " foreground pixels" << std::endl;
+    return false;
+  }
+
+  // set one pixel out of three, and check them pixel-wise and row-wise
+  itk::SizeValueType count = 0;
+  itk::SizeValueType expectedCount = 0;
+  for (itk::BitPackedImageRegionIterator<BitPackedImageType> it(image, region); !it.IsAtEnd(); ++it, ++count)
+  {
+    it.Set(count % 3 == 0);
+    expectedCount += count % 3 == 0;
+  }
+  if (image->GetNumberOfForegroundPixels() != expectedCount)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The image has " << image->GetNumberOfForegroundPixels() << " foreground pixels instead of "
+              << expectedCount << std::endl;
+    return false;
+  }
+
+  count = 0;
+  for (itk::BitPackedImageRegionConstIterator<BitPackedImageType> it(image, region); !it.IsAtEnd(); ++it, ++count)
+  {
+    if (it.Get() != (count % 3 == 0) || image->GetPixel(it.GetIndex()) != it.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong value at " << it.GetIndex() << std::endl;
+      return false;
+    }
+  }
+
+  // the words read past the end of the rows are filled with the outside value
+  using WordType = typename BitPackedImageType::WordType;
+  const itk::SizeValueType numberOfWords = image->GetNumberOfWordsPerRow() + 2;
+  std::vector<WordType>    words(numberOfWords);
+  auto                     index = region.GetIndex();
+  index[0] -= 3;
+  image->GetRowWords(index, numberOfWords, true, words.data());
+  for (itk::SizeValueType i = 0; i < numberOfWords * BitPackedImageType::BitsPerWord; ++i)
+  {
+    auto pixelIndex = index;
+    pixelIndex[0] += i;
+    const bool expected = region.IsInside(pixelIndex) ? image->GetPixel(pixelIndex) : true;
+    if (((words[i / BitPackedImageType::BitsPerWord] >> (i % BitPackedImageType::BitsPerWord)) & 1) != expected)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Wrong value read at " << pixelIndex << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <unsigned int VDimension, typename TKernel>
+bool
+TestMorphology(const itk::ImageRegion<VDimension> & region,
+               const TKernel &                      kernel,
+               bool                                 compareToBinaryFilters,
+               const std::string &                  description)
+{
+  using ImageType = itk::Image<PixelType, VDimension>;
+  using BitPackedImageType = itk::BitPackedImage<VDimension>;
+  using ToBitPackedType = itk::BinaryImageToBitPackedImageFilter<ImageType, BitPackedImageType>;
+  using FromBitPackedType = itk::BitPackedImageToBinaryImageFilter<BitPackedImageType, ImageType>;
+  using DilateType = itk::BitPackedBinaryDilateImageFilter<BitPackedImageType, TKernel>;
+  using ErodeType = itk::BitPackedBinaryErodeImageFilter<BitPackedImageType, TKernel>;
+
+  bool success = true;
+  for (const double probability : { 0.1, 0.5, 0.9 })
+  {
+    const auto image = CreateRandomImage<VDimension>(region, probability, 7);
+
+    auto toBitPacked = ToBitPackedType::New();
+    toBitPacked->SetInput(image);
+    toBitPacked->SetForegroundValue(1);
+
+    auto dilate = DilateType::New();
+    dilate->SetInput(toBitPacked->GetOutput());
+    dilate->SetKernel(kernel);
+    auto erode = ErodeType::New();
+    erode->SetInput(toBitPacked->GetOutput());
+    erode->SetKernel(kernel);
+
+    auto fromDilated = FromBitPackedType::New();
+    fromDilated->SetInput(dilate->GetOutput());
+    fromDilated->SetForegroundValue(1);
+    auto fromEroded = FromBitPackedType::New();
+    fromEroded->SetInput(erode->GetOutput());
+    fromEroded->SetForegroundValue(1);
+
+    const auto dilated = ComputeMorphology(image.GetPointer(), kernel, true);
+    const auto eroded = ComputeMorphology(image.GetPointer(), kernel, false);
+
+    for (const unsigned int numberOfWorkUnits : { 1, 3 })
+    {
+      dilate->SetNumberOfWorkUnits(numberOfWorkUnits);
+      erode->SetNumberOfWorkUnits(numberOfWorkUnits);
+      std::ostringstream name;
+      name << description << ", probability " << probability << ", " << numberOfWorkUnits << " work units";
+
+      fromDilated->Update();
+      success &= CompareImages(fromDilated->GetOutput(), dilated.GetPointer(), "dilation, " + name.str());
+      fromEroded->Update();
+      success &= CompareImages(fromEroded->GetOutput(), eroded.GetPointer(), "erosion, " + name.str());
+    }
+
+    // compute a part of the output only
+    auto subRegion = region;
+    subRegion.ShrinkByRadius(region.GetSize(0) / 4);
+    dilate->Modified();
+    fromDilated->GetOutput()->SetRequestedRegion(subRegion);
+    fromDilated->Update();
+    success &= CompareImages(fromDilated->GetOutput(), dilated.GetPointer(), "dilation of a region, " + description);
+
+    if (compareToBinaryFilters)
+    {
+      using BinaryDilateType = itk::BinaryDilateImageFilter<ImageType, ImageType, TKernel>;
+      auto binaryDilate = BinaryDilateType::New();
+      binaryDilate->SetInput(image);
+      binaryDilate->SetKernel(kernel);
+      binaryDilate->SetForegroundValue(1);
+      binaryDilate->Update();
+      success &= CompareImages(binaryDilate->GetOutput(), dilated.GetPointer(), "BinaryDilate, " + description);
+
+      using BinaryErodeType = itk::BinaryErodeImageFilter<ImageType, ImageType, TKernel>;
+      auto binaryErode = BinaryErodeType::New();
+      binaryErode->SetInput(image);
+      binaryErode->SetKernel(kernel);
+      binaryErode->SetForegroundValue(1);
+      binaryErode->Update();
+      success &= CompareImages(binaryErode->GetOutput(), eroded.GetPointer(), "BinaryErode, " + description);
+    }
+  }
+  return success;
+}
+
+template <typename TFunction, typename TReference>
+bool
+TestLogicOps(const TReference & reference, const std::string & description)
+{
+  constexpr unsigned int Dimension = 2;
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using BitPackedImageType = itk::BitPackedImage<Dimension>;
+  using ToBitPackedType = itk::BinaryImageToBitPackedImageFilter<ImageType, BitPackedImageType>;
+  using FromBitPackedType = itk::BitPackedImageToBinaryImageFilter<BitPackedImageType, ImageType>;
+  using LogicOpsType = itk::BitPackedLogicOpsImageFilter<BitPackedImageType, TFunction>;
+
+  itk::ImageRegion<Dimension> region;
+  region.SetIndex(0, -5);
+  region.SetIndex(1, 2);
+  region.SetSize(0, 141);
+  region.SetSize(1, 13);
+  const auto image1 = CreateRandomImage<Dimension>(region, 0.5, 1);
+  const auto image2 = CreateRandomImage<Dimension>(region, 0.5, 2);
+
+  auto toBitPacked1 = ToBitPackedType::New();
+  toBitPacked1->SetInput(image1);
+  toBitPacked1->SetForegroundValue(1);
+  auto toBitPacked2 = ToBitPackedType::New();
+  toBitPacked2->SetInput(image2);
+  toBitPacked2->SetForegroundValue(1);
+
+  auto logicOps = LogicOpsType::New();
+  logicOps->SetInput1(toBitPacked1->GetOutput());
+  logicOps->SetInput2(toBitPacked2->GetOutput());
+  logicOps->SetNumberOfWorkUnits(2);
+
+  auto fromBitPacked = FromBitPackedType::New();
+  fromBitPacked->SetInput(logicOps->GetOutput());
+  fromBitPacked->SetForegroundValue(1);
+  fromBitPacked->Update();
+
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(fromBitPacked->GetOutput(), region); !it.IsAtEnd(); ++it)
+  {
+    const bool expected = reference(image1->GetPixel(it.GetIndex()) != 0, image2->GetPixel(it.GetIndex()) != 0);
+    if ((it.Get() != 0) != expected)
+    {
+      std::cerr << "Test failed for " << description << std::endl;
+      std::cerr << "Wrong value at " << it.GetIndex() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkBitPackedBinaryMorphologyTest(int, char *[])
+{
+  bool success = true;
+
+  // the rows are 1, 2 and 3 words long, and start at a negative index
+  itk::ImageRegion<2> region2D;
+  region2D.SetIndex(0, -3);
+  region2D.SetIndex(1, 4);
+  region2D.SetSize(0, 63);
+  region2D.SetSize(1, 7);
+  success &= TestImageAndIterators(region2D);
+  region2D.SetSize(0, 129);
+  success &= TestImageAndIterators(region2D);
+
+  itk::ImageRegion<3> region3D;
+  region3D.SetIndex(0, 1);
+  region3D.SetSize(0, 71);
+  region3D.SetSize(1, 9);
+  region3D.SetSize(2, 5);
+  success &= TestImageAndIterators(region3D);
+
+  using Kernel2DType = itk::FlatStructuringElement<2>;
+  using Kernel3DType = itk::FlatStructuringElement<3>;
+  region2D.SetSize(0, 150);
+  region2D.SetSize(1, 41);
+  region3D.SetSize(0, 70);
+  region3D.SetSize(1, 23);
+  region3D.SetSize(2, 17);
+
+  Kernel2DType::RadiusType radius2D;
+  radius2D[0] = 5;
+  radius2D[1] = 3;
+  success &= TestMorphology(region2D, Kernel2DType::Box(radius2D), true, "2D box");
+  success &= TestMorphology(region2D, Kernel2DType::Cross(radius2D), true, "2D cross");
+  success &= TestMorphology(region2D, Kernel2DType::Ball(radius2D), true, "2D ball");
+  radius2D.Fill(40);
+  success &= TestMorphology(region2D, Kernel2DType::Box(radius2D), true, "2D box larger than a word");
+
+  Kernel3DType::RadiusType radius3D;
+  radius3D[0] = 2;
+  radius3D[1] = 3;
+  radius3D[2] = 1;
+  success &= TestMorphology(region3D, Kernel3DType::Box(radius3D), true, "3D box");
+  success &= TestMorphology(region3D, Kernel3DType::Ball(radius3D), true, "3D ball");
+
+  // an asymmetric kernel with several runs on some rows
+  using KernelImageType = Kernel2DType::ImageType;
+  auto                        kernelImage = KernelImageType::New();
+  KernelImageType::RegionType kernelRegion;
+  KernelImageType::SizeType   kernelSize = { { 9, 5 } };
+  kernelRegion.SetSize(kernelSize);
+  kernelImage->SetRegions(kernelRegion);
+  kernelImage->Allocate(true);
+  for (const auto & index : { KernelImageType::IndexType{ { 0, 0 } },
+                              KernelImageType::IndexType{ { 1, 0 } },
+                              KernelImageType::IndexType{ { 5, 0 } },
+                              KernelImageType::IndexType{ { 8, 1 } },
+                              KernelImageType::IndexType{ { 3, 3 } },
+                              KernelImageType::IndexType{ { 4, 3 } },
+                              KernelImageType::IndexType{ { 5, 3 } },
+                              KernelImageType::IndexType{ { 0, 4 } },
+                              KernelImageType::IndexType{ { 1, 4 } } })
+  {
+    kernelImage->SetPixel(index, true);
+  }
+  const auto asymmetricKernel = Kernel2DType::FromImage(kernelImage);
+  success &= TestMorphology(region2D, asymmetricKernel, false, "2D asymmetric kernel");
+
+  using WordType = itk::BitPackedImage<2>::WordType;
+  success &= TestLogicOps<std::bit_and<WordType>>([](bool a, bool b) { return a && b; }, "and");
+  success &= TestLogicOps<std::bit_or<WordType>>([](bool a, bool b) { return a || b; }, "or");
+  success &= TestLogicOps<std::bit_xor<WordType>>([](bool a, bool b) { return a != b; }, "xor");
+  success &= TestLogicOps<itk::Functor::BitPackedAndNot<WordType>>([](bool a, bool b) { return a && !b; }, "and not");
+
+  if (!success)
+  {
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -22,6 +22,9 @@
 #include "itkColormapFunction.h"
 #include "ITKColormapExport.h"
 
+#include <type_traits>
+#include <vector>
+
 namespace itk
 {
 /**\class ScalarToRGBColormapImageFilterEnums
@@ -110,6 +113,11 @@ extern ITKColormap_EXPORT std::ostream &
  * The range of values present in the input image is the range that is mapped to the entire
  * range of colors.
  *
+ * When the input pixel type is an integer type with at most 2^16 values,
+ * and the output has more pixels than the input pixel type has values, the
+ * colormap is evaluated once for each value of the input pixel type, and the
+ * output pixels are read from this lookup table.
+ *
  * This code was contributed in the Insight Journal paper:
  * "Meeting Andy Warhol Somewhere Over the Rainbow: RGB Colormapping and ITK"
  * by Tustison N., Zhang H., Lehmann G., Yushkevich P., Gee J.
@@ -237,11 +245,38 @@ protected:
   void
   BeforeThreadedGenerateData() override;
 
+  /** Discard the lookup table of the colormap. */
+  void
+  AfterThreadedGenerateData() override;
+
 private:
-private:
+  /** Whether the input pixel type has few enough values for a lookup
+   * table. */
+  using IsSmallIntegerInputType = std::integral_constant<bool,
+                                                         std::is_integral<InputImagePixelType>::value &&
+                                                           !std::is_same<InputImagePixelType, bool>::value &&
+                                                           sizeof(InputImagePixelType) <= 2>;
+
+  /** Evaluate the colormap for each value of the input pixel type, once its
+   * extrema are set, if the output is large enough. */
+  void
+  ComputeLookupTable(std::true_type);
+  void
+  ComputeLookupTable(std::false_type)
+  {}
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, std::true_type);
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, std::false_type);
+
   typename ColormapType::Pointer m_Colormap;
 
   bool m_UseInputImageExtremaForScaling;
+
+  /** The colormap, indexed by the input value minus the lowest value of the
+   * input pixel type, or empty if it is evaluated for each pixel. */
+  std::vector<OutputImagePixelType> m_LookupTable;
 };
 } // end namespace itk
 
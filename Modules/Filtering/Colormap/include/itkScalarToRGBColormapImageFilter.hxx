@@ -37,6 +37,8 @@
 #include "itkJetColormapFunction.h"
 #include "itkOverUnderColormapFunction.h"
 
+#include <limits>
+
 /*
  *
  * This code was contributed in the Insight Journal paper:
@@ -91,12 +93,88 @@ ScalarToRGBColormapImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerat
     this->m_Colormap->SetMinimumInputValue(minimumValue);
     this->m_Colormap->SetMaximumInputValue(maximumValue);
   }
+
+  this->ComputeLookupTable(IsSmallIntegerInputType());
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarToRGBColormapImageFilter<TInputImage, TOutputImage>::AfterThreadedGenerateData()
+{
+  m_LookupTable.clear();
+  m_LookupTable.shrink_to_fit();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarToRGBColormapImageFilter<TInputImage, TOutputImage>::ComputeLookupTable(std::true_type)
+{
+  using LimitsType = std::numeric_limits<InputImagePixelType>;
+  constexpr SizeValueType numberOfValues = static_cast<SizeValueType>(LimitsType::max()) - LimitsType::lowest() + 1;
+
+  m_LookupTable.clear();
+
+  // the lookup table is not worth computing for the small images
+  if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() <= numberOfValues)
+  {
+    return;
+  }
+
+  m_LookupTable.reserve(numberOfValues);
+  for (int value = LimitsType::lowest(); value <= LimitsType::max(); ++value)
+  {
+    m_LookupTable.push_back(this->m_Colormap->operator()(static_cast<InputImagePixelType>(value)));
+  }
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
 ScalarToRGBColormapImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
+{
+  this->DynamicThreadedGenerateData(outputRegionForThread, IsSmallIntegerInputType());
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarToRGBColormapImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread,
+  std::true_type)
+{
+  if (m_LookupTable.empty())
+  {
+    this->DynamicThreadedGenerateData(outputRegionForThread, std::false_type());
+    return;
+  }
+
+  using LimitsType = std::numeric_limits<InputImagePixelType>;
+
+  InputImagePointer  inputPtr = this->GetInput();
+  OutputImagePointer outputPtr = this->GetOutput();
+
+  TotalProgressReporter progressReporter(this, this->GetOutput()->GetRequestedRegion().GetNumberOfPixels());
+
+  InputImageRegionType inputRegionForThread;
+
+  this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
+
+  ImageRegionConstIterator<TInputImage> inputIt(inputPtr, inputRegionForThread);
+  ImageRegionIterator<TOutputImage>     outputIt(outputPtr, outputRegionForThread);
+
+  while (!inputIt.IsAtEnd())
+  {
+    outputIt.Set(m_LookupTable[static_cast<int>(inputIt.Get()) - static_cast<int>(LimitsType::lowest())]);
+    ++inputIt;
+    ++outputIt;
+    progressReporter.CompletedPixel();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+ScalarToRGBColormapImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread,
+  std::false_type)
 {
   InputImagePointer  inputPtr = this->GetInput();
   OutputImagePointer outputPtr = this->GetOutput();
@@ -0,0 +1,103 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkScalarToRGBColormapImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkVectorImage.h"
+
+// The output of the filter for integer inputs of at most 16 bits, read from a
+// lookup table when the image is large enough, is compared with the
+// evaluation of the colormap for each pixel.
+
+namespace
+{
+using ColormapEnum = itk::ScalarToRGBColormapImageFilterEnums::RGBColormapFilter;
+
+template <typename TInputImage, typename TOutputImage>
+bool
+TestColormap(itk::SizeValueType size, ColormapEnum colormap)
+{
+  using FilterType = itk::ScalarToRGBColormapImageFilter<TInputImage, TOutputImage>;
+  using PixelType = typename TInputImage::PixelType;
+
+  auto input = TInputImage::New();
+  input->SetRegions(typename TInputImage::SizeType{ { size, size } });
+  input->Allocate();
+  unsigned int n = 0;
+  for (itk::ImageRegionIterator<TInputImage> it(input, input->GetBufferedRegion()); !it.IsAtEnd(); ++it, ++n)
+  {
+    it.Set(static_cast<PixelType>(static_cast<int>(itk::NumericTraits<PixelType>::NonpositiveMin()) +
+                                  (n * 7919 + 13) % 4001));
+  }
+
+  auto filter = FilterType::New();
+  filter->SetInput(input);
+  filter->SetColormap(colormap);
+  filter->Update();
+
+  const TOutputImage *                        output = filter->GetOutput();
+  itk::ImageRegionConstIterator<TInputImage>  inputIt(input, input->GetBufferedRegion());
+  itk::ImageRegionConstIterator<TOutputImage> outputIt(output, output->GetBufferedRegion());
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++outputIt)
+  {
+    const auto expected = filter->GetColormap()->operator()(inputIt.Get());
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      if (outputIt.Get()[i] != expected[i])
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error for the input value " << static_cast<int>(inputIt.Get()) << ", component " << i
+                  << ": expected " << static_cast<int>(expected[i]) << ", got " << static_cast<int>(outputIt.Get()[i])
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkScalarToRGBColormapImageFilterLookupTableTest(int, char *[])
+{
+  using RGBImageType = itk::Image<itk::RGBPixel<unsigned char>, 2>;
+  using VectorImageType = itk::VectorImage<unsigned char, 2>;
+
+  bool success = true;
+  for (const ColormapEnum colormap : { ColormapEnum::Grey, ColormapEnum::Jet, ColormapEnum::HSV })
+  {
+    // smaller and larger than the lookup table
+    for (const itk::SizeValueType size : { 10, 40, 300 })
+    {
+      success &= TestColormap<itk::Image<unsigned char, 2>, RGBImageType>(size, colormap);
+      success &= TestColormap<itk::Image<short, 2>, RGBImageType>(size, colormap);
+      success &= TestColormap<itk::Image<unsigned short, 2>, VectorImageType>(size, colormap);
+      success &= TestColormap<itk::Image<float, 2>, RGBImageType>(size, colormap);
+    }
+  }
+
+  if (!success)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -23,6 +23,8 @@
 #include "itkProgressAccumulator.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 
+#include <vector>
+
 namespace itk
 {
 /**
@@ -43,6 +45,19 @@ namespace itk
  * The kernel can optionally be normalized to sum to 1 using
  * NormalizeOn(). Normalization is off by default.
  *
+ * When the kernel is separable, or is the sum of a few separable
+ * kernels, the convolution is computed with a sequence of 1-D
+ * convolutions along each dimension, which is much cheaper than the
+ * full N-D inner product for large kernels. The decomposition is
+ * computed from successive singular value decompositions of the
+ * unfoldings of the kernel, and is only used when it is cheaper than
+ * the direct convolution. The singular values whose contribution to the
+ * kernel norm is below KernelDecompositionTolerance are discarded: the
+ * default tolerance only discards the rounding errors of exactly
+ * separable kernels, while a larger tolerance forces a low-rank
+ * approximation of the kernel. The decomposition can be disabled with
+ * DecomposeKernelOff().
+ *
  * \warning This filter ignores the spacing, origin, and orientation
  * of the kernel image and treats them as identical to those in the
  * input image.
@@ -69,7 +84,7 @@ public:
   ITK_DISALLOW_COPY_AND_MOVE(ConvolutionImageFilter);
 
   using Self = ConvolutionImageFilter;
-  using Superclass = ConvolutionImageFilterBase<TInputImage, TOutputImage>;
+  using Superclass = ConvolutionImageFilterBase<TInputImage, TKernelImage, TOutputImage>;
   using Pointer = SmartPointer<Self>;
   using ConstPointer = SmartPointer<const Self>;
 
@@ -98,10 +113,29 @@ public:
   using OutputRegionType = typename OutputImageType::RegionType;
   using KernelRegionType = typename KernelImageType::RegionType;
 
+  /** Set/Get whether a separable decomposition of the kernel is used
+   * when it makes the convolution cheaper. Defaults to true. */
+  itkSetMacro(DecomposeKernel, bool);
+  itkGetConstMacro(DecomposeKernel, bool);
+  itkBooleanMacro(DecomposeKernel);
+
+  /** Set/Get the tolerance of the separable decomposition of the kernel,
+   * relative to the norm of the kernel. Defaults to 1e-6. */
+  itkSetMacro(KernelDecompositionTolerance, double);
+  itkGetConstMacro(KernelDecompositionTolerance, double);
+
 protected:
   ConvolutionImageFilter() = default;
   ~ConvolutionImageFilter() override = default;
 
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** A separable kernel: the product of 1-D kernels along each
+   * dimension. */
+  using SeparableKernelType = FixedArray<std::vector<double>, ImageDimension>;
+  using SeparableKernelListType = std::vector<SeparableKernelType>;
+
   /** ConvolutionImageFilter needs the entire image kernel, which in
    * general is going to be a different size then the output requested
    * region. As such, this filter needs to provide an implementation
@@ -130,10 +164,49 @@ protected:
   KernelSizeType
   GetKernelRadius(const TImage * kernelImage) const;
 
+  /** Decompose the (normalized if requested) kernel into a sum of
+   * separable kernels. Return false if the decomposition is not cheaper
+   * than the direct convolution. */
+  bool
+  DecomposeKernelImage(SeparableKernelListType & separableKernels) const;
+
+  /** Compute the convolution as the sum of the separable convolutions by
+   * the given kernels. */
+  void
+  ComputeSeparableConvolution(const SeparableKernelListType & separableKernels);
+
 private:
   template <typename TImage>
   void
   ComputeConvolution(const TImage * kernelImage, ProgressAccumulator * progress);
+
+  using RealImageType = Image<double, ImageDimension>;
+
+  /** Convolve the lines of the source image along a dimension with a 1-D
+   * kernel, over the given output region. The source pixels outside the
+   * buffered region of the source are given by the boundary condition.
+   * The result is added to the destination if accumulate is true. */
+  template <typename TSourceImage>
+  void
+  ConvolveAlongDimension(const TSourceImage *                        source,
+                         const ImageBoundaryCondition<TSourceImage> * boundaryCondition,
+                         unsigned int                                dimension,
+                         const std::vector<double> &                 kernel,
+                         RealImageType *                             destination,
+                         const OutputRegionType &                    region,
+                         bool                                        accumulate);
+
+  /** Decompose a tensor of the given number of dimensions into a sum of
+   * separable tensors. */
+  static void
+  DecomposeTensor(const std::vector<double> & tensor,
+                  unsigned int                numberOfDimensions,
+                  const KernelSizeType &      size,
+                  double                      tolerance,
+                  SeparableKernelListType &   separableKernels);
+
+  bool   m_DecomposeKernel{ true };
+  double m_KernelDecompositionTolerance{ 1e-6 };
 };
 } // namespace itk
 
@@ -23,10 +23,16 @@
 #include "itkConstantPadImageFilter.h"
 #include "itkCropImageFilter.h"
 #include "itkFlipImageFilter.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageBase.h"
 #include "itkImageKernelOperator.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkIndexRange.h"
 #include "itkNeighborhoodOperatorImageFilter.h"
 #include "itkNormalizeToConstantImageFilter.h"
+#include "vnl/algo/vnl_svd.h"
+
+#include <algorithm>
 
 namespace itk
 {
@@ -37,6 +43,18 @@ ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::GenerateData()
   // Allocate the output
   this->AllocateOutputs();
 
+  // Use a sequence of 1-D convolutions when the kernel is (nearly) the
+  // sum of a few separable kernels.
+  if (m_DecomposeKernel)
+  {
+    SeparableKernelListType separableKernels;
+    if (this->DecomposeKernelImage(separableKernels))
+    {
+      this->ComputeSeparableConvolution(separableKernels);
+      return;
+    }
+  }
+
   // Create a process accumulator for tracking the progress of this minipipeline
   auto progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
@@ -183,6 +201,303 @@ ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::ComputeConvolut
   }
 }
 
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+bool
+ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::DecomposeKernelImage(
+  SeparableKernelListType & separableKernels) const
+{
+  const KernelImageType * kernel = this->GetKernelImage();
+  const KernelRegionType  kernelRegion = kernel->GetLargestPossibleRegion();
+  const KernelSizeType    kernelSize = kernelRegion.GetSize();
+
+  // The 1-D convolutions along the dimensions where the kernel size is 1
+  // are only scalings: they are merged in another dimension.
+  unsigned int firstDimension = ImageDimension;
+  SizeValueType separableCost = 0;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    if (kernelSize[i] > 1)
+    {
+      firstDimension = std::min(firstDimension, i);
+      separableCost += kernelSize[i];
+    }
+  }
+  if (firstDimension == ImageDimension)
+  {
+    return false;
+  }
+
+  std::vector<double> tensor;
+  tensor.reserve(kernelRegion.GetNumberOfPixels());
+  double sum = 0.0;
+  for (ImageRegionConstIterator<KernelImageType> it(kernel, kernelRegion); !it.IsAtEnd(); ++it)
+  {
+    tensor.push_back(static_cast<double>(it.Get()));
+    sum += tensor.back();
+  }
+  if (this->GetNormalize())
+  {
+    for (auto & value : tensor)
+    {
+      value /= sum;
+    }
+  }
+
+  separableKernels.clear();
+  DecomposeTensor(tensor, ImageDimension, kernelSize, m_KernelDecompositionTolerance, separableKernels);
+
+  for (auto & separableKernel : separableKernels)
+  {
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      if (kernelSize[i] == 1)
+      {
+        for (auto & value : separableKernel[firstDimension])
+        {
+          value *= separableKernel[i][0];
+        }
+      }
+    }
+  }
+
+  // The cost of the direct convolution is one multiplication per kernel
+  // pixel, the one of the separable convolution is one per pixel of the
+  // 1-D kernels.
+  separableCost *= separableKernels.size();
+  return separableCost < kernelRegion.GetNumberOfPixels();
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+void
+ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::DecomposeTensor(
+  const std::vector<double> & tensor,
+  unsigned int                numberOfDimensions,
+  const KernelSizeType &      size,
+  double                      tolerance,
+  SeparableKernelListType &   separableKernels)
+{
+  const unsigned int lastDimension = numberOfDimensions - 1;
+  if (numberOfDimensions == 1)
+  {
+    SeparableKernelType separableKernel;
+    separableKernel[0] = tensor;
+    separableKernels.push_back(separableKernel);
+    return;
+  }
+
+  // Unfold the tensor into a matrix whose rows are the slices along the
+  // last dimension: its singular value decomposition gives the sum of
+  // the products of 1-D kernels along the last dimension with tensors
+  // of the remaining dimensions, which are decomposed in turn.
+  const unsigned int rows = size[lastDimension];
+  const unsigned int columns = static_cast<unsigned int>(tensor.size() / rows);
+  const bool         transpose = rows < columns;
+  vnl_matrix<double> matrix(std::max(rows, columns), std::min(rows, columns));
+  for (unsigned int row = 0; row < rows; ++row)
+  {
+    for (unsigned int column = 0; column < columns; ++column)
+    {
+      const double value = tensor[row * columns + column];
+      if (transpose)
+      {
+        matrix(column, row) = value;
+      }
+      else
+      {
+        matrix(row, column) = value;
+      }
+    }
+  }
+  vnl_svd<double> svd(matrix);
+
+  // Discard the smallest singular values while their contribution to the
+  // norm is below the tolerance.
+  const unsigned int numberOfSingularValues = matrix.columns();
+  double             squaredNorm = 0.0;
+  for (unsigned int j = 0; j < numberOfSingularValues; ++j)
+  {
+    squaredNorm += svd.W(j) * svd.W(j);
+  }
+  unsigned int rank = numberOfSingularValues;
+  double       discarded = 0.0;
+  while (rank > 0 && discarded + svd.W(rank - 1) * svd.W(rank - 1) <= tolerance * tolerance * squaredNorm)
+  {
+    --rank;
+    discarded += svd.W(rank) * svd.W(rank);
+  }
+
+  for (unsigned int j = 0; j < rank; ++j)
+  {
+    const vnl_vector<double> lastVector = transpose ? svd.V().get_column(j) : svd.U().get_column(j);
+    const vnl_vector<double> otherVector = transpose ? svd.U().get_column(j) : svd.V().get_column(j);
+
+    SeparableKernelListType otherKernels;
+    DecomposeTensor(std::vector<double>(otherVector.begin(), otherVector.end()),
+                    lastDimension,
+                    size,
+                    tolerance,
+                    otherKernels);
+    for (auto & separableKernel : otherKernels)
+    {
+      separableKernel[lastDimension].resize(rows);
+      for (unsigned int row = 0; row < rows; ++row)
+      {
+        separableKernel[lastDimension][row] = svd.W(j) * lastVector[row];
+      }
+      separableKernels.push_back(separableKernel);
+    }
+  }
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+void
+ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::ComputeSeparableConvolution(
+  const SeparableKernelListType & separableKernels)
+{
+  OutputImageType *      output = this->GetOutput();
+  const OutputRegionType requestedRegion = output->GetRequestedRegion();
+  const KernelSizeType   kernelSize = this->GetKernelImage()->GetLargestPossibleRegion().GetSize();
+
+  // One 1-D convolution per dimension where the kernel size is not 1.
+  // Each one is computed over the output requested region, extended along
+  // the dimensions of the following convolutions by the input region they
+  // need, so that the boundary condition is only applied to the input
+  // image, as in the direct convolution.
+  std::vector<unsigned int> dimensions;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    if (kernelSize[i] > 1)
+    {
+      dimensions.push_back(i);
+    }
+  }
+  std::vector<OutputRegionType> regions(dimensions.size(), requestedRegion);
+  for (unsigned int pass = 0; pass < dimensions.size(); ++pass)
+  {
+    for (unsigned int next = pass + 1; next < dimensions.size(); ++next)
+    {
+      const unsigned int d = dimensions[next];
+      const auto         lowRadius = static_cast<IndexValueType>(kernelSize[d] - 1 - kernelSize[d] / 2);
+      regions[pass].SetIndex(d, requestedRegion.GetIndex(d) - lowRadius);
+      regions[pass].SetSize(d, requestedRegion.GetSize(d) + kernelSize[d] - 1);
+    }
+  }
+
+  auto sum = RealImageType::New();
+  sum->SetRegions(requestedRegion);
+  sum->Allocate(true);
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  const float numberOfPasses = separableKernels.size() * dimensions.size();
+  float       completedPasses = 0.0f;
+  for (const auto & separableKernel : separableKernels)
+  {
+    typename RealImageType::Pointer previous;
+    for (unsigned int pass = 0; pass < dimensions.size(); ++pass)
+    {
+      const unsigned int              d = dimensions[pass];
+      const bool                      lastPass = pass + 1 == dimensions.size();
+      typename RealImageType::Pointer destination = sum;
+      if (!lastPass)
+      {
+        destination = RealImageType::New();
+        destination->SetRegions(regions[pass]);
+        destination->Allocate();
+      }
+
+      if (pass == 0)
+      {
+        this->ConvolveAlongDimension(
+          this->GetInput(), this->GetBoundaryCondition(), d, separableKernel[d], destination, regions[pass], lastPass);
+      }
+      else
+      {
+        this->template ConvolveAlongDimension<RealImageType>(
+          previous, nullptr, d, separableKernel[d], destination, regions[pass], lastPass);
+      }
+      previous = destination;
+      this->UpdateProgress(++completedPasses / numberOfPasses);
+    }
+  }
+
+  ImageAlgorithm::Copy(sum.GetPointer(), output, requestedRegion, requestedRegion);
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+template <typename TSourceImage>
+void
+ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::ConvolveAlongDimension(
+  const TSourceImage *                         source,
+  const ImageBoundaryCondition<TSourceImage> * boundaryCondition,
+  unsigned int                                 dimension,
+  const std::vector<double> &                  kernel,
+  RealImageType *                              destination,
+  const OutputRegionType &                     region,
+  bool                                         accumulate)
+{
+  // The output pixel at x is the sum over k of kernel[k] * source[x + r - k],
+  // where r = kernelSize / 2, as in the direct convolution.
+  const SizeValueType       kernelSize = kernel.size();
+  const auto                lowRadius = static_cast<IndexValueType>(kernelSize - 1 - kernelSize / 2);
+  const std::vector<double> flippedKernel(kernel.rbegin(), kernel.rend());
+  const SizeValueType       length = region.GetSize(dimension);
+  const OffsetValueType     sourceStride = source->GetOffsetTable()[dimension];
+  const OffsetValueType     destinationStride = destination->GetOffsetTable()[dimension];
+
+  this->GetMultiThreader()->template ParallelizeImageRegionRestrictDirection<ImageDimension>(
+    dimension,
+    region,
+    [&](const OutputRegionType & subRegion) {
+      std::vector<double> line(length + kernelSize - 1);
+      OutputRegionType    lineRegion = subRegion;
+      lineRegion.SetSize(dimension, 1);
+      for (const auto & index : ImageRegionIndexRange<ImageDimension>(lineRegion))
+      {
+        typename TSourceImage::RegionType sourceLineRegion;
+        sourceLineRegion.SetIndex(index);
+        sourceLineRegion.SetIndex(dimension, index[dimension] - lowRadius);
+        sourceLineRegion.SetSize(dimension, line.size());
+        for (unsigned int i = 0; i < ImageDimension; ++i)
+        {
+          if (i != dimension)
+          {
+            sourceLineRegion.SetSize(i, 1);
+          }
+        }
+
+        if (source->GetBufferedRegion().IsInside(sourceLineRegion))
+        {
+          const auto * sourcePixel = source->GetBufferPointer() + source->ComputeOffset(sourceLineRegion.GetIndex());
+          for (SizeValueType i = 0; i < line.size(); ++i, sourcePixel += sourceStride)
+          {
+            line[i] = static_cast<double>(*sourcePixel);
+          }
+        }
+        else
+        {
+          typename TSourceImage::IndexType sourceIndex = sourceLineRegion.GetIndex();
+          for (SizeValueType i = 0; i < line.size(); ++i, ++sourceIndex[dimension])
+          {
+            line[i] = static_cast<double>(boundaryCondition->GetPixel(sourceIndex, source));
+          }
+        }
+
+        double * destinationPixel = destination->GetBufferPointer() + destination->ComputeOffset(index);
+        for (SizeValueType i = 0; i < length; ++i, destinationPixel += destinationStride)
+        {
+          double value = 0.0;
+          for (SizeValueType k = 0; k < kernelSize; ++k)
+          {
+            value += flippedKernel[k] * line[i + k];
+          }
+          *destinationPixel = accumulate ? *destinationPixel + value : value;
+        }
+      }
+    },
+    nullptr);
+}
+
 template <typename TInputImage, typename TKernelImage, typename TOutputImage>
 bool
 ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::GetKernelNeedsPadding() const
@@ -276,5 +591,15 @@ ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::GenerateInputRe
     kernelPtr->SetRequestedRegionToLargestPossibleRegion();
   }
 }
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage>
+void
+ConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "DecomposeKernel: " << (m_DecomposeKernel ? "On" : "Off") << std::endl;
+  os << indent << "KernelDecompositionTolerance: " << m_KernelDecompositionTolerance << std::endl;
+}
 } // namespace itk
 #endif
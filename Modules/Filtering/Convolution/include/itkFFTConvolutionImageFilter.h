@@ -37,6 +37,15 @@ namespace itk
  * convolution theorem to accelerate the convolution computation when
  * the kernel is large.
  *
+ * By default, the whole padded input image is transformed at once. When
+ * a block size is set, the output is instead computed block by block
+ * with the overlap-save method: each block is obtained from the Fourier
+ * transform of an input patch that only extends the block by the kernel
+ * size, so the memory used by the transforms is bounded by the block
+ * size, the blocks are computed in parallel, and only the input region
+ * needed for the output requested region is requested, which allows the
+ * filter to be streamed.
+ *
  * \warning This filter ignores the spacing, origin, and orientation
  * of the kernel image and treats them as identical to those in the
  * input image.
@@ -107,6 +116,16 @@ public:
   itkSetMacro(SizeGreatestPrimeFactor, SizeValueType);
   itkGetMacro(SizeGreatestPrimeFactor, SizeValueType);
 
+  /** Set/Get the size of the output blocks computed with separate
+   * Fourier transforms. The blocks may be slightly enlarged so that the
+   * size of their transform only has prime factors not greater than
+   * SizeGreatestPrimeFactor. A zero component means that the blocks span
+   * the whole output requested region along that dimension. When all the
+   * components are zero, which is the default, the whole image is
+   * transformed at once. */
+  itkSetMacro(BlockSize, InputSizeType);
+  itkGetConstReferenceMacro(BlockSize, InputSizeType);
+
 protected:
   FFTConvolutionImageFilter();
   ~FFTConvolutionImageFilter() override = default;
@@ -130,6 +149,27 @@ protected:
   void
   GenerateData() override;
 
+  /** Compute the output requested region block by block, with the
+   * overlap-save method. */
+  void
+  GenerateDataByBlocks();
+
+  /** Take the Fourier transform of the kernel, padded to the size of
+   * the transforms of the blocks. */
+  void
+  TransformBlockKernel(const KernelImageType *           kernel,
+                       const InputSizeType &             blockPadSize,
+                       InternalComplexImagePointerType & transformedKernel);
+
+  /** Get the input region the convolution of an output region depends
+   * on: the output region extended by the kernel size minus one. */
+  InputRegionType
+  GetBlockInputRegion(const OutputRegionType & outputRegion) const;
+
+  /** Get whether the output is computed block by block. */
+  bool
+  GetUseBlocks() const;
+
   /** Prepare the input images for operations in the Fourier
    * domain. This includes resizing the input and kernel images,
    * normalizing the kernel if requested, shifting the kernel, and
@@ -203,6 +243,7 @@ protected:
 
 private:
   SizeValueType m_SizeGreatestPrimeFactor;
+  InputSizeType m_BlockSize;
 };
 } // namespace itk
 
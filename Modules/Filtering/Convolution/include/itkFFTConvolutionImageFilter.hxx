@@ -25,11 +25,16 @@
 #include "itkConstantPadImageFilter.h"
 #include "itkCyclicShiftImageFilter.h"
 #include "itkExtractImageFilter.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageBase.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkMultiplyImageFilter.h"
 #include "itkNormalizeToConstantImageFilter.h"
 #include "itkMath.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
@@ -37,17 +42,29 @@ template <typename TInputImage, typename TKernelImage, typename TOutputImage, ty
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::FFTConvolutionImageFilter()
 {
   m_SizeGreatestPrimeFactor = FFTFilterType::New()->GetSizeGreatestPrimeFactor();
+  m_BlockSize.Fill(0);
 }
 
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateInputRequestedRegion()
 {
-  // Request the largest possible region for both input images.
+  // Request the largest possible region for both input images, unless
+  // the output is computed block by block. Then, only the input region
+  // the output requested region depends on is needed.
   if (this->GetInput())
   {
     typename InputImageType::Pointer imagePtr = const_cast<InputImageType *>(this->GetInput());
-    imagePtr->SetRequestedRegionToLargestPossibleRegion();
+    if (this->GetUseBlocks() && this->GetKernelImage())
+    {
+      const InputRegionType blockInputRegion = this->GetBlockInputRegion(this->GetOutput()->GetRequestedRegion());
+      imagePtr->SetRequestedRegion(
+        this->GetBoundaryCondition()->GetInputRequestedRegion(imagePtr->GetLargestPossibleRegion(), blockInputRegion));
+    }
+    else
+    {
+      imagePtr->SetRequestedRegionToLargestPossibleRegion();
+    }
   }
 
   if (this->GetKernelImage())
@@ -63,6 +80,12 @@ template <typename TInputImage, typename TKernelImage, typename TOutputImage, ty
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateData()
 {
+  if (this->GetUseBlocks())
+  {
+    this->GenerateDataByBlocks();
+    return;
+  }
+
   // Create a process accumulator for tracking the progress of this minipipeline
   auto progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
@@ -91,6 +114,198 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
   this->ProduceOutput(multiplyFilter->GetOutput(), progress, 0.2);
 }
 
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateDataByBlocks()
+{
+  this->AllocateOutputs();
+
+  const InputImageType *  input = this->GetInput();
+  const KernelImageType * kernel = this->GetKernelImage();
+  OutputImageType *       output = this->GetOutput();
+  const OutputRegionType  requestedRegion = output->GetRequestedRegion();
+  if (requestedRegion.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+  const KernelSizeType kernelSize = kernel->GetLargestPossibleRegion().GetSize();
+
+  // The convolution of a block only depends on the input patch made of
+  // the block extended by the kernel size minus one. The circular
+  // convolution computed by the Fourier transform of that patch, padded
+  // to an FFT friendly size, wraps around over the extension only, which
+  // is discarded (overlap-save).
+  InputSizeType  blockPadSize;
+  OutputSizeType blockSize;
+  SizeValueType  numberOfBlocksAlong[ImageDimension];
+  SizeValueType  numberOfBlocks = 1;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    const SizeValueType requestedSize = requestedRegion.GetSize(i);
+    blockSize[i] = (m_BlockSize[i] > 0) ? std::min(m_BlockSize[i], requestedSize) : requestedSize;
+    blockPadSize[i] = blockSize[i] + kernelSize[i] - 1;
+    if (m_SizeGreatestPrimeFactor > 1)
+    {
+      while (Math::GreatestPrimeFactor(blockPadSize[i]) > m_SizeGreatestPrimeFactor)
+      {
+        blockPadSize[i]++;
+      }
+    }
+    // Use the padding to enlarge the blocks.
+    blockSize[i] = std::min(blockPadSize[i] - kernelSize[i] + 1, requestedSize);
+    numberOfBlocksAlong[i] = (requestedSize + blockSize[i] - 1) / blockSize[i];
+    numberOfBlocks *= numberOfBlocksAlong[i];
+  }
+
+  InternalComplexImagePointerType transformedKernel;
+  this->TransformBlockKernel(kernel, blockPadSize, transformedKernel);
+
+  // When there are several blocks, they are computed in parallel, each
+  // one with transforms restricted to a single work unit, so that the
+  // machine is not oversubscribed. The FFTW filters plan their transforms
+  // with their number of work units, so these plans are single threaded.
+  const ThreadIdType workUnitsPerBlock = (numberOfBlocks > 1) ? 1 : this->GetNumberOfWorkUnits();
+
+  const BoundaryConditionPointerType boundaryCondition = this->GetBoundaryCondition();
+  const InputRegionType              inputLargestRegion = input->GetLargestPossibleRegion();
+
+  InputIndexType validIndex;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    validIndex[i] = static_cast<IndexValueType>(kernelSize[i]) - 1;
+  }
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType blockNumber) {
+      OutputRegionType block = requestedRegion;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        const SizeValueType blockIndex = blockNumber % numberOfBlocksAlong[i];
+        blockNumber /= numberOfBlocksAlong[i];
+        block.SetIndex(i, requestedRegion.GetIndex(i) + static_cast<IndexValueType>(blockIndex * blockSize[i]));
+        block.SetSize(i, std::min(blockSize[i], requestedRegion.GetSize(i) - blockIndex * blockSize[i]));
+      }
+
+      // Copy the input patch in the low corner of the zero padded image.
+      const InputRegionType patchRegion = this->GetBlockInputRegion(block);
+      auto                  paddedPatch = InternalImageType::New();
+      paddedPatch->SetRegions(blockPadSize);
+      paddedPatch->Allocate(true);
+      const InputRegionType paddedPatchRegion(patchRegion.GetSize());
+      if (inputLargestRegion.IsInside(patchRegion))
+      {
+        ImageAlgorithm::Copy(input, paddedPatch.GetPointer(), patchRegion, paddedPatchRegion);
+      }
+      else
+      {
+        const typename InputIndexType::OffsetType patchOffset = patchRegion.GetIndex() - paddedPatchRegion.GetIndex();
+        for (ImageRegionIteratorWithIndex<InternalImageType> it(paddedPatch, paddedPatchRegion); !it.IsAtEnd(); ++it)
+        {
+          it.Set(static_cast<TInternalPrecision>(boundaryCondition->GetPixel(it.GetIndex() + patchOffset, input)));
+        }
+      }
+
+      auto fftFilter = FFTFilterType::New();
+      fftFilter->SetNumberOfWorkUnits(workUnitsPerBlock);
+      fftFilter->SetInput(paddedPatch);
+      fftFilter->Update();
+      InternalComplexImagePointerType transformedPatch = fftFilter->GetOutput();
+      transformedPatch->DisconnectPipeline();
+
+      InternalComplexType *       patchBuffer = transformedPatch->GetBufferPointer();
+      const InternalComplexType * kernelBuffer = transformedKernel->GetBufferPointer();
+      const SizeValueType         numberOfFrequencies = transformedPatch->GetBufferedRegion().GetNumberOfPixels();
+      for (SizeValueType j = 0; j < numberOfFrequencies; ++j)
+      {
+        patchBuffer[j] *= kernelBuffer[j];
+      }
+
+      auto ifftFilter = IFFTFilterType::New();
+      ifftFilter->SetActualXDimensionIsOdd(blockPadSize[0] % 2 != 0);
+      ifftFilter->SetNumberOfWorkUnits(workUnitsPerBlock);
+      ifftFilter->SetInput(transformedPatch);
+      ifftFilter->Update();
+
+      ImageAlgorithm::Copy(ifftFilter->GetOutput(), output, InputRegionType(validIndex, block.GetSize()), block);
+    },
+    this);
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::TransformBlockKernel(
+  const KernelImageType *           kernel,
+  const InputSizeType &             blockPadSize,
+  InternalComplexImagePointerType & transformedKernel)
+{
+  // The kernel is copied in the low corner of the zero padded image, as
+  // expected by the overlap-save method: no cyclic shift is needed.
+  auto paddedKernel = InternalImageType::New();
+  paddedKernel->SetRegions(blockPadSize);
+  paddedKernel->Allocate(true);
+
+  const KernelRegionType                    kernelRegion = kernel->GetLargestPossibleRegion();
+  TInternalPrecision                        sum = NumericTraits<TInternalPrecision>::ZeroValue();
+  ImageRegionConstIterator<KernelImageType> kernelIt(kernel, kernelRegion);
+  ImageRegionIterator<InternalImageType>    paddedKernelIt(paddedKernel, InputRegionType(kernelRegion.GetSize()));
+  for (; !kernelIt.IsAtEnd(); ++kernelIt, ++paddedKernelIt)
+  {
+    const auto value = static_cast<TInternalPrecision>(kernelIt.Get());
+    paddedKernelIt.Set(value);
+    sum += value;
+  }
+  if (this->GetNormalize())
+  {
+    for (paddedKernelIt.GoToBegin(); !paddedKernelIt.IsAtEnd(); ++paddedKernelIt)
+    {
+      paddedKernelIt.Set(paddedKernelIt.Get() / sum);
+    }
+  }
+
+  auto kernelFFTFilter = FFTFilterType::New();
+  kernelFFTFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  kernelFFTFilter->SetInput(paddedKernel);
+  kernelFFTFilter->Update();
+
+  transformedKernel = kernelFFTFilter->GetOutput();
+  transformedKernel->DisconnectPipeline();
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+auto
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GetBlockInputRegion(
+  const OutputRegionType & outputRegion) const -> InputRegionType
+{
+  // The kernel center is at kernelSize / 2, as in the cyclic shift of the
+  // kernel done when the whole image is transformed.
+  const KernelSizeType kernelSize = this->GetKernelImage()->GetLargestPossibleRegion().GetSize();
+  InputRegionType      inputRegion;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    const auto lowRadius = static_cast<IndexValueType>(kernelSize[i] - 1 - kernelSize[i] / 2);
+    inputRegion.SetIndex(i, outputRegion.GetIndex(i) - lowRadius);
+    inputRegion.SetSize(i, outputRegion.GetSize(i) + kernelSize[i] - 1);
+  }
+  return inputRegion;
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+bool
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GetUseBlocks() const
+{
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    if (m_BlockSize[i] > 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::PrepareInputs(
@@ -415,6 +630,8 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "SizeGreatestPrimeFactor: " << m_SizeGreatestPrimeFactor << std::endl;
+  os << indent << "BlockSize: " << static_cast<typename NumericTraits<InputSizeType>::PrintType>(m_BlockSize)
+     << std::endl;
 }
 
 } // namespace itk
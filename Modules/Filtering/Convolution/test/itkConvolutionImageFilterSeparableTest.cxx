@@ -0,0 +1,228 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkConstantBoundaryCondition.h"
+#include "itkConvolutionImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include <vector>
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+CreateImage(const typename TImage::RegionType & region, unsigned int seed)
+{
+  auto image = TImage::New();
+  image->SetRegions(region);
+  image->Allocate();
+  unsigned int value = seed;
+  for (itk::ImageRegionIterator<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    value = (value * 37 + 11) % 101;
+    it.Set(static_cast<typename TImage::PixelType>(value) / 101.0f - 0.3f);
+  }
+  return image;
+}
+
+// Create a kernel which is the sum of the given number of separable kernels.
+template <typename TImage>
+typename TImage::Pointer
+CreateSeparableKernel(const typename TImage::SizeType & size, unsigned int rank)
+{
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+
+  auto kernel = TImage::New();
+  kernel->SetRegions(size);
+  kernel->Allocate(true);
+  for (unsigned int r = 0; r < rank; ++r)
+  {
+    std::vector<std::vector<float>> factors(Dimension);
+    for (unsigned int i = 0; i < Dimension; ++i)
+    {
+      for (unsigned int k = 0; k < size[i]; ++k)
+      {
+        factors[i].push_back(1.0f + 0.5f * std::cos(0.7f * (k + 1) * (r + i + 1)));
+      }
+    }
+    for (itk::ImageRegionIteratorWithIndex<TImage> it(kernel, kernel->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      float value = 1.0f;
+      for (unsigned int i = 0; i < Dimension; ++i)
+      {
+        value *= factors[i][it.GetIndex()[i]];
+      }
+      it.Set(it.Get() + value);
+    }
+  }
+  return kernel;
+}
+
+// Compare the convolution computed with and without the decomposition of
+// the kernel, streamed in the given number of divisions.
+template <typename TImage>
+bool
+TestDecomposition(const TImage *                                                           image,
+                  const TImage *                                                           kernel,
+                  bool                                                                     normalize,
+                  itk::ConvolutionImageFilterBaseEnums::ConvolutionImageFilterOutputRegion outputRegionMode,
+                  itk::ImageBoundaryCondition<TImage> *                                    boundaryCondition,
+                  unsigned int                                                             numberOfStreamDivisions,
+                  double                                                                   tolerance = 1e-6,
+                  double                                                                   maximumError = 1e-3)
+{
+  using ConvolutionFilterType = itk::ConvolutionImageFilter<TImage>;
+
+  auto reference = ConvolutionFilterType::New();
+  reference->SetInput(image);
+  reference->SetKernelImage(kernel);
+  reference->SetNormalize(normalize);
+  reference->SetOutputRegionMode(outputRegionMode);
+  reference->SetBoundaryCondition(boundaryCondition);
+  reference->DecomposeKernelOff();
+  reference->Update();
+
+  auto convolver = ConvolutionFilterType::New();
+  convolver->SetInput(image);
+  convolver->SetKernelImage(kernel);
+  convolver->SetNormalize(normalize);
+  convolver->SetOutputRegionMode(outputRegionMode);
+  convolver->SetBoundaryCondition(boundaryCondition);
+  convolver->SetKernelDecompositionTolerance(tolerance);
+
+  auto streamer = itk::StreamingImageFilter<TImage, TImage>::New();
+  streamer->SetInput(convolver->GetOutput());
+  streamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  streamer->Update();
+
+  const TImage * expected = reference->GetOutput();
+  const TImage * actual = streamer->GetOutput();
+  if (expected->GetBufferedRegion() != actual->GetBufferedRegion())
+  {
+    std::cerr << "Test failed for kernel size " << kernel->GetLargestPossibleRegion().GetSize() << ": expected region "
+              << expected->GetBufferedRegion() << ", got " << actual->GetBufferedRegion() << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(expected, expected->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    if (itk::Math::abs(it.Get() - actual->GetPixel(it.GetIndex())) > maximumError)
+    {
+      std::cerr << "Test failed for kernel size " << kernel->GetLargestPossibleRegion().GetSize() << ", normalize "
+                << normalize << ", output region mode " << outputRegionMode << ", "
+                << boundaryCondition->GetNameOfClass() << ", " << numberOfStreamDivisions
+                << " stream divisions, at index " << it.GetIndex() << ": expected " << it.Get() << ", got "
+                << actual->GetPixel(it.GetIndex()) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkConvolutionImageFilterSeparableTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 2>;
+  using ConvolutionFilterType = itk::ConvolutionImageFilter<ImageType>;
+
+  auto convolver = ConvolutionFilterType::New();
+  ITK_TEST_SET_GET_BOOLEAN(convolver, DecomposeKernel, true);
+  convolver->SetKernelDecompositionTolerance(1e-3);
+  ITK_TEST_SET_GET_VALUE(1e-3, convolver->GetKernelDecompositionTolerance());
+
+  const ImageType::IndexType imageIndex = { { -3, 5 } };
+  const ImageType::SizeType  imageSize = { { 41, 37 } };
+  const ImageType::Pointer   image = CreateImage<ImageType>(ImageType::RegionType(imageIndex, imageSize), 1);
+
+  const ConvolutionFilterType::OutputRegionModeType outputRegionModes[] = {
+    ConvolutionFilterType::OutputRegionModeEnum::SAME, ConvolutionFilterType::OutputRegionModeEnum::VALID
+  };
+
+  itk::ZeroFluxNeumannBoundaryCondition<ImageType> zeroFluxNeumannBoundaryCondition;
+  itk::ConstantBoundaryCondition<ImageType>        constantBoundaryCondition;
+  constantBoundaryCondition.SetConstant(0.5f);
+  itk::PeriodicBoundaryCondition<ImageType>        periodicBoundaryCondition;
+
+  const ConvolutionFilterType::BoundaryConditionPointerType boundaryConditions[] = {
+    &zeroFluxNeumannBoundaryCondition, &constantBoundaryCondition, &periodicBoundaryCondition
+  };
+
+  // Separable, low-rank and full-rank kernels, of odd and even sizes.
+  std::vector<ImageType::Pointer> kernels;
+  kernels.push_back(CreateSeparableKernel<ImageType>({ { 7, 5 } }, 1));
+  kernels.push_back(CreateSeparableKernel<ImageType>({ { 6, 9 } }, 1));
+  kernels.push_back(CreateSeparableKernel<ImageType>({ { 11, 11 } }, 2));
+  kernels.push_back(CreateSeparableKernel<ImageType>({ { 1, 8 } }, 1));
+  kernels.push_back(CreateImage<ImageType>(ImageType::RegionType(ImageType::SizeType{ { 5, 4 } }), 7));
+
+  bool success = true;
+  for (const auto & kernel : kernels)
+  {
+    for (const auto outputRegionMode : outputRegionModes)
+    {
+      for (const auto boundaryCondition : boundaryConditions)
+      {
+        success &= TestDecomposition<ImageType>(image, kernel, false, outputRegionMode, boundaryCondition, 1);
+      }
+    }
+    success &= TestDecomposition<ImageType>(
+      image, kernel, true, ConvolutionFilterType::OutputRegionModeEnum::SAME, &zeroFluxNeumannBoundaryCondition, 1);
+    success &= TestDecomposition<ImageType>(
+      image, kernel, false, ConvolutionFilterType::OutputRegionModeEnum::SAME, &zeroFluxNeumannBoundaryCondition, 4);
+  }
+
+  // A larger tolerance gives a low-rank approximation of the kernel.
+  const ImageType::Pointer nearlySeparableKernel = CreateSeparableKernel<ImageType>({ { 9, 9 } }, 1);
+  nearlySeparableKernel->SetPixel({ { 4, 4 } }, nearlySeparableKernel->GetPixel({ { 4, 4 } }) + 0.01f);
+  success &= TestDecomposition<ImageType>(image,
+                                          nearlySeparableKernel,
+                                          true,
+                                          ConvolutionFilterType::OutputRegionModeEnum::SAME,
+                                          &zeroFluxNeumannBoundaryCondition,
+                                          1,
+                                          0.01,
+                                          0.01);
+
+  // Separable and low-rank 3-D kernels.
+  using Image3DType = itk::Image<float, 3>;
+  const Image3DType::SizeType image3DSize = { { 19, 17, 15 } };
+  const Image3DType::Pointer  image3D = CreateImage<Image3DType>(Image3DType::RegionType(image3DSize), 3);
+
+  itk::ConstantBoundaryCondition<Image3DType> constantBoundaryCondition3D;
+  for (unsigned int rank = 1; rank <= 2; ++rank)
+  {
+    success &= TestDecomposition<Image3DType>(image3D,
+                                              CreateSeparableKernel<Image3DType>({ { 5, 4, 7 } }, rank),
+                                              false,
+                                              ConvolutionFilterType::OutputRegionModeEnum::SAME,
+                                              &constantBoundaryCondition3D,
+                                              2);
+  }
+
+  if (!success)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
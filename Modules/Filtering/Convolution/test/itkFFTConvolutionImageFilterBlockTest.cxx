@@ -0,0 +1,190 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkConstantBoundaryCondition.h"
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include "itkObjectFactoryBase.h"
+#include "itkVnlRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkVnlHalfHermitianToRealInverseFFTImageFilter.h"
+#if defined(ITK_USE_FFTWD) || defined(ITK_USE_FFTWF)
+#  include "itkFFTWRealToHalfHermitianForwardFFTImageFilter.h"
+#  include "itkFFTWHalfHermitianToRealInverseFFTImageFilter.h"
+#endif
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<float, Dimension>;
+using ConvolutionFilterType = itk::FFTConvolutionImageFilter<ImageType>;
+
+ImageType::Pointer
+CreateImage(const ImageType::RegionType & region, unsigned int seed)
+{
+  auto image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  unsigned int value = seed;
+  for (itk::ImageRegionIterator<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    value = (value * 37 + 11) % 101;
+    it.Set(static_cast<float>(value) / 101.0f - 0.3f);
+  }
+  return image;
+}
+
+bool
+CompareImages(const ImageType * expected, const ImageType * actual, const std::string & description)
+{
+  if (expected->GetBufferedRegion() != actual->GetBufferedRegion())
+  {
+    std::cerr << "Test failed for " << description << ": expected region " << expected->GetBufferedRegion()
+              << ", got " << actual->GetBufferedRegion() << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(expected, expected->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    if (itk::Math::abs(it.Get() - actual->GetPixel(it.GetIndex())) > 1e-3)
+    {
+      std::cerr << "Test failed for " << description << " at index " << it.GetIndex() << ": expected " << it.Get()
+                << ", got " << actual->GetPixel(it.GetIndex()) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compare the convolution computed by blocks with the one of the whole image.
+bool
+TestBlocks(const ImageType *                                   image,
+           const ImageType *                                   kernel,
+           const ImageType::SizeType &                         blockSize,
+           bool                                                normalize,
+           ConvolutionFilterType::OutputRegionModeType         outputRegionMode,
+           ConvolutionFilterType::BoundaryConditionPointerType boundaryCondition,
+           unsigned int                                        numberOfStreamDivisions)
+{
+  auto reference = ConvolutionFilterType::New();
+  reference->SetInput(image);
+  reference->SetKernelImage(kernel);
+  reference->SetNormalize(normalize);
+  reference->SetOutputRegionMode(outputRegionMode);
+  reference->SetBoundaryCondition(boundaryCondition);
+  reference->Update();
+
+  auto convolver = ConvolutionFilterType::New();
+  convolver->SetInput(image);
+  convolver->SetKernelImage(kernel);
+  convolver->SetNormalize(normalize);
+  convolver->SetOutputRegionMode(outputRegionMode);
+  convolver->SetBoundaryCondition(boundaryCondition);
+  convolver->SetBlockSize(blockSize);
+
+  auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamer->SetInput(convolver->GetOutput());
+  streamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+  streamer->Update();
+
+  std::ostringstream description;
+  description << "kernel size " << kernel->GetLargestPossibleRegion().GetSize() << ", block size " << blockSize
+              << ", normalize " << normalize << ", output region mode " << outputRegionMode << ", "
+              << boundaryCondition->GetNameOfClass() << ", " << numberOfStreamDivisions << " stream divisions";
+  return CompareImages(reference->GetOutput(), streamer->GetOutput(), description.str());
+}
+} // namespace
+
+int
+itkFFTConvolutionImageFilterBlockTest(int, char *[])
+{
+#ifndef ITK_FFT_FACTORY_REGISTER_MANAGER // Manual factory registration is required for ITK FFT tests
+#  if defined(ITK_USE_FFTWD) || defined(ITK_USE_FFTWF)
+  itk::ObjectFactoryBase::RegisterInternalFactoryOnce<
+    itk::FFTImageFilterFactory<itk::FFTWRealToHalfHermitianForwardFFTImageFilter>>();
+  itk::ObjectFactoryBase::RegisterInternalFactoryOnce<
+    itk::FFTImageFilterFactory<itk::FFTWHalfHermitianToRealInverseFFTImageFilter>>();
+#  endif
+  itk::ObjectFactoryBase::RegisterInternalFactoryOnce<
+    itk::FFTImageFilterFactory<itk::VnlRealToHalfHermitianForwardFFTImageFilter>>();
+  itk::ObjectFactoryBase::RegisterInternalFactoryOnce<
+    itk::FFTImageFilterFactory<itk::VnlHalfHermitianToRealInverseFFTImageFilter>>();
+#endif
+
+  auto                convolver = ConvolutionFilterType::New();
+  ImageType::SizeType blockSize = { { 16, 8 } };
+  convolver->SetBlockSize(blockSize);
+  ITK_TEST_SET_GET_VALUE(blockSize, convolver->GetBlockSize());
+
+  const ImageType::IndexType imageIndex = { { -3, 5 } };
+  const ImageType::SizeType  imageSize = { { 61, 47 } };
+  const ImageType::Pointer   image = CreateImage(ImageType::RegionType(imageIndex, imageSize), 1);
+  const ImageType::SizeType  kernelSizes[] = { { { 5, 5 } }, { { 4, 7 } }, { { 1, 6 } } };
+  const ImageType::SizeType  blockSizes[] = { { { 16, 8 } }, { { 7, 0 } }, { { 100, 100 } } };
+
+  const ConvolutionFilterType::OutputRegionModeType outputRegionModes[] = {
+    ConvolutionFilterType::OutputRegionModeEnum::SAME, ConvolutionFilterType::OutputRegionModeEnum::VALID
+  };
+
+  itk::ZeroFluxNeumannBoundaryCondition<ImageType> zeroFluxNeumannBoundaryCondition;
+  itk::ConstantBoundaryCondition<ImageType>        constantBoundaryCondition;
+  constantBoundaryCondition.SetConstant(0.5f);
+  itk::PeriodicBoundaryCondition<ImageType>        periodicBoundaryCondition;
+
+  const ConvolutionFilterType::BoundaryConditionPointerType boundaryConditions[] = {
+    &zeroFluxNeumannBoundaryCondition, &constantBoundaryCondition, &periodicBoundaryCondition
+  };
+
+  bool success = true;
+  for (const auto & kernelSize : kernelSizes)
+  {
+    const ImageType::Pointer kernel = CreateImage(ImageType::RegionType(kernelSize), 7);
+    for (const auto & size : blockSizes)
+    {
+      for (const auto outputRegionMode : outputRegionModes)
+      {
+        for (const auto boundaryCondition : boundaryConditions)
+        {
+          for (unsigned int numberOfStreamDivisions : { 1, 3 })
+          {
+            success &=
+              TestBlocks(image, kernel, size, false, outputRegionMode, boundaryCondition, numberOfStreamDivisions);
+          }
+        }
+      }
+      success &= TestBlocks(image,
+                            kernel,
+                            size,
+                            true,
+                            ConvolutionFilterType::OutputRegionModeEnum::SAME,
+                            &zeroFluxNeumannBoundaryCondition,
+                            1);
+    }
+  }
+
+  if (!success)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -21,6 +21,8 @@
 #include "itkImageToImageFilter.h"
 #include "itkImageRegionIteratorWithIndex.h"
 
+#include <vector>
+
 namespace itk
 {
 /**
@@ -45,13 +47,30 @@ namespace itk
  *   computed in "pixels", the vector is represented by an
  *   itk::Offset. That is, physical coordinates are not used.
  *
- * This filter is N-dimensional and known to be efficient
- * in computational time. The algorithm is the N-dimensional version
- * of the 4SED algorithm given for two dimensions in:
+ * The Voronoi partition and the vector map can be skipped with
+ * GenerateVoronoiMapOff() and GenerateVectorDistanceMapOff(), to save
+ * time and memory when only the distance map is needed. These outputs are
+ * then left empty.
+ *
+ * This filter is N-dimensional and multithreaded. The filter was first
+ * implemented with the N-dimensional version of the 4SED algorithm given
+ * for two dimensions in:
  *
  * Danielsson, Per-Erik.  Euclidean Distance Mapping.  Computer
  * Graphics and Image Processing 14, 227-248 (1980).
  *
+ * It now computes the exact closest object pixel with separable passes
+ * along each dimension, in which the lines are independent and are
+ * distributed over the work units. Each pass computes the lower envelope
+ * of the parabolas rooted at the pixels of a line, as in:
+ *
+ * P. F. Felzenszwalb and D. P. Huttenlocher, "Distance Transforms of
+ * Sampled Functions", Theory of Computing, 8(19): 415-428, 2012.
+ *
+ * When several object pixels are at the same distance, the one chosen for
+ * the Voronoi partition and the vector map may differ from the one of the
+ * 4SED algorithm.
+ *
  * \ingroup ImageFeatureExtraction
  * \ingroup ITKDistanceMap
  */
@@ -89,6 +108,7 @@ public:
 
   /** Type for the index of the input image. */
   using OffsetType = typename InputImageType::OffsetType;
+  using OffsetValueType = typename InputImageType::OffsetValueType;
 
   /** Type for the spacing of the input image. */
   using SpacingType = typename InputImageType::SpacingType;
@@ -145,6 +165,16 @@ public:
   itkGetConstReferenceMacro(UseImageSpacing, bool);
   itkBooleanMacro(UseImageSpacing);
 
+  /** Set/Get if the Voronoi map is computed. Default is true. */
+  itkSetMacro(GenerateVoronoiMap, bool);
+  itkGetConstReferenceMacro(GenerateVoronoiMap, bool);
+  itkBooleanMacro(GenerateVoronoiMap);
+
+  /** Set/Get if the vector distance map is computed. Default is true. */
+  itkSetMacro(GenerateVectorDistanceMap, bool);
+  itkGetConstReferenceMacro(GenerateVectorDistanceMap, bool);
+  itkBooleanMacro(GenerateVectorDistanceMap);
+
   /** Get Voronoi Map
    * This map shows for each pixel what object is closest to it.
    * Each object should be labeled by a number (larger than 0),
@@ -204,16 +234,60 @@ protected:
   void
   ComputeVoronoiMap();
 
-  /** Update distance map locally.  Used by GenerateData(). */
+private:
+  /** Squared distances, used when neither the Voronoi map nor the vector
+   * map are generated. */
+  using DistanceImageType = Image<double, InputImageDimension>;
+
+  /** The lower envelope of the parabolas of a line: the position of their
+   * apex, their value at the apex, the position from which they are in the
+   * envelope, and their pixel and vector to the closest object pixel. */
+  struct LowerEnvelope
+  {
+    std::vector<double>        position;
+    std::vector<double>        value;
+    std::vector<double>        begin;
+    std::vector<SizeValueType> pixel;
+    std::vector<OffsetType>    vector;
+  };
+
+  /** Update the vectors to the closest object pixels of the line along
+   * dimension d starting at index. */
+  void
+  UpdateVectorLine(unsigned int d, const IndexType & index, LowerEnvelope & envelope);
+
+  /** Update the squared distances of the line along dimension d starting
+   * at index. */
   void
-  UpdateLocalDistance(VectorImageType *, const IndexType &, const OffsetType &);
+  UpdateDistanceLine(unsigned int d, const IndexType & index, LowerEnvelope & envelope);
+
+  /** Add a parabola to the lower envelope, removing the ones it hides. */
+  static void
+  AddParabola(LowerEnvelope & envelope, SizeValueType & numberOfParabolas, double position, double value);
+
+  /** Squared length of a vector, with the weights of the dimensions. */
+  double
+  SquaredLength(const OffsetType & vector) const;
 
-private:
   bool m_SquaredDistance;
   bool m_InputIsBinary;
   bool m_UseImageSpacing;
+  bool m_GenerateVoronoiMap{ true };
+  bool m_GenerateVectorDistanceMap{ true };
 
   SpacingType m_InputSpacingCache;
+
+  /** Weight of each dimension in the distances: the spacing, or one. */
+  SpacingType m_Weights;
+
+  /** Value of the vector components of the pixels without closest object
+   * pixel. */
+  OffsetValueType m_MaximumComponent{ 0 };
+
+  /** Working images: the vectors to the closest object pixels, which may be
+   * the vector distance map output, or the squared distances. */
+  VectorImagePointer                  m_Components;
+  typename DistanceImageType::Pointer m_SquaredDistances;
 };
 } // end namespace itk
 
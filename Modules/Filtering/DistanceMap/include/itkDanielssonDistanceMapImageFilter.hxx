@@ -20,8 +20,10 @@
 
 #include <iostream>
 
-#include "itkReflectiveImageRegionConstIterator.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkIndexRange.h"
+#include "itkProgressTransformer.h"
 
 namespace itk
 {
@@ -90,29 +92,44 @@ void
 DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::PrepareData()
 {
   itkDebugMacro(<< "PrepareData Start");
-  VoronoiImagePointer voronoiMap = this->GetVoronoiMap();
-
   InputImagePointer inputImage = dynamic_cast<const InputImageType *>(ProcessObject::GetInput(0));
 
-  voronoiMap->SetLargestPossibleRegion(inputImage->GetLargestPossibleRegion());
-
-  voronoiMap->SetBufferedRegion(inputImage->GetBufferedRegion());
-
-  voronoiMap->SetRequestedRegion(inputImage->GetRequestedRegion());
-
-  voronoiMap->Allocate();
+  const auto allocate = [&inputImage](ImageBase<InputImageDimension> * image) {
+    image->SetLargestPossibleRegion(inputImage->GetLargestPossibleRegion());
+    image->SetBufferedRegion(inputImage->GetBufferedRegion());
+    image->SetRequestedRegion(inputImage->GetRequestedRegion());
+    image->Allocate();
+  };
 
-  OutputImagePointer distanceMap = this->GetDistanceMap();
+  allocate(this->GetDistanceMap());
 
-  distanceMap->SetLargestPossibleRegion(inputImage->GetLargestPossibleRegion());
-
-  distanceMap->SetBufferedRegion(inputImage->GetBufferedRegion());
-
-  distanceMap->SetRequestedRegion(inputImage->GetRequestedRegion());
+  VoronoiImagePointer voronoiMap = this->GetVoronoiMap();
+  if (m_GenerateVoronoiMap)
+  {
+    allocate(voronoiMap);
+  }
 
-  distanceMap->Allocate();
+  // the vectors to the closest object pixels are needed for the Voronoi map
+  // even when the vector map is not generated
+  m_Components = nullptr;
+  m_SquaredDistances = nullptr;
+  if (m_GenerateVectorDistanceMap)
+  {
+    m_Components = this->GetVectorDistanceMap();
+    allocate(m_Components);
+  }
+  else if (m_GenerateVoronoiMap)
+  {
+    m_Components = VectorImageType::New();
+    allocate(m_Components);
+  }
+  else
+  {
+    m_SquaredDistances = DistanceImageType::New();
+    allocate(m_SquaredDistances);
+  }
 
-  typename OutputImageType::RegionType region = voronoiMap->GetRequestedRegion();
+  const RegionType region = inputImage->GetRequestedRegion();
 
   // find the largest of the image dimensions
   SizeType      size = region.GetSize();
@@ -125,177 +142,252 @@ DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::Prep
       maxLength = size[dim];
     }
   }
-
-  ImageRegionConstIteratorWithIndex<InputImageType> it(inputImage, region);
-  ImageRegionIteratorWithIndex<VoronoiImageType>    ot(voronoiMap, region);
-
-  it.GoToBegin();
-  ot.GoToBegin();
-
-  itkDebugMacro(<< "PrepareData: Copy input to output");
-  if (m_InputIsBinary)
-  {
-    VoronoiPixelType npt = 1;
-    while (!ot.IsAtEnd())
-    {
-      if (it.Get())
+  m_MaximumComponent = 2 * maxLength;
+
+  // Wherever the input image is non-zero, the pixel is its own closest
+  // object pixel. The other pixels have no closest object pixel yet.
+  itkDebugMacro(<< "PrepareData: Initialize the outputs");
+  ProgressTransformer progress(0.0f, 0.1f, this);
+  this->GetMultiThreader()->template ParallelizeImageRegion<InputImageDimension>(
+    region,
+    [this, &inputImage, voronoiMap](const RegionType & threadRegion) {
+      OffsetType maxValue;
+      maxValue.Fill(m_MaximumComponent);
+      const OffsetType minValue{};
+
+      ImageRegionConstIterator<InputImageType> it(inputImage, threadRegion);
+      if (m_GenerateVoronoiMap)
       {
-        ot.Set(npt);
+        ImageRegionIterator<VoronoiImageType> ot(voronoiMap, threadRegion);
+        for (it.GoToBegin(); !it.IsAtEnd(); ++it, ++ot)
+        {
+          if (m_InputIsBinary)
+          {
+            ot.Set(it.Get() ? 1 : 0);
+          }
+          else
+          {
+            ot.Set(static_cast<VoronoiPixelType>(it.Get()));
+          }
+        }
+      }
+      if (m_Components)
+      {
+        ImageRegionIterator<VectorImageType> ct(m_Components, threadRegion);
+        for (it.GoToBegin(); !it.IsAtEnd(); ++it, ++ct)
+        {
+          ct.Set(it.Get() ? minValue : maxValue);
+        }
       }
       else
       {
-        ot.Set(0);
+        ImageRegionIterator<DistanceImageType> dt(m_SquaredDistances, threadRegion);
+        for (it.GoToBegin(); !it.IsAtEnd(); ++it, ++dt)
+        {
+          dt.Set(it.Get() ? 0.0 : NumericTraits<double>::max());
+        }
       }
-      ++it;
-      ++ot;
-    }
-  }
-  else
-  {
-    while (!ot.IsAtEnd())
-    {
-      ot.Set(static_cast<VoronoiPixelType>(it.Get()));
-      ++it;
-      ++ot;
-    }
-  }
-
-  VectorImagePointer distanceComponents = GetVectorDistanceMap();
-
-  distanceComponents->SetLargestPossibleRegion(inputImage->GetLargestPossibleRegion());
+    },
+    progress.GetProcessObject());
+  itkDebugMacro(<< "PrepareData End");
+}
 
-  distanceComponents->SetBufferedRegion(inputImage->GetBufferedRegion());
+template <typename TInputImage, typename TOutputImage, typename TVoronoiImage>
+void
+DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::ComputeVoronoiMap()
+{
+  itkDebugMacro(<< "ComputeVoronoiMap Start");
+  VoronoiImagePointer voronoiMap = this->GetVoronoiMap();
+  OutputImagePointer  distanceMap = this->GetDistanceMap();
 
-  distanceComponents->SetRequestedRegion(inputImage->GetRequestedRegion());
+  const RegionType region = distanceMap->GetRequestedRegion();
+  itkDebugMacro(<< "ComputeVoronoiMap Region: " << region);
 
-  distanceComponents->Allocate();
+  OffsetType maxValue;
+  maxValue.Fill(m_MaximumComponent);
+  const double maxSquaredDistance = this->SquaredLength(maxValue);
+
+  ProgressTransformer progress(0.9f, 1.0f, this);
+  this->GetMultiThreader()->template ParallelizeImageRegion<InputImageDimension>(
+    region,
+    [&](const RegionType & threadRegion) {
+      ImageRegionIteratorWithIndex<OutputImageType> dt(distanceMap, threadRegion);
+      for (; !dt.IsAtEnd(); ++dt)
+      {
+        double distance = 0.0;
+        if (m_Components)
+        {
+          const OffsetType & distanceVector = m_Components->GetPixel(dt.GetIndex());
+          distance = this->SquaredLength(distanceVector);
+
+          // the object pixels are their own closest object pixel, so they
+          // are only read
+          const IndexType index = dt.GetIndex() + distanceVector;
+          if (m_GenerateVoronoiMap && distanceVector != OffsetType{} && region.IsInside(index))
+          {
+            voronoiMap->SetPixel(dt.GetIndex(), voronoiMap->GetPixel(index));
+          }
+        }
+        else
+        {
+          distance = m_SquaredDistances->GetPixel(dt.GetIndex());
+          if (distance == NumericTraits<double>::max())
+          {
+            distance = maxSquaredDistance;
+          }
+        }
 
-  ImageRegionIteratorWithIndex<VectorImageType> ct(distanceComponents, region);
+        if (m_SquaredDistance)
+        {
+          dt.Set(static_cast<OutputPixelType>(distance));
+        }
+        else
+        {
+          dt.Set(static_cast<OutputPixelType>(std::sqrt(distance)));
+        }
+      }
+    },
+    progress.GetProcessObject());
 
-  OffsetType maxValue;
-  OffsetType minValue;
+  // the working images are not needed anymore
+  m_Components = nullptr;
+  m_SquaredDistances = nullptr;
+  itkDebugMacro(<< "ComputeVoronoiMap End");
+}
 
-  for (unsigned int j = 0; j < InputImageDimension; ++j)
+template <typename TInputImage, typename TOutputImage, typename TVoronoiImage>
+double
+DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::SquaredLength(
+  const OffsetType & vector) const
+{
+  double length = 0.0;
+  for (unsigned int i = 0; i < InputImageDimension; ++i)
   {
-    maxValue[j] = 2 * maxLength;
-    minValue[j] = 0;
+    const double component = vector[i] * static_cast<double>(m_Weights[i]);
+    length += component * component;
   }
+  return length;
+}
 
-  itkDebugMacro(<< "PrepareData: Copy output to ct");
-
-  // Iterate over the input image and distanceComponents image.
-  // Wherever the input image is non-zero, initialize the distanceComponents image to the minValue.
-  // Wherever the input image is zero, initialize the distanceComponents image to the maxValue.
-  it.GoToBegin();
-  ct.GoToBegin();
-  while (!it.IsAtEnd())
+template <typename TInputImage, typename TOutputImage, typename TVoronoiImage>
+void
+DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::AddParabola(
+  LowerEnvelope & envelope,
+  SizeValueType & numberOfParabolas,
+  double          position,
+  double          value)
+{
+  double begin = NumericTraits<double>::NonpositiveMin();
+  while (numberOfParabolas > 0)
   {
-    if (it.Get())
-    {
-      ct.Set(minValue);
-    }
-    else
+    // the new parabola is below the last one from their intersection
+    const SizeValueType l = numberOfParabolas - 1;
+    begin = ((value + position * position) - (envelope.value[l] + envelope.position[l] * envelope.position[l])) /
+            (2.0 * (position - envelope.position[l]));
+    if (begin > envelope.begin[l])
     {
-      ct.Set(maxValue);
+      break;
     }
-    ++it;
-    ++ct;
+    --numberOfParabolas;
+    begin = NumericTraits<double>::NonpositiveMin();
   }
-  itkDebugMacro(<< "PrepareData End");
+  envelope.position[numberOfParabolas] = position;
+  envelope.value[numberOfParabolas] = value;
+  envelope.begin[numberOfParabolas] = begin;
 }
 
 template <typename TInputImage, typename TOutputImage, typename TVoronoiImage>
 void
-DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::ComputeVoronoiMap()
+DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::UpdateVectorLine(unsigned int      d,
+                                                                                             const IndexType & index,
+                                                                                             LowerEnvelope & envelope)
 {
-  itkDebugMacro(<< "ComputeVoronoiMap Start");
-  VoronoiImagePointer voronoiMap = this->GetVoronoiMap();
-  OutputImagePointer  distanceMap = this->GetDistanceMap();
-  VectorImagePointer  distanceComponents = this->GetVectorDistanceMap();
-
-  typename OutputImageType::RegionType region = voronoiMap->GetRequestedRegion();
-
-  ImageRegionIteratorWithIndex<VoronoiImageType> ot(voronoiMap, region);
-  ImageRegionIteratorWithIndex<VectorImageType>  ct(distanceComponents, region);
-  ImageRegionIteratorWithIndex<OutputImageType>  dt(distanceMap, region);
-
-  itkDebugMacro(<< "ComputeVoronoiMap Region: " << region);
-  ot.GoToBegin();
-  ct.GoToBegin();
-  dt.GoToBegin();
-  while (!ot.IsAtEnd())
+  const SizeValueType   length = m_Components->GetRequestedRegion().GetSize(d);
+  const OffsetValueType stride = m_Components->GetOffsetTable()[d];
+  OffsetType *          line = m_Components->GetBufferPointer() + m_Components->ComputeOffset(index);
+  const double          weight = m_Weights[d];
+
+  envelope.position.resize(length);
+  envelope.value.resize(length);
+  envelope.begin.resize(length);
+  envelope.pixel.resize(length);
+  envelope.vector.resize(length);
+
+  // the component d of the vectors is zero before this pass
+  SizeValueType numberOfParabolas = 0;
+  for (SizeValueType i = 0; i < length; ++i)
   {
-    IndexType index = ct.GetIndex() + ct.Get();
-    if (region.IsInside(index))
+    const OffsetType & vector = line[i * stride];
+    if (vector[0] == m_MaximumComponent)
     {
-      ot.Set(voronoiMap->GetPixel(index));
+      continue;
     }
+    AddParabola(envelope, numberOfParabolas, i * weight, this->SquaredLength(vector));
+    envelope.pixel[numberOfParabolas] = i;
+    envelope.vector[numberOfParabolas] = vector;
+    ++numberOfParabolas;
+  }
 
-    OffsetType distanceVector = ct.Get();
-    double     distance = 0.0;
-    if (m_UseImageSpacing)
-    {
-      for (unsigned int i = 0; i < InputImageDimension; ++i)
-      {
-        double component = distanceVector[i] * static_cast<double>(m_InputSpacingCache[i]);
-        distance += component * component;
-      }
-    }
-    else
-    {
-      for (unsigned int i = 0; i < InputImageDimension; ++i)
-      {
-        distance += distanceVector[i] * distanceVector[i];
-      }
-    }
+  if (numberOfParabolas == 0)
+  {
+    return;
+  }
 
-    if (m_SquaredDistance)
-    {
-      dt.Set(static_cast<OutputPixelType>(distance));
-    }
-    else
+  SizeValueType l = 0;
+  for (SizeValueType i = 0; i < length; ++i)
+  {
+    while (l + 1 < numberOfParabolas && envelope.begin[l + 1] < i * weight)
     {
-      dt.Set(static_cast<OutputPixelType>(std::sqrt(distance)));
+      ++l;
     }
-    ++ot;
-    ++ct;
-    ++dt;
+    OffsetType vector = envelope.vector[l];
+    vector[d] = static_cast<OffsetValueType>(envelope.pixel[l]) - static_cast<OffsetValueType>(i);
+    line[i * stride] = vector;
   }
-  itkDebugMacro(<< "ComputeVoronoiMap End");
 }
 
 template <typename TInputImage, typename TOutputImage, typename TVoronoiImage>
 void
-DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::UpdateLocalDistance(
-  VectorImageType *  components,
-  const IndexType &  here,
-  const OffsetType & offset)
+DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::UpdateDistanceLine(
+  unsigned int      d,
+  const IndexType & index,
+  LowerEnvelope &   envelope)
 {
-  IndexType  there = here + offset;
-  OffsetType offsetValueHere = components->GetPixel(here);
-  OffsetType offsetValueThere = components->GetPixel(there) + offset;
+  const SizeValueType   length = m_SquaredDistances->GetRequestedRegion().GetSize(d);
+  const OffsetValueType stride = m_SquaredDistances->GetOffsetTable()[d];
+  double *              line = m_SquaredDistances->GetBufferPointer() + m_SquaredDistances->ComputeOffset(index);
+  const double          weight = m_Weights[d];
 
-  double norm1 = 0.0;
-  double norm2 = 0.0;
-  for (unsigned int i = 0; i < InputImageDimension; ++i)
-  {
-    auto v1 = static_cast<double>(offsetValueHere[i]);
-    auto v2 = static_cast<double>(offsetValueThere[i]);
+  envelope.position.resize(length);
+  envelope.value.resize(length);
+  envelope.begin.resize(length);
 
-    if (m_UseImageSpacing)
+  SizeValueType numberOfParabolas = 0;
+  for (SizeValueType i = 0; i < length; ++i)
+  {
+    const double value = line[i * stride];
+    if (value == NumericTraits<double>::max())
     {
-      auto spacingComponent = static_cast<double>(m_InputSpacingCache[i]);
-      v1 *= spacingComponent;
-      v2 *= spacingComponent;
+      continue;
     }
+    AddParabola(envelope, numberOfParabolas, i * weight, value);
+    ++numberOfParabolas;
+  }
 
-    norm1 += v1 * v1;
-    norm2 += v2 * v2;
+  if (numberOfParabolas == 0)
+  {
+    return;
   }
 
-  if (norm1 > norm2)
+  SizeValueType l = 0;
+  for (SizeValueType i = 0; i < length; ++i)
   {
-    components->SetPixel(here, offsetValueThere);
+    const double position = i * weight;
+    while (l + 1 < numberOfParabolas && envelope.begin[l + 1] < position)
+    {
+      ++l;
+    }
+    line[i * stride] = envelope.value[l] + (position - envelope.position[l]) * (position - envelope.position[l]);
   }
 }
 
@@ -303,107 +395,46 @@ template <typename TInputImage, typename TOutputImage, typename TVoronoiImage>
 void
 DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::GenerateData()
 {
-  this->PrepareData();
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
   this->m_InputSpacingCache = this->GetInput()->GetSpacing();
-
-  // Specify images and regions.
-
-  VoronoiImagePointer voronoiMap = this->GetVoronoiMap();
-  VectorImagePointer  distanceComponents = this->GetVectorDistanceMap();
-
-  RegionType region = voronoiMap->GetRequestedRegion();
-
-  itkDebugMacro(<< "Region to process: " << region);
-
-  // Instantiate reflective iterator
-
-  ReflectiveImageRegionConstIterator<VectorImageType> it(distanceComponents, region);
-
-  typename VectorImageType::OffsetType voffset;
-  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
-  {
-    if (region.GetSize()[dim] > 1)
-    {
-      voffset[dim] = 1;
-    }
-    else
-    {
-      voffset[dim] = 0;
-    }
-  }
-  it.SetBeginOffset(voffset);
-  it.SetEndOffset(voffset);
-  it.GoToBegin();
-
-  // Set up an iterator for the input image.
-  // In this image, non-zero values are the background and zero values are the foreground.
-  // The foreground values are where the distance map should be solved.
-  // We iterate over this input image so that all background (non-zero) values are ignored in the
-  // distance map computation.
-  InputImagePointer inputImage = dynamic_cast<const InputImageType *>(ProcessObject::GetInput(0));
-  ReflectiveImageRegionConstIterator<const InputImageType> inputIt(inputImage, region);
-  inputIt.SetBeginOffset(voffset);
-  inputIt.SetEndOffset(voffset);
-  inputIt.GoToBegin();
-
-  // Support progress methods/callbacks.
-
-  // Each pixel is visited 2^InputImageDimension times, and the number
-  // of visits per pixel needs to be computed for progress reporting.
-  SizeValueType visitsPerPixel = (1 << InputImageDimension);
-  SizeValueType updateVisits = region.GetNumberOfPixels() * visitsPerPixel / 10;
-  if (updateVisits < 1)
+  for (unsigned int i = 0; i < InputImageDimension; ++i)
   {
-    updateVisits = 1;
+    m_Weights[i] = m_UseImageSpacing ? m_InputSpacingCache[i] : 1.0;
   }
-  const float updatePeriod = static_cast<float>(updateVisits) * 10.0;
-
-  // Process image.
 
-  OffsetType offset;
-  offset.Fill(0);
+  this->PrepareData();
 
-  SizeValueType i = 0;
+  const RegionType region = this->GetDistanceMap()->GetRequestedRegion();
+  itkDebugMacro(<< "Region to process: " << region);
 
+  // Process the lines along each dimension in turn. The lines along a
+  // dimension are independent, so they are distributed over the work units.
   itkDebugMacro(<< "GenerateData: Computing distance transform");
-  while (!it.IsAtEnd())
+  const float progressPerDimension = 0.8f / static_cast<float>(InputImageDimension);
+  for (unsigned int d = 0; d < InputImageDimension; ++d)
   {
-    if (!(i % updateVisits))
-    {
-      this->UpdateProgress(static_cast<float>(i) / updatePeriod);
-    }
-
-    // The background is the region from which we are growing.
-    // The region we want to solve for is the foreground.
-    // The background pixels are set to a non-zero value.
-    // We can ignore these pixels in the update step.
-    if (!inputIt.Get())
-    {
-      IndexType here = it.GetIndex();
-      for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
-      {
-        if (region.GetSize()[dim] <= 1)
-        {
-          continue;
-        }
-        if (it.IsReflected(dim))
-        {
-          offset[dim]++;
-          UpdateLocalDistance(distanceComponents, here, offset);
-          offset[dim] = 0;
-        }
-        else
+    RegionType lines = region;
+    lines.SetSize(d, 1);
+
+    ProgressTransformer progress(0.1f + d * progressPerDimension, 0.1f + (d + 1) * progressPerDimension, this);
+    this->GetMultiThreader()->template ParallelizeImageRegion<InputImageDimension>(
+      lines,
+      [this, d](const RegionType & threadRegion) {
+        LowerEnvelope envelope;
+        for (const IndexType & index : ImageRegionIndexRange<InputImageDimension>(threadRegion))
         {
-          offset[dim]--;
-          UpdateLocalDistance(distanceComponents, here, offset);
-          offset[dim] = 0;
+          if (m_Components)
+          {
+            this->UpdateVectorLine(d, index, envelope);
+          }
+          else
+          {
+            this->UpdateDistanceLine(d, index, envelope);
+          }
         }
-      }
-    }
-    ++it;
-    ++i;
-    ++inputIt;
+      },
+      progress.GetProcessObject());
   }
 
   itkDebugMacro(<< "GenerateData: ComputeVoronoiMap");
@@ -422,6 +453,8 @@ DanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>::Prin
   os << indent << "Input Is Binary   : " << m_InputIsBinary << std::endl;
   os << indent << "Use Image Spacing : " << m_UseImageSpacing << std::endl;
   os << indent << "Squared Distance  : " << m_SquaredDistance << std::endl;
+  os << indent << "Generate Voronoi Map : " << m_GenerateVoronoiMap << std::endl;
+  os << indent << "Generate Vector Distance Map : " << m_GenerateVectorDistanceMap << std::endl;
 }
 } // end namespace itk
 
@@ -118,6 +118,12 @@ SignedDanielssonDistanceMapImageFilter<TInputImage, TOutputImage, TVoronoiImage>
   filter2->SetUseImageSpacing(m_UseImageSpacing);
   filter1->SetSquaredDistance(m_SquaredDistance);
   filter2->SetSquaredDistance(m_SquaredDistance);
+  filter1->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  filter2->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  // only the distance map of the inverted image is used
+  filter2->GenerateVoronoiMapOff();
+  filter2->GenerateVectorDistanceMapOff();
 
   // Invert input image for second Danielsson filter
   using InputPixelType = typename InputImageType::PixelType;
@@ -20,6 +20,8 @@
 
 #include "itkImageToImageFilter.h"
 
+#include <vector>
+
 namespace itk
 {
 /**
@@ -50,12 +52,29 @@ namespace itk
  *  the itk::DanielssonDistanceImageFilter class except it does not return
  *  the Voronoi map.
  *
- *  Reference:
+ *  \par Feature image
+ *  When ComputeFeatureImage is on, the second output, GetFeatureImage(),
+ *  holds for each pixel the index of the closest pixel of the boundary of
+ *  the object, which is the pixel the distance is measured to. It is not
+ *  computed by default.
+ *
+ *  \par Implementation
+ *  The distance is computed one dimension after the other. In each pass,
+ *  the lower envelope of the parabolas rooted at the pixels of a line which
+ *  have a distance is computed with the algorithm of Felzenszwalb and
+ *  Huttenlocher, which is equivalent to the partial Voronoi diagram
+ *  construction of Maurer et al. The lines of a pass are distributed over
+ *  the work units, so all the passes are parallel.
+ *
+ *  References:
  *  C. R. Maurer, Jr., R. Qi, and V. Raghavan, "A Linear Time Algorithm
  *  for Computing Exact Euclidean Distance Transforms of Binary Images in
  *  Arbitrary Dimensions", IEEE - Transactions on Pattern Analysis and
  *  Machine Intelligence, 25(2): 265-270, 2003.
  *
+ *  P. F. Felzenszwalb and D. P. Huttenlocher, "Distance Transforms of
+ *  Sampled Functions", Theory of Computing, 8(19): 415-428, 2012.
+ *
  * \ingroup ImageFeatureExtraction
  * \ingroup ITKDistanceMap
  *
@@ -115,6 +134,10 @@ public:
   using OutputSpacingType = typename OutputImageType::SpacingType;
   using OutputImageRegionType = typename OutputImageType::RegionType;
 
+  /** Type of the image of the indices of the closest boundary pixels. */
+  using FeatureImageType = Image<OutputIndexType, OutputImageDimension>;
+  using FeatureImagePointer = typename FeatureImageType::Pointer;
+
   /** Set if the distance should be squared. */
   itkSetMacro(SquaredDistance, bool);
 
@@ -153,6 +176,16 @@ public:
   itkSetMacro(BackgroundValue, InputPixelType);
   itkGetConstReferenceMacro(BackgroundValue, InputPixelType);
 
+  /** Set/Get whether the feature image is computed. Default is false. */
+  itkSetMacro(ComputeFeatureImage, bool);
+  itkGetConstReferenceMacro(ComputeFeatureImage, bool);
+  itkBooleanMacro(ComputeFeatureImage);
+
+  /** Get the image of the indices of the closest boundary pixels. It is only
+   * computed when ComputeFeatureImage is on. */
+  FeatureImageType *
+  GetFeatureImage();
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(IntConvertibleToInputCheck, (Concept::Convertible<int, InputPixelType>));
@@ -168,34 +201,39 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
+  using Superclass::MakeOutput;
+  DataObject::Pointer
+  MakeOutput(DataObjectPointerArraySizeType idx) override;
+
   void
   GenerateData() override;
 
-  unsigned int
-  SplitRequestedRegion(unsigned int i, unsigned int num, OutputImageRegionType & splitRegion) override;
-
-  void
-  ThreadedGenerateData(const OutputImageRegionType &, ThreadIdType) override;
+private:
+  using RealType = typename NumericTraits<OutputPixelType>::RealType;
 
-  void
-  DynamicThreadedGenerateData(const OutputImageRegionType &) override
+  /** The lower envelope of the parabolas of a line: the position of their
+   * apex, their value at the apex, the position from which they are in the
+   * envelope, and the index of their closest boundary pixel. */
+  struct LowerEnvelope
   {
-    itkExceptionMacro("This class requires threadId so it must use classic multi-threading model");
-  }
+    std::vector<RealType>        position;
+    std::vector<RealType>        value;
+    std::vector<RealType>        begin;
+    std::vector<OutputIndexType> feature;
+  };
 
-private:
+  /** Compute the distance along dimension d for the line starting at idx. */
   void
-       Voronoi(unsigned int, OutputIndexType idx, OutputImageType * output);
-  bool Remove(OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType);
+  Voronoi(unsigned int d, const OutputIndexType & idx, OutputImageType * output, LowerEnvelope & envelope);
 
   InputPixelType   m_BackgroundValue;
   InputSpacingType m_Spacing;
 
-  unsigned int m_CurrentDimension{ 0 };
-
   bool m_InsideIsPositive{ false };
   bool m_UseImageSpacing{ true };
   bool m_SquaredDistance{ false };
+  bool m_ComputeFeatureImage{ false };
 
   const InputImageType * m_InputCache;
 };
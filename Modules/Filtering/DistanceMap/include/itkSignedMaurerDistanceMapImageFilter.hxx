@@ -18,14 +18,11 @@
 #ifndef itkSignedMaurerDistanceMapImageFilter_hxx
 #define itkSignedMaurerDistanceMapImageFilter_hxx
 
-#include "itkImageRegionIteratorWithIndex.h"
-#include "itkImageRegionIterator.h"
 #include "itkBinaryThresholdImageFilter.h"
 #include "itkBinaryContourImageFilter.h"
-#include "itkProgressReporter.h"
+#include "itkIndexRange.h"
 #include "itkProgressAccumulator.h"
-#include "itkMath.h"
-#include "vnl/vnl_vector.h"
+#include "itkProgressTransformer.h"
 #include "itkMath.h"
 
 namespace itk
@@ -36,65 +33,26 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::SignedMaurerDista
   , m_Spacing(0.0)
   , m_InputCache(nullptr)
 {
-  this->DynamicMultiThreadingOff();
+  this->SetNumberOfRequiredOutputs(2);
+  this->SetNthOutput(1, this->MakeOutput(1));
 }
 
 template <typename TInputImage, typename TOutputImage>
-unsigned int
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::SplitRequestedRegion(unsigned int            i,
-                                                                                    unsigned int            num,
-                                                                                    OutputImageRegionType & splitRegion)
+DataObject::Pointer
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::MakeOutput(DataObjectPointerArraySizeType idx)
 {
-  // Get the output pointer
-  OutputImageType * outputPtr = this->GetOutput();
-
-  // Initialize the splitRegion to the output requested region
-  splitRegion = outputPtr->GetRequestedRegion();
-
-  const OutputSizeType & requestedRegionSize = splitRegion.GetSize();
-
-  OutputIndexType splitIndex = splitRegion.GetIndex();
-  OutputSizeType  splitSize = splitRegion.GetSize();
-
-  // split on the outermost dimension available
-  // and avoid the current dimension
-  int splitAxis = static_cast<int>(outputPtr->GetImageDimension()) - 1;
-  while ((requestedRegionSize[splitAxis] == 1) || (splitAxis == static_cast<int>(m_CurrentDimension)))
+  if (idx == 1)
   {
-    --splitAxis;
-    if (splitAxis < 0)
-    { // cannot split
-      itkDebugMacro("Cannot Split");
-      return 1;
-    }
+    return FeatureImageType::New().GetPointer();
   }
+  return Superclass::MakeOutput(idx);
+}
 
-  // determine the actual number of pieces that will be generated
-  auto range = static_cast<double>(requestedRegionSize[splitAxis]);
-
-  auto         valuesPerThread = static_cast<unsigned int>(std::ceil(range / static_cast<double>(num)));
-  unsigned int maxThreadIdUsed = static_cast<unsigned int>(std::ceil(range / static_cast<double>(valuesPerThread))) - 1;
-
-  // Split the region
-  if (i < maxThreadIdUsed)
-  {
-    splitIndex[splitAxis] += i * valuesPerThread;
-    splitSize[splitAxis] = valuesPerThread;
-  }
-  if (i == maxThreadIdUsed)
-  {
-    splitIndex[splitAxis] += i * valuesPerThread;
-    // last thread needs to process the "rest" dimension being split
-    splitSize[splitAxis] = splitSize[splitAxis] - i * valuesPerThread;
-  }
-
-  // set the split region ivars
-  splitRegion.SetIndex(splitIndex);
-  splitRegion.SetSize(splitSize);
-
-  itkDebugMacro("Split Piece: " << splitRegion);
-
-  return maxThreadIdUsed + 1;
+template <typename TInputImage, typename TOutputImage>
+auto
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::GetFeatureImage() -> FeatureImageType *
+{
+  return dynamic_cast<FeatureImageType *>(this->ProcessObject::GetOutput(1));
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -107,10 +65,23 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::GenerateData()
   const InputImageType * inputPtr = this->GetInput();
   m_InputCache = this->GetInput();
 
-  // prepare the data
-  this->AllocateOutputs();
+  // prepare the data; the feature image is only allocated when it is
+  // computed, and has an empty buffered region otherwise
+  outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
+  outputPtr->Allocate();
   this->m_Spacing = outputPtr->GetSpacing();
 
+  FeatureImageType * featureImage = this->GetFeatureImage();
+  if (m_ComputeFeatureImage)
+  {
+    featureImage->SetBufferedRegion(featureImage->GetRequestedRegion());
+    featureImage->Allocate();
+  }
+  else
+  {
+    featureImage->Initialize();
+  }
+
   // store the binary image in an image with a pixel type as small as possible
   // instead of keeping the native input pixel type to avoid using too much
   // memory.
@@ -147,305 +118,148 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::GenerateData()
   borderFilter->Update();
 
   this->GraftOutput(borderFilter->GetOutput());
+  outputPtr = this->GetOutput();
 
-  // Set up the multithreaded processing
-  typename ImageSource<OutputImageType>::ThreadStruct str;
-  str.Filter = this;
-
-  this->GetMultiThreader()->SetNumberOfWorkUnits(numberOfWorkUnits);
-  this->GetMultiThreader()->SetSingleMethod(this->ThreaderCallback, &str);
+  // process the lines along each dimension in turn; the lines along a
+  // dimension are independent, so they are distributed over the work units
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
 
-  // multithread the execution
+  const OutputRegionType requestedRegion = outputPtr->GetRequestedRegion();
+  const float            progressPerDimension = 0.67f / static_cast<float>(ImageDimension);
   for (unsigned int d = 0; d < ImageDimension; ++d)
   {
-    m_CurrentDimension = d;
-    this->GetMultiThreader()->SingleMethodExecute();
+    OutputRegionType lines = requestedRegion;
+    lines.SetSize(d, 1);
+
+    ProgressTransformer progress(0.33f + d * progressPerDimension, 0.33f + (d + 1) * progressPerDimension, this);
+    multiThreader->template ParallelizeImageRegion<ImageDimension>(
+      lines,
+      [this, d, outputPtr](const OutputRegionType & region) {
+        LowerEnvelope envelope;
+        for (const OutputIndexType & index : ImageRegionIndexRange<ImageDimension>(region))
+        {
+          this->Voronoi(d, index, outputPtr, envelope);
+        }
+      },
+      progress.GetProcessObject());
   }
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
-  const OutputImageRegionType & outputRegionForThread,
-  ThreadIdType                  threadId)
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned int            d,
+                                                                       const OutputIndexType & idx,
+                                                                       OutputImageType *       output,
+                                                                       LowerEnvelope &         envelope)
 {
-  OutputImageType * outputImage = this->GetOutput();
-
-  InputRegionType region = outputRegionForThread;
-  InputSizeType   size = region.GetSize();
-  InputIndexType  startIndex = outputRegionForThread.GetIndex();
-
-  OutputImageType * outputPtr = this->GetOutput();
-
-  // compute the number of rows first, so we can setup a progress reporter
-  std::vector<InputSizeValueType> NumberOfRows;
-  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  const OutputSizeValueType nd = output->GetRequestedRegion().GetSize(d);
+  const OffsetValueType     stride = output->GetOffsetTable()[d];
+  OutputPixelType *         line = output->GetBufferPointer() + output->ComputeOffset(idx);
+
+  FeatureImageType * featureImage = m_ComputeFeatureImage ? this->GetFeatureImage() : nullptr;
+  OutputIndexType *  featureLine = nullptr;
+  OffsetValueType    featureStride = 0;
+  if (featureImage)
   {
-    NumberOfRows.push_back(1);
-    for (unsigned int d = 0; d < InputImageDimension; ++d)
-    {
-      if (d != i)
-      {
-        NumberOfRows[i] *= size[d];
-      }
-    }
+    featureLine = featureImage->GetBufferPointer() + featureImage->ComputeOffset(idx);
+    featureStride = featureImage->GetOffsetTable()[d];
   }
 
-  // set the progress reporter. Use a pointer to be able to destroy it before
-  // the creation of progress2
-  // so it won't set wrong progress at the end of ThreadedGenerateData()
-  float progressPerDimension = 0.67f / static_cast<float>(ImageDimension);
-  if (!this->m_SquaredDistance)
-  {
-    progressPerDimension = 0.67f / (static_cast<float>(ImageDimension) + 1);
-  }
-  auto progress =
-    std::make_unique<ProgressReporter>(this,
-                                       threadId,
-                                       NumberOfRows[m_CurrentDimension],
-                                       30,
-                                       0.33f + static_cast<float>(m_CurrentDimension * progressPerDimension),
-                                       progressPerDimension);
+  const RealType spacing = this->GetUseImageSpacing() ? static_cast<RealType>(this->m_Spacing[d]) : 1.0;
 
-  // This variable provides the amount by which to divide the dimensionless index in order to get the index for each
-  // dimension.
-  vnl_vector<unsigned int> k(InputImageDimension - 1);
-  unsigned int             count = 0;
-  k[count] = 1;
-  for (unsigned int d = m_CurrentDimension + InputImageDimension - 1; d > m_CurrentDimension + 1; d--)
-  {
-    k[count + 1] = k[count] * size[d % InputImageDimension];
-    count++;
-  }
-  k.flip();
+  envelope.position.resize(nd);
+  envelope.value.resize(nd);
+  envelope.begin.resize(nd);
+  envelope.feature.resize(featureImage ? nd : 0);
 
-  // The index is defined as the dimensionless index into the pixel.
-  // It must be divided by each dimension size in order to get the index for that dimension.
-  // The result of this division is the offsetIndex, which is the index offset relative to the region of this thread.
-  // The true pixel location (idx) is provided by the sum of the offsetIndex and the startIndex.
-  InputSizeValueType index;
-  OutputIndexType    offsetIndex;
-  offsetIndex.Fill(0);
-  InputSizeValueType tempRow = NumberOfRows[m_CurrentDimension];
-  OutputIndexType    idx;
-  idx.Fill(0);
-
-  for (InputSizeValueType n = 0; n < tempRow; ++n)
+  // build the lower envelope of the parabolas rooted at the pixels which
+  // already have a distance, removing the ones hidden by the new parabola
+  SizeValueType numberOfParabolas = 0;
+  for (OutputSizeValueType i = 0; i < nd; ++i)
   {
-    index = n;
-    count = 0;
-    for (unsigned int d = m_CurrentDimension + 1; d < m_CurrentDimension + InputImageDimension; ++d)
+    const OutputPixelType di = line[i * stride];
+    if (Math::ExactlyEquals(di, NumericTraits<OutputPixelType>::max()))
     {
-      offsetIndex[d % InputImageDimension] =
-        static_cast<OutputIndexValueType>(static_cast<double>(index) / static_cast<double>(k[count]));
-      idx[d % InputImageDimension] =
-        offsetIndex[d % InputImageDimension] + static_cast<OutputIndexValueType>(startIndex[d % InputImageDimension]);
-
-      index %= k[count];
-      count++;
+      continue;
     }
-    this->Voronoi(m_CurrentDimension, idx, outputImage);
-    progress->CompletedPixel();
-  }
-  progress.reset();
-
-  if (m_CurrentDimension == ImageDimension - 1 && !this->m_SquaredDistance)
-  {
-    using OutputIterator = ImageRegionIterator<OutputImageType>;
-    using InputIterator = ImageRegionConstIterator<InputImageType>;
-
-    typename OutputImageType::RegionType outputRegion = outputRegionForThread;
-
-    OutputIterator Ot(outputPtr, outputRegion);
-    InputIterator  It(m_InputCache, outputRegion);
-
-    Ot.GoToBegin();
-    It.GoToBegin();
-
-    ProgressReporter progress2(this,
-                               threadId,
-                               outputRegionForThread.GetNumberOfPixels(),
-                               30,
-                               0.33f + static_cast<float>(ImageDimension * progressPerDimension),
-                               progressPerDimension);
-
-    using OutputRealType = typename NumericTraits<OutputPixelType>::RealType;
-
-    while (!Ot.IsAtEnd())
+    const RealType iw = static_cast<RealType>(i) * spacing;
+    const RealType value = itk::Math::abs(static_cast<RealType>(di));
+    RealType       begin = NumericTraits<RealType>::NonpositiveMin();
+    while (numberOfParabolas > 0)
     {
-      // cast to a real type is required on some platforms
-      const auto outputValue =
-        static_cast<OutputPixelType>(std::sqrt(static_cast<OutputRealType>(itk::Math::abs(Ot.Get()))));
-
-      if (Math::NotExactlyEquals(It.Get(), this->m_BackgroundValue))
-      {
-        if (this->GetInsideIsPositive())
-        {
-          Ot.Set(outputValue);
-        }
-        else
-        {
-          Ot.Set(-outputValue);
-        }
-      }
-      else
+      // the new parabola is below the last one from their intersection
+      const SizeValueType l = numberOfParabolas - 1;
+      begin = ((value + iw * iw) - (envelope.value[l] + envelope.position[l] * envelope.position[l])) /
+              (2 * (iw - envelope.position[l]));
+      if (begin > envelope.begin[l])
       {
-        if (this->GetInsideIsPositive())
-        {
-          Ot.Set(-outputValue);
-        }
-        else
-        {
-          Ot.Set(outputValue);
-        }
+        break;
       }
-
-      ++Ot;
-      ++It;
-      progress2.CompletedPixel();
+      --numberOfParabolas;
+      begin = NumericTraits<RealType>::NonpositiveMin();
     }
-  }
-}
-
-template <typename TInputImage, typename TOutputImage>
-void
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned int      d,
-                                                                       OutputIndexType   idx,
-                                                                       OutputImageType * output)
-{
-  OutputRegionType    oRegion = output->GetRequestedRegion();
-  OutputSizeValueType nd = oRegion.GetSize()[d];
-
-  vnl_vector<OutputPixelType> g(nd, 0);
-  vnl_vector<OutputPixelType> h(nd, 0);
-
-
-  InputRegionType iRegion = m_InputCache->GetRequestedRegion();
-  InputIndexType  startIndex = iRegion.GetIndex();
-
-  OutputPixelType di;
-
-  int l = -1;
-
-  for (unsigned int i = 0; i < nd; ++i)
-  {
-    idx[d] = i + startIndex[d];
-
-    di = output->GetPixel(idx);
-
-    OutputPixelType iw;
-
-    if (this->GetUseImageSpacing())
-    {
-      iw = static_cast<OutputPixelType>(i) * static_cast<OutputPixelType>(this->m_Spacing[d]);
-    }
-    else
-    {
-      iw = static_cast<OutputPixelType>(i);
-    }
-
-    if (Math::NotExactlyEquals(di, NumericTraits<OutputPixelType>::max()))
+    envelope.position[numberOfParabolas] = iw;
+    envelope.value[numberOfParabolas] = value;
+    envelope.begin[numberOfParabolas] = begin;
+    if (featureImage)
     {
-      if (l < 1)
-      {
-        l++;
-        g(l) = di;
-        h(l) = iw;
-      }
-      else
-      {
-        while ((l >= 1) && this->Remove(g(l - 1), g(l), di, h(l - 1), h(l), iw))
-        {
-          l--;
-        }
-        l++;
-        g(l) = di;
-        h(l) = iw;
-      }
+      // in the first pass, the pixels with a distance are on the boundary
+      OutputIndexType feature = idx;
+      feature[d] += i;
+      envelope.feature[numberOfParabolas] = d == 0 ? feature : featureLine[i * featureStride];
     }
+    ++numberOfParabolas;
   }
 
-  if (l == -1)
+  const bool lastDimension = d == ImageDimension - 1;
+  if (numberOfParabolas == 0 && !(lastDimension && !this->m_SquaredDistance))
   {
     return;
   }
 
-  int ns = l;
-
-  l = 0;
-
-  for (unsigned int i = 0; i < nd; ++i)
+  // the sign and the square root are applied in the last pass
+  const InputPixelType * inputLine = nullptr;
+  OffsetValueType        inputStride = 0;
+  if (lastDimension)
   {
-    OutputPixelType iw;
-
-    if (this->GetUseImageSpacing())
-    {
-      iw = static_cast<OutputPixelType>(i * this->m_Spacing[d]);
-    }
-    else
-    {
-      iw = static_cast<OutputPixelType>(i);
-    }
-
-    OutputPixelType d1 = itk::Math::abs(g(l)) + (h(l) - iw) * (h(l) - iw);
+    inputLine = m_InputCache->GetBufferPointer() + m_InputCache->ComputeOffset(idx);
+    inputStride = m_InputCache->GetOffsetTable()[d];
+  }
 
-    while (l < ns)
+  SizeValueType l = 0;
+  for (OutputSizeValueType i = 0; i < nd; ++i)
+  {
+    RealType d1 = NumericTraits<OutputPixelType>::max();
+    if (numberOfParabolas > 0)
     {
-      // be sure to compute d2 *only* if l < ns
-      OutputPixelType d2 = itk::Math::abs(g(l + 1)) + (h(l + 1) - iw) * (h(l + 1) - iw);
-      // then compare d1 and d2
-      if (d1 <= d2)
+      const RealType iw = static_cast<RealType>(i) * spacing;
+      while (l + 1 < numberOfParabolas && envelope.begin[l + 1] < iw)
       {
-        break;
+        ++l;
+      }
+      d1 = envelope.value[l] + (envelope.position[l] - iw) * (envelope.position[l] - iw);
+      if (featureImage)
+      {
+        featureLine[i * featureStride] = envelope.feature[l];
       }
-      l++;
-      d1 = d2;
     }
-    idx[d] = i + startIndex[d];
 
-    if (Math::NotExactlyEquals(m_InputCache->GetPixel(idx), this->m_BackgroundValue))
+    if (!lastDimension)
     {
-      if (this->m_InsideIsPositive)
-      {
-        output->SetPixel(idx, d1);
-      }
-      else
-      {
-        output->SetPixel(idx, -d1);
-      }
+      line[i * stride] = static_cast<OutputPixelType>(d1);
+      continue;
     }
-    else
+
+    if (!this->m_SquaredDistance)
     {
-      if (this->m_InsideIsPositive)
-      {
-        output->SetPixel(idx, -d1);
-      }
-      else
-      {
-        output->SetPixel(idx, d1);
-      }
+      d1 = std::sqrt(d1);
     }
+    const bool inside = Math::NotExactlyEquals(inputLine[i * inputStride], this->m_BackgroundValue);
+    line[i * stride] = static_cast<OutputPixelType>(inside == this->m_InsideIsPositive ? d1 : -d1);
   }
 }
 
-template <typename TInputImage, typename TOutputImage>
-bool
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Remove(OutputPixelType d1,
-                                                                      OutputPixelType d2,
-                                                                      OutputPixelType df,
-                                                                      OutputPixelType x1,
-                                                                      OutputPixelType x2,
-                                                                      OutputPixelType xf)
-{
-  OutputPixelType a = x2 - x1;
-  OutputPixelType b = xf - x2;
-  OutputPixelType c = xf - x1;
-
-  OutputPixelType value = (c * itk::Math::abs(d2) - b * itk::Math::abs(d1) - a * itk::Math::abs(df) - a * b * c);
-
-  return (value > 0);
-}
-
 /**
  * Standard "PrintSelf" method
  */
@@ -459,6 +273,7 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::PrintSelf(std::os
   os << indent << "Inside is positive: " << this->m_InsideIsPositive << std::endl;
   os << indent << "Use image spacing: " << this->m_UseImageSpacing << std::endl;
   os << indent << "Squared distance: " << this->m_SquaredDistance << std::endl;
+  os << indent << "Compute feature image: " << this->m_ComputeFeatureImage << std::endl;
 }
 } // end namespace itk
 
@@ -0,0 +1,143 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkDanielssonDistanceMapImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+// Compare the outputs of DanielssonDistanceMapImageFilter with the distance
+// to the closest object pixel computed by brute force, with an anisotropic
+// spacing, several work units, and with or without the Voronoi and vector
+// maps.
+
+namespace
+{
+template <unsigned int VDimension>
+int
+TestDistanceMap(const itk::Size<VDimension> & size, const itk::Vector<double, VDimension> & spacing)
+{
+  using InputImageType = itk::Image<unsigned short, VDimension>;
+  using OutputImageType = itk::Image<double, VDimension>;
+  using FilterType = itk::DanielssonDistanceMapImageFilter<InputImageType, OutputImageType>;
+  using IndexType = typename InputImageType::IndexType;
+
+  typename InputImageType::RegionType region;
+  region.SetSize(size);
+  region.SetIndex(0, -2);
+  auto image = InputImageType::New();
+  image->SetRegions(region);
+  image->SetSpacing(spacing);
+  image->Allocate(true);
+
+  // a few labeled object pixels
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(4321);
+  std::vector<IndexType> objects(12);
+  for (unsigned int label = 1; label <= objects.size(); ++label)
+  {
+    IndexType & object = objects[label - 1];
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      object[d] = region.GetIndex(d) + generator->GetIntegerVariate(size[d] - 1);
+    }
+    image->SetPixel(object, label);
+  }
+
+  const auto squaredDistance = [&spacing](const IndexType & a, const IndexType & b) {
+    double distance = 0.0;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      distance += itk::Math::sqr(spacing[d] * static_cast<double>(a[d] - b[d]));
+    }
+    return distance;
+  };
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->UseImageSpacingOn();
+
+  for (const bool generateMaps : { true, false })
+  {
+    for (const unsigned int numberOfWorkUnits : { 1, 3 })
+    {
+      ITK_TEST_SET_GET_BOOLEAN(filter, GenerateVoronoiMap, generateMaps);
+      ITK_TEST_SET_GET_BOOLEAN(filter, GenerateVectorDistanceMap, generateMaps);
+      filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+      for (itk::ImageRegionConstIteratorWithIndex<OutputImageType> it(filter->GetDistanceMap(), region); !it.IsAtEnd();
+           ++it)
+      {
+        const IndexType & index = it.GetIndex();
+        double            expected = itk::NumericTraits<double>::max();
+        for (const auto & object : objects)
+        {
+          expected = std::min(expected, squaredDistance(index, object));
+        }
+        expected = std::sqrt(expected);
+
+        bool valid = itk::Math::abs(it.Get() - expected) < 1e-6;
+        if (generateMaps)
+        {
+          // the vector leads to an object pixel at the distance, whose label is
+          // in the Voronoi map
+          const IndexType closest = index + filter->GetVectorDistanceMap()->GetPixel(index);
+          valid = valid && region.IsInside(closest) && image->GetPixel(closest) != 0 &&
+                  itk::Math::abs(std::sqrt(squaredDistance(index, closest)) - expected) < 1e-6 &&
+                  filter->GetVoronoiMap()->GetPixel(index) == image->GetPixel(closest);
+        }
+        if (!valid)
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "At " << index << " with " << numberOfWorkUnits << " work units: distance " << it.Get()
+                    << " instead of " << expected << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkDanielssonDistanceMapImageFilterBruteForceTest(int, char *[])
+{
+  itk::Size<2>           size2D = { { 41, 23 } };
+  itk::Vector<double, 2> spacing2D;
+  spacing2D[0] = 1.5;
+  spacing2D[1] = 0.8;
+  if (TestDistanceMap(size2D, spacing2D) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  itk::Size<3>           size3D = { { 15, 12, 9 } };
+  itk::Vector<double, 3> spacing3D;
+  spacing3D[0] = 1.0;
+  spacing3D[1] = 2.0;
+  spacing3D[2] = 0.7;
+  if (TestDistanceMap(size3D, spacing3D) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBinaryContourImageFilter.h"
+#include "itkBinaryThresholdImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkSignedMaurerDistanceMapImageFilter.h"
+#include "itkTestingMacros.h"
+
+// Compare the output of SignedMaurerDistanceMapImageFilter with the
+// distance to the closest boundary pixel computed by brute force, with an
+// anisotropic spacing and several work units, and check the feature image.
+
+namespace
+{
+template <unsigned int VDimension>
+int
+TestDistanceMap(const itk::Size<VDimension> & size, const itk::Vector<double, VDimension> & spacing)
+{
+  using InputImageType = itk::Image<unsigned char, VDimension>;
+  using OutputImageType = itk::Image<double, VDimension>;
+  using FilterType = itk::SignedMaurerDistanceMapImageFilter<InputImageType, OutputImageType>;
+  using IndexType = typename InputImageType::IndexType;
+
+  typename InputImageType::RegionType region;
+  region.SetSize(size);
+  region.SetIndex(0, 3);
+  auto image = InputImageType::New();
+  image->SetRegions(region);
+  image->SetSpacing(spacing);
+  image->Allocate();
+
+  // a few blobs of foreground
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(12345);
+  std::vector<IndexType> centers(4);
+  for (auto & center : centers)
+  {
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      center[d] = region.GetIndex(d) + generator->GetIntegerVariate(size[d] - 1);
+    }
+  }
+  for (itk::ImageRegionIterator<InputImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    bool inside = false;
+    for (const auto & center : centers)
+    {
+      double distance = 0.0;
+      for (unsigned int d = 0; d < VDimension; ++d)
+      {
+        distance += itk::Math::sqr(static_cast<double>(it.GetIndex()[d] - center[d]));
+      }
+      inside |= distance < 16.0;
+    }
+    it.Set(inside ? 1 : 0);
+  }
+
+  // the boundary pixels, computed as in the filter
+  using ThresholdType = itk::BinaryThresholdImageFilter<InputImageType, OutputImageType>;
+  auto threshold = ThresholdType::New();
+  threshold->SetInput(image);
+  threshold->SetLowerThreshold(0);
+  threshold->SetUpperThreshold(0);
+  threshold->SetInsideValue(1);
+  threshold->SetOutsideValue(0);
+  using ContourType = itk::BinaryContourImageFilter<OutputImageType, OutputImageType>;
+  auto contour = ContourType::New();
+  contour->SetInput(threshold->GetOutput());
+  contour->SetForegroundValue(0);
+  contour->SetBackgroundValue(1);
+  contour->SetFullyConnected(true);
+  contour->Update();
+
+  std::vector<IndexType> boundary;
+  for (itk::ImageRegionConstIteratorWithIndex<OutputImageType> it(contour->GetOutput(), region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() == 0)
+    {
+      boundary.push_back(it.GetIndex());
+    }
+  }
+
+  const auto squaredDistance = [&spacing](const IndexType & a, const IndexType & b) {
+    double distance = 0.0;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      distance += itk::Math::sqr(spacing[d] * static_cast<double>(a[d] - b[d]));
+    }
+    return distance;
+  };
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  ITK_TEST_SET_GET_BOOLEAN(filter, ComputeFeatureImage, true);
+
+  for (const bool squared : { false, true })
+  {
+    for (const unsigned int numberOfWorkUnits : { 1, 4 })
+    {
+      filter->SetSquaredDistance(squared);
+      filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      filter->SetInsideIsPositive(numberOfWorkUnits == 1);
+      ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+      const OutputImageType *                     output = filter->GetOutput();
+      const typename FilterType::FeatureImageType * features = filter->GetFeatureImage();
+      for (itk::ImageRegionConstIteratorWithIndex<OutputImageType> it(output, region); !it.IsAtEnd(); ++it)
+      {
+        const IndexType & index = it.GetIndex();
+        double            expected = itk::NumericTraits<double>::max();
+        for (const auto & boundaryIndex : boundary)
+        {
+          expected = std::min(expected, squaredDistance(index, boundaryIndex));
+        }
+        if (!squared)
+        {
+          expected = std::sqrt(expected);
+        }
+        const bool inside = image->GetPixel(index) != 0;
+        if (inside != filter->GetInsideIsPositive())
+        {
+          expected = -expected;
+        }
+
+        const IndexType & feature = features->GetPixel(index);
+        double            featureDistance = squaredDistance(index, feature);
+        if (!squared)
+        {
+          featureDistance = std::sqrt(featureDistance);
+        }
+        if (itk::Math::abs(it.Get() - expected) > 1e-6 ||
+            itk::Math::abs(featureDistance - itk::Math::abs(expected)) > 1e-6 || !region.IsInside(feature) ||
+            contour->GetOutput()->GetPixel(feature) != 0)
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "At " << index << " with " << numberOfWorkUnits << " work units, squared distance " << squared
+                    << ": distance " << it.Get() << " instead of " << expected << ", feature " << feature << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  // the feature image is not allocated when it is not computed
+  filter->ComputeFeatureImageOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(filter->GetFeatureImage()->GetBufferedRegion().GetNumberOfPixels(), 0);
+  ITK_TEST_EXPECT_EQUAL(filter->GetOutput()->GetBufferedRegion(), region);
+
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkSignedMaurerDistanceMapImageFilterBruteForceTest(int, char *[])
+{
+  itk::Size<2>           size2D = { { 37, 29 } };
+  itk::Vector<double, 2> spacing2D;
+  spacing2D[0] = 0.7;
+  spacing2D[1] = 1.3;
+  if (TestDistanceMap(size2D, spacing2D) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  itk::Size<3>           size3D = { { 17, 13, 11 } };
+  itk::Vector<double, 3> spacing3D;
+  spacing3D[0] = 1.0;
+  spacing3D[1] = 0.5;
+  spacing3D[2] = 2.0;
+  if (TestDistanceMap(size3D, spacing3D) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
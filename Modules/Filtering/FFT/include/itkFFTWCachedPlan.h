@@ -0,0 +1,319 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFFTWCachedPlan_h
+#define itkFFTWCachedPlan_h
+
+#include "itkFFTWCommon.h"
+
+#if defined(ITK_USE_FFTWF) || defined(ITK_USE_FFTWD)
+
+#  include <cstring>
+#  include <memory>
+#  include <utility>
+#  include <vector>
+
+namespace itk
+{
+namespace fftw
+{
+/**
+ * \class CachedPlan
+ * \brief FFTW plan which can be reused by later transforms of the same kind.
+ *
+ * A CachedPlan is taken from the plan cache of FFTWGlobalConfiguration, or
+ * created if the cache holds no matching plan, and is given back to the cache
+ * with Release() once the transform has been computed. The plan is created on
+ * aligned arrays owned by the CachedPlan, so that planning never overwrites
+ * the data of the caller, and is executed on the arrays of the caller with the
+ * FFTW new-array execute functions. The owned arrays are only kept when they
+ * are needed to execute the plan: when the arrays of the caller do not have
+ * the alignment required by the plan, or when the input of a complex to real
+ * transform must be preserved. They are then reused by the later executions
+ * of the plan.
+ *
+ * When ITK_USE_CUFFTW is set, there is no plan cache: the plans are created
+ * by New_dft_*() and destroyed by Release().
+ *
+ * \ingroup ITKFFT
+ */
+template <typename TPixel>
+class CachedPlan
+#  ifndef ITK_USE_CUFFTW
+  : public FFTWCachedPlanBase
+#  endif
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CachedPlan);
+
+  using Self = CachedPlan;
+  using ProxyType = Proxy<TPixel>;
+  using PixelType = typename ProxyType::PixelType;
+  using ComplexType = typename ProxyType::ComplexType;
+  using PlanType = typename ProxyType::PlanType;
+  using Pointer = std::unique_ptr<Self>;
+
+#  ifndef ITK_USE_CUFFTW
+  ~CachedPlan() override
+#  else
+  ~CachedPlan()
+#  endif
+  {
+    if (m_Plan != nullptr)
+    {
+      ProxyType::DestroyPlan(m_Plan);
+    }
+    ProxyType::Free(m_InputBuffer);
+    ProxyType::Free(m_OutputBuffer);
+  }
+
+#  ifndef ITK_USE_CUFFTW
+  void
+  DiscardPlan() override
+  {
+    m_Plan = nullptr;
+  }
+#  endif
+
+  /** Get a plan computing the real to complex transform of an array of the
+   * given rank and sizes. */
+  static Pointer
+  New_dft_r2c(int rank, const int * n, unsigned flags, int threads = 1)
+  {
+    return New(TransformEnum::R2C, rank, n, 0, flags, threads);
+  }
+
+  /** Get a plan computing the complex to real transform of an array of the
+   * given rank and sizes. */
+  static Pointer
+  New_dft_c2r(int rank, const int * n, unsigned flags, int threads = 1)
+  {
+    return New(TransformEnum::C2R, rank, n, 0, flags, threads);
+  }
+
+  /** Get a plan computing the complex to complex transform, in the direction
+   * given by sign, of an array of the given rank and sizes. */
+  static Pointer
+  New_dft(int rank, const int * n, int sign, unsigned flags, int threads = 1)
+  {
+    return New(TransformEnum::C2C, rank, n, sign, flags, threads);
+  }
+
+  /** Give the plan back to the plan cache, so that a later transform of the
+   * same kind can reuse it. */
+  static void
+  Release(Pointer plan)
+  {
+#  ifndef ITK_USE_CUFFTW
+    PlanCacheKeyType key = plan->m_Key;
+    FFTWGlobalConfiguration::PushCachedPlan(key, std::move(plan));
+#  else
+    plan.reset();
+#  endif
+  }
+
+  /** Execute a real to complex plan. The input is never modified. */
+  void
+  Execute_dft_r2c(const PixelType * in, ComplexType * out)
+  {
+    auto * source = static_cast<PixelType *>(this->GetSource(in, out, false));
+    auto * destination = static_cast<ComplexType *>(this->GetDestination(out));
+    ProxyType::Execute_dft_r2c(m_Plan, source, destination);
+    this->CopyDestination(destination, out);
+  }
+
+  /** Execute a complex to real plan. The input is only modified if
+   * canDestroyInput is true. */
+  void
+  Execute_dft_c2r(const ComplexType * in, PixelType * out, bool canDestroyInput = false)
+  {
+    auto * source = static_cast<ComplexType *>(this->GetSource(in, out, canDestroyInput));
+    auto * destination = static_cast<PixelType *>(this->GetDestination(out));
+    ProxyType::Execute_dft_c2r(m_Plan, source, destination);
+    this->CopyDestination(destination, out);
+  }
+
+  /** Execute a complex to complex plan. The input is never modified. */
+  void
+  Execute_dft(const ComplexType * in, ComplexType * out)
+  {
+    auto * source = static_cast<ComplexType *>(this->GetSource(in, out, false));
+    auto * destination = static_cast<ComplexType *>(this->GetDestination(out));
+    ProxyType::Execute_dft(m_Plan, source, destination);
+    this->CopyDestination(destination, out);
+  }
+
+private:
+  using PlanCacheKeyType = std::vector<int>;
+
+  enum class TransformEnum : int
+  {
+    R2C = 0,
+    C2R = 1,
+    C2C = 2
+  };
+
+  CachedPlan() = default;
+
+  static Pointer
+  New(TransformEnum transform, int rank, const int * n, int sign, unsigned flags, int threads)
+  {
+    PlanCacheKeyType key{ static_cast<int>(sizeof(PixelType)), static_cast<int>(transform), sign,
+                          static_cast<int>(flags),             threads,                     rank };
+    key.insert(key.end(), n, n + rank);
+
+#  ifndef ITK_USE_CUFFTW
+    FFTWGlobalConfiguration::CachedPlanPointer cached = FFTWGlobalConfiguration::PopCachedPlan(key);
+    if (cached)
+    {
+      // The key holds the precision of the plan, so the cached plan is a Self.
+      return Pointer(static_cast<Self *>(cached.release()));
+    }
+#  endif
+
+    Pointer plan(new Self);
+    plan->m_Key = key;
+
+    size_t numberOfValues = 1;
+    for (int i = 0; i < rank - 1; ++i)
+    {
+      numberOfValues *= static_cast<size_t>(n[i]);
+    }
+    const size_t numberOfHalfValues = numberOfValues * static_cast<size_t>(n[rank - 1] / 2 + 1);
+    numberOfValues *= static_cast<size_t>(n[rank - 1]);
+    switch (transform)
+    {
+      case TransformEnum::R2C:
+        plan->m_InputBufferSize = numberOfValues * sizeof(PixelType);
+        plan->m_OutputBufferSize = numberOfHalfValues * sizeof(ComplexType);
+        break;
+      case TransformEnum::C2R:
+        plan->m_InputBufferSize = numberOfHalfValues * sizeof(ComplexType);
+        plan->m_OutputBufferSize = numberOfValues * sizeof(PixelType);
+        break;
+      case TransformEnum::C2C:
+        plan->m_InputBufferSize = numberOfValues * sizeof(ComplexType);
+        plan->m_OutputBufferSize = numberOfValues * sizeof(ComplexType);
+        break;
+    }
+    // FFTW only preserves the input of the multi-dimensional complex to real
+    // transforms when asked to, and does not always know how to.
+    plan->m_PreservesInput = transform != TransformEnum::C2R || (flags & FFTW_PRESERVE_INPUT);
+
+    // The plan is created on the owned arrays, which are released afterward:
+    // they are only needed again when the arrays of the caller can't be used.
+    void * in = plan->GetInputBuffer();
+    void * out = plan->GetOutputBuffer();
+    switch (transform)
+    {
+      case TransformEnum::R2C:
+        plan->m_Plan = ProxyType::Plan_dft_r2c(
+          rank, n, static_cast<PixelType *>(in), static_cast<ComplexType *>(out), flags, threads, true);
+        break;
+      case TransformEnum::C2R:
+        plan->m_Plan = ProxyType::Plan_dft_c2r(
+          rank, n, static_cast<ComplexType *>(in), static_cast<PixelType *>(out), flags, threads, true);
+        break;
+      case TransformEnum::C2C:
+        plan->m_Plan = ProxyType::Plan_dft(
+          rank, n, static_cast<ComplexType *>(in), static_cast<ComplexType *>(out), sign, flags, threads, true);
+        break;
+    }
+    ProxyType::Free(plan->m_InputBuffer);
+    plan->m_InputBuffer = nullptr;
+    ProxyType::Free(plan->m_OutputBuffer);
+    plan->m_OutputBuffer = nullptr;
+    return plan;
+  }
+
+  void *
+  GetInputBuffer()
+  {
+    if (m_InputBuffer == nullptr)
+    {
+      m_InputBuffer = ProxyType::Malloc(m_InputBufferSize);
+    }
+    return m_InputBuffer;
+  }
+
+  void *
+  GetOutputBuffer()
+  {
+    if (m_OutputBuffer == nullptr)
+    {
+      m_OutputBuffer = ProxyType::Malloc(m_OutputBufferSize);
+    }
+    return m_OutputBuffer;
+  }
+
+  static bool
+  IsAligned(const void * p)
+  {
+#  ifndef ITK_USE_CUFFTW
+    // The plans are created on arrays allocated by fftw_malloc(), which have
+    // the alignment 0.
+    return ProxyType::AlignmentOf(static_cast<PixelType *>(const_cast<void *>(p))) == 0;
+#  else
+    (void)p;
+    return true;
+#  endif
+  }
+
+  /** Get the array the plan reads from: the input of the caller, or its copy
+   * in the owned input array. The plan is out-of-place, so the copy is also
+   * used when the caller works in-place. */
+  void *
+  GetSource(const void * in, const void * out, bool canDestroyInput)
+  {
+    if (in == out || !IsAligned(in) || !(m_PreservesInput || canDestroyInput))
+    {
+      std::memcpy(this->GetInputBuffer(), in, m_InputBufferSize);
+      return m_InputBuffer;
+    }
+    return const_cast<void *>(in);
+  }
+
+  /** Get the array the plan writes to: the output of the caller if it has the
+   * alignment of the plan, or the owned output array. */
+  void *
+  GetDestination(void * out)
+  {
+    return IsAligned(out) ? out : this->GetOutputBuffer();
+  }
+
+  void
+  CopyDestination(const void * destination, void * out) const
+  {
+    if (destination != out)
+    {
+      std::memcpy(out, destination, m_OutputBufferSize);
+    }
+  }
+
+  PlanType         m_Plan{ nullptr };
+  PlanCacheKeyType m_Key;
+  void *           m_InputBuffer{ nullptr };
+  void *           m_OutputBuffer{ nullptr };
+  size_t           m_InputBufferSize{ 0 };
+  size_t           m_OutputBufferSize{ 0 };
+  bool             m_PreservesInput{ true };
+};
+} // end namespace fftw
+} // end namespace itk
+
+#endif
+#endif
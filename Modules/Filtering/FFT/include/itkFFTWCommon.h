@@ -390,6 +390,47 @@ public:
   {
     fftwf_execute(p);
   }
+
+  /** Execute the plan on other arrays than the ones it was created with. The
+   * arrays must have the same alignment and in-place-ness as the original ones. */
+  static void
+  Execute_dft_r2c(PlanType p, PixelType * in, ComplexType * out)
+  {
+    fftwf_execute_dft_r2c(p, in, out);
+  }
+  static void
+  Execute_dft_c2r(PlanType p, ComplexType * in, PixelType * out)
+  {
+    fftwf_execute_dft_c2r(p, in, out);
+  }
+  static void
+  Execute_dft(PlanType p, ComplexType * in, ComplexType * out)
+  {
+    fftwf_execute_dft(p, in, out);
+  }
+
+  /** Allocate and free memory with the alignment required by the SIMD
+   * implementations of FFTW. */
+  static void *
+  Malloc(size_t n)
+  {
+    return fftwf_malloc(n);
+  }
+  static void
+  Free(void * p)
+  {
+    fftwf_free(p);
+  }
+
+#  ifndef ITK_USE_CUFFTW
+  /** Get the alignment of an array, as defined by FFTW: plans executed on
+   * arrays with different alignments are not compatible. */
+  static int
+  AlignmentOf(PixelType * p)
+  {
+    return fftwf_alignment_of(p);
+  }
+#  endif
   static void
   DestroyPlan(PlanType p)
   {
@@ -731,6 +772,47 @@ public:
   {
     fftw_execute(p);
   }
+
+  /** Execute the plan on other arrays than the ones it was created with. The
+   * arrays must have the same alignment and in-place-ness as the original ones. */
+  static void
+  Execute_dft_r2c(PlanType p, PixelType * in, ComplexType * out)
+  {
+    fftw_execute_dft_r2c(p, in, out);
+  }
+  static void
+  Execute_dft_c2r(PlanType p, ComplexType * in, PixelType * out)
+  {
+    fftw_execute_dft_c2r(p, in, out);
+  }
+  static void
+  Execute_dft(PlanType p, ComplexType * in, ComplexType * out)
+  {
+    fftw_execute_dft(p, in, out);
+  }
+
+  /** Allocate and free memory with the alignment required by the SIMD
+   * implementations of FFTW. */
+  static void *
+  Malloc(size_t n)
+  {
+    return fftw_malloc(n);
+  }
+  static void
+  Free(void * p)
+  {
+    fftw_free(p);
+  }
+
+#  ifndef ITK_USE_CUFFTW
+  /** Get the alignment of an array, as defined by FFTW: plans executed on
+   * arrays with different alignments are not compatible. */
+  static int
+  AlignmentOf(PixelType * p)
+  {
+    return fftw_alignment_of(p);
+  }
+#  endif
   static void
   DestroyPlan(PlanType p)
   {
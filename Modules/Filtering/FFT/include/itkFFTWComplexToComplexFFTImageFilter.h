@@ -19,7 +19,7 @@
 #define itkFFTWComplexToComplexFFTImageFilter_h
 
 #include "itkComplexToComplexFFTImageFilter.h"
-#include "itkFFTWCommon.h"
+#include "itkFFTWCachedPlan.h"
 
 #include "itkFFTImageFilterFactory.h"
 
@@ -82,6 +82,11 @@ public:
   //
   using FFTWProxyType = typename fftw::Proxy<typename PixelType::value_type>;
 
+
+  /** The FFTW plans are reused across executions through the plan cache of
+   * FFTWGlobalConfiguration. */
+  using FFTWCachedPlanType = typename fftw::CachedPlan<typename PixelType::value_type>;
+
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
@@ -20,7 +20,7 @@
 
 #include "itkForwardFFTImageFilter.h"
 
-#include "itkFFTWCommon.h"
+#include "itkFFTWCachedPlan.h"
 
 #include "itkFFTImageFilterFactory.h"
 
@@ -79,6 +79,10 @@ public:
    * configured. */
   using FFTWProxyType = typename fftw::Proxy<InputPixelType>;
 
+  /** The FFTW plans are reused across executions through the plan cache of
+   * FFTWGlobalConfiguration. */
+  using FFTWCachedPlanType = typename fftw::CachedPlan<InputPixelType>;
+
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
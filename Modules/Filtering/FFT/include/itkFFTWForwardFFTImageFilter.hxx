@@ -91,9 +91,8 @@ FFTWForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
   fftwOutput->SetRegions(fftwOutputRegion);
   fftwOutput->Allocate();
 
-  typename FFTWProxyType::PlanType plan;
-  auto *                           in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
-  int                              flags = m_PlanRigor;
+  const InputPixelType * in = inputPtr->GetBufferPointer();
+  int                    flags = m_PlanRigor;
   if (!m_CanUseDestructiveAlgorithm)
   {
     // if the input is about to be destroyed, there is no need to force fftw
@@ -107,14 +106,10 @@ FFTWForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_r2c(ImageDimension,
-                                     sizes,
-                                     in,
-                                     (typename FFTWProxyType::ComplexType *)fftwOutput->GetBufferPointer(),
-                                     flags,
-                                     MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  typename FFTWCachedPlanType::Pointer plan = FFTWCachedPlanType::New_dft_r2c(
+    ImageDimension, sizes, flags, this->GetNumberOfWorkUnits());
+  plan->Execute_dft_r2c(in, (typename FFTWProxyType::ComplexType *)fftwOutput->GetBufferPointer());
+  FFTWCachedPlanType::Release(std::move(plan));
 
   // Expand the half image to the full image size
   using HalfToFullFilterType = HalfToFullHermitianImageFilter<OutputImageType>;
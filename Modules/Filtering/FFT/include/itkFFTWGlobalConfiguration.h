@@ -35,6 +35,9 @@
 #  endif
 #  include <algorithm>
 #  include <cctype>
+#  include <list>
+#  include <memory>
+#  include <vector>
 
 struct FFTWGlobalConfigurationGlobals;
 
@@ -56,6 +59,9 @@ struct FFTWGlobalConfigurationGlobals;
 //                             file to be generated.  If this is
 //                             set, then ITK_FFTW_WISDOM_CACHE_BASE
 //                             is ignored.
+// ITK_FFTW_PLAN_CACHE - Defines if the FFTW plans should be kept
+//                       in an in-process cache to be reused by
+//                       later transforms (it is "On" by default)
 //
 // The above behaviors can also be controlled by the application.
 //
@@ -183,6 +189,26 @@ private:
   bool m_UseSteppingCode{ true };
 };
 
+/**
+ * \class FFTWCachedPlanBase
+ * \brief Base class of the FFTW plans stored in the plan cache of
+ * FFTWGlobalConfiguration.
+ *
+ * The concrete, precision dependent, plans are implemented by fftw::CachedPlan.
+ *
+ * \ingroup ITKFFT
+ */
+class ITKFFT_EXPORT FFTWCachedPlanBase
+{
+public:
+  virtual ~FFTWCachedPlanBase();
+
+  /** Forget the FFTW plan without destroying it. This is used at exit, when
+   * fftw_cleanup() reclaims all the plans which are still alive. */
+  virtual void
+  DiscardPlan() = 0;
+};
+
 /**
  * \class FFTWGlobalConfiguration
  * A class to contain all the global configuration options for
@@ -212,6 +238,10 @@ public:
   using ConstPointer = SmartPointer<const Self>;
   using MutexType = std::mutex;
 
+  /** Key and pointer types of the plan cache. */
+  using PlanCacheKeyType = std::vector<int>;
+  using CachedPlanPointer = std::unique_ptr<FFTWCachedPlanBase>;
+
   /** Run-time type information (and related methods). */
   itkTypeMacro(FFTWGlobalConfiguration, Object);
 
@@ -348,6 +378,55 @@ public:
   static bool
   ExportDefaultWisdomFile();
 
+  /**
+   * \brief Set/Get whether the FFTW plans are kept in an in-process cache
+   *
+   * Creating a plan, especially with a plan rigor other than FFTW_ESTIMATE,
+   * often costs more than executing it. When the plan cache is used, the FFTW
+   * filters give their plans back to the cache after execution, and a later
+   * transform of the same type, size, direction, flags and number of threads
+   * reuses them. The plan cache is used by default; if the environmental
+   * variable "ITK_FFTW_PLAN_CACHE" is set to "Off", it is not.
+   */
+  static void
+  SetUsePlanCache(const bool & v);
+  static bool
+  GetUsePlanCache();
+
+  /** Set/Get the maximum number of idle plans kept in the plan cache. When the
+   * cache is full, the least recently used plan is destroyed. Defaults to 16. */
+  static void
+  SetPlanCacheMaximumSize(const SizeValueType & v);
+  static SizeValueType
+  GetPlanCacheMaximumSize();
+
+  /** Get the number of plan requests that were served from the plan cache,
+   * and the number of those that required the creation of a new plan. */
+  static SizeValueType
+  GetPlanCacheHits();
+  static SizeValueType
+  GetPlanCacheMisses();
+
+  /** Get the number of idle plans currently held by the plan cache. */
+  static SizeValueType
+  GetPlanCacheSize();
+
+  /** Destroy all the idle plans of the plan cache, and reset its counters. */
+  static void
+  ClearPlanCache();
+
+  /** Take an idle plan matching the key out of the plan cache. A null pointer
+   * is returned, and a miss is counted, if there is none. This is used by
+   * fftw::CachedPlan and should not be needed in application code. */
+  static CachedPlanPointer
+  PopCachedPlan(const PlanCacheKeyType & key);
+
+  /** Give a plan back to the plan cache. The plan is destroyed if the plan
+   * cache is not used. This is used by fftw::CachedPlan and should not be
+   * needed in application code. */
+  static void
+  PushCachedPlan(const PlanCacheKeyType & key, CachedPlanPointer plan);
+
 private:
   FFTWGlobalConfiguration();           // This will process env variables
   ~FFTWGlobalConfiguration() override; // This will write cache file if requested.
@@ -376,6 +455,15 @@ private:
   // m_WriteWisdomCache Controls the behavior of default
   // wisdom file creation policies.
   WisdomFilenameGeneratorBase * m_WisdomFilenameGenerator;
+
+  // The idle plans, most recently used first. The plan cache has its own
+  // lock because destroying a plan requires the FFTW lock.
+  std::mutex                                                 m_PlanCacheLock;
+  std::list<std::pair<PlanCacheKeyType, CachedPlanPointer>> m_PlanCache;
+  bool                                                       m_UsePlanCache{ true };
+  SizeValueType                                              m_PlanCacheMaximumSize{ 16 };
+  SizeValueType                                              m_PlanCacheHits{ 0 };
+  SizeValueType                                              m_PlanCacheMisses{ 0 };
 };
 } // namespace itk
 #endif
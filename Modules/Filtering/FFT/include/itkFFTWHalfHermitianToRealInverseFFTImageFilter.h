@@ -19,7 +19,7 @@
 #define itkFFTWHalfHermitianToRealInverseFFTImageFilter_h
 
 #include "itkHalfHermitianToRealInverseFFTImageFilter.h"
-#include "itkFFTWCommon.h"
+#include "itkFFTWCachedPlan.h"
 
 #include "itkFFTImageFilterFactory.h"
 
@@ -76,6 +76,11 @@ public:
    * configured. */
   using FFTWProxyType = typename fftw::Proxy<OutputPixelType>;
 
+
+  /** The FFTW plans are reused across executions through the plan cache of
+   * FFTWGlobalConfiguration. */
+  using FFTWCachedPlanType = typename fftw::CachedPlan<OutputPixelType>;
+
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
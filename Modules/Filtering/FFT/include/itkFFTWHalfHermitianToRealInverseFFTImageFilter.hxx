@@ -73,54 +73,23 @@ FFTWHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeT
 
   // The complex-to-real transform doesn't support the
   // FFTW_PRESERVE_INPUT flag at this time. So if the input can't be
-  // destroyed, we have to copy the input data to a buffer before
-  // running the IFFT.
-  typename FFTWProxyType::ComplexType * const in = [&]() -> typename FFTWProxyType::ComplexType *
-  {
-    if (m_CanUseDestructiveAlgorithm)
-    {
-      // Ok, so lets use the input buffer directly, to save some memory.
-      return const_cast<typename FFTWProxyType::ComplexType *>(
-        reinterpret_cast<const typename FFTWProxyType::ComplexType *>(inputPtr->GetBufferPointer()));
-    }
-    else
-    {
-      // We must use a buffer where fftw can work and destroy what it wants.
-      return new typename FFTWProxyType::ComplexType[totalInputSize];
-    }
-  }
-  ();
-  OutputPixelType *                out = outputPtr->GetBufferPointer();
-  typename FFTWProxyType::PlanType plan;
+  // destroyed, the cached plan copies the input data to a buffer, which
+  // it keeps for its next executions, before running the IFFT.
+  // complex<double> and double[2] types are compatible memory layouts.
+  // The reinterpret_cast is used here to
+  // make the "C" fftw libary compatible with the c++ complex<double>.
+  const auto *      in = reinterpret_cast<const typename FFTWProxyType::ComplexType *>(inputPtr->GetBufferPointer());
+  OutputPixelType * out = outputPtr->GetBufferPointer();
 
   int sizes[ImageDimension];
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
     sizes[(ImageDimension - 1) - i] = outputSize[i];
   }
-  plan = FFTWProxyType::Plan_dft_c2r(ImageDimension,
-                                     sizes,
-                                     in,
-                                     out,
-                                     m_PlanRigor,
-                                     MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
-                                     !m_CanUseDestructiveAlgorithm);
-  if (!m_CanUseDestructiveAlgorithm)
-  {
-    // complex<double> and double[2] types are compatible memory layouts.
-    // The reinterpret_cast is used here to
-    // make the "C" fftw libary compatible with the c++ complex<double>.
-    std::copy_n(
-      inputPtr->GetBufferPointer(), totalInputSize, reinterpret_cast<typename InputImageType::PixelType *>(in));
-  }
-  FFTWProxyType::Execute(plan);
-
-  // Some cleanup.
-  FFTWProxyType::DestroyPlan(plan);
-  if (!m_CanUseDestructiveAlgorithm)
-  {
-    delete[] in;
-  }
+  typename FFTWCachedPlanType::Pointer plan = FFTWCachedPlanType::New_dft_c2r(
+    ImageDimension, sizes, m_PlanRigor, this->GetNumberOfWorkUnits());
+  plan->Execute_dft_c2r(in, out, m_CanUseDestructiveAlgorithm);
+  FFTWCachedPlanType::Release(std::move(plan));
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -19,7 +19,7 @@
 #define itkFFTWInverseFFTImageFilter_h
 
 #include "itkInverseFFTImageFilter.h"
-#include "itkFFTWCommon.h"
+#include "itkFFTWCachedPlan.h"
 
 #include "itkFFTImageFilterFactory.h"
 
@@ -73,6 +73,11 @@ public:
    * configured. */
   using FFTWProxyType = typename fftw::Proxy<OutputPixelType>;
 
+
+  /** The FFTW plans are reused across executions through the plan cache of
+   * FFTWGlobalConfiguration. */
+  using FFTWCachedPlanType = typename fftw::CachedPlan<OutputPixelType>;
+
   using OutputImageRegionType = typename OutputImageType::RegionType;
 
   /** Method for creation through the object factory. */
@@ -82,8 +82,7 @@ FFTWInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData
 
   auto * in = (typename FFTWProxyType::ComplexType *)fullToHalfFilter->GetOutput()->GetBufferPointer();
 
-  OutputPixelType *                out = outputPtr->GetBufferPointer();
-  typename FFTWProxyType::PlanType plan;
+  OutputPixelType * out = outputPtr->GetBufferPointer();
 
   int sizes[ImageDimension];
   for (unsigned int i = 0; i < ImageDimension; ++i)
@@ -91,12 +90,11 @@ FFTWInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData
     sizes[(ImageDimension - 1) - i] = outputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_c2r(
-    ImageDimension, sizes, in, out, m_PlanRigor, MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), false);
-  FFTWProxyType::Execute(plan);
-
-  // Some cleanup.
-  FFTWProxyType::DestroyPlan(plan);
+  typename FFTWCachedPlanType::Pointer plan = FFTWCachedPlanType::New_dft_c2r(
+    ImageDimension, sizes, m_PlanRigor, this->GetNumberOfWorkUnits());
+  // The half image is a temporary one, which can be destroyed.
+  plan->Execute_dft_c2r(in, out, true);
+  FFTWCachedPlanType::Release(std::move(plan));
 }
 
 template <typename TInputImage, typename TOutputImage>
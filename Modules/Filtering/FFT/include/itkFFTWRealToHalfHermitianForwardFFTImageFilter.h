@@ -19,7 +19,7 @@
 #define itkFFTWRealToHalfHermitianForwardFFTImageFilter_h
 
 #include "itkRealToHalfHermitianForwardFFTImageFilter.h"
-#include "itkFFTWCommon.h"
+#include "itkFFTWCachedPlan.h"
 
 #include "itkFFTImageFilterFactory.h"
 
@@ -79,6 +79,11 @@ public:
    * configured. */
   using FFTWProxyType = typename fftw::Proxy<InputPixelType>;
 
+
+  /** The FFTW plans are reused across executions through the plan cache of
+   * FFTWGlobalConfiguration. */
+  using FFTWCachedPlanType = typename fftw::CachedPlan<InputPixelType>;
+
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
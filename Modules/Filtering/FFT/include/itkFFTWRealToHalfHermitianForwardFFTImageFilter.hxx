@@ -73,10 +73,9 @@ FFTWRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::Generat
     totalOutputSize *= outputSize[i];
   }
 
-  typename FFTWProxyType::PlanType plan;
-  auto *                           in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
-  auto *                           out = (typename FFTWProxyType::ComplexType *)outputPtr->GetBufferPointer();
-  int                              flags = m_PlanRigor;
+  const InputPixelType * in = inputPtr->GetBufferPointer();
+  auto *                 out = (typename FFTWProxyType::ComplexType *)outputPtr->GetBufferPointer();
+  int                    flags = m_PlanRigor;
   if (!m_CanUseDestructiveAlgorithm)
   {
     // if the input is about to be destroyed, there is no need to force fftw
@@ -90,10 +89,10 @@ FFTWRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::Generat
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_r2c(
-    ImageDimension, sizes, in, out, flags, MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  typename FFTWCachedPlanType::Pointer plan =
+    FFTWCachedPlanType::New_dft_r2c(ImageDimension, sizes, flags, this->GetNumberOfWorkUnits());
+  plan->Execute_dft_r2c(in, out);
+  FFTWCachedPlanType::Release(std::move(plan));
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -39,6 +39,8 @@
 
 #  include "itkObjectFactory.h"
 
+#  include <iterator>
+
 namespace itk
 {
 
@@ -51,6 +53,8 @@ struct FFTWGlobalConfigurationGlobals
   std::mutex                       m_CreationLock;
 };
 
+FFTWCachedPlanBase::~FFTWCachedPlanBase() = default;
+
 WisdomFilenameGeneratorBase::WisdomFilenameGeneratorBase() = default;
 
 WisdomFilenameGeneratorBase::~WisdomFilenameGeneratorBase() = default;
@@ -475,6 +479,15 @@ FFTWGlobalConfiguration ::FFTWGlobalConfiguration()
     }
   }
 
+  {
+    std::string plan_cache_env;
+    const bool  envITK_FFTW_PLAN_CACHEfound = itksys::SystemTools::GetEnv("ITK_FFTW_PLAN_CACHE", plan_cache_env);
+    if (envITK_FFTW_PLAN_CACHEfound && isDeclineString(plan_cache_env))
+    {
+      this->m_UsePlanCache = false;
+    }
+  }
+
   if (this->m_ReadWisdomCache)
   {
     std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -509,6 +522,12 @@ FFTWGlobalConfiguration::~FFTWGlobalConfiguration()
     }
 #  endif
   }
+  // fftw_cleanup() below reclaims the cached plans.
+  for (auto & cached : this->m_PlanCache)
+  {
+    cached.second->DiscardPlan();
+  }
+  this->m_PlanCache.clear();
 #  if defined(ITK_USE_FFTWF)
 #    if !defined(_WIN32) || defined(ITK_STATIC)
   // Cannot be called with shared libs on Windows because FFTW does not check
@@ -830,6 +849,134 @@ FFTWGlobalConfiguration::GetWisdomCacheBase()
   return GetInstance()->m_WisdomCacheBase;
 }
 
+void
+FFTWGlobalConfiguration::SetUsePlanCache(const bool & v)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  GetInstance()->m_UsePlanCache = v;
+  if (!v)
+  {
+    ClearPlanCache();
+  }
+}
+
+bool
+FFTWGlobalConfiguration::GetUsePlanCache()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return GetInstance()->m_UsePlanCache;
+}
+
+void
+FFTWGlobalConfiguration::SetPlanCacheMaximumSize(const SizeValueType & v)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                                                   instance = GetInstance();
+  std::list<std::pair<PlanCacheKeyType, CachedPlanPointer>> evicted;
+  {
+    std::lock_guard<std::mutex> lock(instance->m_PlanCacheLock);
+    instance->m_PlanCacheMaximumSize = v;
+    while (instance->m_PlanCache.size() > v)
+    {
+      evicted.splice(evicted.end(), instance->m_PlanCache, std::prev(instance->m_PlanCache.end()));
+    }
+  }
+  // The evicted plans are destroyed here, without holding the plan cache lock.
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetPlanCacheMaximumSize()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return GetInstance()->m_PlanCacheMaximumSize;
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetPlanCacheHits()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                     instance = GetInstance();
+  std::lock_guard<std::mutex> lock(instance->m_PlanCacheLock);
+  return instance->m_PlanCacheHits;
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetPlanCacheMisses()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                     instance = GetInstance();
+  std::lock_guard<std::mutex> lock(instance->m_PlanCacheLock);
+  return instance->m_PlanCacheMisses;
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetPlanCacheSize()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                     instance = GetInstance();
+  std::lock_guard<std::mutex> lock(instance->m_PlanCacheLock);
+  return static_cast<SizeValueType>(instance->m_PlanCache.size());
+}
+
+void
+FFTWGlobalConfiguration::ClearPlanCache()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                                                   instance = GetInstance();
+  std::list<std::pair<PlanCacheKeyType, CachedPlanPointer>> evicted;
+  {
+    std::lock_guard<std::mutex> lock(instance->m_PlanCacheLock);
+    evicted.swap(instance->m_PlanCache);
+    instance->m_PlanCacheHits = 0;
+    instance->m_PlanCacheMisses = 0;
+  }
+}
+
+FFTWGlobalConfiguration::CachedPlanPointer
+FFTWGlobalConfiguration::PopCachedPlan(const PlanCacheKeyType & key)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                     instance = GetInstance();
+  std::lock_guard<std::mutex> lock(instance->m_PlanCacheLock);
+  if (!instance->m_UsePlanCache)
+  {
+    return nullptr;
+  }
+  for (auto it = instance->m_PlanCache.begin(); it != instance->m_PlanCache.end(); ++it)
+  {
+    if (it->first == key)
+    {
+      CachedPlanPointer plan = std::move(it->second);
+      instance->m_PlanCache.erase(it);
+      ++instance->m_PlanCacheHits;
+      return plan;
+    }
+  }
+  ++instance->m_PlanCacheMisses;
+  return nullptr;
+}
+
+void
+FFTWGlobalConfiguration::PushCachedPlan(const PlanCacheKeyType & key, CachedPlanPointer plan)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Pointer                                                   instance = GetInstance();
+  std::list<std::pair<PlanCacheKeyType, CachedPlanPointer>> evicted;
+  {
+    std::lock_guard<std::mutex> lock(instance->m_PlanCacheLock);
+    if (instance->m_UsePlanCache && instance->m_PlanCacheMaximumSize > 0)
+    {
+      instance->m_PlanCache.emplace_front(key, std::move(plan));
+      while (instance->m_PlanCache.size() > instance->m_PlanCacheMaximumSize)
+      {
+        evicted.splice(evicted.end(), instance->m_PlanCache, std::prev(instance->m_PlanCache.end()));
+      }
+    }
+  }
+  // The plans which are not kept are destroyed when leaving this function,
+  // without holding the plan cache lock.
+}
+
 } // end namespace itk
 
 #endif
@@ -0,0 +1,132 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTWHalfHermitianToRealInverseFFTImageFilter.h"
+#include "itkFFTWRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkTestingMacros.h"
+
+// Check that repeated transforms of the same size reuse the cached FFTW
+// plans, and that the cached plans compute the same transforms as new ones.
+template <typename TPixel>
+int
+PlanCacheTest()
+{
+  constexpr unsigned int Dimension = 3;
+  using RealImageType = itk::Image<TPixel, Dimension>;
+  using ComplexImageType = itk::Image<std::complex<TPixel>, Dimension>;
+
+  auto                             image = RealImageType::New();
+  typename RealImageType::SizeType size = { { 12, 7, 5 } };
+  image->SetRegions(size);
+  image->Allocate();
+  unsigned int value = 0;
+  for (itk::ImageRegionIterator<RealImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    value = (value * 37 + 11) % 101;
+    it.Set(static_cast<TPixel>(value));
+  }
+
+  using ForwardFilterType = itk::FFTWRealToHalfHermitianForwardFFTImageFilter<RealImageType, ComplexImageType>;
+  using InverseFilterType = itk::FFTWHalfHermitianToRealInverseFFTImageFilter<ComplexImageType, RealImageType>;
+
+  const auto roundTrip = [&image]() {
+    auto forward = ForwardFilterType::New();
+    forward->SetInput(image);
+    auto inverse = InverseFilterType::New();
+    inverse->SetInput(forward->GetOutput());
+    inverse->SetActualXDimensionIsOdd(false);
+    inverse->Update();
+    typename RealImageType::Pointer output = inverse->GetOutput();
+    output->DisconnectPipeline();
+    return output;
+  };
+
+  itk::FFTWGlobalConfiguration::SetUsePlanCache(true);
+  itk::FFTWGlobalConfiguration::ClearPlanCache();
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheHits(), 0);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheMisses(), 0);
+
+  // The first round trip creates a forward and an inverse plan.
+  typename RealImageType::Pointer first = roundTrip();
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheHits(), 0);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheMisses(), 2);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 2);
+
+  // The next ones reuse them.
+  typename RealImageType::Pointer second = roundTrip();
+  roundTrip();
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheHits(), 4);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheMisses(), 2);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 2);
+
+  // Without the plan cache, the plans are destroyed after each transform.
+  itk::FFTWGlobalConfiguration::SetUsePlanCache(false);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 0);
+  typename RealImageType::Pointer third = roundTrip();
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 0);
+  itk::FFTWGlobalConfiguration::SetUsePlanCache(true);
+
+  int                                          status = EXIT_SUCCESS;
+  itk::ImageRegionConstIterator<RealImageType> inputIt(image, image->GetBufferedRegion());
+  itk::ImageRegionConstIterator<RealImageType> firstIt(first, first->GetBufferedRegion());
+  itk::ImageRegionConstIterator<RealImageType> secondIt(second, second->GetBufferedRegion());
+  itk::ImageRegionConstIterator<RealImageType> thirdIt(third, third->GetBufferedRegion());
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++firstIt, ++secondIt, ++thirdIt)
+  {
+    if (itk::Math::abs(firstIt.Get() - inputIt.Get()) > 1e-3 ||
+        itk::Math::abs(secondIt.Get() - firstIt.Get()) > 1e-5 || itk::Math::abs(thirdIt.Get() - firstIt.Get()) > 1e-5)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in round trip at index " << inputIt.GetIndex() << ": expected " << inputIt.Get()
+                << ", got " << firstIt.Get() << ", " << secondIt.Get() << " and " << thirdIt.Get() << std::endl;
+      status = EXIT_FAILURE;
+      break;
+    }
+  }
+
+  // The plan cache is bounded.
+  roundTrip();
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 2);
+  itk::FFTWGlobalConfiguration::SetPlanCacheMaximumSize(1);
+  ITK_TEST_EXPECT_EQUAL(itk::FFTWGlobalConfiguration::GetPlanCacheSize(), 1);
+  itk::FFTWGlobalConfiguration::SetPlanCacheMaximumSize(16);
+
+  return status;
+}
+
+int
+itkFFTWPlanCacheTest(int, char *[])
+{
+  int status = EXIT_SUCCESS;
+#if defined(ITK_USE_FFTWF)
+  if (PlanCacheTest<float>() == EXIT_FAILURE)
+  {
+    status = EXIT_FAILURE;
+  }
+#endif
+#if defined(ITK_USE_FFTWD)
+  if (PlanCacheTest<double>() == EXIT_FAILURE)
+  {
+    status = EXIT_FAILURE;
+  }
+#endif
+
+  std::cout << "Test finished." << std::endl;
+  return status;
+}
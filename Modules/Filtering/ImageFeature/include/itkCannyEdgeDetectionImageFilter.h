@@ -20,15 +20,21 @@
 
 #include "itkConstNeighborhoodIterator.h"
 #include "itkDiscreteGaussianImageFilter.h"
-#include "itkMultiplyImageFilter.h"
 #include "itkMultiThreaderBase.h"
 #include "itkDerivativeOperator.h"
-#include "itkSparseFieldLayer.h"
-#include "itkObjectStore.h"
 #include "itkMath.h"
+#if !defined(ITK_FUTURE_LEGACY_REMOVE)
+#  include "itkMultiplyImageFilter.h"
+#  include "itkObjectStore.h"
+#  include "itkSparseFieldLayer.h"
+#endif
+
+#include <vector>
 
 namespace itk
 {
+#if !defined(ITK_FUTURE_LEGACY_REMOVE)
+/** \deprecated The edges are no longer followed with a list of nodes. */
 template <typename TValue>
 class ITK_TEMPLATE_EXPORT ListNode
 {
@@ -38,6 +44,7 @@ public:
   ListNode * Next;
   ListNode * Previous;
 };
+#endif
 
 /**
  *\class CannyEdgeDetectionImageFilter
@@ -56,6 +63,15 @@ public:
  *      (multiplied with zero-crossings) of the smoothed image to find and
  *      link edges.
  *
+ * Step (3) is computed in the same threaded pass as the third derivative,
+ * without intermediate zero-crossing image. In step (4), the pixels above the
+ * lower threshold are linked into connected components with a union-find
+ * forest, built in parallel in slabs along the last dimension which are then
+ * merged along their boundaries; the components which contain a pixel above
+ * the upper threshold are the edges. The forest takes 4 bytes per pixel,
+ * with the flags of a pixel packed with the index of its parent, and 8 bytes
+ * per pixel for images of more than 2^30 pixels.
+ *
  * \par Inputs and Outputs
  * The input to this filter should be a scalar, real-valued Itk image of
  * arbitrary dimension.  The output should also be a scalar, real-value Itk
@@ -117,10 +133,14 @@ public:
    */
   using NeighborhoodType = ConstNeighborhoodIterator<OutputImageType, DefaultBoundaryConditionType>;
 
+#if !defined(ITK_FUTURE_LEGACY_REMOVE)
+  /** \deprecated The edges are no longer followed with a list of nodes, and
+   * these types are not used by the filter. */
   using ListNodeType = ListNode<IndexType>;
   using ListNodeStorageType = ObjectStore<ListNodeType>;
   using ListType = SparseFieldLayer<ListNodeType>;
   using ListPointerType = typename ListType::Pointer;
+#endif
 
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
@@ -198,7 +218,7 @@ public:
   OutputImageType *
   GetNonMaximumSuppressionImage()
   {
-    return this->m_MultiplyImageFilter->GetOutput();
+    return this->m_UpdateBuffer1;
   }
 
 #ifdef ITK_USE_CONCEPT_CHECKING
@@ -220,7 +240,11 @@ protected:
   GenerateData() override;
 
   using GaussianImageFilterType = DiscreteGaussianImageFilter<InputImageType, OutputImageType>;
+#if !defined(ITK_FUTURE_LEGACY_REMOVE)
+  /** \deprecated The zero crossings are no longer multiplied by the gradient
+   * magnitude with a separate filter, and this type is not used. */
   using MultiplyImageFilterType = MultiplyImageFilter<OutputImageType, OutputImageType, OutputImageType>;
+#endif
 
 private:
   ~CannyEdgeDetectionImageFilter() override = default;
@@ -233,9 +257,51 @@ private:
   void
   HysteresisThresholding();
 
-  /** Edge linking function. */
+  /** Link the edge pixels with the nodes of the forest of the given width. */
+  template <typename TNode>
   void
-  FollowEdge(IndexType index, const OutputImageType * multiplyImageFilterOutput);
+  HysteresisThresholding();
+
+  /** Union-find forest of the hysteresis thresholding, with one node per
+   * pixel. The two highest bits of a node are the flags of the pixel, and the
+   * other ones the index of its parent. ConnectedToUpperThreshold is only
+   * meaningful for the root of a component. */
+  template <typename TNode>
+  struct EdgeForest
+  {
+    static constexpr TNode ConnectedToUpperThreshold = TNode{ 1 } << (8 * sizeof(TNode) - 1);
+    static constexpr TNode AboveLowerThreshold = TNode{ 1 } << (8 * sizeof(TNode) - 2);
+    static constexpr TNode ParentMask = AboveLowerThreshold - 1;
+
+    SizeValueType
+    GetParent(SizeValueType pixel) const
+    {
+      return m_Nodes[pixel] & ParentMask;
+    }
+
+    void
+    SetParent(SizeValueType pixel, SizeValueType parent)
+    {
+      m_Nodes[pixel] = (m_Nodes[pixel] & ~ParentMask) | static_cast<TNode>(parent);
+    }
+
+    TNode
+    GetFlags(SizeValueType pixel) const
+    {
+      return m_Nodes[pixel] & ~ParentMask;
+    }
+
+    /** Find the root of the component of a pixel, halving the path to it. */
+    SizeValueType
+    FindRoot(SizeValueType pixel);
+
+    /** Merge the components of two neighbor pixels if they are connected by
+     * the hysteresis thresholding. */
+    void
+    Link(SizeValueType pixel, SizeValueType neighbor);
+
+    std::vector<TNode> m_Nodes;
+  };
 
   /** Calculate the second derivative of the smoothed image, it writes the
    *  result to the update buffer */
@@ -249,10 +315,16 @@ private:
   OutputImagePixelType
   ComputeCannyEdge(const NeighborhoodType & it, void * globalData);
 
-  /** Calculate the gradient of the second derivative of the smoothed image,
-   *  it writes the result to m_UpdateBuffer1 */
+  /** Calculate the gradient of the second derivative of the smoothed image
+   *  and the zero crossings of the second derivative, and write the gradient
+   *  magnitude of the edge pixels to m_UpdateBuffer1 */
   void
-  ThreadedCompute2ndDerivativePos(const OutputImageRegionType & outputRegionForThread);
+  ThreadedComputeNonMaximumSuppression(const OutputImageRegionType & outputRegionForThread);
+
+  /** Check if the second derivative crosses zero at the center of the
+   *  neighborhood, as ZeroCrossingImageFilter. */
+  bool
+  IsZeroCrossing(const NeighborhoodType & it) const;
 
   ArrayType m_Variance;
   ArrayType m_MaximumError;
@@ -265,10 +337,6 @@ private:
   /** Gaussian filter to smooth the input image. */
   typename GaussianImageFilterType::Pointer m_GaussianFilter;
 
-  /** Multiply image filter to multiply with the zero crossings of the second
-   *  derivative. */
-  typename MultiplyImageFilterType::Pointer m_MultiplyImageFilter;
-
   /** Function objects that are used in the inner loops of derivatiVex
    *  calculations. */
   DerivativeOperator<OutputImagePixelType, Self::ImageDimension> m_ComputeCannyEdge1stDerivativeOper;
@@ -279,9 +347,6 @@ private:
   SizeValueType m_Stride[ImageDimension];
   SizeValueType m_Center;
 
-  typename ListNodeStorageType::Pointer m_NodeStore;
-  ListPointerType                       m_NodeList;
-
   OutputImageType * m_OutputImage;
 };
 } // end of namespace itk
@@ -18,15 +18,15 @@
 #ifndef itkCannyEdgeDetectionImageFilter_hxx
 #define itkCannyEdgeDetectionImageFilter_hxx
 
-#include "itkZeroCrossingImageFilter.h"
 #include "itkNeighborhoodInnerProduct.h"
 #include "itkNumericTraits.h"
-#include "itkProgressReporter.h"
-#include "itkGradientMagnitudeImageFilter.h"
-#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkMath.h"
 #include "itkProgressTransformer.h"
 
+#include <algorithm>
+
 namespace itk
 {
 template <typename TInputImage, typename TOutputImage>
@@ -38,7 +38,6 @@ CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::CannyEdgeDetectionImag
   m_MaximumError.Fill(0.01);
 
   m_GaussianFilter = GaussianImageFilterType::New();
-  m_MultiplyImageFilter = MultiplyImageFilterType::New();
   m_UpdateBuffer1 = OutputImageType::New();
 
   // Set up neighborhood slices for all the dimensions.
@@ -71,10 +70,6 @@ CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::CannyEdgeDetectionImag
   m_ComputeCannyEdge2ndDerivativeOper.SetOrder(2);
   m_ComputeCannyEdge2ndDerivativeOper.CreateDirectional();
 
-  // Initialize the list
-  m_NodeStore = ListNodeStorageType::New();
-  m_NodeList = ListType::New();
-
   m_OutputImage = nullptr;
 }
 
@@ -205,9 +200,6 @@ CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::GenerateData()
   output->Graft(this->GetOutput());
   this->m_OutputImage = output;
 
-  typename ZeroCrossingImageFilter<TOutputImage, TOutputImage>::Pointer zeroCrossFilter =
-    ZeroCrossingImageFilter<TOutputImage, TOutputImage>::New();
-
   this->AllocateUpdateBuffer();
 
   // 1.Apply the Gaussian Filter to the input image
@@ -232,37 +224,24 @@ CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::GenerateData()
     },
     progress1.GetProcessObject());
 
+  // 3. Non-maximum suppression
+
+  // Calculate the gradient of the 2nd directional derivative and its zero
+  // crossings, and write the gradient magnitude of the edge pixels to the
+  // update buffer.
   ProgressTransformer progress2(0.45f, 0.9f, this);
   this->GetMultiThreader()->template ParallelizeImageRegion<TOutputImage::ImageDimension>(
     this->GetOutput()->GetRequestedRegion(),
     [this](const OutputImageRegionType & outputRegionForThread) {
-      this->ThreadedCompute2ndDerivativePos(outputRegionForThread);
+      this->ThreadedComputeNonMaximumSuppression(outputRegionForThread);
     },
     progress2.GetProcessObject());
 
-  // 3. Non-maximum suppression
-
-  // Calculate the zero crossings of the 2nd directional derivative and write
-  // the result to output buffer.
-  zeroCrossFilter->SetInput(this->m_OutputImage);
-  zeroCrossFilter->Update();
-  this->UpdateProgress(0.92f);
+  // The smoothed image is no longer needed
+  m_GaussianFilter->GetOutput()->ReleaseData();
 
   // 4. Hysteresis Thresholding
-
-  // First get all the edges corresponding to zerocrossings
-  m_MultiplyImageFilter->SetInput1(m_UpdateBuffer1);
-  m_MultiplyImageFilter->SetInput2(zeroCrossFilter->GetOutput());
-
-  // To save memory, we will graft the output of the m_GaussianFilter,
-  // which is no longer needed, into the m_MultiplyImageFilter.
-  m_MultiplyImageFilter->GraftOutput(m_GaussianFilter->GetOutput());
-  m_MultiplyImageFilter->Update();
-  this->UpdateProgress(0.95f);
-
-  // Then do the double threshoulding upon the edge responses
   this->HysteresisThresholding();
-  this->UpdateProgress(0.99f);
 
   this->GraftOutput(output);
   this->m_OutputImage = nullptr;
@@ -272,147 +251,260 @@ CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::GenerateData()
 template <typename TInputImage, typename TOutputImage>
 void
 CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::HysteresisThresholding()
+{
+  // The nodes of the forest are 32 bits wide as long as the index of a pixel
+  // fits in the bits left by the flags.
+  const SizeValueType numberOfPixels = this->m_OutputImage->GetRequestedRegion().GetNumberOfPixels();
+  if (numberOfPixels <= EdgeForest<uint32_t>::ParentMask)
+  {
+    this->template HysteresisThresholding<uint32_t>();
+  }
+  else
+  {
+    this->template HysteresisThresholding<uint64_t>();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TNode>
+void
+CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::HysteresisThresholding()
 {
   // This is the Zero crossings of the Second derivative multiplied with the
   // gradients of the image. HysteresisThresholding of this image should give
   // the Canny output.
-  typename OutputImageType::Pointer input = m_MultiplyImageFilter->GetOutput();
-  float                             value;
+  const OutputImageType *     input = m_UpdateBuffer1;
+  const OutputImageRegionType region = this->m_OutputImage->GetRequestedRegion();
 
-  ListNodeType * node;
-
-  // fix me
-  ImageRegionIterator<TOutputImage> oit(input, input->GetRequestedRegion());
+  const SizeValueType numberOfPixels = region.GetNumberOfPixels();
+  if (numberOfPixels == 0)
+  {
+    return;
+  }
 
-  oit.GoToBegin();
+  // The pixels are numbered in the order of the region. A pixel above the
+  // lower threshold is linked to all its neighbors which are above the lower
+  // threshold, and a pixel above the upper threshold to all its neighbors
+  // above the lower threshold, as the edges were followed from the pixels
+  // above the upper threshold.
+  using ForestType = EdgeForest<TNode>;
+  ForestType forest;
+  forest.m_Nodes.resize(numberOfPixels);
+
+  // The neighbors which precede a pixel in the order of the region
+  OffsetValueType pixelStrides[ImageDimension];
+  pixelStrides[0] = 1;
+  for (unsigned int i = 1; i < ImageDimension; ++i)
+  {
+    pixelStrides[i] = pixelStrides[i - 1] * static_cast<OffsetValueType>(region.GetSize(i - 1));
+  }
 
-  ImageRegionIterator<TOutputImage> uit(this->m_OutputImage, this->m_OutputImage->GetRequestedRegion());
-  uit.GoToBegin();
-  while (!uit.IsAtEnd())
+  using OffsetType = typename OutputImageType::OffsetType;
+  std::vector<OffsetType>      neighborOffsets;
+  std::vector<OffsetValueType> neighborSteps;
+  const unsigned int           nSize = m_Center * 2 + 1;
+  for (unsigned int n = 0; n < nSize; ++n)
   {
-    uit.Value() = NumericTraits<OutputImagePixelType>::ZeroValue();
-    ++uit;
+    OffsetType      offset;
+    OffsetValueType step = 0;
+    unsigned int    digits = n;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      offset[i] = static_cast<OffsetValueType>(digits % 3) - 1;
+      digits /= 3;
+      step += offset[i] * pixelStrides[i];
+    }
+    if (step < 0)
+    {
+      neighborOffsets.push_back(offset);
+      neighborSteps.push_back(step);
+    }
   }
 
-  const OutputImageType * multiplyImageFilterOutput = this->m_MultiplyImageFilter->GetOutput();
-  while (!oit.IsAtEnd())
+  // The forest is built in slabs along the last dimension, whose pixels are
+  // contiguous in the numbering.
+  constexpr unsigned int SlabDimension = ImageDimension - 1;
+  const SizeValueType    slabDimensionSize = region.GetSize(SlabDimension);
+  const SizeValueType    numberOfSlabs =
+    std::min(static_cast<SizeValueType>(this->GetNumberOfWorkUnits()), slabDimensionSize);
+
+  const auto slabBegin = [slabDimensionSize, numberOfSlabs](SizeValueType slab) -> SizeValueType {
+    return slab * slabDimensionSize / numberOfSlabs;
+  };
+  const auto slabRegion = [&region, &slabBegin](SizeValueType slab) -> OutputImageRegionType {
+    OutputImageRegionType slabRegion = region;
+    slabRegion.SetIndex(SlabDimension,
+                        region.GetIndex(SlabDimension) + static_cast<IndexValueType>(slabBegin(slab)));
+    slabRegion.SetSize(SlabDimension, slabBegin(slab + 1) - slabBegin(slab));
+    return slabRegion;
+  };
+
+  ProgressTransformer progress1(0.9f, 0.95f, this);
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfSlabs,
+    [&](SizeValueType slab) {
+      const OutputImageRegionType currentRegion = slabRegion(slab);
+
+      SizeValueType pixel = slabBegin(slab) * pixelStrides[SlabDimension];
+      for (ImageRegionConstIteratorWithIndex<OutputImageType> it(input, currentRegion); !it.IsAtEnd(); ++it, ++pixel)
+      {
+        const OutputImagePixelType value = it.Get();
+        TNode                      flags = 0;
+        if (value > m_LowerThreshold)
+        {
+          flags |= ForestType::AboveLowerThreshold;
+        }
+        if (value > m_UpperThreshold)
+        {
+          flags |= ForestType::ConnectedToUpperThreshold;
+        }
+        forest.m_Nodes[pixel] = static_cast<TNode>(pixel) | flags;
+        if (flags == 0)
+        {
+          continue;
+        }
+
+        const IndexType index = it.GetIndex();
+        for (unsigned int i = 0; i < neighborOffsets.size(); ++i)
+        {
+          if (currentRegion.IsInside(index + neighborOffsets[i]))
+          {
+            forest.Link(pixel, pixel + neighborSteps[i]);
+          }
+        }
+      }
+    },
+    progress1.GetProcessObject());
+
+  // Merge the components across the boundaries between the slabs
+  for (SizeValueType slab = 1; slab < numberOfSlabs; ++slab)
   {
-    value = oit.Value();
+    OutputImageRegionType boundaryRegion = slabRegion(slab);
+    boundaryRegion.SetSize(SlabDimension, 1);
 
-    if (value > m_UpperThreshold)
+    SizeValueType pixel = slabBegin(slab) * pixelStrides[SlabDimension];
+    for (ImageRegionConstIteratorWithIndex<OutputImageType> it(input, boundaryRegion); !it.IsAtEnd(); ++it, ++pixel)
     {
-      node = m_NodeStore->Borrow();
-      node->m_Value = oit.GetIndex();
-      m_NodeList->PushFront(node);
-      FollowEdge(oit.GetIndex(), multiplyImageFilterOutput);
+      if (forest.GetFlags(pixel) == 0)
+      {
+        continue;
+      }
+
+      const IndexType index = it.GetIndex();
+      for (unsigned int i = 0; i < neighborOffsets.size(); ++i)
+      {
+        if (neighborOffsets[i][SlabDimension] < 0 && region.IsInside(index + neighborOffsets[i]))
+        {
+          forest.Link(pixel, pixel + neighborSteps[i]);
+        }
+      }
     }
+  }
 
-    ++oit;
+  // The edges are the components connected to a pixel above the upper
+  // threshold. The forest is only read, so that the roots are found
+  // without halving the paths.
+  ProgressTransformer progress2(0.95f, 0.99f, this);
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfSlabs,
+    [&](SizeValueType slab) {
+      SizeValueType pixel = slabBegin(slab) * pixelStrides[SlabDimension];
+      for (ImageRegionIterator<OutputImageType> it(this->m_OutputImage, slabRegion(slab)); !it.IsAtEnd();
+           ++it, ++pixel)
+      {
+        SizeValueType root = pixel;
+        while (forest.GetParent(root) != root)
+        {
+          root = forest.GetParent(root);
+        }
+        if (forest.GetFlags(pixel) != 0 && (forest.GetFlags(root) & ForestType::ConnectedToUpperThreshold))
+        {
+          it.Set(NumericTraits<OutputImagePixelType>::OneValue());
+        }
+        else
+        {
+          it.Set(NumericTraits<OutputImagePixelType>::ZeroValue());
+        }
+      }
+    },
+    progress2.GetProcessObject());
+}
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TNode>
+auto
+CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::EdgeForest<TNode>::FindRoot(SizeValueType pixel)
+  -> SizeValueType
+{
+  while (this->GetParent(pixel) != pixel)
+  {
+    this->SetParent(pixel, this->GetParent(this->GetParent(pixel)));
+    pixel = this->GetParent(pixel);
   }
+  return pixel;
 }
 
 template <typename TInputImage, typename TOutputImage>
+template <typename TNode>
 void
-CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::FollowEdge(IndexType               index,
-                                                                     const OutputImageType * multiplyImageFilterOutput)
+CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::EdgeForest<TNode>::Link(SizeValueType pixel,
+                                                                                   SizeValueType neighbor)
 {
-  // This is the Zero crossings of the Second derivative multiplied with the
-  // gradients of the image. HysteresisThresholding of this image should give
-  // the Canny output.
-  InputImageRegionType inputRegion = multiplyImageFilterOutput->GetRequestedRegion();
-
-  IndexType      nIndex;
-  IndexType      cIndex;
-  ListNodeType * node;
-
-  // Assign iterator radius
-  Size<ImageDimension> radius;
-  radius.Fill(1);
-
-  ConstNeighborhoodIterator<TOutputImage> oit(
-    radius, multiplyImageFilterOutput, multiplyImageFilterOutput->GetRequestedRegion());
-  ImageRegionIteratorWithIndex<TOutputImage> uit(this->m_OutputImage, this->m_OutputImage->GetRequestedRegion());
-
-  uit.SetIndex(index);
-  if (Math::ExactlyEquals(uit.Get(), NumericTraits<OutputImagePixelType>::OneValue()))
+  if (this->GetFlags(neighbor) == 0 || ((this->GetFlags(pixel) | this->GetFlags(neighbor)) & AboveLowerThreshold) == 0)
   {
-    // Remove the node if we are not going to follow it!
-    //
-    // Pop the front node from the list and read its index value.
-    node = m_NodeList->Front(); // get a pointer to the first node
-    m_NodeList->PopFront();     // unlink the front node
-    m_NodeStore->Return(node);  // return the memory for reuse
     return;
   }
 
-  int nSize = m_Center * 2 + 1;
-  while (!m_NodeList->Empty())
+  SizeValueType root = this->FindRoot(pixel);
+  SizeValueType neighborRoot = this->FindRoot(neighbor);
+  if (root == neighborRoot)
   {
-    // Pop the front node from the list and read its index value.
-    node = m_NodeList->Front(); // Get a pointer to the first node
-    cIndex = node->m_Value;     // Read the value of the first node
-    m_NodeList->PopFront();     // Unlink the front node
-    m_NodeStore->Return(node);  // Return the memory for reuse
-
-    // Move iterators to the correct index position.
-    oit.SetLocation(cIndex);
-    uit.SetIndex(cIndex);
-    uit.Value() = 1;
-
-    // Search the neighbors for new indices to add to the list.
-    for (int i = 0; i < nSize; ++i)
-    {
-      nIndex = oit.GetIndex(i);
-      uit.SetIndex(nIndex);
-      if (inputRegion.IsInside(nIndex))
-      {
-        if (oit.GetPixel(i) > m_LowerThreshold &&
-            Math::NotExactlyEquals(uit.Value(), NumericTraits<OutputImagePixelType>::OneValue()))
-        {
-          node = m_NodeStore->Borrow(); // Get a new node struct
-          node->m_Value = nIndex;       // Set its value
-          m_NodeList->PushFront(node);  // Add the new node to the list
+    return;
+  }
 
-          uit.SetIndex(nIndex);
-          uit.Value() = NumericTraits<OutputImagePixelType>::OneValue();
-        }
-      }
-    }
+  // The root of a component is its first pixel
+  if (root < neighborRoot)
+  {
+    std::swap(root, neighborRoot);
   }
+  this->SetParent(root, neighborRoot);
+  m_Nodes[neighborRoot] |= m_Nodes[root] & ConnectedToUpperThreshold;
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
-CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::ThreadedCompute2ndDerivativePos(
+CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::ThreadedComputeNonMaximumSuppression(
   const OutputImageRegionType & outputRegionForThread)
 {
-  ZeroFluxNeumannBoundaryCondition<TInputImage> nbc;
+  ZeroFluxNeumannBoundaryCondition<OutputImageType> nbc;
 
-  ConstNeighborhoodIterator<TInputImage> bit;
-  ConstNeighborhoodIterator<TInputImage> bit1;
+  NeighborhoodType bit;
+  NeighborhoodType bit1;
 
   ImageRegionIterator<TOutputImage> it;
 
   // Here input is the result from the gaussian filter
   //      input1 is the 2nd derivative result
-  //      output is the gradient of 2nd derivative
+  //      output is the gradient magnitude of the edge pixels
   typename OutputImageType::Pointer input1 = this->m_OutputImage;
   typename OutputImageType::Pointer input = m_GaussianFilter->GetOutput();
 
-  typename InputImageType::Pointer output = m_UpdateBuffer1;
+  typename OutputImageType::Pointer output = m_UpdateBuffer1;
 
   // Set iterator radius
   Size<ImageDimension> radius;
   radius.Fill(1);
 
   // Find the data-set boundary "faces"
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<TInputImage>::FaceListType faceList;
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<TInputImage>                        bC;
+  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<OutputImageType>::FaceListType faceList;
+  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<OutputImageType>                        bC;
   faceList = bC(input, outputRegionForThread, radius);
 
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<TInputImage>::FaceListType::iterator fit;
+  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<OutputImageType>::FaceListType::iterator fit;
 
-  InputImagePixelType zero = NumericTraits<InputImagePixelType>::ZeroValue();
+  const OutputImagePixelType zero = NumericTraits<OutputImagePixelType>::ZeroValue();
 
   OutputImagePixelType dx[ImageDimension];
   OutputImagePixelType dx1[ImageDimension];
@@ -429,8 +521,8 @@ CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::ThreadedCompute2ndDeri
 
   for (fit = faceList.begin(); fit != faceList.end(); ++fit)
   {
-    bit = ConstNeighborhoodIterator<InputImageType>(radius, input, *fit);
-    bit1 = ConstNeighborhoodIterator<InputImageType>(radius, input1, *fit);
+    bit = NeighborhoodType(radius, input, *fit);
+    bit1 = NeighborhoodType(radius, input1, *fit);
     it = ImageRegionIterator<OutputImageType>(output, *fit);
     bit.OverrideBoundaryCondition(&nbc);
     bit.GoToBegin();
@@ -460,8 +552,17 @@ CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::ThreadedCompute2ndDeri
         derivPos += dx1[i] * directional[i];
       }
 
-      it.Value() = ((derivPos <= zero));
-      it.Value() = it.Get() * gradMag;
+      // Keep the gradient magnitude at the zero crossings of the 2nd
+      // derivative where the gradient of the 2nd derivative does not point
+      // along the gradient
+      if (derivPos <= zero && this->IsZeroCrossing(bit1))
+      {
+        it.Value() = gradMag;
+      }
+      else
+      {
+        it.Value() = zero;
+      }
       ++bit;
       ++bit1;
       ++it;
@@ -469,6 +570,34 @@ CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::ThreadedCompute2ndDeri
   }
 }
 
+template <typename TInputImage, typename TOutputImage>
+bool
+CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::IsZeroCrossing(const NeighborhoodType & it) const
+{
+  const OutputImagePixelType zero = NumericTraits<OutputImagePixelType>::ZeroValue();
+  const OutputImagePixelType thisOne = it.GetPixel(m_Center);
+
+  // The neighbors before the center are checked first, so that a crossing
+  // between two pixels of the same magnitude is assigned to the first one
+  for (unsigned int i = 0; i < ImageDimension * 2; ++i)
+  {
+    const OutputImagePixelType that =
+      i < ImageDimension ? it.GetPixel(m_Center - m_Stride[i]) : it.GetPixel(m_Center + m_Stride[i - ImageDimension]);
+    if (((thisOne < zero) && (that > zero)) || ((thisOne > zero) && (that < zero)) ||
+        ((Math::ExactlyEquals(thisOne, zero)) && (Math::NotExactlyEquals(that, zero))) ||
+        ((Math::NotExactlyEquals(thisOne, zero)) && (Math::ExactlyEquals(that, zero))))
+    {
+      const OutputImagePixelType absThisOne = itk::Math::abs(thisOne);
+      const OutputImagePixelType absThat = itk::Math::abs(that);
+      if (absThisOne < absThat || (Math::ExactlyEquals(absThisOne, absThat) && i >= ImageDimension))
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
@@ -486,7 +615,6 @@ CannyEdgeDetectionImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream
   os << "Center: " << m_Center << std::endl;
   os << "Stride: " << m_Stride << std::endl;
   itkPrintSelfObjectMacro(GaussianFilter);
-  itkPrintSelfObjectMacro(MultiplyImageFilter);
   itkPrintSelfObjectMacro(UpdateBuffer1);
 }
 } // namespace itk
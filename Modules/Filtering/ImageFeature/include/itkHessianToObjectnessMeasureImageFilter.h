@@ -21,6 +21,8 @@
 #include "itkSymmetricSecondRankTensor.h"
 #include "itkImageToImageFilter.h"
 
+#include <type_traits>
+
 namespace itk
 {
 /**
@@ -36,6 +38,11 @@ namespace itk
  * pixels ) and produces an enhanced image. The Hessian input image can be produced
  * using itk::HessianRecursiveGaussianImageFilter.
  *
+ * In 2D and 3D, the eigenvalues of the Hessian are computed for blocks of
+ * pixels of a scanline with SymmetricEigenAnalysisBatch. In higher
+ * dimensions they are computed pixel by pixel with
+ * SymmetricEigenAnalysisFixedDimension.
+ *
  *
  * \par References
  * Frangi, AF, Niessen, WJ, Vincken, KL, & Viergever, MA (1998). Multiscale Vessel
@@ -53,6 +60,7 @@ namespace itk
  * \sa Hessian3DToVesselnessMeasureImageFilter
  * \sa HessianRecursiveGaussianImageFilter
  * \sa SymmetricEigenAnalysisImageFilter
+ * \sa SymmetricEigenAnalysisBatch
  * \sa SymmetricSecondRankTensor
  *
  * \ingroup ITKImageFeature
@@ -142,6 +150,15 @@ protected:
 
 
 private:
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, std::true_type);
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, std::false_type);
+
+  /** Compute the objectness measure from the eigenvalues of the Hessian. */
+  double
+  ComputeObjectnessMeasure(const EigenValueArrayType & eigenValues) const;
+
   // functor used to sort the eigenvalues are to be sorted
   // |e1|<=|e2|<=...<=|eN|
   //
@@ -19,7 +19,9 @@
 #define itkHessianToObjectnessMeasureImageFilter_hxx
 
 #include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
 #include "itkSymmetricEigenAnalysis.h"
+#include "itkSymmetricEigenAnalysisBatch.h"
 #include "itkProgressReporter.h"
 #include "itkTotalProgressReporter.h"
 
@@ -53,6 +55,59 @@ template <typename TInputImage, typename TOutputImage>
 void
 HessianToObjectnessMeasureImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
+{
+  this->DynamicThreadedGenerateData(outputRegionForThread,
+                                    std::integral_constant < bool, ImageDimension == 2 || ImageDimension == 3 > ());
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+HessianToObjectnessMeasureImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread,
+  std::true_type)
+{
+  using BatchType = SymmetricEigenAnalysisBatch<ImageDimension, EigenValueType>;
+
+  OutputImageType *      output = this->GetOutput();
+  const InputImageType * input = this->GetInput();
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels(), 1000);
+
+  BatchType batch;
+
+  ImageScanlineConstIterator<InputImageType> it(input, outputRegionForThread);
+  ImageScanlineIterator<OutputImageType>     oit(output, outputRegionForThread);
+
+  while (!it.IsAtEnd())
+  {
+    while (!it.IsAtEndOfLine())
+    {
+      unsigned int numberOfPixels = 0;
+      for (; numberOfPixels < BatchType::BlockSize && !it.IsAtEndOfLine(); ++numberOfPixels, ++it)
+      {
+        batch.SetMatrix(numberOfPixels, it.Get());
+      }
+
+      batch.ComputeEigenValues(numberOfPixels);
+
+      for (unsigned int n = 0; n < numberOfPixels; ++n, ++oit)
+      {
+        EigenValueArrayType eigenValues;
+        batch.GetEigenValues(n, eigenValues);
+        oit.Set(static_cast<OutputPixelType>(this->ComputeObjectnessMeasure(eigenValues)));
+      }
+      progress.Completed(numberOfPixels);
+    }
+    it.NextLine();
+    oit.NextLine();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+HessianToObjectnessMeasureImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread,
+  std::false_type)
 {
   OutputImageType *      output = this->GetOutput();
   const InputImageType * input = this->GetInput();
@@ -76,105 +131,109 @@ HessianToObjectnessMeasureImageFilter<TInputImage, TOutputImage>::DynamicThreade
     EigenValueArrayType eigenValues;
     eigenCalculator.ComputeEigenValues(it.Get(), eigenValues);
 
-    // Sort the eigenvalues by magnitude but retain their sign.
-    // The eigenvalues are to be sorted |e1|<=|e2|<=...<=|eN|
-    EigenValueArrayType sortedEigenValues = eigenValues;
-    std::sort(sortedEigenValues.Begin(), sortedEigenValues.End(), AbsLessCompare());
+    oit.Set(static_cast<OutputPixelType>(this->ComputeObjectnessMeasure(eigenValues)));
 
-    // Check whether eigenvalues have the right sign
-    bool signConstraintsSatisfied = true;
-    for (unsigned int i = m_ObjectDimension; i < ImageDimension; ++i)
-    {
-      if ((m_BrightObject && sortedEigenValues[i] > 0.0) || (!m_BrightObject && sortedEigenValues[i] < 0.0))
-      {
-        signConstraintsSatisfied = false;
-        break;
-      }
-    }
+    ++it;
+    ++oit;
+    progress.CompletedPixel();
+  }
+}
 
-    if (!signConstraintsSatisfied)
+template <typename TInputImage, typename TOutputImage>
+double
+HessianToObjectnessMeasureImageFilter<TInputImage, TOutputImage>::ComputeObjectnessMeasure(
+  const EigenValueArrayType & eigenValues) const
+{
+  // Sort the eigenvalues by magnitude but retain their sign.
+  // The eigenvalues are to be sorted |e1|<=|e2|<=...<=|eN|
+  EigenValueArrayType sortedEigenValues = eigenValues;
+  std::sort(sortedEigenValues.Begin(), sortedEigenValues.End(), AbsLessCompare());
+
+  // Check whether eigenvalues have the right sign
+  bool signConstraintsSatisfied = true;
+  for (unsigned int i = m_ObjectDimension; i < ImageDimension; ++i)
+  {
+    if ((m_BrightObject && sortedEigenValues[i] > 0.0) || (!m_BrightObject && sortedEigenValues[i] < 0.0))
     {
-      oit.Set(NumericTraits<OutputPixelType>::ZeroValue());
-      ++it;
-      ++oit;
-      progress.CompletedPixel();
-      continue;
+      signConstraintsSatisfied = false;
+      break;
     }
+  }
 
-    EigenValueArrayType sortedAbsEigenValues;
-    for (unsigned int i = 0; i < ImageDimension; ++i)
-    {
-      sortedAbsEigenValues[i] = itk::Math::abs(sortedEigenValues[i]);
-    }
+  if (!signConstraintsSatisfied)
+  {
+    return 0.0;
+  }
 
-    // Initialize the objectness measure
-    double objectnessMeasure = 1.0;
+  EigenValueArrayType sortedAbsEigenValues;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    sortedAbsEigenValues[i] = itk::Math::abs(sortedEigenValues[i]);
+  }
 
-    // Compute objectness from eigenvalue ratios and second-order structureness
-    if (m_ObjectDimension < ImageDimension - 1)
+  // Initialize the objectness measure
+  double objectnessMeasure = 1.0;
+
+  // Compute objectness from eigenvalue ratios and second-order structureness
+  if (m_ObjectDimension < ImageDimension - 1)
+  {
+    double rA = sortedAbsEigenValues[m_ObjectDimension];
+    double rADenominatorBase = 1.0;
+    for (unsigned int j = m_ObjectDimension + 1; j < ImageDimension; ++j)
     {
-      double rA = sortedAbsEigenValues[m_ObjectDimension];
-      double rADenominatorBase = 1.0;
-      for (unsigned int j = m_ObjectDimension + 1; j < ImageDimension; ++j)
-      {
-        rADenominatorBase *= sortedAbsEigenValues[j];
-      }
-      if (itk::Math::abs(rADenominatorBase) > 0.0)
-      {
-        if (itk::Math::abs(m_Alpha) > 0.0)
-        {
-          rA /= std::pow(rADenominatorBase, 1.0 / (ImageDimension - m_ObjectDimension - 1));
-          objectnessMeasure *= 1.0 - std::exp(-0.5 * itk::Math::sqr(rA) / itk::Math::sqr(m_Alpha));
-        }
-      }
-      else
-      {
-        objectnessMeasure = 0.0;
-      }
+      rADenominatorBase *= sortedAbsEigenValues[j];
     }
-
-    if (m_ObjectDimension > 0)
+    if (itk::Math::abs(rADenominatorBase) > 0.0)
     {
-      double rB = sortedAbsEigenValues[m_ObjectDimension - 1];
-      double rBDenominatorBase = 1.0;
-      for (unsigned int j = m_ObjectDimension; j < ImageDimension; ++j)
-      {
-        rBDenominatorBase *= sortedAbsEigenValues[j];
-      }
-      if (itk::Math::abs(rBDenominatorBase) > 0.0 && itk::Math::abs(m_Beta) > 0.0)
-      {
-        rB /= std::pow(rBDenominatorBase, 1.0 / (ImageDimension - m_ObjectDimension));
-
-        objectnessMeasure *= std::exp(-0.5 * itk::Math::sqr(rB) / itk::Math::sqr(m_Beta));
-      }
-      else
+      if (itk::Math::abs(m_Alpha) > 0.0)
       {
-        objectnessMeasure = 0.0;
+        rA /= std::pow(rADenominatorBase, 1.0 / (ImageDimension - m_ObjectDimension - 1));
+        objectnessMeasure *= 1.0 - std::exp(-0.5 * itk::Math::sqr(rA) / itk::Math::sqr(m_Alpha));
       }
     }
+    else
+    {
+      objectnessMeasure = 0.0;
+    }
+  }
 
-    if (itk::Math::abs(m_Gamma) > 0.0)
+  if (m_ObjectDimension > 0)
+  {
+    double rB = sortedAbsEigenValues[m_ObjectDimension - 1];
+    double rBDenominatorBase = 1.0;
+    for (unsigned int j = m_ObjectDimension; j < ImageDimension; ++j)
     {
-      double frobeniusNormSquared = 0.0;
-      for (unsigned int i = 0; i < ImageDimension; ++i)
-      {
-        frobeniusNormSquared += itk::Math::sqr(sortedAbsEigenValues[i]);
-      }
-      objectnessMeasure *= 1.0 - std::exp(-0.5 * frobeniusNormSquared / itk::Math::sqr(m_Gamma));
+      rBDenominatorBase *= sortedAbsEigenValues[j];
     }
+    if (itk::Math::abs(rBDenominatorBase) > 0.0 && itk::Math::abs(m_Beta) > 0.0)
+    {
+      rB /= std::pow(rBDenominatorBase, 1.0 / (ImageDimension - m_ObjectDimension));
 
-    // Just in case, scale by largest absolute eigenvalue
-    if (m_ScaleObjectnessMeasure)
+      objectnessMeasure *= std::exp(-0.5 * itk::Math::sqr(rB) / itk::Math::sqr(m_Beta));
+    }
+    else
     {
-      objectnessMeasure *= sortedAbsEigenValues[ImageDimension - 1];
+      objectnessMeasure = 0.0;
     }
+  }
 
-    oit.Set(static_cast<OutputPixelType>(objectnessMeasure));
+  if (itk::Math::abs(m_Gamma) > 0.0)
+  {
+    double frobeniusNormSquared = 0.0;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      frobeniusNormSquared += itk::Math::sqr(sortedAbsEigenValues[i]);
+    }
+    objectnessMeasure *= 1.0 - std::exp(-0.5 * frobeniusNormSquared / itk::Math::sqr(m_Gamma));
+  }
 
-    ++it;
-    ++oit;
-    progress.CompletedPixel();
+  // Just in case, scale by largest absolute eigenvalue
+  if (m_ScaleObjectnessMeasure)
+  {
+    objectnessMeasure *= sortedAbsEigenValues[ImageDimension - 1];
   }
+
+  return objectnessMeasure;
 }
 
 template <typename TInputImage, typename TOutputImage>
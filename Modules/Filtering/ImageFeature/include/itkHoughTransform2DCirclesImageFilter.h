@@ -41,6 +41,17 @@ namespace itk
  * radius given by the user, and fills in the array of radii.
  * The SweepAngle value can be adjusted to improve the segmentation.
  *
+ * The votes are computed in parallel for slabs of rows of the input, each
+ * into its own accumulator, and added in the order of the slabs, so that the
+ * outputs are reproducible and the accumulator does not depend on the number
+ * of work units. The accumulator and radius images of the slabs take
+ * (number of work units - 1) times the memory of the outputs; when that
+ * exceeds MaximumAccumulatorMemory, the rows of the outputs are split into
+ * bands instead, each voted for directly by the input pixels within the
+ * maximum radius of it. The gradients of the input pixels close to the
+ * boundaries of the bands are then computed by several work units. The maxima
+ * of the accumulator are also searched in parallel by GetCircles().
+ *
  * The filter will detect ring-shaped objects in the image, but it also finds discs.
  * For a disc to be found, the intensity values within the disc must be higher than
  * the surrounding of the disc.
@@ -175,6 +186,13 @@ public:
   itkSetMacro(UseImageSpacing, bool);
   itkGetConstMacro(UseImageSpacing, bool);
 
+  /** Set/Get the maximum memory, in bytes, of the accumulator and radius
+   * images which the work units allocate in addition to the outputs. Beyond
+   * it, the work units vote directly into bands of rows of the outputs.
+   * Defaults to 64 MiB. */
+  itkSetMacro(MaximumAccumulatorMemory, SizeValueType);
+  itkGetConstMacro(MaximumAccumulatorMemory, SizeValueType);
+
 
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
@@ -206,6 +224,12 @@ protected:
   EnlargeOutputRequestedRegion(DataObject * itkNotUsed(output)) override;
 
 private:
+  /** Find the maximum of an image, and its first index in the order of the
+   * image. */
+  template <typename TImage>
+  void
+  FindMaximum(const TImage * image, typename TImage::PixelType & maximum, IndexType & indexOfMaximum) const;
+
   double m_SweepAngle{ 0.0 };
   double m_MinimumRadius{ 0.0 };
   double m_MaximumRadius{ 10.0 };
@@ -219,6 +243,7 @@ private:
   double              m_DiscRadiusRatio{ 1 };
   double              m_Variance{ 10 };
   bool                m_UseImageSpacing{ true };
+  SizeValueType       m_MaximumAccumulatorMemory{ SizeValueType{ 1 } << 26 };
   ModifiedTimeType    m_OldModifiedTime{ 0 };
 };
 } // end namespace itk
@@ -21,9 +21,11 @@
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkDiscreteGaussianImageFilter.h"
 #include "itkGaussianDerivativeImageFunction.h"
-#include "itkMinimumMaximumImageCalculator.h"
 #include "itkMath.h"
 
+#include <mutex>
+#include <vector>
+
 namespace itk
 {
 template <typename TInputPixelType, typename TOutputPixelType, typename TRadiusPixelType>
@@ -105,76 +107,184 @@ HoughTransform2DCirclesImageFilter<TInputPixelType, TOutputPixelType, TRadiusPix
   m_RadiusImage->SetDirection(inputImage->GetDirection());
   m_RadiusImage->Allocate(true); // initialize buffer to zero
 
-  ImageRegionConstIteratorWithIndex<InputImageType> image_it(inputImage, inputImage->GetRequestedRegion());
-  image_it.GoToBegin();
-
   const ImageRegion<2> & region = outputImage->GetRequestedRegion();
-
-  while (!image_it.IsAtEnd())
-  {
-    if (image_it.Get() > m_Threshold)
+  const ImageRegion<2> & inputRegion = inputImage->GetRequestedRegion();
+
+  // Vote for the centers of the circles through the pixels of the given
+  // input region, into the rows [firstRow, lastRow) of the accumulator
+  const auto vote = [&](OutputImageType *      accumulator,
+                        RadiusImageType *      radiusSum,
+                        const ImageRegion<2> & votingRegion,
+                        IndexValueType         firstRow,
+                        IndexValueType         lastRow) {
+    for (ImageRegionConstIteratorWithIndex<InputImageType> image_it(inputImage, votingRegion); !image_it.IsAtEnd();
+         ++image_it)
     {
-      const Index<2>                             inputIndex = image_it.GetIndex();
-      const typename DoGFunctionType::VectorType grad = DoGFunction->DoGFunctionType::EvaluateAtIndex(inputIndex);
-
-      double Vx = grad[0];
-      double Vy = grad[1];
+      if (image_it.Get() > m_Threshold)
+      {
+        const Index<2>                             inputIndex = image_it.GetIndex();
+        const typename DoGFunctionType::VectorType grad = DoGFunction->DoGFunctionType::EvaluateAtIndex(inputIndex);
 
-      const double norm = std::sqrt(Vx * Vx + Vy * Vy);
+        double Vx = grad[0];
+        double Vy = grad[1];
 
-      // if the gradient is not flat (using GradientNormThreshold to estimate flatness)
-      if (norm > m_GradientNormThreshold)
-      {
-        Vx /= norm;
-        Vy /= norm;
+        const double norm = std::sqrt(Vx * Vx + Vy * Vy);
 
-        for (double angle = -m_SweepAngle; angle <= m_SweepAngle; angle += 0.05)
+        // if the gradient is not flat (using GradientNormThreshold to estimate flatness)
+        if (norm > m_GradientNormThreshold)
         {
-          double i = m_MinimumRadius;
-          double distance;
+          Vx /= norm;
+          Vy /= norm;
 
-          do
+          for (double angle = -m_SweepAngle; angle <= m_SweepAngle; angle += 0.05)
           {
-            const Index<2> outputIndex = {
-              { Math::Round<IndexValueType>(inputIndex[0] - i * (Vx * std::cos(angle) + Vy * std::sin(angle))),
-                Math::Round<IndexValueType>(inputIndex[1] - i * (Vx * std::sin(angle) + Vy * std::cos(angle))) }
-            };
+            double i = m_MinimumRadius;
+            double distance;
 
-            if (region.IsInside(outputIndex))
-            {
-              distance =
-                std::sqrt(static_cast<double>((outputIndex[0] - inputIndex[0]) * (outputIndex[0] - inputIndex[0]) +
-                                              (outputIndex[1] - inputIndex[1]) * (outputIndex[1] - inputIndex[1])));
-
-              ++outputImage->GetPixel(outputIndex);
-              m_RadiusImage->GetPixel(outputIndex) += distance;
-            }
-            else
+            do
             {
-              break;
-            }
-            ++i;
-          } while (distance < m_MaximumRadius);
+              const Index<2> outputIndex = {
+                { Math::Round<IndexValueType>(inputIndex[0] - i * (Vx * std::cos(angle) + Vy * std::sin(angle))),
+                  Math::Round<IndexValueType>(inputIndex[1] - i * (Vx * std::sin(angle) + Vy * std::cos(angle))) }
+              };
+
+              if (region.IsInside(outputIndex))
+              {
+                distance =
+                  std::sqrt(static_cast<double>((outputIndex[0] - inputIndex[0]) * (outputIndex[0] - inputIndex[0]) +
+                                                (outputIndex[1] - inputIndex[1]) * (outputIndex[1] - inputIndex[1])));
+
+                if (outputIndex[1] >= firstRow && outputIndex[1] < lastRow)
+                {
+                  ++accumulator->GetPixel(outputIndex);
+                  radiusSum->GetPixel(outputIndex) += distance;
+                }
+              }
+              else
+              {
+                break;
+              }
+              ++i;
+            } while (distance < m_MaximumRadius);
+          }
         }
       }
     }
-    ++image_it;
-  }
+  };
+
+  // The rows of the input are split into slabs, which vote in parallel into
+  // their own accumulator and radius images. The first slab votes directly
+  // into the outputs, and the other ones are added to them in the order of
+  // the slabs, so that the result is reproducible.
+  const SizeValueType numberOfSlabs =
+    std::min(static_cast<SizeValueType>(this->GetNumberOfWorkUnits()), inputRegion.GetSize(1));
+  const SizeValueType bytesPerSlab = region.GetNumberOfPixels() * (sizeof(TOutputPixelType) + sizeof(TRadiusPixelType));
+
+  std::vector<OutputImagePointer> accumulators;
+  std::vector<RadiusImagePointer> radiusSums;
 
-  // Compute the average radius
-  ImageRegionConstIterator<OutputImageType> output_it(outputImage, outputImage->GetLargestPossibleRegion());
-  ImageRegionIterator<RadiusImageType>      radius_it(m_RadiusImage, m_RadiusImage->GetLargestPossibleRegion());
-  output_it.GoToBegin();
-  radius_it.GoToBegin();
-  while (!output_it.IsAtEnd())
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  if ((numberOfSlabs - 1) * bytesPerSlab <= m_MaximumAccumulatorMemory)
   {
-    if (output_it.Get() > 1)
-    {
-      radius_it.Value() /= output_it.Get();
-    }
-    ++output_it;
-    ++radius_it;
+    accumulators.resize(numberOfSlabs);
+    radiusSums.resize(numberOfSlabs);
+
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfSlabs,
+      [&](SizeValueType slab) {
+        if (slab == 0)
+        {
+          accumulators[slab] = outputImage;
+          radiusSums[slab] = m_RadiusImage;
+        }
+        else
+        {
+          accumulators[slab] = OutputImageType::New();
+          accumulators[slab]->SetRegions(region);
+          accumulators[slab]->Allocate(true);
+          radiusSums[slab] = RadiusImageType::New();
+          radiusSums[slab]->SetRegions(region);
+          radiusSums[slab]->Allocate(true);
+        }
+
+        const SizeValueType firstRow = slab * inputRegion.GetSize(1) / numberOfSlabs;
+        const SizeValueType lastRow = (slab + 1) * inputRegion.GetSize(1) / numberOfSlabs;
+        ImageRegion<2>      slabRegion = inputRegion;
+        slabRegion.SetIndex(1, inputRegion.GetIndex(1) + static_cast<IndexValueType>(firstRow));
+        slabRegion.SetSize(1, lastRow - firstRow);
+
+        vote(accumulators[slab],
+             radiusSums[slab],
+             slabRegion,
+             region.GetIndex(1),
+             region.GetIndex(1) + static_cast<IndexValueType>(region.GetSize(1)));
+      },
+      nullptr);
+  }
+  else
+  {
+    // The accumulators of the slabs would take too much memory: the rows of
+    // the outputs are split into bands instead, and each band is voted for by
+    // the input pixels which are close enough to it, in the order of the
+    // input.
+    const SizeValueType numberOfBands =
+      std::min(static_cast<SizeValueType>(this->GetNumberOfWorkUnits()), region.GetSize(1));
+    const auto reach = Math::Ceil<IndexValueType>(std::max(m_MinimumRadius, m_MaximumRadius)) + 3;
+
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfBands,
+      [&](SizeValueType band) {
+        const IndexValueType firstRow =
+          region.GetIndex(1) + static_cast<IndexValueType>(band * region.GetSize(1) / numberOfBands);
+        const IndexValueType lastRow =
+          region.GetIndex(1) + static_cast<IndexValueType>((band + 1) * region.GetSize(1) / numberOfBands);
+
+        const IndexValueType firstInputRow = std::max(firstRow - reach, inputRegion.GetIndex(1));
+        const IndexValueType lastInputRow =
+          std::min(lastRow + reach, inputRegion.GetIndex(1) + static_cast<IndexValueType>(inputRegion.GetSize(1)));
+        if (firstInputRow >= lastInputRow)
+        {
+          return;
+        }
+        ImageRegion<2> votingRegion = inputRegion;
+        votingRegion.SetIndex(1, firstInputRow);
+        votingRegion.SetSize(1, static_cast<SizeValueType>(lastInputRow - firstInputRow));
+
+        vote(outputImage, m_RadiusImage, votingRegion, firstRow, lastRow);
+      },
+      nullptr);
   }
+
+  // Add the votes of the slabs and compute the average radius
+  this->GetMultiThreader()->template ParallelizeImageRegion<2>(
+    region,
+    [&](const OutputImageRegionType & regionForThread) {
+      for (SizeValueType slab = 1; slab < accumulators.size(); ++slab)
+      {
+        ImageRegionIterator<OutputImageType>      output_it(outputImage, regionForThread);
+        ImageRegionIterator<RadiusImageType>      radius_it(m_RadiusImage, regionForThread);
+        ImageRegionConstIterator<OutputImageType> accumulator_it(accumulators[slab], regionForThread);
+        ImageRegionConstIterator<RadiusImageType> radiusSum_it(radiusSums[slab], regionForThread);
+        for (; !output_it.IsAtEnd(); ++output_it, ++radius_it, ++accumulator_it, ++radiusSum_it)
+        {
+          output_it.Value() += accumulator_it.Get();
+          radius_it.Value() += radiusSum_it.Get();
+        }
+      }
+
+      ImageRegionConstIterator<OutputImageType> output_it(outputImage, regionForThread);
+      ImageRegionIterator<RadiusImageType>      radius_it(m_RadiusImage, regionForThread);
+      for (; !output_it.IsAtEnd(); ++output_it, ++radius_it)
+      {
+        if (output_it.Get() > 1)
+        {
+          radius_it.Value() /= output_it.Get();
+        }
+      }
+    },
+    nullptr);
 }
 
 template <typename TInputPixelType, typename TOutputPixelType, typename TRadiusPixelType>
@@ -217,19 +327,17 @@ HoughTransform2DCirclesImageFilter<TInputPixelType, TOutputPixelType, TRadiusPix
     gaussianFilter->Update();
     const InternalImageType::Pointer postProcessImage = gaussianFilter->GetOutput();
 
-    const auto                             minMaxCalculator = MinimumMaximumImageCalculator<InternalImageType>::New();
-    ImageRegionIterator<InternalImageType> it_input(postProcessImage, postProcessImage->GetLargestPossibleRegion());
-
     CirclesListSizeType circles = 0;
 
     // Find maxima
     // Break out of "forever loop" as soon as the requested number of circles is found.
     for (;;)
     {
-      minMaxCalculator->SetImage(postProcessImage);
-      minMaxCalculator->ComputeMaximum();
+      InternalImageType::PixelType maximum;
+      IndexType                    indexOfMaximum;
+      this->FindMaximum(postProcessImage.GetPointer(), maximum, indexOfMaximum);
 
-      if (minMaxCalculator->GetMaximum() <= 0)
+      if (maximum <= 0)
       {
         // When all pixel values in 'postProcessImage' are zero or less, no more circles
         // should be found. Note that a zero in 'postProcessImage' might correspond to a
@@ -238,8 +346,6 @@ HoughTransform2DCirclesImageFilter<TInputPixelType, TOutputPixelType, TRadiusPix
         break;
       }
 
-      const InternalImageType::IndexType indexOfMaximum = minMaxCalculator->GetIndexOfMaximum();
-
       // Create a Circle Spatial Object
       const auto Circle = CircleType::New();
       Circle->SetId(static_cast<int>(circles));
@@ -280,6 +386,50 @@ HoughTransform2DCirclesImageFilter<TInputPixelType, TOutputPixelType, TRadiusPix
   return m_CirclesList;
 }
 
+template <typename TInputPixelType, typename TOutputPixelType, typename TRadiusPixelType>
+template <typename TImage>
+void
+HoughTransform2DCirclesImageFilter<TInputPixelType, TOutputPixelType, TRadiusPixelType>::FindMaximum(
+  const TImage *               image,
+  typename TImage::PixelType & maximum,
+  IndexType &                  indexOfMaximum) const
+{
+  using ImagePixelType = typename TImage::PixelType;
+
+  maximum = NumericTraits<ImagePixelType>::NonpositiveMin();
+  indexOfMaximum = image->GetRequestedRegion().GetIndex();
+
+  // Each work unit finds the first maximum of its region, and the maximum
+  // which comes first in the order of the image is kept, as
+  // MinimumMaximumImageCalculator would find.
+  std::mutex mutex;
+  this->GetMultiThreader()->template ParallelizeImageRegion<2>(
+    image->GetRequestedRegion(),
+    [&](const OutputImageRegionType & regionForThread) {
+      ImagePixelType regionMaximum = NumericTraits<ImagePixelType>::NonpositiveMin();
+      IndexType      regionIndexOfMaximum = regionForThread.GetIndex();
+      for (ImageRegionConstIteratorWithIndex<TImage> it(image, regionForThread); !it.IsAtEnd(); ++it)
+      {
+        if (it.Get() > regionMaximum)
+        {
+          regionMaximum = it.Get();
+          regionIndexOfMaximum = it.GetIndex();
+        }
+      }
+
+      const std::lock_guard<std::mutex> lock(mutex);
+      if (regionMaximum > maximum ||
+          (Math::ExactlyEquals(regionMaximum, maximum) &&
+           (regionIndexOfMaximum[1] < indexOfMaximum[1] ||
+            (regionIndexOfMaximum[1] == indexOfMaximum[1] && regionIndexOfMaximum[0] < indexOfMaximum[0]))))
+      {
+        maximum = regionMaximum;
+        indexOfMaximum = regionIndexOfMaximum;
+      }
+    },
+    nullptr);
+}
+
 template <typename TInputPixelType, typename TOutputPixelType, typename TRadiusPixelType>
 void
 HoughTransform2DCirclesImageFilter<TInputPixelType, TOutputPixelType, TRadiusPixelType>::PrintSelf(std::ostream & os,
@@ -297,6 +447,7 @@ HoughTransform2DCirclesImageFilter<TInputPixelType, TOutputPixelType, TRadiusPix
   os << indent << "Accumulator blur variance: " << m_Variance << std::endl;
   os << indent << "Sweep angle : " << m_SweepAngle << std::endl;
   os << indent << "UseImageSpacing: " << m_UseImageSpacing << std::endl;
+  os << indent << "MaximumAccumulatorMemory: " << m_MaximumAccumulatorMemory << std::endl;
 
   itkPrintSelfObjectMacro(RadiusImage);
 
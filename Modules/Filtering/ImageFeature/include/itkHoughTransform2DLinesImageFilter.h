@@ -50,6 +50,23 @@ namespace itk
  * (500 by default) for the angle axis. The distance axis depends on the
  * size of the diagonal of the input image.
  *
+ * By default, every pixel above the threshold votes for all the angles.
+ * When UseGradientDirection is on, the pixels above the threshold whose
+ * gradient norm is above GradientNormThreshold only vote for the angles
+ * within SweepAngle of the direction of their gradient, which is normal to
+ * the edge, and the other pixels do not vote. The input is then expected to
+ * be an intensity image rather than an edge image.
+ *
+ * The votes are computed in parallel for slabs of rows of the input, each
+ * into its own accumulator, and added in the order of the slabs, so that the
+ * output does not depend on the number of work units. The accumulators of
+ * the slabs take (number of work units - 1) times the memory of the output;
+ * when that exceeds MaximumAccumulatorMemory, the angles of the output are
+ * split into bands instead, each voted for directly by all the input pixels.
+ * With UseGradientDirection on, every work unit then computes the gradients
+ * of all the input pixels above the threshold. The maxima of the accumulator
+ * are also searched in parallel by GetLines().
+ *
  * \ingroup ImageFeatureExtraction
  * \sa LineSpatialObject
  *
@@ -107,6 +124,10 @@ public:
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
+  /** Verifies the preconditions of this filter. */
+  void
+  VerifyPreconditions() ITKv5_CONST override;
+
   /** Method for evaluating the implicit function over the image. */
   void
   GenerateData() override;
@@ -148,6 +169,36 @@ public:
   itkSetMacro(Variance, double);
   itkGetConstMacro(Variance, double);
 
+  /** Set/Get whether the pixels only vote for the angles close to the
+   * direction of their gradient. Off by default. */
+  itkSetMacro(UseGradientDirection, bool);
+  itkGetConstMacro(UseGradientDirection, bool);
+  itkBooleanMacro(UseGradientDirection);
+
+  /** Set/Get the scale of the derivative function (using DoG), when
+   * UseGradientDirection is on. */
+  itkSetMacro(SigmaGradient, double);
+  itkGetConstMacro(SigmaGradient, double);
+
+  /** Threshold for the norm of the gradient: when UseGradientDirection is
+   * on, only pixels whose gradient norm is above this threshold vote. The
+   * threshold must be >= 0. */
+  itkSetMacro(GradientNormThreshold, double);
+  itkGetConstMacro(GradientNormThreshold, double);
+
+  /** Set/Get the largest difference, in radians, between the angle of a
+   * vote and the direction of the gradient, when UseGradientDirection is
+   * on. The angle closest to the direction of the gradient always gets a
+   * vote. */
+  itkSetMacro(SweepAngle, double);
+  itkGetConstMacro(SweepAngle, double);
+
+  /** Set/Get the maximum memory, in bytes, of the accumulators which the work
+   * units allocate in addition to the output. Beyond it, the work units vote
+   * directly into bands of angles of the output. Defaults to 64 MiB. */
+  itkSetMacro(MaximumAccumulatorMemory, SizeValueType);
+  itkGetConstMacro(MaximumAccumulatorMemory, SizeValueType);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(IntConvertibleToOutputCheck, (Concept::Convertible<int, TOutputPixelType>));
@@ -183,6 +234,11 @@ protected:
   EnlargeOutputRequestedRegion(DataObject * output) override;
 
 private:
+  /** Find the maximum of an image. */
+  template <typename TImage>
+  typename TImage::PixelType
+  FindMaximum(const TImage * image) const;
+
   double m_AngleResolution{ 500 };
   double m_Threshold{ 0 };
 
@@ -191,6 +247,11 @@ private:
   LinesListSizeType  m_NumberOfLines{ 1 };
   double             m_DiscRadius{ 10 };
   double             m_Variance{ 5 };
+  bool               m_UseGradientDirection{ false };
+  double             m_SigmaGradient{ 1.0 };
+  double             m_GradientNormThreshold{ 1.0 };
+  double             m_SweepAngle{ 0.0 };
+  SizeValueType      m_MaximumAccumulatorMemory{ SizeValueType{ 1 } << 26 };
   ModifiedTimeType   m_OldModifiedTime{ 0 };
 };
 } // end namespace itk
@@ -20,10 +20,13 @@
 
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkDiscreteGaussianImageFilter.h"
-#include "itkMinimumMaximumImageCalculator.h"
+#include "itkGaussianDerivativeImageFunction.h"
 #include "itkCastImageFilter.h"
 #include "itkMath.h"
 
+#include <mutex>
+#include <vector>
+
 namespace itk
 {
 
@@ -89,6 +92,19 @@ HoughTransform2DLinesImageFilter<TInputPixelType, TOutputPixelType>::GenerateInp
 }
 
 
+template <typename TInputPixelType, typename TOutputPixelType>
+void
+HoughTransform2DLinesImageFilter<TInputPixelType, TOutputPixelType>::VerifyPreconditions() ITKv5_CONST
+{
+  Superclass::VerifyPreconditions();
+
+  if (!(m_GradientNormThreshold >= 0.0))
+  {
+    itkExceptionMacro("Failed precondition: GradientNormThreshold >= 0.");
+  }
+}
+
+
 template <typename TInputPixelType, typename TOutputPixelType>
 void
 HoughTransform2DLinesImageFilter<TInputPixelType, TOutputPixelType>::GenerateData()
@@ -103,34 +119,161 @@ HoughTransform2DLinesImageFilter<TInputPixelType, TOutputPixelType>::GenerateDat
 
   const double nPI = 4.0 * std::atan(1.0);
 
-  ImageRegionConstIteratorWithIndex<InputImageType> image_it(inputImage, inputImage->GetRequestedRegion());
-  image_it.GoToBegin();
+  // The gradient is computed in the index space, where the lines are
+  // parameterized.
+  using DoGFunctionType = GaussianDerivativeImageFunction<InputImageType>;
+  const auto DoGFunction = DoGFunctionType::New();
+  if (m_UseGradientDirection)
+  {
+    DoGFunction->SetSigma(m_SigmaGradient);
+    DoGFunction->SetUseImageSpacing(false);
+    DoGFunction->SetInputImage(inputImage);
+  }
+  const double         angleStep = nPI / m_AngleResolution;
+  const IndexValueType numberOfAngles = Math::Ceil<IndexValueType>(2.0 * m_AngleResolution);
+  const IndexValueType halfSweep = Math::Floor<IndexValueType>(m_SweepAngle / angleStep);
+
+  const ImageRegion<2> & region = outputImage->GetRequestedRegion();
+  const ImageRegion<2> & inputRegion = inputImage->GetRequestedRegion();
+
+  // Vote for the lines through the pixels of the given input region, into
+  // the rows [firstRow, lastRow) of the accumulator, which are the angles
+  const auto voteForRegion = [&](OutputImageType *      accumulator,
+                                 const ImageRegion<2> & votingRegion,
+                                 IndexValueType         firstRow,
+                                 IndexValueType         lastRow) {
+    const auto vote = [accumulator, firstRow, lastRow, nPI, this](const IndexType & inputIndex, double angle) {
+      Index<2> index;
+      // m_Theta
+      index[1] = (IndexValueType)((m_AngleResolution / 2) + m_AngleResolution * angle / (2 * nPI));
+      if (index[1] < firstRow || index[1] >= lastRow)
+      {
+        return;
+      }
+      // m_R
+      index[0] = (IndexValueType)(inputIndex[0] * std::cos(angle) + inputIndex[1] * std::sin(angle));
 
-  Index<2> index;
+      if (index[0] > 0 && index[0] <= (IndexValueType)accumulator->GetBufferedRegion().GetSize()[0])
+      // The preceding "if" should be replaceable with "if (
+      // outputImage->GetBufferedRegion().IsInside(index) )" but
+      // the algorithm fails if it is
+      {
+        accumulator->SetPixel(index, accumulator->GetPixel(index) + 1);
+      }
+    };
 
-  while (!image_it.IsAtEnd())
-  {
-    if (image_it.Get() > m_Threshold)
+    for (ImageRegionConstIteratorWithIndex<InputImageType> image_it(inputImage, votingRegion); !image_it.IsAtEnd();
+         ++image_it)
     {
-      for (double angle = -nPI; angle < nPI; angle += nPI / m_AngleResolution)
+      if (image_it.Get() > m_Threshold)
       {
-        index[0] =
-          // m_R
-          (IndexValueType)(image_it.GetIndex()[0] * std::cos(angle) + image_it.GetIndex()[1] * std::sin(angle));
-        // m_Theta
-        index[1] = (IndexValueType)((m_AngleResolution / 2) + m_AngleResolution * angle / (2 * nPI));
+        const IndexType inputIndex = image_it.GetIndex();
+        if (!m_UseGradientDirection)
+        {
+          for (double angle = -nPI; angle < nPI; angle += nPI / m_AngleResolution)
+          {
+            vote(inputIndex, angle);
+          }
+          continue;
+        }
 
-        if (index[0] > 0 && index[0] <= (IndexValueType)outputImage->GetBufferedRegion().GetSize()[0])
-        // The preceding "if" should be replaceable with "if (
-        // outputImage->GetBufferedRegion().IsInside(index) )" but
-        // the algorithm fails if it is
+        const typename DoGFunctionType::VectorType grad = DoGFunction->DoGFunctionType::EvaluateAtIndex(inputIndex);
+        if (std::sqrt(grad[0] * grad[0] + grad[1] * grad[1]) > m_GradientNormThreshold)
         {
-          outputImage->SetPixel(index, outputImage->GetPixel(index) + 1);
+          // The normal to the line is along the gradient, in either
+          // direction; the distance to the corner is only positive for one
+          // of them.
+          const double gradientAngle = std::atan2(grad[1], grad[0]);
+          for (const double normalAngle : { gradientAngle, gradientAngle + nPI })
+          {
+            const auto closestAngle = Math::Round<IndexValueType>((normalAngle + nPI) / angleStep);
+            for (IndexValueType k = closestAngle - halfSweep; k <= closestAngle + halfSweep; ++k)
+            {
+              vote(inputIndex, -nPI + (((k % numberOfAngles) + numberOfAngles) % numberOfAngles) * angleStep);
+            }
+          }
         }
       }
     }
-    ++image_it;
+  };
+
+  // The rows of the input are split into slabs, which vote in parallel into
+  // their own accumulator. The first slab votes directly into the output,
+  // and the other ones are added to it in the order of the slabs.
+  const SizeValueType numberOfSlabs =
+    std::min(static_cast<SizeValueType>(this->GetNumberOfWorkUnits()), inputRegion.GetSize(1));
+  const SizeValueType bytesPerSlab = region.GetNumberOfPixels() * sizeof(TOutputPixelType);
+
+  std::vector<OutputImagePointer> accumulators;
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  if ((numberOfSlabs - 1) * bytesPerSlab <= m_MaximumAccumulatorMemory)
+  {
+    accumulators.resize(numberOfSlabs);
+
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfSlabs,
+      [&](SizeValueType slab) {
+        if (slab == 0)
+        {
+          accumulators[slab] = outputImage;
+        }
+        else
+        {
+          accumulators[slab] = OutputImageType::New();
+          accumulators[slab]->SetRegions(region);
+          accumulators[slab]->Allocate(true);
+        }
+
+        const SizeValueType firstRow = slab * inputRegion.GetSize(1) / numberOfSlabs;
+        const SizeValueType lastRow = (slab + 1) * inputRegion.GetSize(1) / numberOfSlabs;
+        ImageRegion<2>      slabRegion = inputRegion;
+        slabRegion.SetIndex(1, inputRegion.GetIndex(1) + static_cast<IndexValueType>(firstRow));
+        slabRegion.SetSize(1, lastRow - firstRow);
+
+        voteForRegion(accumulators[slab],
+                      slabRegion,
+                      NumericTraits<IndexValueType>::NonpositiveMin(),
+                      NumericTraits<IndexValueType>::max());
+      },
+      nullptr);
+  }
+  else
+  {
+    // The accumulators of the slabs would take too much memory: the angles
+    // of the output are split into bands instead, and each band is voted for
+    // by all the input pixels.
+    const SizeValueType numberOfBands =
+      std::min(static_cast<SizeValueType>(this->GetNumberOfWorkUnits()), region.GetSize(1));
+
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      numberOfBands,
+      [&](SizeValueType band) {
+        voteForRegion(outputImage,
+                      inputRegion,
+                      region.GetIndex(1) + static_cast<IndexValueType>(band * region.GetSize(1) / numberOfBands),
+                      region.GetIndex(1) + static_cast<IndexValueType>((band + 1) * region.GetSize(1) / numberOfBands));
+      },
+      nullptr);
   }
+
+  // Add the votes of the slabs
+  this->GetMultiThreader()->template ParallelizeImageRegion<2>(
+    region,
+    [&](const OutputImageRegionType & regionForThread) {
+      for (SizeValueType slab = 1; slab < accumulators.size(); ++slab)
+      {
+        ImageRegionIterator<OutputImageType>      output_it(outputImage, regionForThread);
+        ImageRegionConstIterator<OutputImageType> accumulator_it(accumulators[slab], regionForThread);
+        for (; !output_it.IsAtEnd(); ++output_it, ++accumulator_it)
+        {
+          output_it.Value() += accumulator_it.Get();
+        }
+      }
+    },
+    nullptr);
 }
 
 
@@ -256,8 +399,6 @@ HoughTransform2DLinesImageFilter<TInputPixelType, TOutputPixelType>::GetLines()
     gaussianFilter->Update();
     const InternalImageType::Pointer postProcessImage = gaussianFilter->GetOutput();
 
-    using MinMaxCalculatorType = MinimumMaximumImageCalculator<InternalImageType>;
-    auto                                        minMaxCalculator = MinMaxCalculatorType::New();
     itk::ImageRegionIterator<InternalImageType> it_input(postProcessImage,
                                                          postProcessImage->GetLargestPossibleRegion());
 
@@ -269,9 +410,7 @@ HoughTransform2DLinesImageFilter<TInputPixelType, TOutputPixelType>::GetLines()
     // Find maxima
     do
     {
-      minMaxCalculator->SetImage(postProcessImage);
-      minMaxCalculator->ComputeMaximum();
-      InternalImageType::PixelType max = minMaxCalculator->GetMaximum();
+      InternalImageType::PixelType max = this->FindMaximum(postProcessImage.GetPointer());
 
       if (max <= 0)
       {
@@ -341,9 +480,7 @@ HoughTransform2DLinesImageFilter<TInputPixelType, TOutputPixelType>::GetLines()
               }
             }
           }
-          minMaxCalculator->SetImage(postProcessImage);
-          minMaxCalculator->ComputeMaximum();
-          max = minMaxCalculator->GetMaximum();
+          max = this->FindMaximum(postProcessImage.GetPointer());
 
           lines++;
           if (lines == m_NumberOfLines)
@@ -360,6 +497,33 @@ HoughTransform2DLinesImageFilter<TInputPixelType, TOutputPixelType>::GetLines()
 }
 
 
+template <typename TInputPixelType, typename TOutputPixelType>
+template <typename TImage>
+typename TImage::PixelType
+HoughTransform2DLinesImageFilter<TInputPixelType, TOutputPixelType>::FindMaximum(const TImage * image) const
+{
+  using ImagePixelType = typename TImage::PixelType;
+
+  ImagePixelType maximum = NumericTraits<ImagePixelType>::NonpositiveMin();
+
+  std::mutex mutex;
+  this->GetMultiThreader()->template ParallelizeImageRegion<2>(
+    image->GetRequestedRegion(),
+    [&](const OutputImageRegionType & regionForThread) {
+      ImagePixelType regionMaximum = NumericTraits<ImagePixelType>::NonpositiveMin();
+      for (ImageRegionConstIterator<TImage> it(image, regionForThread); !it.IsAtEnd(); ++it)
+      {
+        regionMaximum = std::max(regionMaximum, it.Get());
+      }
+
+      const std::lock_guard<std::mutex> lock(mutex);
+      maximum = std::max(maximum, regionMaximum);
+    },
+    nullptr);
+  return maximum;
+}
+
+
 template <typename TInputPixelType, typename TOutputPixelType>
 void
 HoughTransform2DLinesImageFilter<TInputPixelType, TOutputPixelType>::PrintSelf(std::ostream & os, Indent indent) const
@@ -371,6 +535,11 @@ HoughTransform2DLinesImageFilter<TInputPixelType, TOutputPixelType>::PrintSelf(s
   os << indent << "Number Of Lines: " << m_NumberOfLines << std::endl;
   os << indent << "Disc Radius: " << m_DiscRadius << std::endl;
   os << indent << "Accumulator blur variance: " << m_Variance << std::endl;
+  os << indent << "UseGradientDirection: " << m_UseGradientDirection << std::endl;
+  os << indent << "Derivative Scale : " << m_SigmaGradient << std::endl;
+  os << indent << "Gradient Norm Threshold: " << m_GradientNormThreshold << std::endl;
+  os << indent << "Sweep angle : " << m_SweepAngle << std::endl;
+  os << indent << "MaximumAccumulatorMemory: " << m_MaximumAccumulatorMemory << std::endl;
   itkPrintSelfObjectMacro(SimplifyAccumulator);
 
   os << indent << "LinesList: " << std::endl;
@@ -20,6 +20,7 @@
 
 #include "itkImageToImageFilter.h"
 #include "itkHessianRecursiveGaussianImageFilter.h"
+#include "itkExtractImageFilter.h"
 #include "ITKImageFeatureExport.h"
 
 namespace itk
@@ -62,6 +63,16 @@ extern ITKImageFeature_EXPORT std::ostream &
  * The filter computes a second output image (accessed by the GetScalesOutput method)
  * containing the scales at which each pixel gave the best response.
  *
+ * By default the Hessian and the measure of each scale are computed over the
+ * whole image. When SlabSize is set, they are computed for slabs of SlabSize
+ * slices along the last dimension, each extended by a margin of the input
+ * proportional to the scale, and only the running best response is kept for
+ * the whole image. The memory used by the Hessian and the measure is then
+ * proportional to the slab size rather than to the image size, at the cost of
+ * computing the margins again for each slab. Since the recursive Gaussian
+ * filters have an infinite support, the responses differ very slightly from
+ * the ones computed over the whole image.
+ *
  *
  * This code was contributed in the Insight Journal paper:
  * "Generalizing vesselness with respect to dimensionality and shape"
@@ -117,6 +128,9 @@ public:
   /** Hessian computation filter. */
   using HessianFilterType = HessianRecursiveGaussianImageFilter<InputImageType, HessianImageType>;
 
+  /** Filter extracting the slabs of the input. */
+  using SlabFilterType = ExtractImageFilter<InputImageType, InputImageType>;
+
   /** Update image buffer that holds the best objectness response. This is not redundant from
    the output image because the latter may not be of float type, which is required for the comparisons
    between responses at different scales. */
@@ -201,6 +215,17 @@ public:
   itkGetConstMacro(GenerateHessianOutput, bool);
   itkBooleanMacro(GenerateHessianOutput);
 
+  /** Set/Get the number of slices along the last dimension for which the
+   * Hessian and the measure are computed at once. Zero, the default,
+   * computes them over the whole image. */
+  itkSetMacro(SlabSize, SizeValueType);
+  itkGetConstMacro(SlabSize, SizeValueType);
+
+  /** Set/Get the margin added on each side of a slab, in multiples of the
+   * scale. Default is 6. */
+  itkSetMacro(SlabMarginInSigmas, double);
+  itkGetConstMacro(SlabMarginInSigmas, double);
+
   /** This is overloaded to create the Scales and Hessian output images */
   using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
 
@@ -223,7 +248,12 @@ protected:
 
 private:
   void
-  UpdateMaximumResponse(double sigma);
+  UpdateMaximumResponse(double sigma, const OutputRegionType & region);
+
+  /** Compute the measure at a given scale slab by slab, and update the
+   * maximum response with the measure of each slab. */
+  void
+  UpdateMaximumResponseBySlabs(double sigma);
 
   double
   ComputeSigmaValue(int scaleLevel);
@@ -243,10 +273,15 @@ private:
 
   typename HessianFilterType::Pointer m_HessianFilter;
 
+  typename SlabFilterType::Pointer m_SlabFilter;
+
   typename UpdateBufferType::Pointer m_UpdateBuffer;
 
   bool m_GenerateScalesOutput;
   bool m_GenerateHessianOutput;
+
+  SizeValueType m_SlabSize{ 0 };
+  double        m_SlabMarginInSigmas{ 6.0 };
 };
 } // end namespace itk
 
@@ -46,6 +46,7 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
   m_SigmaStepMethod = Self::SigmaStepMethodEnum::LogarithmicSigmaSteps;
 
   m_HessianFilter = HessianFilterType::New();
+  m_SlabFilter = SlabFilterType::New();
   m_HessianToMeasureFilter = nullptr;
 
   // Instantiate Update buffer
@@ -162,7 +163,23 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
 
   typename InputImageType::ConstPointer input = this->GetInput();
 
-  this->m_HessianFilter->SetInput(input);
+  // the meta-data should match between the output and the images computed
+  // at each scale, therefore we iterate over the desired output region
+  const OutputRegionType outputRegion = this->GetOutput()->GetBufferedRegion();
+
+  const SizeValueType numberOfSlices = outputRegion.GetSize(ImageDimension - 1);
+  const bool          computeBySlabs = m_SlabSize > 0 && m_SlabSize < numberOfSlices;
+  const SizeValueType numberOfSlabs = computeBySlabs ? (numberOfSlices + m_SlabSize - 1) / m_SlabSize : 1;
+
+  if (computeBySlabs)
+  {
+    this->m_SlabFilter->SetInput(input);
+    this->m_HessianFilter->SetInput(this->m_SlabFilter->GetOutput());
+  }
+  else
+  {
+    this->m_HessianFilter->SetInput(input);
+  }
 
   this->m_HessianFilter->SetNormalizeAcrossScale(true);
 
@@ -174,8 +191,9 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
   // prevent a divide by zero
   if (m_NumberOfSigmaSteps > 0)
   {
-    progress->RegisterInternalFilter(this->m_HessianFilter, .5 / m_NumberOfSigmaSteps);
-    progress->RegisterInternalFilter(this->m_HessianToMeasureFilter, .5 / m_NumberOfSigmaSteps);
+    const float weight = .5 / (m_NumberOfSigmaSteps * numberOfSlabs);
+    progress->RegisterInternalFilter(this->m_HessianFilter, weight);
+    progress->RegisterInternalFilter(this->m_HessianToMeasureFilter, weight);
   }
 
   for (unsigned int scaleLevel = 0; scaleLevel < m_NumberOfSigmaSteps; ++scaleLevel)
@@ -188,15 +206,20 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
 
     m_HessianToMeasureFilter->SetInput(m_HessianFilter->GetOutput());
 
-    m_HessianToMeasureFilter->Update();
+    if (computeBySlabs)
+    {
+      this->UpdateMaximumResponseBySlabs(sigma);
+    }
+    else
+    {
+      m_HessianToMeasureFilter->GetOutput()->SetRequestedRegion(outputRegion);
+      m_HessianToMeasureFilter->Update();
 
-    this->UpdateMaximumResponse(sigma);
+      this->UpdateMaximumResponse(sigma, outputRegion);
+    }
   }
 
   // Write out the best response to the output image
-  // we can assume that the meta-data should match between these two
-  // image, therefore we iterate over the desired output region
-  OutputRegionType                      outputRegion = this->GetOutput()->GetBufferedRegion();
   ImageRegionIterator<UpdateBufferType> it(m_UpdateBuffer, outputRegion);
   it.GoToBegin();
 
@@ -212,16 +235,65 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
 
   // Release data from the update buffer.
   m_UpdateBuffer->ReleaseData();
+
+  if (computeBySlabs)
+  {
+    // do not keep the last slab
+    m_HessianToMeasureFilter->GetOutput()->ReleaseData();
+    m_HessianFilter->GetOutput()->ReleaseData();
+    m_SlabFilter->GetOutput()->ReleaseData();
+  }
 }
 
 template <typename TInputImage, typename THessianImage, typename TOutputImage>
 void
-MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::UpdateMaximumResponse(double sigma)
+MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::UpdateMaximumResponseBySlabs(
+  double sigma)
 {
-  // the meta-data should match between these images, therefore we
-  // iterate over the desired output region
-  OutputRegionType outputRegion = this->GetOutput()->GetBufferedRegion();
+  constexpr unsigned int lastDimension = ImageDimension - 1;
+
+  const InputImageType * input = this->GetInput();
+  const OutputRegionType outputRegion = this->GetOutput()->GetBufferedRegion();
 
+  // the Hessian of each slice of a slab is computed from a margin of slices
+  // on each side, so that it hardly depends on the slab boundaries
+  const auto margin =
+    static_cast<SizeValueType>(std::ceil(m_SlabMarginInSigmas * sigma / input->GetSpacing()[lastDimension]));
+
+  const IndexValueType outputEnd =
+    outputRegion.GetIndex(lastDimension) + static_cast<IndexValueType>(outputRegion.GetSize(lastDimension));
+
+  for (IndexValueType slabStart = outputRegion.GetIndex(lastDimension); slabStart < outputEnd;
+       slabStart += static_cast<IndexValueType>(m_SlabSize))
+  {
+    OutputRegionType slabRegion = outputRegion;
+    slabRegion.SetIndex(lastDimension, slabStart);
+    slabRegion.SetSize(lastDimension, std::min<SizeValueType>(m_SlabSize, outputEnd - slabStart));
+
+    typename InputImageType::RegionType paddedRegion = slabRegion;
+    paddedRegion.SetIndex(lastDimension, slabStart - static_cast<IndexValueType>(margin));
+    paddedRegion.SetSize(lastDimension, slabRegion.GetSize(lastDimension) + 2 * margin);
+    paddedRegion.Crop(input->GetLargestPossibleRegion());
+
+    itkDebugMacro(<< "Computing measure for slab " << slabRegion << " from " << paddedRegion);
+
+    m_SlabFilter->SetExtractionRegion(paddedRegion);
+
+    // the measure is only needed in the slab, the Hessian filter
+    // computes its whole input anyway
+    m_HessianToMeasureFilter->GetOutput()->SetRequestedRegion(slabRegion);
+    m_HessianToMeasureFilter->Update();
+
+    this->UpdateMaximumResponse(sigma, slabRegion);
+  }
+}
+
+template <typename TInputImage, typename THessianImage, typename TOutputImage>
+void
+MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImage>::UpdateMaximumResponse(
+  double                   sigma,
+  const OutputRegionType & outputRegion)
+{
   ImageRegionIterator<UpdateBufferType> oit(m_UpdateBuffer, outputRegion);
 
   typename ScalesImageType::Pointer    scalesImage = static_cast<ScalesImageType *>(this->ProcessObject::GetOutput(1));
@@ -367,6 +439,8 @@ MultiScaleHessianBasedMeasureImageFilter<TInputImage, THessianImage, TOutputImag
   os << indent << "NonNegativeHessianBasedMeasure:  " << m_NonNegativeHessianBasedMeasure << std::endl;
   os << indent << "GenerateScalesOutput: " << m_GenerateScalesOutput << std::endl;
   os << indent << "GenerateHessianOutput: " << m_GenerateHessianOutput << std::endl;
+  os << indent << "SlabSize: " << m_SlabSize << std::endl;
+  os << indent << "SlabMarginInSigmas: " << m_SlabMarginInSigmas << std::endl;
 }
 } // end namespace itk
 
@@ -0,0 +1,141 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkCannyEdgeDetectionImageFilter.h"
+#include "itkConstNeighborhoodIterator.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <vector>
+
+// The edges of a synthetic image are detected with several numbers of work
+// units, and compared with the edges followed one by one from the pixels of
+// the non-maximum suppression image above the upper threshold.
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+
+using ImageType = itk::Image<float, Dimension>;
+using FilterType = itk::CannyEdgeDetectionImageFilter<ImageType, ImageType>;
+
+ImageType::Pointer
+CreateImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 96, 73 } });
+  image->Allocate();
+
+  // a blob and a ramp, with a deterministic texture which makes short edges
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    const double               blob = itk::Math::sqr(index[0] - 40.0) + itk::Math::sqr(index[1] - 30.0) < 400.0;
+    const double               texture = (index[0] * 7919 + index[1] * 104729) % 23;
+    it.Set(static_cast<float>(100.0 * blob + 0.5 * index[0] + texture));
+  }
+  return image;
+}
+
+// Follow the edges from the pixels above the upper threshold to their
+// neighbors above the lower threshold.
+ImageType::Pointer
+FollowEdges(const ImageType * nonMaximum, const ImageType::RegionType & region, float lower, float upper)
+{
+  auto edges = ImageType::New();
+  edges->SetRegions(region);
+  edges->Allocate(true);
+
+  ImageType::SizeType radius;
+  radius.Fill(1);
+  itk::ConstNeighborhoodIterator<ImageType> nit(radius, nonMaximum, region);
+
+  std::vector<ImageType::IndexType> front;
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(nonMaximum, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() > upper && edges->GetPixel(it.GetIndex()) == 0.0f)
+    {
+      edges->SetPixel(it.GetIndex(), 1.0f);
+      front.push_back(it.GetIndex());
+    }
+    while (!front.empty())
+    {
+      nit.SetLocation(front.back());
+      front.pop_back();
+      for (unsigned int i = 0; i < nit.Size(); ++i)
+      {
+        const ImageType::IndexType neighbor = nit.GetIndex(i);
+        if (region.IsInside(neighbor) && nonMaximum->GetPixel(neighbor) > lower && edges->GetPixel(neighbor) == 0.0f)
+        {
+          edges->SetPixel(neighbor, 1.0f);
+          front.push_back(neighbor);
+        }
+      }
+    }
+  }
+  return edges;
+}
+} // namespace
+
+int
+itkCannyEdgeDetectionImageFilterHysteresisTest(int, char *[])
+{
+  const ImageType::Pointer input = CreateImage();
+
+  // the usual thresholds, and a lower threshold above the upper one
+  const float thresholds[][2] = { { 2.0f, 6.0f }, { 6.0f, 2.0f } };
+  for (const auto & threshold : thresholds)
+  {
+    for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3, 16 })
+    {
+      auto filter = FilterType::New();
+      filter->SetInput(input);
+      filter->SetVariance(1.0);
+      filter->SetLowerThreshold(threshold[0]);
+      filter->SetUpperThreshold(threshold[1]);
+      filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+      const ImageType::Pointer expected = FollowEdges(
+        filter->GetNonMaximumSuppressionImage(), filter->GetOutput()->GetBufferedRegion(), threshold[0], threshold[1]);
+
+      itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+      itk::ImageRegionConstIterator<ImageType> expectedIt(expected, expected->GetBufferedRegion());
+      unsigned int                             numberOfEdgePixels = 0;
+      for (; !it.IsAtEnd(); ++it, ++expectedIt)
+      {
+        if (it.Get() != expectedIt.Get())
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "With thresholds " << threshold[0] << " and " << threshold[1] << " and " << numberOfWorkUnits
+                    << " work units, the output at " << it.GetIndex() << " is " << it.Get() << " instead of "
+                    << expectedIt.Get() << std::endl;
+          return EXIT_FAILURE;
+        }
+        numberOfEdgePixels += it.Get() != 0.0f;
+      }
+      std::cout << "Thresholds " << threshold[0] << " and " << threshold[1] << ", " << numberOfWorkUnits
+                << " work units: " << numberOfEdgePixels << " edge pixels" << std::endl;
+      ITK_TEST_EXPECT_TRUE(numberOfEdgePixels > 0);
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -19,6 +19,7 @@
 #include "itkHoughTransform2DCirclesImageFilter.h"
 #include "itkThresholdImageFilter.h"
 #include "itkGradientMagnitudeImageFilter.h"
+#include "itkMinimumMaximumImageCalculator.h"
 #include "itkCastImageFilter.h"
 #include "itkMath.h"
 #include "itkTestingMacros.h"
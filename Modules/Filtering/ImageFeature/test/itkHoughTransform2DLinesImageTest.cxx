@@ -19,6 +19,7 @@
 #include "itkHoughTransform2DLinesImageFilter.h"
 #include "itkThresholdImageFilter.h"
 #include "itkGradientMagnitudeImageFilter.h"
+#include "itkMinimumMaximumImageCalculator.h"
 #include "itkMath.h"
 #include "itkTestingMacros.h"
 
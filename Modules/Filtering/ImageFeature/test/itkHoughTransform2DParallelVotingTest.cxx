@@ -0,0 +1,246 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkHoughTransform2DCirclesImageFilter.h"
+#include "itkHoughTransform2DLinesImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+// The accumulators of the Hough transforms of a synthetic image, and the
+// lines and circles found in them, are computed with several numbers of work
+// units, with and without the accumulators of the slabs, and compared. The
+// lines of an intensity image are also found with votes restricted to the
+// direction of the gradient.
+
+namespace
+{
+using ImageType = itk::Image<double, 2>;
+using LinesFilterType = itk::HoughTransform2DLinesImageFilter<double, double>;
+using CirclesFilterType = itk::HoughTransform2DCirclesImageFilter<double, double, double>;
+
+ImageType::Pointer
+CreateEdgesImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 160, 121 } });
+  image->Allocate(true);
+
+  // two lines, two rings, and a deterministic scatter of isolated pixels
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    const double               x = index[0];
+    const double               y = index[1];
+    const bool                 isEdge = itk::Math::abs(0.3 * x + y - 50.0) < 1.0 || itk::Math::abs(x - 110.0) < 1.0 ||
+                        itk::Math::abs(std::hypot(x - 45.0, y - 80.0) - 20.0) < 1.0 ||
+                        itk::Math::abs(std::hypot(x - 125.0, y - 40.0) - 12.0) < 1.0 ||
+                        (index[0] * 31 + index[1] * 17) % 97 == 0;
+    it.Set(isEdge ? 255.0 : 0.0);
+  }
+  return image;
+}
+
+double
+MaximumDifference(const ImageType * image1, const ImageType * image2)
+{
+  double                                   maximumDifference = 0.0;
+  itk::ImageRegionConstIterator<ImageType> it1(image1, image1->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> it2(image2, image2->GetBufferedRegion());
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    maximumDifference = std::max(maximumDifference, itk::Math::abs(it1.Get() - it2.Get()));
+  }
+  return maximumDifference;
+}
+
+double
+SumOfVotes(const ImageType * accumulator)
+{
+  double sum = 0.0;
+  for (itk::ImageRegionConstIterator<ImageType> it(accumulator, accumulator->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    sum += it.Get();
+  }
+  return sum;
+}
+} // namespace
+
+int
+itkHoughTransform2DParallelVotingTest(int, char *[])
+{
+  const ImageType::Pointer edges = CreateEdgesImage();
+
+  auto referenceLines = LinesFilterType::New();
+  referenceLines->SetInput(edges);
+  referenceLines->SetNumberOfLines(2);
+  referenceLines->SetNumberOfWorkUnits(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceLines->Update());
+  const LinesFilterType::LinesListType referenceLinesList = referenceLines->GetLines();
+  ITK_TEST_EXPECT_EQUAL(referenceLinesList.size(), 2);
+
+  auto referenceCircles = CirclesFilterType::New();
+  referenceCircles->SetInput(edges);
+  referenceCircles->SetNumberOfCircles(2);
+  referenceCircles->SetMinimumRadius(8.0);
+  referenceCircles->SetMaximumRadius(25.0);
+  referenceCircles->SetSweepAngle(0.2);
+  referenceCircles->SetNumberOfWorkUnits(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceCircles->Update());
+  const CirclesFilterType::CirclesListType referenceCirclesList = referenceCircles->GetCircles();
+  ITK_TEST_EXPECT_EQUAL(referenceCirclesList.size(), 2);
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 2, 3, 16 })
+  {
+    std::cout << "Number of work units: " << numberOfWorkUnits << std::endl;
+
+    auto lines = LinesFilterType::New();
+    lines->SetInput(edges);
+    lines->SetNumberOfLines(2);
+    lines->SetNumberOfWorkUnits(numberOfWorkUnits);
+    ITK_TRY_EXPECT_NO_EXCEPTION(lines->Update());
+
+    // the votes are counts, which do not depend on the order of the sums
+    ITK_TEST_EXPECT_EQUAL(MaximumDifference(lines->GetOutput(), referenceLines->GetOutput()), 0.0);
+
+    const LinesFilterType::LinesListType & linesList = lines->GetLines();
+    ITK_TEST_EXPECT_EQUAL(linesList.size(), referenceLinesList.size());
+    auto referenceLine = referenceLinesList.begin();
+    for (const auto & line : linesList)
+    {
+      for (unsigned int i = 0; i < 2; ++i)
+      {
+        ITK_TEST_EXPECT_EQUAL(line->GetPoints()[i].GetPositionInObjectSpace(),
+                              (*referenceLine)->GetPoints()[i].GetPositionInObjectSpace());
+      }
+      ++referenceLine;
+    }
+
+    auto circles = CirclesFilterType::New();
+    circles->SetInput(edges);
+    circles->SetNumberOfCircles(2);
+    circles->SetMinimumRadius(8.0);
+    circles->SetMaximumRadius(25.0);
+    circles->SetSweepAngle(0.2);
+    circles->SetNumberOfWorkUnits(numberOfWorkUnits);
+    ITK_TRY_EXPECT_NO_EXCEPTION(circles->Update());
+
+    ITK_TEST_EXPECT_EQUAL(MaximumDifference(circles->GetOutput(), referenceCircles->GetOutput()), 0.0);
+    ITK_TEST_EXPECT_TRUE(MaximumDifference(circles->GetRadiusImage(), referenceCircles->GetRadiusImage()) < 1e-9);
+
+    // without memory for the accumulators of the slabs, the bands of the
+    // outputs are voted for in the order of the input
+    auto bandLines = LinesFilterType::New();
+    bandLines->SetInput(edges);
+    bandLines->SetNumberOfWorkUnits(numberOfWorkUnits);
+    bandLines->SetMaximumAccumulatorMemory(0);
+    ITK_TEST_SET_GET_VALUE(0, bandLines->GetMaximumAccumulatorMemory());
+    ITK_TRY_EXPECT_NO_EXCEPTION(bandLines->Update());
+    ITK_TEST_EXPECT_EQUAL(MaximumDifference(bandLines->GetOutput(), referenceLines->GetOutput()), 0.0);
+
+    auto bandCircles = CirclesFilterType::New();
+    bandCircles->SetInput(edges);
+    bandCircles->SetMinimumRadius(8.0);
+    bandCircles->SetMaximumRadius(25.0);
+    bandCircles->SetSweepAngle(0.2);
+    bandCircles->SetNumberOfWorkUnits(numberOfWorkUnits);
+    bandCircles->SetMaximumAccumulatorMemory(0);
+    ITK_TEST_SET_GET_VALUE(0, bandCircles->GetMaximumAccumulatorMemory());
+    ITK_TRY_EXPECT_NO_EXCEPTION(bandCircles->Update());
+    ITK_TEST_EXPECT_EQUAL(MaximumDifference(bandCircles->GetOutput(), referenceCircles->GetOutput()), 0.0);
+    ITK_TEST_EXPECT_EQUAL(MaximumDifference(bandCircles->GetRadiusImage(), referenceCircles->GetRadiusImage()), 0.0);
+
+    const CirclesFilterType::CirclesListType & circlesList = circles->GetCircles();
+    ITK_TEST_EXPECT_EQUAL(circlesList.size(), referenceCirclesList.size());
+    auto referenceCircle = referenceCirclesList.begin();
+    for (const auto & circle : circlesList)
+    {
+      ITK_TEST_EXPECT_EQUAL(circle->GetCenterInObjectSpace(), (*referenceCircle)->GetCenterInObjectSpace());
+      ITK_TEST_EXPECT_TRUE(itk::Math::abs(circle->GetRadiusInObjectSpace()[0] -
+                                          (*referenceCircle)->GetRadiusInObjectSpace()[0]) < 1e-9);
+      ++referenceCircle;
+    }
+  }
+
+  // An intensity step along the line x + y / 2 = 75
+  auto step = ImageType::New();
+  step->SetRegions(ImageType::SizeType{ { 100, 100 } });
+  step->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(step, step->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(it.GetIndex()[0] + 0.5 * it.GetIndex()[1] > 75.0 ? 100.0 : 0.0);
+  }
+
+  auto gradientLines = LinesFilterType::New();
+  ITK_TEST_SET_GET_BOOLEAN(gradientLines, UseGradientDirection, false);
+  ITK_TEST_SET_GET_VALUE(1.0, gradientLines->GetSigmaGradient());
+  ITK_TEST_SET_GET_VALUE(1.0, gradientLines->GetGradientNormThreshold());
+  ITK_TEST_SET_GET_VALUE(0.0, gradientLines->GetSweepAngle());
+
+  gradientLines->SetInput(step);
+  gradientLines->SetThreshold(-1.0);
+  gradientLines->SetNumberOfLines(1);
+  gradientLines->UseGradientDirectionOn();
+  gradientLines->SetSigmaGradient(3.0);
+  ITK_TEST_SET_GET_VALUE(3.0, gradientLines->GetSigmaGradient());
+  gradientLines->SetSweepAngle(0.02);
+  ITK_TEST_SET_GET_VALUE(0.02, gradientLines->GetSweepAngle());
+
+  gradientLines->SetGradientNormThreshold(-1.0);
+  ITK_TRY_EXPECT_EXCEPTION(gradientLines->Update());
+
+  gradientLines->SetGradientNormThreshold(5.0);
+  ITK_TEST_SET_GET_VALUE(5.0, gradientLines->GetGradientNormThreshold());
+  ITK_TRY_EXPECT_NO_EXCEPTION(gradientLines->Update());
+
+  auto bandGradientLines = LinesFilterType::New();
+  bandGradientLines->SetInput(step);
+  bandGradientLines->SetThreshold(-1.0);
+  bandGradientLines->UseGradientDirectionOn();
+  bandGradientLines->SetSigmaGradient(3.0);
+  bandGradientLines->SetSweepAngle(0.02);
+  bandGradientLines->SetGradientNormThreshold(5.0);
+  bandGradientLines->SetNumberOfWorkUnits(3);
+  bandGradientLines->SetMaximumAccumulatorMemory(0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(bandGradientLines->Update());
+  ITK_TEST_EXPECT_EQUAL(MaximumDifference(bandGradientLines->GetOutput(), gradientLines->GetOutput()), 0.0);
+
+  const LinesFilterType::LinesListType & gradientLinesList = gradientLines->GetLines();
+  ITK_TEST_EXPECT_EQUAL(gradientLinesList.size(), 1);
+
+  // the line goes through the step, along its direction
+  const auto   point0 = gradientLinesList.front()->GetPoints()[0].GetPositionInObjectSpace();
+  const auto   point1 = gradientLinesList.front()->GetPoints()[1].GetPositionInObjectSpace();
+  const double distance = itk::Math::abs(point0[0] + 0.5 * point0[1] - 75.0) / std::sqrt(1.25);
+  const auto   direction = point1 - point0;
+  const double sine = itk::Math::abs(direction[0] + 0.5 * direction[1]) / (direction.GetNorm() * std::sqrt(1.25));
+  std::cout << "Line of the step: " << point0 << " " << point1 << std::endl;
+  ITK_TEST_EXPECT_TRUE(distance < 2.0);
+  ITK_TEST_EXPECT_TRUE(sine < 0.05);
+
+  // only the pixels of the step vote, for a few angles
+  auto allAngles = LinesFilterType::New();
+  allAngles->SetInput(step);
+  allAngles->SetThreshold(-1.0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(allAngles->Update());
+  ITK_TEST_EXPECT_TRUE(SumOfVotes(gradientLines->GetOutput()) < 0.01 * SumOfVotes(allAngles->GetOutput()));
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,142 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMultiScaleHessianBasedMeasureImageFilter.h"
+#include "itkHessianToObjectnessMeasureImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+// Compute the vesselness of a synthetic 3D image of tubes over the whole
+// image and slab by slab, and compare the responses and the scales.
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using ImageType = itk::Image<float, Dimension>;
+using HessianImageType = itk::Image<itk::SymmetricSecondRankTensor<double, Dimension>, Dimension>;
+using ObjectnessFilterType = itk::HessianToObjectnessMeasureImageFilter<HessianImageType, ImageType>;
+using MultiScaleFilterType = itk::MultiScaleHessianBasedMeasureImageFilter<ImageType, HessianImageType, ImageType>;
+
+ImageType::Pointer
+CreateTubesImage()
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 32, 28, 45 } });
+  const ImageType::SpacingType::ValueType spacing[Dimension] = { 0.8, 0.8, 1.2 };
+  image->SetSpacing(spacing);
+  image->Allocate();
+
+  // a tube oblique to the slabs, and a thicker one along the slabs
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ImageType::PointType point;
+    image->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+    const double obliqueDistance2 = itk::Math::sqr(point[0] - 10.0 - 0.2 * point[2]) + itk::Math::sqr(point[1] - 8.0);
+    const double alongDistance2 = itk::Math::sqr(point[1] - 15.0) + itk::Math::sqr(point[2] - 26.0);
+    it.Set(static_cast<float>(100.0 * std::exp(-obliqueDistance2 / 4.0) + 80.0 * std::exp(-alongDistance2 / 9.0)));
+  }
+  return image;
+}
+
+MultiScaleFilterType::Pointer
+CreateFilter(const ImageType * input, itk::SizeValueType slabSize)
+{
+  auto objectnessFilter = ObjectnessFilterType::New();
+  objectnessFilter->SetObjectDimension(1);
+  objectnessFilter->SetBrightObject(true);
+  objectnessFilter->SetScaleObjectnessMeasure(false);
+
+  auto filter = MultiScaleFilterType::New();
+  filter->SetInput(input);
+  filter->SetHessianToMeasureFilter(objectnessFilter);
+  filter->SetSigmaMinimum(1.0);
+  filter->SetSigmaMaximum(3.0);
+  filter->SetNumberOfSigmaSteps(3);
+  filter->SetGenerateScalesOutput(true);
+  filter->SetSlabSize(slabSize);
+  return filter;
+}
+} // namespace
+
+int
+itkMultiScaleHessianBasedMeasureImageFilterSlabTest(int, char *[])
+{
+  const ImageType::Pointer input = CreateTubesImage();
+
+  auto reference = CreateFilter(input, 0);
+  ITK_TEST_SET_GET_VALUE(0, reference->GetSlabSize());
+  ITK_TEST_SET_GET_VALUE(6.0, reference->GetSlabMarginInSigmas());
+  ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+
+  double maximumResponse = 0.0;
+  for (itk::ImageRegionConstIterator<ImageType> it(reference->GetOutput(), reference->GetOutput()->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    maximumResponse = std::max(maximumResponse, static_cast<double>(it.Get()));
+  }
+  ITK_TEST_EXPECT_TRUE(maximumResponse > 0.1);
+
+  // slabs of one slice, of a size that does not divide the image, and
+  // larger than the image
+  for (const itk::SizeValueType slabSize : { 1, 7, 100 })
+  {
+    auto filter = CreateFilter(input, slabSize);
+    ITK_TEST_SET_GET_VALUE(slabSize, filter->GetSlabSize());
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+    itk::ImageRegionConstIterator<ImageType> referenceIt(reference->GetOutput(),
+                                                         reference->GetOutput()->GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+    double                                   maximumDifference = 0.0;
+    for (; !it.IsAtEnd(); ++it, ++referenceIt)
+    {
+      maximumDifference = std::max(maximumDifference, itk::Math::abs(static_cast<double>(it.Get() - referenceIt.Get())));
+    }
+    std::cout << "Slab size " << slabSize << ": maximum difference " << maximumDifference << std::endl;
+    if (maximumDifference > 1e-3 * maximumResponse)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The response computed by slabs of " << slabSize << " slices differs by " << maximumDifference
+                << " from the response computed over the whole image" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // the scale is only compared where the response is significant
+    itk::ImageRegionConstIterator<MultiScaleFilterType::ScalesImageType> referenceScaleIt(
+      reference->GetScalesOutput(), reference->GetScalesOutput()->GetBufferedRegion());
+    itk::ImageRegionConstIterator<MultiScaleFilterType::ScalesImageType> scaleIt(
+      filter->GetScalesOutput(), filter->GetScalesOutput()->GetBufferedRegion());
+    for (referenceIt.GoToBegin(); !referenceIt.IsAtEnd(); ++referenceIt, ++referenceScaleIt, ++scaleIt)
+    {
+      if (referenceIt.Get() > 0.1 * maximumResponse && scaleIt.Get() != referenceScaleIt.Get())
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "The scale computed by slabs of " << slabSize << " slices is " << scaleIt.Get()
+                  << " instead of " << referenceScaleIt.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
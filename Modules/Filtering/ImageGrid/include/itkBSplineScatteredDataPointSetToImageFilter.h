@@ -277,6 +277,22 @@ public:
   itkGetConstReferenceMacro(GenerateOutputImage, bool);
   itkBooleanMacro(GenerateOutputImage);
 
+  /** Set/Get whether the control point lattice is partitioned among the work
+   * units during the fitting. By default, each work unit accumulates the
+   * contributions of its share of the points in its own copy of the lattice,
+   * so that the memory grows with the number of work units times the size of
+   * the lattice. When the lattice is partitioned, each work unit owns a range
+   * of control points along the last parametric dimension, and accumulates
+   * the contributions of the points whose support overlaps this range
+   * directly in a single lattice. The points are sorted by span beforehand,
+   * and the points close to the boundaries between ranges are weighted by
+   * each of the work units whose range they overlap. The contributions to a
+   * control point are accumulated in the same order whatever the number of
+   * work units. Default = false. */
+  itkSetMacro(PartitionControlPointLattice, bool);
+  itkGetConstMacro(PartitionControlPointLattice, bool);
+  itkBooleanMacro(PartitionControlPointLattice);
+
   /** Get the control point lattice produced by the fitting process. */
   PointDataImagePointer
   GetPhiLattice()
@@ -331,10 +347,34 @@ private:
   void
   ThreadedGenerateDataForFitting(const RegionType &, ThreadIdType);
 
+  /** Function used to fit the points whose support overlaps the range of
+   * control points owned by a work unit, when the lattice is partitioned. */
+  void
+  ThreadedGenerateDataForPartitionedFitting(ThreadIdType);
+
+  /** Sort the points by their span along the last parametric dimension, for
+   * the partitioned fitting. */
+  void
+  SortPointsBySpan();
+
+  /** Map a point to the parametric domain of the current control point
+   * lattice. */
+  void
+  ReparameterizePoint(const PointType &, RealArrayType &) const;
+
   /** Function used to generate the sampled B-spline object quickly. */
   void
   ThreadedGenerateDataForReconstruction(const RegionType &, ThreadIdType);
 
+  /** Compute the B-spline weights of the output grid along each dimension,
+   * which are shared by the work units of the reconstruction. */
+  void
+  ComputeOutputGridWeights();
+
+  /** Evaluate the B-spline kernel of the given parametric dimension. */
+  double
+  EvaluateKernel(const RealType, const unsigned int) const;
+
   /** Sub-function used by GenerateOutputImageFast() to generate the sampled
    * B-spline object quickly. */
   void
@@ -353,6 +393,7 @@ private:
   bool         m_DoMultilevel{ false };
   bool         m_GenerateOutputImage{ true };
   bool         m_UsePointWeights{ false };
+  bool         m_PartitionControlPointLattice{ false };
   unsigned int m_MaximumNumberOfLevels{ 1 };
   unsigned int m_CurrentLevel{ 0 };
   ArrayType    m_NumberOfControlPoints;
@@ -381,6 +422,16 @@ private:
   std::vector<RealImagePointer>      m_OmegaLatticePerThread;
   std::vector<PointDataImagePointer> m_DeltaLatticePerThread;
 
+  // Indices of the points sorted by span along the last parametric
+  // dimension, and offset of the first point of each span.
+  std::vector<typename PointSetType::PointIdentifier> m_PointsSortedBySpan;
+  std::vector<SizeValueType>                          m_SpanOffsets;
+
+  // First control point and B-spline weights of the output pixels along each
+  // dimension.
+  std::vector<unsigned int> m_OutputGridFirstControlPoints[ImageDimension];
+  std::vector<RealType>     m_OutputGridWeights[ImageDimension];
+
   RealType m_BSplineEpsilon{ static_cast<RealType>(1e-3) };
   bool     m_IsFittingComplete{ false };
 };
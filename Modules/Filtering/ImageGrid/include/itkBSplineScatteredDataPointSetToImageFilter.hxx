@@ -354,9 +354,8 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::Generat
 
   if (this->m_GenerateOutputImage)
   {
-    //    this->BeforeThreadedGenerateData();
+    this->ComputeOutputGridWeights();
     multiThreader->SingleMethodExecute();
-    //    this->AfterThreadedGenerateData();
   }
 
   this->SetPhiLatticeParametricDomainParameters();
@@ -368,8 +367,15 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::BeforeT
 {
   if (!this->m_IsFittingComplete)
   {
-    this->m_DeltaLatticePerThread.resize(this->GetNumberOfWorkUnits());
-    this->m_OmegaLatticePerThread.resize(this->GetNumberOfWorkUnits());
+    // The work units share a single lattice when it is partitioned among them.
+    unsigned int numberOfLattices = this->GetNumberOfWorkUnits();
+    if (this->m_PartitionControlPointLattice)
+    {
+      this->SortPointsBySpan();
+      numberOfLattices = 1;
+    }
+    this->m_DeltaLatticePerThread.resize(numberOfLattices);
+    this->m_OmegaLatticePerThread.resize(numberOfLattices);
 
     typename RealImageType::SizeType size;
     for (unsigned int i = 0; i < ImageDimension; ++i)
@@ -384,7 +390,7 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::BeforeT
       }
     }
 
-    for (unsigned int n = 0; n < this->GetNumberOfWorkUnits(); ++n)
+    for (unsigned int n = 0; n < numberOfLattices; ++n)
     {
       this->m_OmegaLatticePerThread[n] = RealImageType::New();
       this->m_OmegaLatticePerThread[n]->SetRegions(size);
@@ -424,7 +430,14 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::Threade
 {
   if (!this->m_IsFittingComplete)
   {
-    this->ThreadedGenerateDataForFitting(region, threadId);
+    if (this->m_PartitionControlPointLattice)
+    {
+      this->ThreadedGenerateDataForPartitionedFitting(threadId);
+    }
+    else
+    {
+      this->ThreadedGenerateDataForFitting(region, threadId);
+    }
   }
   else
   {
@@ -458,14 +471,6 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::Threade
                                                   neighborhoodWeightImage->GetRequestedRegion());
 
   RealArrayType p;
-  RealArrayType r;
-  RealArrayType epsilon;
-  for (unsigned int i = 0; i < ImageDimension; ++i)
-  {
-    r[i] = static_cast<RealType>(this->m_CurrentNumberOfControlPoints[i] - this->m_SplineOrder[i]) /
-           (static_cast<RealType>(this->m_Size[i] - 1) * this->m_Spacing[i]);
-    epsilon[i] = r[i] * this->m_Spacing[i] * this->m_BSplineEpsilon;
-  }
 
   // Determine which points should be handled by this particular thread.
 
@@ -486,27 +491,7 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::Threade
 
     input->GetPoint(n, &point);
 
-    for (unsigned int i = 0; i < ImageDimension; ++i)
-    {
-      unsigned int totalNumberOfSpans = this->m_CurrentNumberOfControlPoints[i] - this->m_SplineOrder[i];
-
-      p[i] = (point[i] - this->m_Origin[i]) * r[i];
-      if (itk::Math::abs(p[i] - static_cast<RealType>(totalNumberOfSpans)) <= epsilon[i])
-      {
-        p[i] = static_cast<RealType>(totalNumberOfSpans) - epsilon[i];
-      }
-      if (p[i] < NumericTraits<RealType>::ZeroValue() && itk::Math::abs(p[i]) <= epsilon[i])
-      {
-        p[i] = NumericTraits<RealType>::ZeroValue();
-      }
-
-      if (p[i] < NumericTraits<RealType>::ZeroValue() || p[i] >= static_cast<RealType>(totalNumberOfSpans))
-      {
-        itkExceptionMacro("The reparameterized point component "
-                          << p[i] << " is outside the corresponding parametric domain of [0, " << totalNumberOfSpans
-                          << ").");
-      }
-    }
+    this->ReparameterizePoint(point, p);
 
     RealType w2Sum = 0.0;
     for (ItW.GoToBegin(); !ItW.IsAtEnd(); ++ItW)
@@ -518,34 +503,7 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::Threade
         RealType u = static_cast<RealType>(p[i] - static_cast<unsigned>(p[i]) - idx[i]) +
                      0.5 * static_cast<RealType>(this->m_SplineOrder[i] - 1);
 
-        switch (this->m_SplineOrder[i])
-        {
-          case 0:
-          {
-            B *= this->m_KernelOrder0->Evaluate(u);
-            break;
-          }
-          case 1:
-          {
-            B *= this->m_KernelOrder1->Evaluate(u);
-            break;
-          }
-          case 2:
-          {
-            B *= this->m_KernelOrder2->Evaluate(u);
-            break;
-          }
-          case 3:
-          {
-            B *= this->m_KernelOrder3->Evaluate(u);
-            break;
-          }
-          default:
-          {
-            B *= this->m_Kernel[i]->Evaluate(u);
-            break;
-          }
-        }
+        B *= this->EvaluateKernel(u, i);
       }
       ItW.Set(B);
       w2Sum += B * B;
@@ -577,103 +535,367 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::Threade
 
 template <typename TInputPointSet, typename TOutputImage>
 void
-BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::ThreadedGenerateDataForReconstruction(
-  const RegionType & region,
-  ThreadIdType       itkNotUsed(threadId))
+BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::ThreadedGenerateDataForPartitionedFitting(
+  ThreadIdType threadId)
 {
-  typename PointDataImageType::Pointer collapsedPhiLattices[ImageDimension + 1];
+  const TInputPointSet * input = this->GetInput();
+
+  RealImageType *      omegaLattice = this->m_OmegaLatticePerThread[0];
+  PointDataImageType * deltaLattice = this->m_DeltaLatticePerThread[0];
+
+  // This work unit owns the control points in the range [first, end) along
+  // the last parametric dimension, and is the only one to write them.
+
+  constexpr unsigned int lastDimension = ImageDimension - 1;
+
+  const SizeValueType latticeSize = omegaLattice->GetLargestPossibleRegion().GetSize()[lastDimension];
+  const SizeValueType numberOfWorkUnits = this->GetMultiThreader()->GetNumberOfWorkUnits();
+  const SizeValueType firstControlPoint = threadId * latticeSize / numberOfWorkUnits;
+  const SizeValueType endControlPoint = (threadId + 1) * latticeSize / numberOfWorkUnits;
+  if (firstControlPoint == endControlPoint)
+  {
+    return;
+  }
+
+  typename RealImageType::SizeType size;
+
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
-    collapsedPhiLattices[i] = PointDataImageType::New();
-    collapsedPhiLattices[i]->CopyInformation(this->m_PhiLattice);
+    size[i] = this->m_SplineOrder[i] + 1;
+  }
+  RealImagePointer neighborhoodWeightImage = RealImageType::New();
+  neighborhoodWeightImage->SetRegions(size);
+  neighborhoodWeightImage->Allocate();
+  neighborhoodWeightImage->FillBuffer(0.0);
 
-    typename PointDataImageType::SizeType size;
-    size.Fill(1);
-    for (unsigned int j = 0; j < i; ++j)
+  ImageRegionIteratorWithIndex<RealImageType> ItW(neighborhoodWeightImage,
+                                                  neighborhoodWeightImage->GetRequestedRegion());
+
+  // The indices along the closed dimensions are wrapped as in
+  // ThreadedGenerateDataForFitting.
+  const auto isOwnedControlPoint = [&](SizeValueType controlPoint) -> bool {
+    if (this->m_CloseDimension[lastDimension])
     {
-      size[j] = this->m_PhiLattice->GetLargestPossibleRegion().GetSize()[j];
+      controlPoint %= size[lastDimension];
     }
-    collapsedPhiLattices[i]->SetRegions(size);
-    collapsedPhiLattices[i]->Allocate();
+    return controlPoint >= firstControlPoint && controlPoint < endControlPoint;
+  };
+
+  // The kernel is evaluated once per dimension for each point, and the
+  // weights of its neighborhood are products of these values.
+  std::vector<double> weights[ImageDimension];
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    weights[i].resize(size[i]);
   }
-  using ImageDuplicatorType = ImageDuplicator<PointDataImageType>;
-  auto duplicator = ImageDuplicatorType::New();
-  duplicator->SetInputImage(this->m_PhiLattice);
-  duplicator->Update();
 
-  collapsedPhiLattices[ImageDimension] = duplicator->GetOutput();
+  RealArrayType p;
 
-  ArrayType totalNumberOfSpans;
-  for (unsigned int i = 0; i < ImageDimension; ++i)
+  const SizeValueType numberOfSpans = this->m_SpanOffsets.size() - 1;
+  for (SizeValueType span = 0; span < numberOfSpans; ++span)
   {
-    if (this->m_CloseDimension[i])
+    bool isSpanOverlapping = false;
+    for (unsigned int j = 0; j < size[lastDimension]; ++j)
     {
-      totalNumberOfSpans[i] = this->m_PhiLattice->GetLargestPossibleRegion().GetSize()[i];
+      isSpanOverlapping |= isOwnedControlPoint(span + j);
     }
-    else
+    if (!isSpanOverlapping)
     {
-      totalNumberOfSpans[i] = this->m_PhiLattice->GetLargestPossibleRegion().GetSize()[i] - this->m_SplineOrder[i];
+      continue;
+    }
+
+    for (SizeValueType k = this->m_SpanOffsets[span]; k < this->m_SpanOffsets[span + 1]; ++k)
+    {
+      const typename PointSetType::PointIdentifier n = this->m_PointsSortedBySpan[k];
+
+      PointType point;
+      point.Fill(0.0);
+
+      input->GetPoint(n, &point);
+
+      this->ReparameterizePoint(point, p);
+
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        for (unsigned int j = 0; j < size[i]; ++j)
+        {
+          RealType u = static_cast<RealType>(p[i] - static_cast<unsigned>(p[i]) - j) +
+                       0.5 * static_cast<RealType>(this->m_SplineOrder[i] - 1);
+
+          weights[i][j] = this->EvaluateKernel(u, i);
+        }
+      }
+
+      RealType w2Sum = 0.0;
+      for (ItW.GoToBegin(); !ItW.IsAtEnd(); ++ItW)
+      {
+        RealType                          B = 1.0;
+        typename RealImageType::IndexType idx = ItW.GetIndex();
+        for (unsigned int i = 0; i < ImageDimension; ++i)
+        {
+          B *= weights[i][idx[i]];
+        }
+        ItW.Set(B);
+        w2Sum += B * B;
+      }
+
+      for (ItW.GoToBegin(); !ItW.IsAtEnd(); ++ItW)
+      {
+        typename RealImageType::IndexType idx = ItW.GetIndex();
+        for (unsigned int i = 0; i < ImageDimension; ++i)
+        {
+          idx[i] += static_cast<unsigned>(p[i]);
+          if (this->m_CloseDimension[i])
+          {
+            idx[i] %= size[i];
+          }
+        }
+        if (!isOwnedControlPoint(idx[lastDimension]))
+        {
+          continue;
+        }
+        RealType wc = this->m_PointWeights->GetElement(n);
+        RealType t = ItW.Get();
+        omegaLattice->SetPixel(idx, omegaLattice->GetPixel(idx) + wc * t * t);
+        PointDataType data = this->m_InputPointData->GetElement(n);
+        data *= (t * t * t * wc / w2Sum);
+        deltaLattice->SetPixel(idx, deltaLattice->GetPixel(idx) + data);
+      }
     }
   }
+}
 
-  RealArrayType r;
-  for (unsigned int i = 0; i < ImageDimension; ++i)
+template <typename TInputPointSet, typename TOutputImage>
+void
+BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::SortPointsBySpan()
+{
+  const TInputPointSet * input = this->GetInput();
+
+  constexpr unsigned int lastDimension = ImageDimension - 1;
+
+  const SizeValueType numberOfPoints = input->GetNumberOfPoints();
+  const SizeValueType numberOfSpans =
+    this->m_CurrentNumberOfControlPoints[lastDimension] - this->m_SplineOrder[lastDimension];
+
+  // Counting sort of the points, which keeps the points of a span in the
+  // order of their indices. All the points are reparameterized here, so
+  // that the points outside the parametric domain are reported before the
+  // work units start.
+  std::vector<SizeValueType> spans(numberOfPoints);
+  this->m_SpanOffsets.assign(numberOfSpans + 1, 0);
+
+  RealArrayType p;
+  for (SizeValueType n = 0; n < numberOfPoints; ++n)
   {
-    r[i] =
-      static_cast<RealType>(totalNumberOfSpans[i]) / (static_cast<RealType>(this->m_Size[i] - 1) * this->m_Spacing[i]);
+    PointType point;
+    point.Fill(0.0);
+
+    input->GetPoint(n, &point);
+
+    this->ReparameterizePoint(point, p);
+
+    spans[n] = static_cast<unsigned>(p[lastDimension]);
+    ++this->m_SpanOffsets[spans[n] + 1];
+  }
+  for (SizeValueType span = 0; span < numberOfSpans; ++span)
+  {
+    this->m_SpanOffsets[span + 1] += this->m_SpanOffsets[span];
   }
 
-  RealArrayType epsilon;
+  std::vector<SizeValueType> nextPoint(this->m_SpanOffsets.begin(), this->m_SpanOffsets.end() - 1);
+  this->m_PointsSortedBySpan.resize(numberOfPoints);
+  for (SizeValueType n = 0; n < numberOfPoints; ++n)
+  {
+    this->m_PointsSortedBySpan[nextPoint[spans[n]]++] = n;
+  }
+}
+
+template <typename TInputPointSet, typename TOutputImage>
+void
+BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::ReparameterizePoint(const PointType & point,
+                                                                                             RealArrayType &   p) const
+{
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
-    epsilon[i] = r[i] * this->m_Spacing[i] * this->m_BSplineEpsilon;
+    unsigned int totalNumberOfSpans = this->m_CurrentNumberOfControlPoints[i] - this->m_SplineOrder[i];
+
+    RealType r = static_cast<RealType>(totalNumberOfSpans) /
+                 (static_cast<RealType>(this->m_Size[i] - 1) * this->m_Spacing[i]);
+    RealType epsilon = r * this->m_Spacing[i] * this->m_BSplineEpsilon;
+
+    p[i] = (point[i] - this->m_Origin[i]) * r;
+    if (itk::Math::abs(p[i] - static_cast<RealType>(totalNumberOfSpans)) <= epsilon)
+    {
+      p[i] = static_cast<RealType>(totalNumberOfSpans) - epsilon;
+    }
+    if (p[i] < NumericTraits<RealType>::ZeroValue() && itk::Math::abs(p[i]) <= epsilon)
+    {
+      p[i] = NumericTraits<RealType>::ZeroValue();
+    }
+
+    if (p[i] < NumericTraits<RealType>::ZeroValue() || p[i] >= static_cast<RealType>(totalNumberOfSpans))
+    {
+      itkExceptionMacro("The reparameterized point component "
+                        << p[i] << " is outside the corresponding parametric domain of [0, " << totalNumberOfSpans
+                        << ").");
+    }
   }
+}
 
-  FixedArray<RealType, ImageDimension> U;
-  FixedArray<RealType, ImageDimension> currentU;
-  currentU.Fill(-1);
+template <typename TInputPointSet, typename TOutputImage>
+void
+BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::ThreadedGenerateDataForReconstruction(
+  const RegionType & region,
+  ThreadIdType       itkNotUsed(threadId))
+{
+  // The lattice is collapsed one dimension at a time, from the last one to
+  // the first one. collapsedPhiLattices[i] holds the lattice collapsed along
+  // the dimensions i and above, and only the ones whose index changed from
+  // the previous pixel are collapsed again. The weights of the output grid
+  // along each dimension are shared by all the work units.
 
-  typename ImageType::IndexType          startIndex = this->GetOutput()->GetRequestedRegion().GetIndex();
-  typename PointDataImageType::IndexType startPhiIndex = this->m_PhiLattice->GetLargestPossibleRegion().GetIndex();
+  const typename PointDataImageType::SizeType latticeSize = this->m_PhiLattice->GetLargestPossibleRegion().GetSize();
+  const PointDataType *                       lattice = this->m_PhiLattice->GetBufferPointer();
+
+  std::vector<PointDataType> collapsedPhiLattices[ImageDimension];
+  SizeValueType              strides[ImageDimension];
+
+  SizeValueType stride = 1;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    strides[i] = stride;
+    collapsedPhiLattices[i].resize(stride);
+    stride *= latticeSize[i];
+  }
+
+  typename ImageType::IndexType startIndex = this->GetOutput()->GetRequestedRegion().GetIndex();
+  typename ImageType::IndexType previousIdx = startIndex;
+  bool                          isFirstPixel = true;
 
   ImageRegionIteratorWithIndex<ImageType> It(this->GetOutput(), region);
   for (It.GoToBegin(); !It.IsAtEnd(); ++It)
   {
     typename ImageType::IndexType idx = It.GetIndex();
-    for (unsigned int i = 0; i < ImageDimension; ++i)
+
+    int dimension = ImageDimension - 1;
+    while (!isFirstPixel && dimension > 0 && idx[dimension] == previousIdx[dimension])
+    {
+      --dimension;
+    }
+    for (int j = dimension; j >= 0; j--)
     {
-      U[i] = static_cast<RealType>(totalNumberOfSpans[i]) * static_cast<RealType>(idx[i] - startIndex[i]) /
-             static_cast<RealType>(this->m_Size[i] - 1);
+      const unsigned int    numberOfWeights = this->m_SplineOrder[j] + 1;
+      const SizeValueType   x = idx[j] - startIndex[j];
+      const unsigned int    firstControlPoint = this->m_OutputGridFirstControlPoints[j][x];
+      const RealType *      weights = &this->m_OutputGridWeights[j][x * numberOfWeights];
+      const PointDataType * source =
+        (j == static_cast<int>(ImageDimension) - 1) ? lattice : collapsedPhiLattices[j + 1].data();
+
+      for (SizeValueType n = 0; n < strides[j]; ++n)
+      {
+        PointDataType data;
+        data.Fill(0.0);
+        for (unsigned int k = 0; k < numberOfWeights; ++k)
+        {
+          SizeValueType controlPoint = firstControlPoint + k;
+          if (this->m_CloseDimension[j])
+          {
+            controlPoint %= latticeSize[j];
+          }
+          data += (source[n + controlPoint * strides[j]] * weights[k]);
+        }
+        collapsedPhiLattices[j][n] = data;
+      }
+    }
+    It.Set(collapsedPhiLattices[0][0]);
 
-      if (itk::Math::abs(U[i] - static_cast<RealType>(totalNumberOfSpans[i])) <= epsilon[i])
+    previousIdx = idx;
+    isFirstPixel = false;
+  }
+}
+
+template <typename TInputPointSet, typename TOutputImage>
+void
+BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::ComputeOutputGridWeights()
+{
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    unsigned int totalNumberOfSpans = this->m_PhiLattice->GetLargestPossibleRegion().GetSize()[i];
+    if (!this->m_CloseDimension[i])
+    {
+      totalNumberOfSpans -= this->m_SplineOrder[i];
+    }
+
+    RealType r =
+      static_cast<RealType>(totalNumberOfSpans) / (static_cast<RealType>(this->m_Size[i] - 1) * this->m_Spacing[i]);
+    RealType epsilon = r * this->m_Spacing[i] * this->m_BSplineEpsilon;
+
+    const unsigned int numberOfWeights = this->m_SplineOrder[i] + 1;
+    this->m_OutputGridFirstControlPoints[i].resize(this->m_Size[i]);
+    this->m_OutputGridWeights[i].resize(this->m_Size[i] * numberOfWeights);
+
+    for (SizeValueType x = 0; x < this->m_Size[i]; ++x)
+    {
+      RealType U = static_cast<RealType>(totalNumberOfSpans) * static_cast<RealType>(x) /
+                   static_cast<RealType>(this->m_Size[i] - 1);
+
+      if (itk::Math::abs(U - static_cast<RealType>(totalNumberOfSpans)) <= epsilon)
       {
-        U[i] = static_cast<RealType>(totalNumberOfSpans[i]) - epsilon[i];
+        U = static_cast<RealType>(totalNumberOfSpans) - epsilon;
       }
-      if (U[i] < NumericTraits<RealType>::ZeroValue() && itk::Math::abs(U[i]) <= epsilon[i])
+      if (U < NumericTraits<RealType>::ZeroValue() && itk::Math::abs(U) <= epsilon)
       {
-        U[i] = NumericTraits<RealType>::ZeroValue();
+        U = NumericTraits<RealType>::ZeroValue();
       }
 
-      if (U[i] < NumericTraits<RealType>::ZeroValue() || U[i] >= static_cast<RealType>(totalNumberOfSpans[i]))
+      if (U < NumericTraits<RealType>::ZeroValue() || U >= static_cast<RealType>(totalNumberOfSpans))
       {
         itkExceptionMacro("The collapse point component "
-                          << U[i] << " is outside the corresponding parametric domain of [0, " << totalNumberOfSpans[i]
+                          << U << " is outside the corresponding parametric domain of [0, " << totalNumberOfSpans
                           << ").");
       }
-    }
-    for (int i = ImageDimension - 1; i >= 0; i--)
-    {
-      if (Math::NotExactlyEquals(U[i], currentU[i]))
+
+      const auto firstControlPoint = static_cast<unsigned int>(U);
+      this->m_OutputGridFirstControlPoints[i][x] = firstControlPoint;
+      for (unsigned int k = 0; k < numberOfWeights; ++k)
       {
-        for (int j = i; j >= 0; j--)
-        {
-          this->CollapsePhiLattice(collapsedPhiLattices[j + 1], collapsedPhiLattices[j], U[j], j);
-          currentU[j] = U[j];
-        }
-        break;
+        RealType v = U - static_cast<RealType>(firstControlPoint + k) +
+                     0.5 * static_cast<RealType>(this->m_SplineOrder[i] - 1);
+
+        this->m_OutputGridWeights[i][x * numberOfWeights + k] = this->EvaluateKernel(v, i);
       }
     }
-    It.Set(collapsedPhiLattices[0]->GetPixel(startPhiIndex));
+  }
+}
+
+template <typename TInputPointSet, typename TOutputImage>
+double
+BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::EvaluateKernel(
+  const RealType     u,
+  const unsigned int dimension) const
+{
+  switch (this->m_SplineOrder[dimension])
+  {
+    case 0:
+    {
+      return this->m_KernelOrder0->Evaluate(u);
+    }
+    case 1:
+    {
+      return this->m_KernelOrder1->Evaluate(u);
+    }
+    case 2:
+    {
+      return this->m_KernelOrder2->Evaluate(u);
+    }
+    case 3:
+    {
+      return this->m_KernelOrder3->Evaluate(u);
+    }
+    default:
+    {
+      return this->m_Kernel[dimension]->Evaluate(u);
+    }
   }
 }
 
@@ -691,7 +913,7 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::AfterTh
     ImageRegionIterator<RealImageType>      ItO(this->m_OmegaLatticePerThread[0],
                                            this->m_OmegaLatticePerThread[0]->GetLargestPossibleRegion());
 
-    for (ThreadIdType n = 1; n < this->GetNumberOfWorkUnits(); ++n)
+    for (ThreadIdType n = 1; n < this->m_DeltaLatticePerThread.size(); ++n)
     {
       ImageRegionIterator<PointDataImageType> Itd(this->m_DeltaLatticePerThread[n],
                                                   this->m_DeltaLatticePerThread[n]->GetLargestPossibleRegion());
@@ -1027,35 +1249,7 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::Collaps
       idx[dimension] = static_cast<unsigned int>(u) + i;
       RealType v = u - idx[dimension] + 0.5 * static_cast<RealType>(this->m_SplineOrder[dimension] - 1);
 
-      RealType B = 0.0;
-      switch (this->m_SplineOrder[dimension])
-      {
-        case 0:
-        {
-          B = this->m_KernelOrder0->Evaluate(v);
-          break;
-        }
-        case 1:
-        {
-          B = this->m_KernelOrder1->Evaluate(v);
-          break;
-        }
-        case 2:
-        {
-          B = this->m_KernelOrder2->Evaluate(v);
-          break;
-        }
-        case 3:
-        {
-          B = this->m_KernelOrder3->Evaluate(v);
-          break;
-        }
-        default:
-        {
-          B = this->m_Kernel[dimension]->Evaluate(v);
-          break;
-        }
-      }
+      RealType B = this->EvaluateKernel(v, dimension);
       if (this->m_CloseDimension[dimension])
       {
         idx[dimension] %= lattice->GetLargestPossibleRegion().GetSize()[dimension];
@@ -1137,6 +1331,7 @@ BSplineScatteredDataPointSetToImageFilter<TInputPointSet, TOutputImage>::PrintSe
   os << indent << "Do multi level: " << this->m_DoMultilevel << std::endl;
   os << indent << "Generate output image: " << this->m_GenerateOutputImage << std::endl;
   os << indent << "Use point weights: " << this->m_UsePointWeights << std::endl;
+  os << indent << "Partition control point lattice: " << this->m_PartitionControlPointLattice << std::endl;
   os << indent << "Maximum number of levels: " << this->m_MaximumNumberOfLevels << std::endl;
   os << indent << "Current level: " << this->m_CurrentLevel << std::endl;
   os << indent << "Number of control points: " << this->m_NumberOfControlPoints << std::endl;
@@ -21,6 +21,8 @@
 #include "itkImageToImageFilter.h"
 #include "itkLinearInterpolateImageFunction.h"
 
+#include <type_traits> // For true_type and false_type.
+
 namespace itk
 {
 /**
@@ -38,7 +40,9 @@ namespace itk
  * The default interpolation type used is the LinearInterpolateImageFunction.
  * The user can specify a particular interpolation function via
  * SetInterpolator(). Note that the input interpolator must derive
- * from base class InterpolateImageFunction.
+ * from base class InterpolateImageFunction. A
+ * BSplineInterpolateImageFunction is evaluated separably over the output
+ * grid, which is considerably faster than evaluating it pixel by pixel.
  *
  * This filter will produce an output with different pixel spacing
  * that its input image such that:
@@ -157,6 +161,19 @@ protected:
   BeforeThreadedGenerateData() override;
 
 private:
+  /** Implements DynamicThreadedGenerateData for a
+   * BSplineInterpolateImageFunction, by evaluating the interpolator
+   * separably on the grid of the output region. Returns false if the
+   * interpolator is of any other type. */
+  bool
+  DynamicThreadedGenerateDataOnBSplineGrid(const OutputImageRegionType & outputRegionForThread, std::true_type);
+
+  bool
+  DynamicThreadedGenerateDataOnBSplineGrid(const OutputImageRegionType &, std::false_type)
+  {
+    return false;
+  }
+
   ExpandFactorsType   m_ExpandFactors;
   InterpolatorPointer m_Interpolator;
 };
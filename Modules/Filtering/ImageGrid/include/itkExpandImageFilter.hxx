@@ -18,10 +18,14 @@
 #ifndef itkExpandImageFilter_hxx
 #define itkExpandImageFilter_hxx
 
+#include "itkBSplineInterpolateImageFunction.h"
 #include "itkImageScanlineIterator.h"
 #include "itkObjectFactory.h"
 #include "itkProgressReporter.h"
 
+#include <typeinfo> // For typeid.
+#include <vector>
+
 namespace itk
 {
 template <typename TInputImage, typename TOutputImage>
@@ -124,6 +128,17 @@ ExpandImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
     return;
   }
 
+  // A B-spline interpolator is evaluated separably on the output grid.
+  using IsBSplineGridSupported = std::integral_constant<bool,
+                                                        std::is_arithmetic<typename InputImageType::PixelType>::value &&
+                                                          std::is_arithmetic<OutputPixelType>::value &&
+                                                          (ImageDimension > 1)>;
+
+  if (this->DynamicThreadedGenerateDataOnBSplineGrid(outputRegionForThread, IsBSplineGridSupported()))
+  {
+    return;
+  }
+
   // Walk the output region, and interpolate the input image
   while (!outIt.IsAtEnd())
   {
@@ -162,6 +177,73 @@ ExpandImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
 }
 
 
+template <typename TInputImage, typename TOutputImage>
+bool
+ExpandImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDataOnBSplineGrid(
+  const OutputImageRegionType & outputRegionForThread,
+  std::true_type)
+{
+  using BSplineInterpolatorType = BSplineInterpolateImageFunction<InputImageType, CoordRepType>;
+  using ContinuousIndexType = typename InterpolatorType::ContinuousIndexType;
+
+  const InterpolatorType & interpolator = *m_Interpolator;
+
+  if (typeid(interpolator) != typeid(BSplineInterpolatorType))
+  {
+    return false;
+  }
+  const auto & bsplineInterpolator = static_cast<const BSplineInterpolatorType &>(interpolator);
+
+  OutputImagePointer outputPtr = this->GetOutput();
+
+  constexpr unsigned int sliceDimension = ImageDimension - 1;
+
+  // The grid is evaluated one output slice at a time, to limit the memory used.
+  typename BSplineInterpolatorType::SizeType gridSize = outputRegionForThread.GetSize();
+  gridSize[sliceDimension] = 1;
+
+  ContinuousIndexType                      gridOrigin;
+  typename ContinuousIndexType::VectorType gridStep;
+  for (unsigned int j = 0; j < ImageDimension; ++j)
+  {
+    gridOrigin[j] = ((double)outputRegionForThread.GetIndex(j) + 0.5) / (double)m_ExpandFactors[j] - 0.5;
+    gridStep[j] = (double)1.0 / (double)m_ExpandFactors[j];
+  }
+
+  std::vector<typename InterpolatorType::OutputType> values(OutputImageRegionType(gridSize).GetNumberOfPixels());
+
+  OutputImageRegionType sliceRegion = outputRegionForThread;
+  sliceRegion.SetSize(sliceDimension, 1);
+
+  const IndexValueType sliceBegin = outputRegionForThread.GetIndex(sliceDimension);
+  const IndexValueType sliceEnd =
+    sliceBegin + static_cast<IndexValueType>(outputRegionForThread.GetSize(sliceDimension));
+
+  for (IndexValueType slice = sliceBegin; slice < sliceEnd; ++slice)
+  {
+    gridOrigin[sliceDimension] = ((double)slice + 0.5) / (double)m_ExpandFactors[sliceDimension] - 0.5;
+    bsplineInterpolator.EvaluateAtContinuousIndexGrid(gridOrigin, gridStep, gridSize, values.data());
+
+    // The values are ordered just like the pixels along the scanlines.
+    sliceRegion.SetIndex(sliceDimension, slice);
+    ImageScanlineIterator<TOutputImage> outIt(outputPtr, sliceRegion);
+    auto                                valueIt = values.cbegin();
+
+    while (!outIt.IsAtEnd())
+    {
+      while (!outIt.IsAtEndOfLine())
+      {
+        outIt.Set(static_cast<OutputPixelType>(*valueIt));
+        ++outIt;
+        ++valueIt;
+      }
+      outIt.NextLine();
+    }
+  }
+  return true;
+}
+
+
 template <typename TInputImage, typename TOutputImage>
 void
 ExpandImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
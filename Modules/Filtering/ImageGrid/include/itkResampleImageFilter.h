@@ -28,6 +28,8 @@
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkDataObjectDecorator.h"
 
+#include <type_traits> // For true_type and false_type.
+
 
 namespace itk
 {
@@ -340,7 +342,14 @@ protected:
   NonlinearThreadedGenerateData(const OutputImageRegionType & outputRegionForThread);
 
   /** Implementation for resampling that works for with linear
-   *  transformation types. */
+   *  transformation types. For each scan line, the span of output pixels
+   *  that map inside the input buffer is computed up front, so that no
+   *  bounds checking is needed per pixel. When the interpolator is exactly a
+   *  LinearInterpolateImageFunction or a
+   *  NearestNeighborInterpolateImageFunction, it is evaluated without
+   *  virtual dispatch. When it is exactly a BSplineInterpolateImageFunction,
+   *  and the transform only scales and translates along the image axes, it
+   *  is evaluated separably on the output grid. */
   virtual void
   LinearThreadedGenerateData(const OutputImageRegionType & outputRegionForThread);
 
@@ -364,6 +373,27 @@ private:
   static PixelType
   CastPixelWithBoundsChecking(const TPixel value);
 
+  /** Implements LinearThreadedGenerateData for a
+   * BSplineInterpolateImageFunction, by evaluating the interpolator on the
+   * grid of the output region, in case the transform maps the output grid
+   * axes onto the input grid axes (scaling and translation only). Returns
+   * false if the grid evaluation is not applicable. */
+  bool
+  LinearThreadedGenerateDataOnBSplineGrid(const OutputImageRegionType & outputRegionForThread, std::true_type);
+
+  bool
+  LinearThreadedGenerateDataOnBSplineGrid(const OutputImageRegionType &, std::false_type)
+  {
+    return false;
+  }
+
+  /** Implements LinearThreadedGenerateData, using the specified function
+   * object to evaluate the interpolator inside the input buffer. */
+  template <typename TEvaluator>
+  void
+  LinearThreadedGenerateDataWithEvaluator(const OutputImageRegionType & outputRegionForThread,
+                                          const TEvaluator &            evaluator);
+
   void
   InitializeTransform();
 
@@ -26,8 +26,14 @@
 #include "itkSpecialCoordinatesImage.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkImageAlgorithm.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+#include "itkBSplineInterpolateImageFunction.h"
 
+#include <algorithm>   // For max, min and swap.
+#include <cmath>       // For floor, ceil and isfinite.
 #include <type_traits> // For is_same.
+#include <typeinfo>    // For typeid.
+#include <vector>
 
 namespace itk
 {
@@ -437,6 +443,238 @@ template <typename TInputImage,
 void
 ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
   LinearThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  // When the exact type of the interpolator is one of the standard interpolators, it is evaluated by a qualified
+  // (non-virtual) call, which allows the compiler to inline the interpolation into the scanline loop. Classes derived
+  // from these interpolators may override the evaluation, so they are handled by the generic (virtual) call.
+  using NearestNeighborInterpolatorType =
+    NearestNeighborInterpolateImageFunction<InputImageType, TInterpolatorPrecisionType>;
+
+  // A B-spline interpolator is evaluated separably on the output grid, when
+  // the transform only scales and translates along the image axes.
+  using IsBSplineGridSupported = std::integral_constant<bool,
+                                                        std::is_arithmetic<InputPixelType>::value &&
+                                                          std::is_arithmetic<PixelType>::value &&
+                                                          (InputImageDimension == OutputImageDimension) &&
+                                                          (OutputImageDimension > 1)>;
+
+  if (this->LinearThreadedGenerateDataOnBSplineGrid(outputRegionForThread, IsBSplineGridSupported()))
+  {
+    return;
+  }
+
+  const InterpolatorType & interpolator = *m_Interpolator;
+
+  if (typeid(interpolator) == typeid(LinearInterpolatorType))
+  {
+    const auto & linearInterpolator = static_cast<const LinearInterpolatorType &>(interpolator);
+    this->LinearThreadedGenerateDataWithEvaluator(
+      outputRegionForThread, [&linearInterpolator](const ContinuousInputIndexType & inputIndex) {
+        return linearInterpolator.LinearInterpolatorType::EvaluateAtContinuousIndex(inputIndex);
+      });
+  }
+  else if (typeid(interpolator) == typeid(NearestNeighborInterpolatorType))
+  {
+    const auto & nearestNeighborInterpolator = static_cast<const NearestNeighborInterpolatorType &>(interpolator);
+    this->LinearThreadedGenerateDataWithEvaluator(
+      outputRegionForThread, [&nearestNeighborInterpolator](const ContinuousInputIndexType & inputIndex) {
+        return nearestNeighborInterpolator.NearestNeighborInterpolatorType::EvaluateAtContinuousIndex(inputIndex);
+      });
+  }
+  else
+  {
+    this->LinearThreadedGenerateDataWithEvaluator(outputRegionForThread,
+                                                  [&interpolator](const ContinuousInputIndexType & inputIndex) {
+                                                    return interpolator.EvaluateAtContinuousIndex(inputIndex);
+                                                  });
+  }
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+bool
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  LinearThreadedGenerateDataOnBSplineGrid(const OutputImageRegionType & outputRegionForThread, std::true_type)
+{
+  using BSplineInterpolatorType = BSplineInterpolateImageFunction<InputImageType, TInterpolatorPrecisionType>;
+  using GridStepType = typename ContinuousInputIndexType::VectorType;
+
+  const InterpolatorType & interpolator = *m_Interpolator;
+
+  if (typeid(interpolator) != typeid(BSplineInterpolatorType))
+  {
+    return false;
+  }
+  const auto & bsplineInterpolator = static_cast<const BSplineInterpolatorType &>(interpolator);
+
+  OutputImageType *      outputPtr = this->GetOutput();
+  const InputImageType * inputPtr = this->GetInput();
+  const TransformType *  transformPtr = this->GetTransform();
+
+  const auto transformIndex = [outputPtr, transformPtr, inputPtr](const IndexType & index) {
+    return inputPtr->template TransformPhysicalPointToContinuousIndex<TInterpolatorPrecisionType>(
+      transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
+  };
+
+  // The output grid is mapped onto a grid in the input index space, relative
+  // to the start of the largest possible region, so that the mapping does not
+  // depend on how the image is split for processing. The mapping must not mix
+  // the axes.
+  const IndexType                largestPossibleStart = outputPtr->GetLargestPossibleRegion().GetIndex();
+  const ContinuousInputIndexType gridOrigin = transformIndex(largestPossibleStart);
+  GridStepType                   gridStep;
+
+  for (unsigned int n = 0; n < OutputImageDimension; ++n)
+  {
+    IndexType index = largestPossibleStart;
+    ++index[n];
+    const GridStepType step = transformIndex(index) - gridOrigin;
+    for (unsigned int m = 0; m < InputImageDimension; ++m)
+    {
+      if (m != n && step[m] != 0.0)
+      {
+        return false;
+      }
+    }
+    gridStep[n] = step[n];
+  }
+
+  const auto computeInputIndex = [&gridOrigin, &gridStep, &largestPossibleStart](const IndexType & index) {
+    ContinuousInputIndexType inputIndex;
+    for (unsigned int n = 0; n < InputImageDimension; ++n)
+    {
+      inputIndex[n] = gridOrigin[n] + (index[n] - largestPossibleStart[n]) * gridStep[n];
+    }
+    return inputIndex;
+  };
+
+  // As the axes are not mixed, the output pixels that map inside the input
+  // buffer form a box, whose bounds can be determined per axis.
+  const ContinuousInputIndexType & startContinuousIndexOfBuffer = m_Interpolator->GetStartContinuousIndex();
+  const ContinuousInputIndexType & endContinuousIndexOfBuffer = m_Interpolator->GetEndContinuousIndex();
+
+  IndexType insideBegin = outputRegionForThread.GetIndex();
+  IndexType insideEnd = outputRegionForThread.GetUpperIndex();
+  bool      isInsideEmpty = false;
+
+  for (unsigned int n = 0; n < OutputImageDimension; ++n)
+  {
+    const IndexValueType regionBegin = outputRegionForThread.GetIndex(n);
+    const IndexValueType regionEnd = regionBegin + static_cast<IndexValueType>(outputRegionForThread.GetSize(n));
+
+    insideBegin[n] = regionEnd;
+    insideEnd[n] = regionEnd;
+    for (IndexValueType i = regionBegin; i < regionEnd; ++i)
+    {
+      const double coordinate = gridOrigin[n] + (i - largestPossibleStart[n]) * gridStep[n];
+      if (coordinate >= startContinuousIndexOfBuffer[n] && coordinate < endContinuousIndexOfBuffer[n])
+      {
+        if (insideBegin[n] == regionEnd)
+        {
+          insideBegin[n] = i;
+        }
+        insideEnd[n] = i + 1;
+      }
+    }
+    isInsideEmpty = isInsideEmpty || (insideBegin[n] == regionEnd);
+  }
+
+  const auto isInside = [&insideBegin, &insideEnd, isInsideEmpty](const IndexType & index, const unsigned int n) {
+    return !isInsideEmpty && index[n] >= insideBegin[n] && index[n] < insideEnd[n];
+  };
+
+  constexpr unsigned int sliceDimension = OutputImageDimension - 1;
+
+  typename BSplineInterpolatorType::SizeType gridSize;
+  OffsetValueType                            gridStrides[OutputImageDimension];
+  for (unsigned int n = 0; n < OutputImageDimension; ++n)
+  {
+    gridSize[n] = isInsideEmpty ? 0 : static_cast<SizeValueType>(insideEnd[n] - insideBegin[n]);
+    gridStrides[n] = (n == 0) ? 1 : (gridStrides[n - 1] * static_cast<OffsetValueType>(gridSize[n - 1]));
+  }
+  // The grid is evaluated one slice at a time, to limit the memory used.
+  gridSize[sliceDimension] = isInsideEmpty ? 0 : 1;
+
+  std::vector<InterpolatorOutputType> values(ImageRegion<InputImageDimension>(gridSize).GetNumberOfPixels());
+
+  TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+  const PixelType defaultValue = this->GetDefaultPixelValue();
+
+  const IndexValueType sliceBegin = outputRegionForThread.GetIndex(sliceDimension);
+  const IndexValueType sliceEnd =
+    sliceBegin + static_cast<IndexValueType>(outputRegionForThread.GetSize(sliceDimension));
+
+  for (IndexValueType slice = sliceBegin; slice < sliceEnd; ++slice)
+  {
+    OutputImageRegionType sliceRegion = outputRegionForThread;
+    sliceRegion.SetIndex(sliceDimension, slice);
+    sliceRegion.SetSize(sliceDimension, 1);
+
+    IndexType sliceInsideBegin = insideBegin;
+    sliceInsideBegin[sliceDimension] = slice;
+    const bool isSliceInside = isInside(sliceInsideBegin, sliceDimension);
+
+    if (isSliceInside)
+    {
+      bsplineInterpolator.EvaluateAtContinuousIndexGrid(
+        computeInputIndex(sliceInsideBegin), gridStep, gridSize, values.data());
+    }
+
+    ImageScanlineIterator<TOutputImage> outIt(outputPtr, sliceRegion);
+
+    while (!outIt.IsAtEnd())
+    {
+      IndexType index = outIt.GetIndex();
+
+      bool isLineInside = isSliceInside;
+      for (unsigned int n = 1; n < sliceDimension; ++n)
+      {
+        isLineInside = isLineInside && isInside(index, n);
+      }
+
+      const InterpolatorOutputType * lineValues = values.data();
+      for (unsigned int n = 1; n < sliceDimension; ++n)
+      {
+        lineValues += (index[n] - insideBegin[n]) * gridStrides[n];
+      }
+
+      while (!outIt.IsAtEndOfLine())
+      {
+        if (isLineInside && isInside(index, 0))
+        {
+          outIt.Set(Self::CastPixelWithBoundsChecking(lineValues[index[0] - insideBegin[0]]));
+        }
+        else if (m_Extrapolator.IsNull())
+        {
+          outIt.Set(defaultValue); // default background value
+        }
+        else
+        {
+          outIt.Set(
+            Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(computeInputIndex(index))));
+        }
+        ++outIt;
+        ++index[0];
+      }
+      outIt.NextLine();
+      progress.Completed(outputRegionForThread.GetSize()[0]);
+    }
+  }
+  return true;
+}
+
+template <typename TInputImage,
+          typename TOutputImage,
+          typename TInterpolatorPrecisionType,
+          typename TTransformPrecisionType>
+template <typename TEvaluator>
+void
+ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
+  LinearThreadedGenerateDataWithEvaluator(const OutputImageRegionType & outputRegionForThread,
+                                          const TEvaluator &            evaluator)
 {
   OutputImageType *      outputPtr = this->GetOutput();
   const InputImageType * inputPtr = this->GetInput();
@@ -453,9 +691,16 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   const auto firstIndexValueOfLargestPossibleRegion = largestPossibleRegion.GetIndex(0);
   const auto firstSizeValueOfLargestPossibleRegion = static_cast<double>(largestPossibleRegion.GetSize(0));
 
+  const IndexValueType firstIndexValueOfRegion = outputRegionForThread.GetIndex(0);
+  const IndexValueType endIndexValueOfRegion =
+    firstIndexValueOfRegion + static_cast<IndexValueType>(outputRegionForThread.GetSize(0));
+
   // Cache information from the superclass
   PixelType defaultValue = this->GetDefaultPixelValue();
 
+  const ContinuousInputIndexType & startContinuousIndexOfBuffer = m_Interpolator->GetStartContinuousIndex();
+  const ContinuousInputIndexType & endContinuousIndexOfBuffer = m_Interpolator->GetEndContinuousIndex();
+
   // As we walk across a scan line in the output image, we trace
   // an oriented/scaled/translated line in the input image. Each scan
   // line has a starting and ending point. Since all transforms
@@ -474,6 +719,19 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
       transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
   };
 
+  // Clamps a (possibly huge or fractional) scanline position to the region of this thread.
+  const auto clampToRegion = [firstIndexValueOfRegion, endIndexValueOfRegion](const double position) {
+    if (!(position > static_cast<double>(firstIndexValueOfRegion)))
+    {
+      return firstIndexValueOfRegion;
+    }
+    if (position >= static_cast<double>(endIndexValueOfRegion))
+    {
+      return endIndexValueOfRegion;
+    }
+    return static_cast<IndexValueType>(position);
+  };
+
   while (!outIt.IsAtEnd())
   {
     // Determine the continuous index of the first and end pixel of output
@@ -486,13 +744,11 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
     index[0] += firstSizeValueOfLargestPossibleRegion;
     const auto vectorFromStartIndex = transformIndex(index) - startIndex;
 
-    IndexValueType scanlineIndex = outIt.GetIndex()[0];
-
-
-    while (!outIt.IsAtEndOfLine())
-    {
-
-      // Perform linear interpolation from startIndex, along vectorFromStartIndex
+    // Perform linear interpolation from startIndex, along vectorFromStartIndex
+    const auto computeInputIndex = [&startIndex,
+                                    &vectorFromStartIndex,
+                                    firstIndexValueOfLargestPossibleRegion,
+                                    firstSizeValueOfLargestPossibleRegion](const IndexValueType scanlineIndex) {
       const double alpha =
         (scanlineIndex - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
 
@@ -501,27 +757,93 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
       {
         inputIndex[i] += alpha * vectorFromStartIndex[i];
       }
-
-      // Evaluate input at right position and copy to the output
-      if (m_Interpolator->IsInsideBuffer(inputIndex))
+      return inputIndex;
+    };
+
+    // The traced line is straight, and each of its coordinates is monotonic along the scan line, so the
+    // output pixels that map inside the input buffer form a single contiguous span. First estimate this
+    // span analytically (with a margin), then shrink it by the exact IsInsideBuffer() test, so that each
+    // pixel is classified exactly as a per-pixel test would, while the bounds check is removed from the
+    // inner loop.
+    IndexValueType spanBegin = firstIndexValueOfRegion;
+    IndexValueType spanEnd = endIndexValueOfRegion;
+
+    for (unsigned int i = 0; i < InputImageDimension && spanBegin < spanEnd; ++i)
+    {
+      const double direction = vectorFromStartIndex[i];
+      if (direction == 0.0)
       {
-        outIt.Set(Self::CastPixelWithBoundsChecking(m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+        if (!(startIndex[i] >= startContinuousIndexOfBuffer[i] && startIndex[i] < endContinuousIndexOfBuffer[i]))
+        {
+          spanEnd = spanBegin;
+        }
       }
       else
       {
-        if (m_Extrapolator.IsNull())
+        // Scan line positions at which this coordinate crosses the bounds of the buffer.
+        const double scale = firstSizeValueOfLargestPossibleRegion / direction;
+        double lower =
+          firstIndexValueOfLargestPossibleRegion + scale * (startContinuousIndexOfBuffer[i] - startIndex[i]);
+        double upper = firstIndexValueOfLargestPossibleRegion + scale * (endContinuousIndexOfBuffer[i] - startIndex[i]);
+        if (lower > upper)
         {
-          outIt.Set(defaultValue); // default background value
+          std::swap(lower, upper);
         }
-        else
+        if (std::isfinite(lower) && std::isfinite(upper))
         {
-          outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex)));
+          spanBegin = std::max(spanBegin, clampToRegion(std::floor(lower) - 2.0));
+          spanEnd = std::min(spanEnd, clampToRegion(std::ceil(upper) + 2.0));
         }
       }
+    }
 
+    while (spanBegin < spanEnd && !m_Interpolator->IsInsideBuffer(computeInputIndex(spanBegin)))
+    {
+      ++spanBegin;
+    }
+    while (spanEnd > spanBegin && !m_Interpolator->IsInsideBuffer(computeInputIndex(spanEnd - 1)))
+    {
+      --spanEnd;
+    }
+    if (spanBegin == spanEnd)
+    {
+      spanBegin = endIndexValueOfRegion;
+      spanEnd = endIndexValueOfRegion;
+    }
+
+    const auto setOutsideValue = [this, &outIt, &defaultValue, &computeInputIndex](const IndexValueType scanlineIndex) {
+      if (m_Extrapolator.IsNull())
+      {
+        outIt.Set(defaultValue); // default background value
+      }
+      else
+      {
+        outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(
+          computeInputIndex(scanlineIndex))));
+      }
+    };
+
+    IndexValueType scanlineIndex = firstIndexValueOfRegion;
+
+    for (; scanlineIndex < spanBegin; ++scanlineIndex)
+    {
+      setOutsideValue(scanlineIndex);
+      ++outIt;
+    }
+
+    // Evaluate input at right position and copy to the output
+    for (; scanlineIndex < spanEnd; ++scanlineIndex)
+    {
+      outIt.Set(Self::CastPixelWithBoundsChecking(evaluator(computeInputIndex(scanlineIndex))));
       ++outIt;
-      ++scanlineIndex;
     }
+
+    for (; scanlineIndex < endIndexValueOfRegion; ++scanlineIndex)
+    {
+      setOutsideValue(scanlineIndex);
+      ++outIt;
+    }
+
     outIt.NextLine();
     progress.Completed(outputRegionForThread.GetSize()[0]);
   }
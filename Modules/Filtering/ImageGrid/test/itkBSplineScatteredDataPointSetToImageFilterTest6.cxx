@@ -0,0 +1,160 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBSplineScatteredDataPointSetToImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkPointSet.h"
+#include "itkTestingMacros.h"
+
+
+/**
+ * In this test, we fit a 2D vector field over a 3D parametric domain,
+ * sampled at scattered points, with several levels, point weights and a
+ * closed dimension, with and without partitioning the control point lattice
+ * among the work units. The partitioned fits must not depend on the number
+ * of work units, and must agree with the default fit up to the order of the
+ * sums.
+ */
+namespace
+{
+constexpr unsigned int ParametricDimension = 3;
+constexpr unsigned int DataDimension = 2;
+
+using VectorType = itk::Vector<float, DataDimension>;
+using ImageType = itk::Image<VectorType, ParametricDimension>;
+using PointSetType = itk::PointSet<VectorType, ParametricDimension>;
+using FilterType = itk::BSplineScatteredDataPointSetToImageFilter<PointSetType, ImageType>;
+
+FilterType::Pointer
+CreateFilter(const PointSetType * pointSet, FilterType::WeightsContainerType * weights, itk::ThreadIdType workUnits)
+{
+  auto filter = FilterType::New();
+
+  ImageType::SizeType size;
+  size.Fill(33);
+  ImageType::SpacingType spacing;
+  spacing.Fill(1.0 / 32.0);
+  ImageType::PointType origin;
+  origin.Fill(0.0);
+
+  FilterType::ArrayType ncps;
+  ncps.Fill(5);
+  ncps[0] = 7;
+  FilterType::ArrayType close;
+  close.Fill(0);
+  close[0] = 1;
+
+  filter->SetSize(size);
+  filter->SetSpacing(spacing);
+  filter->SetOrigin(origin);
+  filter->SetSplineOrder(3);
+  filter->SetNumberOfControlPoints(ncps);
+  filter->SetNumberOfLevels(3);
+  filter->SetCloseDimension(close);
+  filter->SetInput(pointSet);
+  filter->SetPointWeights(weights);
+  filter->SetNumberOfWorkUnits(workUnits);
+
+  return filter;
+}
+
+double
+MaximumDifference(const ImageType * image1, const ImageType * image2)
+{
+  double                                   maximumDifference = 0.0;
+  itk::ImageRegionConstIterator<ImageType> It1(image1, image1->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> It2(image2, image2->GetLargestPossibleRegion());
+  for (; !It1.IsAtEnd(); ++It1, ++It2)
+  {
+    maximumDifference = std::max(maximumDifference, static_cast<double>((It1.Get() - It2.Get()).GetNorm()));
+  }
+  return maximumDifference;
+}
+} // namespace
+
+int
+itkBSplineScatteredDataPointSetToImageFilterTest6(int, char *[])
+{
+  auto pointSet = PointSetType::New();
+  auto weights = FilterType::WeightsContainerType::New();
+
+  // Deterministic scatter of points in the parametric domain, including
+  // points on its boundaries.
+  for (unsigned int n = 0; n < 4000; ++n)
+  {
+    PointSetType::PointType point;
+    for (unsigned int i = 0; i < ParametricDimension; ++i)
+    {
+      point[i] = static_cast<double>((n * (7919 + 104729 * i)) % 1001) / 1000.0;
+    }
+    pointSet->SetPoint(n, point);
+
+    VectorType V;
+    V[0] = std::cos(2.0 * itk::Math::pi * point[0]) + point[1] * point[2];
+    V[1] = std::sin(2.0 * itk::Math::pi * point[0]) - point[2];
+    pointSet->SetPointData(n, V);
+
+    weights->InsertElement(n, 0.5 + static_cast<float>(n % 5) / 4.0f);
+  }
+
+  auto filter = CreateFilter(pointSet, weights, 4);
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, BSplineScatteredDataPointSetToImageFilter, PointSetToImageFilter);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  ImageType::Pointer partitionedOutput;
+  ImageType::Pointer partitionedLattice;
+  for (const itk::ThreadIdType workUnits : { 1, 3, 8 })
+  {
+    auto partitionedFilter = CreateFilter(pointSet, weights, workUnits);
+
+    ITK_TEST_SET_GET_BOOLEAN(partitionedFilter, PartitionControlPointLattice, true);
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(partitionedFilter->Update());
+
+    if (partitionedOutput.IsNull())
+    {
+      partitionedOutput = partitionedFilter->GetOutput();
+      partitionedLattice = partitionedFilter->GetPhiLattice();
+
+      const double difference = MaximumDifference(partitionedOutput, filter->GetOutput());
+      std::cout << "Difference with the default fit: " << difference << std::endl;
+      ITK_TEST_EXPECT_TRUE(difference < 1e-4);
+    }
+    else
+    {
+      ITK_TEST_EXPECT_EQUAL(MaximumDifference(partitionedFilter->GetOutput(), partitionedOutput), 0.0);
+      ITK_TEST_EXPECT_EQUAL(MaximumDifference(partitionedFilter->GetPhiLattice(), partitionedLattice), 0.0);
+    }
+  }
+
+  // Points outside the parametric domain are reported before the fitting.
+  PointSetType::PointType outsidePoint;
+  outsidePoint.Fill(0.5);
+  outsidePoint[ParametricDimension - 1] = 1.5;
+  pointSet->SetPoint(0, outsidePoint);
+
+  auto outsideFilter = CreateFilter(pointSet, weights, 3);
+  outsideFilter->PartitionControlPointLatticeOn();
+  ITK_TRY_EXPECT_EXCEPTION(outsideFilter->Update());
+
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// The header file to be tested:
+#include "itkExpandImageFilter.h"
+
+#include "itkBSplineInterpolateImageFunction.h"
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+
+// Google Test header file:
+#include <gtest/gtest.h>
+
+// Standard C++ header files:
+#include <random>
+
+
+namespace
+{
+
+// A B-spline interpolator that behaves exactly like its base class. As its
+// type is different, ExpandImageFilter evaluates it pixel by pixel, instead of
+// on the output grid.
+class DerivedBSplineInterpolator : public itk::BSplineInterpolateImageFunction<itk::Image<float, 3>, double>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(DerivedBSplineInterpolator);
+
+  using Self = DerivedBSplineInterpolator;
+  using Superclass = itk::BSplineInterpolateImageFunction<itk::Image<float, 3>, double>;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+
+protected:
+  DerivedBSplineInterpolator() = default;
+  ~DerivedBSplineInterpolator() override = default;
+};
+
+} // namespace
+
+
+TEST(ExpandImageFilter, BSplineInterpolatorOnGridYieldsSameOutputAsPixelwiseEvaluation)
+{
+  using ImageType = itk::Image<float, 3>;
+  using InterpolatorType = itk::BSplineInterpolateImageFunction<ImageType, double>;
+
+  const auto image = ImageType::New();
+  image->SetRegions(itk::MakeSize(9, 7, 5));
+  image->Allocate();
+
+  std::default_random_engine randomEngine;
+  for (auto & pixel : itk::ImageBufferRange<ImageType>(*image))
+  {
+    pixel = std::uniform_real_distribution<float>{ 0.0f, 100.0f }(randomEngine);
+  }
+
+  const auto expand = [&image](InterpolatorType & interpolator) {
+    const auto filter = itk::ExpandImageFilter<ImageType, ImageType>::New();
+    filter->SetInput(image);
+    filter->SetInterpolator(&interpolator);
+    const unsigned int expandFactors[] = { 3, 2, 4 };
+    filter->SetExpandFactors(expandFactors);
+    filter->Update();
+    return ImageType::Pointer(filter->GetOutput());
+  };
+
+  for (unsigned int splineOrder = 0; splineOrder <= 5; ++splineOrder)
+  {
+    const auto gridInterpolator = InterpolatorType::New();
+    gridInterpolator->SetSplineOrder(splineOrder);
+    const auto pixelwiseInterpolator = DerivedBSplineInterpolator::New();
+    pixelwiseInterpolator->SetSplineOrder(splineOrder);
+
+    const auto gridOutput = expand(*gridInterpolator);
+    const auto pixelwiseOutput = expand(*pixelwiseInterpolator);
+
+    const itk::ImageBufferRange<const ImageType> gridRange(*gridOutput);
+    const itk::ImageBufferRange<const ImageType> pixelwiseRange(*pixelwiseOutput);
+    ASSERT_EQ(gridRange.size(), pixelwiseRange.size());
+    ASSERT_EQ(gridRange.size(), 27u * 14u * 20u);
+
+    for (std::size_t i = 0; i < gridRange.size(); ++i)
+    {
+      EXPECT_NEAR(gridRange[i], pixelwiseRange[i], 1e-3);
+    }
+  }
+}
@@ -19,7 +19,12 @@
 // The header file to be tested:
 #include "itkResampleImageFilter.h"
 
+#include "itkAffineTransform.h"
+#include "itkBSplineInterpolateImageFunction.h"
 #include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
 
 // Google Test header file:
 #include <gtest/gtest.h>
@@ -111,6 +116,161 @@ Expect_ResampleImageFilter_thows_on_incomplete_configuration(const TPixel inputP
   EXPECT_EQ(TestThrowErrorOnEmptyResampleSpace(inputPixel, true), inputPixel);
 }
 
+
+// An interpolator that behaves exactly like its base class, TInterpolator. As
+// its type is different, ResampleImageFilter cannot bypass its virtual
+// functions, so it is evaluated by the generic code path.
+template <typename TInterpolator>
+class DerivedInterpolator : public TInterpolator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(DerivedInterpolator);
+
+  using Self = DerivedInterpolator;
+  using Superclass = TInterpolator;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+
+protected:
+  DerivedInterpolator() = default;
+  ~DerivedInterpolator() override = default;
+};
+
+
+// Resamples a 3D image by an affine transform that maps part of the output
+// outside of the input, using the specified interpolator.
+template <typename TImage, typename TInterpolator>
+typename TImage::Pointer
+ResampleByAffineTransform(const TImage & inputImage, TInterpolator & interpolator)
+{
+  auto transform = itk::AffineTransform<double, 3>::New();
+  transform->Rotate(0, 1, 0.3);
+  transform->Rotate(1, 2, -0.2);
+  transform->Scale(0.85);
+  transform->Translate(itk::MakeVector(-3.25, 2.5, 1.75));
+
+  const auto filter = itk::ResampleImageFilter<TImage, TImage>::New();
+  filter->SetInput(&inputImage);
+  filter->SetTransform(transform);
+  filter->SetInterpolator(&interpolator);
+  filter->SetDefaultPixelValue(-1);
+  filter->SetOutputStartIndex(itk::MakeIndex(-2, 1, 0));
+  filter->SetSize(itk::MakeSize(23, 19, 11));
+  filter->Update();
+  return filter->GetOutput();
+}
+
+
+// Tests that resampling with the specified interpolator type yields the very
+// same output image as resampling with a derived interpolator, which does not
+// use the non-virtual scanline fast path.
+template <template <typename, typename> class TInterpolator>
+void
+Expect_fast_path_output_equal_to_generic_path_output()
+{
+  using ImageType = itk::Image<float, 3>;
+  using InterpolatorType = TInterpolator<ImageType, double>;
+
+  const auto image = ImageType::New();
+  image->SetRegions(itk::MakeSize(20, 17, 13));
+  image->Allocate();
+
+  std::default_random_engine randomEngine;
+  for (auto & pixel : itk::ImageBufferRange<ImageType>(*image))
+  {
+    pixel = std::uniform_real_distribution<float>{ 0.0f, 100.0f }(randomEngine);
+  }
+
+  const auto fastPathOutput = ResampleByAffineTransform(*image, *InterpolatorType::New());
+  const auto genericPathOutput = ResampleByAffineTransform(*image, *DerivedInterpolator<InterpolatorType>::New());
+
+  const itk::ImageBufferRange<const ImageType> fastPathRange(*fastPathOutput);
+  const itk::ImageBufferRange<const ImageType> genericPathRange(*genericPathOutput);
+  ASSERT_EQ(fastPathRange.size(), genericPathRange.size());
+
+  std::size_t numberOfDefaultPixels = 0;
+
+  for (std::size_t i = 0; i < fastPathRange.size(); ++i)
+  {
+    EXPECT_EQ(fastPathRange[i], genericPathRange[i]);
+    if (genericPathRange[i] == -1.0f)
+    {
+      ++numberOfDefaultPixels;
+    }
+  }
+
+  // Sanity check: the transform should map the output partly inside and partly outside of the input.
+  EXPECT_GT(numberOfDefaultPixels, 0u);
+  EXPECT_LT(numberOfDefaultPixels, fastPathRange.size());
+}
+
+
+// Tests that resampling by a scale and translation only transform with a
+// B-spline interpolator, which is evaluated on the output grid, yields the same
+// output as resampling with a derived B-spline interpolator, which is evaluated
+// pixel by pixel.
+void
+Expect_BSpline_grid_output_near_pixelwise_output(const unsigned int splineOrder)
+{
+  using ImageType = itk::Image<float, 3>;
+  using InterpolatorType = itk::BSplineInterpolateImageFunction<ImageType, double>;
+
+  const auto image = ImageType::New();
+  image->SetRegions(itk::MakeSize(12, 11, 9));
+  image->Allocate();
+
+  std::default_random_engine randomEngine;
+  for (auto & pixel : itk::ImageBufferRange<ImageType>(*image))
+  {
+    pixel = std::uniform_real_distribution<float>{ 0.0f, 100.0f }(randomEngine);
+  }
+
+  auto transform = itk::AffineTransform<double, 3>::New();
+  transform->Scale(itk::MakeVector(0.4, 0.55, 0.7));
+  transform->Translate(itk::MakeVector(-1.25, 0.5, 2.0));
+
+  const auto resample = [&image, &transform](InterpolatorType & interpolator) {
+    const auto filter = itk::ResampleImageFilter<ImageType, ImageType>::New();
+    filter->SetInput(image);
+    filter->SetTransform(transform);
+    filter->SetInterpolator(&interpolator);
+    filter->SetDefaultPixelValue(-1);
+    filter->SetOutputStartIndex(itk::MakeIndex(-3, 0, 2));
+    filter->SetSize(itk::MakeSize(31, 22, 12));
+    filter->Update();
+    return ImageType::Pointer(filter->GetOutput());
+  };
+
+  const auto gridInterpolator = InterpolatorType::New();
+  gridInterpolator->SetSplineOrder(splineOrder);
+  const auto pixelwiseInterpolator = DerivedInterpolator<InterpolatorType>::New();
+  pixelwiseInterpolator->SetSplineOrder(splineOrder);
+
+  const auto gridOutput = resample(*gridInterpolator);
+  const auto pixelwiseOutput = resample(*pixelwiseInterpolator);
+
+  const itk::ImageBufferRange<const ImageType> gridRange(*gridOutput);
+  const itk::ImageBufferRange<const ImageType> pixelwiseRange(*pixelwiseOutput);
+  ASSERT_EQ(gridRange.size(), pixelwiseRange.size());
+
+  std::size_t numberOfDefaultPixels = 0;
+
+  for (std::size_t i = 0; i < gridRange.size(); ++i)
+  {
+    EXPECT_NEAR(gridRange[i], pixelwiseRange[i], 1e-3);
+    if (pixelwiseRange[i] == -1.0f)
+    {
+      ++numberOfDefaultPixels;
+    }
+  }
+
+  // Sanity check: the transform should map the output partly inside and partly outside of the input.
+  EXPECT_GT(numberOfDefaultPixels, 0u);
+  EXPECT_LT(numberOfDefaultPixels, gridRange.size());
+}
+
 } // namespace
 
 // Compile time check of mixing transform and precision types
@@ -172,3 +332,24 @@ TEST(ResampleImageFilter, Expect_ResampleImageFilter_thows_on_incomplete_configu
 {
   Expect_ResampleImageFilter_thows_on_incomplete_configuration(128.0);
 }
+
+
+TEST(ResampleImageFilter, LinearInterpolatorFastPathYieldsSameOutputAsGenericPath)
+{
+  Expect_fast_path_output_equal_to_generic_path_output<itk::LinearInterpolateImageFunction>();
+}
+
+
+TEST(ResampleImageFilter, NearestNeighborInterpolatorFastPathYieldsSameOutputAsGenericPath)
+{
+  Expect_fast_path_output_equal_to_generic_path_output<itk::NearestNeighborInterpolateImageFunction>();
+}
+
+
+TEST(ResampleImageFilter, BSplineInterpolatorOnGridYieldsSameOutputAsPixelwiseEvaluation)
+{
+  for (unsigned int splineOrder = 0; splineOrder <= 5; ++splineOrder)
+  {
+    Expect_BSpline_grid_output_near_pixelwise_output(splineOrder);
+  }
+}
@@ -20,6 +20,7 @@
 
 #include "itkUnaryFunctorImageFilter.h"
 #include "itkSymmetricEigenAnalysis.h"
+#include "itkSymmetricEigenAnalysisBatch.h"
 #include "ITKImageIntensityExport.h"
 
 namespace itk
@@ -184,6 +185,19 @@ public:
       m_Calculator.SetOrderEigenValues(false);
     }
   }
+  EigenValueOrderEnum
+  GetOrderEigenValuesBy() const
+  {
+    if (m_Calculator.GetOrderEigenMagnitudes())
+    {
+      return EigenValueOrderEnum::OrderByMagnitude;
+    }
+    if (m_Calculator.GetOrderEigenValues())
+    {
+      return EigenValueOrderEnum::OrderByValue;
+    }
+    return EigenValueOrderEnum::DoNotOrder;
+  }
 
 private:
   CalculatorType m_Calculator;
@@ -209,6 +223,12 @@ extern ITKImageIntensity_EXPORT std::ostream &
  * OrderByMagnitude:  |lambda_1| < |lambda_2| < .....
  * DoNotOrder:        Default order of eigen values obtained after QL method
  *
+ * When the eigen values are ordered and the dimension of the matrices is 2
+ * or 3, they are computed for blocks of pixels of a scanline with
+ * SymmetricEigenAnalysisBatch.
+ *
+ * \sa SymmetricEigenAnalysisBatch
+ *
  * \ingroup IntensityImageFilters  MultiThreaded  TensorObjects
  *
  * \ingroup ITKImageIntensity
@@ -297,6 +317,11 @@ public:
 protected:
   SymmetricEigenAnalysisImageFilter() { this->SetDimension(TInputImage::ImageDimension); }
   ~SymmetricEigenAnalysisImageFilter() override = default;
+
+  using typename Superclass::OutputImageRegionType;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 };
 
 /**
@@ -313,6 +338,12 @@ protected:
  * OrderByMagnitude:  |lambda_1| < |lambda_2| < .....
  * DoNotOrder:        Default order of eigen values obtained after QL method
  *
+ * When the dimension of the matrices is 2 or 3, the eigen values are
+ * computed for blocks of pixels of a scanline with
+ * SymmetricEigenAnalysisBatch.
+ *
+ * \sa SymmetricEigenAnalysisBatch
+ *
  * \ingroup IntensityImageFilters  MultiThreaded  TensorObjects
  *
  * \ingroup ITKImageIntensity
@@ -387,7 +418,22 @@ public:
 protected:
   SymmetricEigenAnalysisFixedDimensionImageFilter() = default;
   ~SymmetricEigenAnalysisFixedDimensionImageFilter() override = default;
+
+  using typename Superclass::OutputImageRegionType;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, std::true_type);
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, std::false_type);
 };
 } // end namespace itk
 
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkSymmetricEigenAnalysisImageFilter.hxx"
+#endif
+
 #endif
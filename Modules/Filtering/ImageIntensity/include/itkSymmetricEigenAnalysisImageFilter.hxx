@@ -0,0 +1,147 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSymmetricEigenAnalysisImageFilter_hxx
+#define itkSymmetricEigenAnalysisImageFilter_hxx
+
+#include "itkImageScanlineIterator.h"
+#include "itkTotalProgressReporter.h"
+
+namespace itk
+{
+namespace detail
+{
+/** Compute the eigen values of the matrix pixels of a region with
+ * SymmetricEigenAnalysisBatch, one block of pixels of a scanline at a time. */
+template <unsigned int VMatrixDimension, typename TInputImage, typename TOutputImage>
+void
+ComputeSymmetricEigenValuesByBlocks(const TInputImage *                       input,
+                                    const typename TInputImage::RegionType &  inputRegion,
+                                    TOutputImage *                            output,
+                                    const typename TOutputImage::RegionType & outputRegion,
+                                    EigenValueOrderEnum                       order,
+                                    TotalProgressReporter &                   progress)
+{
+  using BatchType = SymmetricEigenAnalysisBatch<VMatrixDimension>;
+
+  BatchType batch;
+
+  ImageScanlineConstIterator<TInputImage> inputIt(input, inputRegion);
+  ImageScanlineIterator<TOutputImage>     outputIt(output, outputRegion);
+
+  while (!inputIt.IsAtEnd())
+  {
+    while (!inputIt.IsAtEndOfLine())
+    {
+      unsigned int numberOfMatrices = 0;
+      for (; numberOfMatrices < BatchType::BlockSize && !inputIt.IsAtEndOfLine(); ++numberOfMatrices, ++inputIt)
+      {
+        batch.SetMatrix(numberOfMatrices, inputIt.Get());
+      }
+
+      batch.ComputeEigenValues(numberOfMatrices);
+
+      for (unsigned int n = 0; n < numberOfMatrices; ++n, ++outputIt)
+      {
+        typename TOutputImage::PixelType eigenValues;
+        batch.GetEigenValues(n, eigenValues, order);
+        outputIt.Set(eigenValues);
+      }
+    }
+    inputIt.NextLine();
+    outputIt.NextLine();
+    progress.Completed(outputRegion.GetSize()[0]);
+  }
+}
+} // end namespace detail
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+SymmetricEigenAnalysisImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  const EigenValueOrderEnum order = this->GetOrderEigenValuesBy();
+  const unsigned int        dimension = this->GetDimension();
+
+  // the order of the eigen values of the QL method is kept when they are
+  // not ordered
+  if (order == EigenValueOrderEnum::DoNotOrder || (dimension != 2 && dimension != 3))
+  {
+    Superclass::DynamicThreadedGenerateData(outputRegionForThread);
+    return;
+  }
+
+  typename Superclass::InputImageRegionType inputRegionForThread;
+  this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
+
+  TOutputImage *        output = this->GetOutput();
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  if (dimension == 2)
+  {
+    detail::ComputeSymmetricEigenValuesByBlocks<2>(
+      this->GetInput(), inputRegionForThread, output, outputRegionForThread, order, progress);
+  }
+  else
+  {
+    detail::ComputeSymmetricEigenValuesByBlocks<3>(
+      this->GetInput(), inputRegionForThread, output, outputRegionForThread, order, progress);
+  }
+}
+
+
+template <unsigned int TMatrixDimension, typename TInputImage, typename TOutputImage>
+void
+SymmetricEigenAnalysisFixedDimensionImageFilter<TMatrixDimension, TInputImage, TOutputImage>::
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  this->DynamicThreadedGenerateData(outputRegionForThread,
+                                    std::integral_constant < bool, TMatrixDimension == 2 || TMatrixDimension == 3 > ());
+}
+
+
+template <unsigned int TMatrixDimension, typename TInputImage, typename TOutputImage>
+void
+SymmetricEigenAnalysisFixedDimensionImageFilter<TMatrixDimension, TInputImage, TOutputImage>::
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, std::true_type)
+{
+  typename Superclass::InputImageRegionType inputRegionForThread;
+  this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
+
+  TOutputImage *        output = this->GetOutput();
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  detail::ComputeSymmetricEigenValuesByBlocks<TMatrixDimension>(this->GetInput(),
+                                                                inputRegionForThread,
+                                                                output,
+                                                                outputRegionForThread,
+                                                                this->GetFunctor().GetOrderEigenValuesBy(),
+                                                                progress);
+}
+
+
+template <unsigned int TMatrixDimension, typename TInputImage, typename TOutputImage>
+void
+SymmetricEigenAnalysisFixedDimensionImageFilter<TMatrixDimension, TInputImage, TOutputImage>::
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, std::false_type)
+{
+  Superclass::DynamicThreadedGenerateData(outputRegionForThread);
+}
+} // end namespace itk
+
+#endif
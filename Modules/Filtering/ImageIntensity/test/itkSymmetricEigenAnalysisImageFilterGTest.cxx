@@ -0,0 +1,120 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkSymmetricEigenAnalysisImageFilter.h"
+#include "itkSymmetricSecondRankTensor.h"
+
+#include <algorithm>
+
+
+// The eigen values computed by blocks of pixels by the filters are compared
+// with the ones of their functor, evaluated for each pixel.
+
+namespace
+{
+
+template <typename TImage>
+typename TImage::Pointer
+CreateRandomTensorImage()
+{
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::SizeType{ { 71, 13, 5 } });
+  image->Allocate();
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(97531);
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    typename TImage::PixelType tensor;
+    for (auto & component : tensor)
+    {
+      component = generator->GetNormalVariate(0.0, 10.0);
+    }
+    it.Set(tensor);
+  }
+  return image;
+}
+
+template <typename TFilter>
+void
+ExpectFunctorValues(TFilter * filter, double tolerance)
+{
+  using InputImageType = typename TFilter::InputImageType;
+  using OutputImageType = typename TFilter::OutputImageType;
+
+  // the settings of the functor do not modify the filter
+  filter->Modified();
+  filter->Update();
+  const InputImageType *  input = filter->GetInput();
+  const OutputImageType * output = filter->GetOutput();
+
+  itk::ImageRegionConstIterator<InputImageType>  inputIt(input, input->GetBufferedRegion());
+  itk::ImageRegionConstIterator<OutputImageType> outputIt(output, output->GetBufferedRegion());
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++outputIt)
+  {
+    const typename OutputImageType::PixelType expected = filter->GetFunctor()(inputIt.Get());
+    // the error on every eigen value is relative to the norm of the matrix;
+    // the QL iterations of the functor stop at a relative error above 1e-10
+    double norm = 1.0;
+    for (unsigned int i = 0; i < filter->GetDimension(); ++i)
+    {
+      norm = std::max(norm, static_cast<double>(itk::Math::abs(expected[i])));
+    }
+    for (unsigned int i = 0; i < filter->GetDimension(); ++i)
+    {
+      ASSERT_NEAR(outputIt.Get()[i], expected[i], tolerance * norm);
+    }
+  }
+}
+
+} // namespace
+
+
+TEST(SymmetricEigenAnalysisImageFilter, SameEigenValuesAsFunctor)
+{
+  using InputImageType = itk::Image<itk::SymmetricSecondRankTensor<double, 3>, 3>;
+  using OutputImageType = itk::Image<itk::Vector<double, 3>, 3>;
+  using FilterType = itk::SymmetricEigenAnalysisImageFilter<InputImageType, OutputImageType>;
+
+  auto filter = FilterType::New();
+  filter->SetInput(CreateRandomTensorImage<InputImageType>());
+  ExpectFunctorValues(filter.GetPointer(), 1e-8);
+
+  filter->OrderEigenValuesBy(itk::EigenValueOrderEnum::OrderByMagnitude);
+  ExpectFunctorValues(filter.GetPointer(), 1e-8);
+}
+
+
+TEST(SymmetricEigenAnalysisImageFilter, FixedDimensionSameEigenValuesAsFunctor)
+{
+  using InputImageType = itk::Image<itk::SymmetricSecondRankTensor<float, 2>, 3>;
+  using OutputImageType = itk::Image<itk::FixedArray<float, 2>, 3>;
+  using FilterType = itk::SymmetricEigenAnalysisFixedDimensionImageFilter<2, InputImageType, OutputImageType>;
+
+  auto filter = FilterType::New();
+  filter->SetInput(CreateRandomTensorImage<InputImageType>());
+  ExpectFunctorValues(filter.GetPointer(), 1e-5);
+
+  filter->OrderEigenValuesBy(itk::EigenValueOrderEnum::OrderByMagnitude);
+  ExpectFunctorValues(filter.GetPointer(), 1e-5);
+}
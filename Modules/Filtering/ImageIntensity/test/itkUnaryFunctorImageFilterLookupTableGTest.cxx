@@ -0,0 +1,225 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkIntensityWindowingImageFilter.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkRescaleIntensityImageFilter.h"
+#include "itkSigmoidImageFilter.h"
+#include "itkUnaryFunctorImageFilter.h"
+
+#include <atomic>
+#include <limits>
+
+
+// The output of the filters with an integer input of at most 16 bits, read
+// from a lookup table when the image is large enough, is compared with the
+// evaluation of the functor of the filter for each pixel.
+
+namespace
+{
+
+template <typename TImage>
+typename TImage::Pointer
+CreateRandomImage(itk::SizeValueType width, itk::SizeValueType height)
+{
+  using PixelType = typename TImage::PixelType;
+  using LimitsType = std::numeric_limits<PixelType>;
+
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::SizeType{ { width, height } });
+  image->Allocate();
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(24680);
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto range = static_cast<uint32_t>(static_cast<int>(LimitsType::max()) - LimitsType::lowest());
+    it.Set(static_cast<PixelType>(static_cast<int>(LimitsType::lowest()) + generator->GetIntegerVariate(range)));
+  }
+  return image;
+}
+
+template <typename TFilter>
+void
+ExpectFunctorValues(TFilter * filter)
+{
+  using InputImageType = typename TFilter::InputImageType;
+  using OutputImageType = typename TFilter::OutputImageType;
+
+  filter->Update();
+  const InputImageType *  input = filter->GetInput();
+  const OutputImageType * output = filter->GetOutput();
+
+  itk::ImageRegionConstIterator<InputImageType>  inputIt(input, input->GetBufferedRegion());
+  itk::ImageRegionConstIterator<OutputImageType> outputIt(output, output->GetBufferedRegion());
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++outputIt)
+  {
+    ASSERT_EQ(outputIt.Get(), filter->GetFunctor()(inputIt.Get()));
+  }
+}
+
+class ScaleShiftFunctor
+{
+public:
+  bool
+  operator==(const ScaleShiftFunctor &) const
+  {
+    return true;
+  }
+  bool
+  operator!=(const ScaleShiftFunctor &) const
+  {
+    return false;
+  }
+  short
+  operator()(signed char value) const
+  {
+    return static_cast<short>(3 * value + 1);
+  }
+};
+
+// Counts its calls, and so must not be evaluated for the values of the
+// lookup table.
+class CountingFunctor
+{
+public:
+  bool
+  operator==(const CountingFunctor & other) const
+  {
+    return m_Count == other.m_Count;
+  }
+  bool
+  operator!=(const CountingFunctor & other) const
+  {
+    return !(*this == other);
+  }
+  unsigned char
+  operator()(unsigned char value) const
+  {
+    ++*m_Count;
+    return value;
+  }
+
+  std::atomic<itk::SizeValueType> * m_Count{ nullptr };
+};
+
+} // namespace
+
+
+TEST(UnaryFunctorImageFilterLookupTable, IntensityWindowing)
+{
+  using InputImageType = itk::Image<unsigned short, 2>;
+  using OutputImageType = itk::Image<unsigned char, 2>;
+  using FilterType = itk::IntensityWindowingImageFilter<InputImageType, OutputImageType>;
+
+  auto filter = FilterType::New();
+  filter->SetInput(CreateRandomImage<InputImageType>(301, 257));
+  filter->SetWindowMinimum(1000);
+  filter->SetWindowMaximum(40000);
+  filter->SetOutputMinimum(10);
+  filter->SetOutputMaximum(250);
+  ExpectFunctorValues(filter.GetPointer());
+
+  // the lookup table is computed again when the functor changes
+  filter->SetWindowLevel(20000, 30000);
+  ExpectFunctorValues(filter.GetPointer());
+}
+
+
+TEST(UnaryFunctorImageFilterLookupTable, Sigmoid)
+{
+  using InputImageType = itk::Image<short, 2>;
+  using OutputImageType = itk::Image<float, 2>;
+  using FilterType = itk::SigmoidImageFilter<InputImageType, OutputImageType>;
+
+  auto filter = FilterType::New();
+  filter->SetInput(CreateRandomImage<InputImageType>(300, 250));
+  filter->SetAlpha(2000.0);
+  filter->SetBeta(-500.0);
+  filter->SetOutputMinimum(-1.0);
+  filter->SetOutputMaximum(1.0);
+  ExpectFunctorValues(filter.GetPointer());
+}
+
+
+TEST(UnaryFunctorImageFilterLookupTable, RescaleIntensity)
+{
+  using ImageType = itk::Image<unsigned char, 2>;
+  using FilterType = itk::RescaleIntensityImageFilter<ImageType, ImageType>;
+
+  // smaller and larger than the lookup table
+  for (const itk::SizeValueType size : { 10, 40 })
+  {
+    auto filter = FilterType::New();
+    filter->SetInput(CreateRandomImage<ImageType>(size, size));
+    filter->SetOutputMinimum(100);
+    filter->SetOutputMaximum(200);
+    ExpectFunctorValues(filter.GetPointer());
+  }
+}
+
+
+TEST(UnaryFunctorImageFilterLookupTable, SignedInput)
+{
+  using InputImageType = itk::Image<signed char, 2>;
+  using OutputImageType = itk::Image<short, 2>;
+  using FilterType = itk::UnaryFunctorImageFilter<InputImageType, OutputImageType, ScaleShiftFunctor>;
+
+  auto filter = FilterType::New();
+  filter->SetInput(CreateRandomImage<InputImageType>(33, 17));
+  ExpectFunctorValues(filter.GetPointer());
+
+  const OutputImageType * output = filter->GetOutput();
+  itk::ImageRegionConstIterator<InputImageType> inputIt(filter->GetInput(), output->GetBufferedRegion());
+  for (itk::ImageRegionConstIterator<OutputImageType> it(output, output->GetBufferedRegion()); !it.IsAtEnd();
+       ++it, ++inputIt)
+  {
+    ASSERT_EQ(it.Get(), 3 * inputIt.Get() + 1);
+  }
+}
+
+
+TEST(UnaryFunctorImageFilterLookupTable, UseLookupTableOff)
+{
+  using ImageType = itk::Image<unsigned char, 2>;
+  using FilterType = itk::UnaryFunctorImageFilter<ImageType, ImageType, CountingFunctor>;
+
+  std::atomic<itk::SizeValueType> count{ 0 };
+  CountingFunctor                 functor;
+  functor.m_Count = &count;
+
+  auto filter = FilterType::New();
+  filter->SetInput(CreateRandomImage<ImageType>(40, 40));
+  filter->SetFunctor(functor);
+  EXPECT_TRUE(filter->GetUseLookupTable());
+
+  // the functor is evaluated for each value of the input pixel type
+  filter->Update();
+  EXPECT_EQ(count, 256u);
+
+  // and for each pixel without the lookup table
+  count = 0;
+  filter->UseLookupTableOff();
+  EXPECT_FALSE(filter->GetUseLookupTable());
+  filter->Update();
+  EXPECT_EQ(count, 40u * 40u);
+}
@@ -22,6 +22,7 @@
 #include "itkStructHashFunction.h"
 #include "itkMath.h"
 #include <cmath>
+#include <cstddef>
 namespace itk
 {
 namespace Function
@@ -79,6 +80,19 @@ public:
     double         sum = 0.0;
     auto           itMap = m_Map.begin();
     const RealType u = ((double)pixel - m_Minimum) / iscale - 0.5;
+    if (m_CumulativeFunctionTable != nullptr)
+    {
+      // the part of the cumulative function which depends on the difference
+      // of the pixel values is read from the table
+      const double   ikernel = m_KernelSize - m_BoundaryCount;
+      const RealType offset = m_Beta * u;
+      for (; itMap != m_Map.end(); ++itMap)
+      {
+        const auto difference = static_cast<std::ptrdiff_t>(pixel) - static_cast<std::ptrdiff_t>(itMap->first);
+        sum += itMap->second * static_cast<RealType>(m_CumulativeFunctionTable[difference] + offset) / ikernel;
+      }
+      return (TOutputPixel)(iscale * (sum + 0.5) + m_Minimum);
+    }
     while (itMap != m_Map.end())
     {
       const RealType v = ((double)itMap->first - m_Minimum) / iscale - 0.5;
@@ -119,6 +133,16 @@ public:
     m_KernelSize = kernelSize;
   }
 
+  /** Set the values of the cumulative function without the term which
+   * depends on the pixel value, for each difference of integer pixel values.
+   * The table is indexed from -(maximum - minimum) to (maximum - minimum),
+   * and is not owned by the histogram. */
+  void
+  SetCumulativeFunctionTable(const RealType * table)
+  {
+    m_CumulativeFunctionTable = table;
+  }
+
   void
   SetMinimum(TInputPixel minimum)
   {
@@ -138,6 +162,8 @@ private:
   TInputPixel m_Minimum;
   TInputPixel m_Maximum;
 
+  const RealType * m_CumulativeFunctionTable{ nullptr };
+
   RealType
   CumulativeFunction(RealType u, RealType v)
   {
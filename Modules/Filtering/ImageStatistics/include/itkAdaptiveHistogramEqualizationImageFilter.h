@@ -21,6 +21,7 @@
 #include "itkMovingHistogramImageFilter.h"
 #include "itkAdaptiveEqualizationHistogram.h"
 #include "itkImage.h"
+#include <vector>
 
 namespace itk
 {
@@ -57,6 +58,14 @@ namespace itk
  * outside the image, and over-weights the valid part of the
  * neighborhood.
  *
+ * The histogram of the window is updated incrementally as the window
+ * slides along the lines of the image, see MovingHistogramImageFilter. For
+ * the images of integers whose range of values is not larger than 65535, the
+ * power law is tabulated for each difference of pixel values, so that the
+ * mapping of a pixel only costs one table lookup per distinct value in its
+ * window. The tile-based ContrastLimitedAdaptiveHistogramEqualizationImageFilter
+ * is a faster alternative for large windows.
+ *
  * For detail description, reference "Adaptive Image Contrast
  * Enhancement using Generalizations of Histogram Equalization."
  * J.Alex Stark. IEEE Transactions on Image Processing, May 2000.
@@ -145,6 +154,11 @@ public:
     h.SetBeta(this->m_Beta);
     h.SetMinimum(this->m_InputMinimum);
     h.SetMaximum(this->m_InputMaximum);
+    if (!m_CumulativeFunctionTable.empty())
+    {
+      // centered on the null difference of pixel values
+      h.SetCumulativeFunctionTable(m_CumulativeFunctionTable.data() + m_CumulativeFunctionTable.size() / 2);
+    }
 
     typename Superclass::HistogramType::RealType kernelSize = 1;
     for (unsigned int i = 0; i < ImageDimension; ++i)
@@ -186,6 +200,9 @@ private:
   InputPixelType m_InputMaximum;
 
   bool m_UseLookupTable;
+
+  /** The tabulated cumulative function, for the images of integers. */
+  std::vector<typename Superclass::HistogramType::RealType> m_CumulativeFunctionTable;
 };
 } // end namespace itk
 
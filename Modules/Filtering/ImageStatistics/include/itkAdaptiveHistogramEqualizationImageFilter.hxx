@@ -50,6 +50,26 @@ AdaptiveHistogramEqualizationImageFilter<TImageType, TKernel>::BeforeThreadedGen
 
   m_InputMinimum = minmax->GetMinimum();
   m_InputMaximum = minmax->GetMaximum();
+
+  // Tabulate the terms of the cumulative function of the histogram which only
+  // depend on the difference of the pixel values, with the same
+  // normalization of the pixel values to [-0.5 0.5].
+  using RealType = typename Superclass::HistogramType::RealType;
+  constexpr double maximumRange = 65535.0;
+  const double     iscale = static_cast<double>(m_InputMaximum) - static_cast<double>(m_InputMinimum);
+  m_CumulativeFunctionTable.clear();
+  if (NumericTraits<InputPixelType>::is_integer && iscale > 0.0 && iscale <= maximumRange)
+  {
+    const auto range = static_cast<std::ptrdiff_t>(iscale);
+    m_CumulativeFunctionTable.resize(2 * range + 1);
+    for (std::ptrdiff_t difference = -range; difference <= range; ++difference)
+    {
+      const auto     d = static_cast<RealType>(difference / iscale);
+      const RealType s = itk::Math::sgn(d);
+      const RealType ad = itk::Math::abs(2.0 * d);
+      m_CumulativeFunctionTable[difference + range] = 0.5 * s * std::pow(ad, m_Alpha) - m_Beta * 0.5 * s * ad;
+    }
+  }
 }
 
 template <typename TImageType, typename TKernel>
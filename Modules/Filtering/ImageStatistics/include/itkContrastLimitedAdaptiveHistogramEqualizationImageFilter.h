@@ -0,0 +1,155 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkContrastLimitedAdaptiveHistogramEqualizationImageFilter_h
+#define itkContrastLimitedAdaptiveHistogramEqualizationImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+#include <vector>
+
+namespace itk
+{
+/** \class ContrastLimitedAdaptiveHistogramEqualizationImageFilter
+ * \brief Contrast limited adaptive histogram equalization (CLAHE) computed
+ * on a grid of tiles.
+ *
+ * The image is divided in NumberOfTiles tiles along each dimension. The
+ * histogram of each tile is computed with NumberOfHistogramBins bins over
+ * the range of values of the whole image, and is clipped at ClipLimit times
+ * the mean frequency of its bins: the frequencies in excess are distributed
+ * uniformly over all the bins. Each tile then maps the values of the image
+ * to the cumulative distribution of its clipped histogram, scaled to the
+ * range of values of the image. The output value of a pixel is the
+ * N-linear interpolation of the mappings of the 2^N tiles whose centers
+ * surround the pixel, so that there is no discontinuity at the borders of
+ * the tiles.
+ *
+ * The histograms are computed once for the whole image, which makes the
+ * computation time independent of the size of the tiles, as opposed to
+ * AdaptiveHistogramEqualizationImageFilter which computes the histogram of
+ * a window around each pixel. A ClipLimit lower than or equal to 0 disables
+ * the clipping.
+ *
+ * The whole input image is required to compute the histograms.
+ *
+ * For detail description, reference "Contrast Limited Adaptive Histogram
+ * Equalization." K. Zuiderveld. Graphics Gems IV, 1994.
+ *
+ * \sa AdaptiveHistogramEqualizationImageFilter
+ * \ingroup ImageEnhancement
+ * \ingroup ITKImageStatistics
+ */
+template <typename TImage>
+class ITK_TEMPLATE_EXPORT ContrastLimitedAdaptiveHistogramEqualizationImageFilter
+  : public ImageToImageFilter<TImage, TImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ContrastLimitedAdaptiveHistogramEqualizationImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = ContrastLimitedAdaptiveHistogramEqualizationImageFilter;
+  using Superclass = ImageToImageFilter<TImage, TImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  static constexpr unsigned int ImageDimension = TImage::ImageDimension;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ContrastLimitedAdaptiveHistogramEqualizationImageFilter, ImageToImageFilter);
+
+  /** Image type type alias support */
+  using ImageType = TImage;
+  using PixelType = typename ImageType::PixelType;
+  using RegionType = typename ImageType::RegionType;
+  using SizeType = typename ImageType::SizeType;
+  using IndexType = typename ImageType::IndexType;
+
+  /** Set/Get the number of tiles along each dimension. The number of tiles
+   * is reduced along the dimensions where the image is smaller. Default
+   * is 8. */
+  itkSetMacro(NumberOfTiles, SizeType);
+  itkGetConstReferenceMacro(NumberOfTiles, SizeType);
+
+  /** Set/Get the maximum frequency of the bins of the histograms, relative
+   * to the mean frequency of the bins. A value lower than or equal to 0
+   * disables the clipping. Default is 4. */
+  itkSetMacro(ClipLimit, double);
+  itkGetConstMacro(ClipLimit, double);
+
+  /** Set/Get the number of bins of the histograms. Default is 256. */
+  itkSetClampMacro(NumberOfHistogramBins, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfHistogramBins, unsigned int);
+
+protected:
+  ContrastLimitedAdaptiveHistogramEqualizationImageFilter();
+  ~ContrastLimitedAdaptiveHistogramEqualizationImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The histograms of the tiles require the whole input image. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** Compute the range of the image, and the mapping of each tile. */
+  void
+  BeforeThreadedGenerateData() override;
+
+  void
+  DynamicThreadedGenerateData(const RegionType & outputRegionForThread) override;
+
+private:
+  /** Interpolation of the mappings of the tiles along a dimension, for a
+   * pixel position. */
+  struct TileInterpolation
+  {
+    SizeValueType m_Tile0;
+    SizeValueType m_Tile1;
+    double        m_Weight1;
+  };
+
+  /** Return the bin of the histograms of a pixel value. */
+  SizeValueType
+  GetBin(const PixelType & value) const;
+
+  SizeType     m_NumberOfTiles;
+  double       m_ClipLimit{ 4.0 };
+  unsigned int m_NumberOfHistogramBins{ 256 };
+
+  double m_Minimum{ 0.0 };
+  double m_Maximum{ 0.0 };
+  double m_BinScale{ 0.0 };
+
+  /** The tile interpolation of each position along each dimension, and the
+   * offset of the tiles along each dimension. */
+  std::vector<TileInterpolation> m_TileInterpolations[ImageDimension];
+  SizeValueType                  m_TileStrides[ImageDimension];
+
+  /** The mapped values of the bins, for each tile. */
+  std::vector<double> m_Mappings;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkContrastLimitedAdaptiveHistogramEqualizationImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,276 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkContrastLimitedAdaptiveHistogramEqualizationImageFilter_hxx
+#define itkContrastLimitedAdaptiveHistogramEqualizationImageFilter_hxx
+
+#include "itkImageRegionConstIterator.h"
+#include "itkImageScanlineIterator.h"
+#include "itkMinimumMaximumImageFilter.h"
+#include "itkTotalProgressReporter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+
+template <typename TImage>
+ContrastLimitedAdaptiveHistogramEqualizationImageFilter<TImage>::
+  ContrastLimitedAdaptiveHistogramEqualizationImageFilter()
+{
+  m_NumberOfTiles.Fill(8);
+  std::fill_n(m_TileStrides, ImageDimension, 0);
+  this->DynamicMultiThreadingOn();
+}
+
+template <typename TImage>
+void
+ContrastLimitedAdaptiveHistogramEqualizationImageFilter<TImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  if (this->GetInput())
+  {
+    auto * input = const_cast<ImageType *>(this->GetInput());
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <typename TImage>
+void
+ContrastLimitedAdaptiveHistogramEqualizationImageFilter<TImage>::BeforeThreadedGenerateData()
+{
+  auto input = ImageType::New();
+  input->Graft(const_cast<ImageType *>(this->GetInput()));
+
+  using MinMaxFilter = MinimumMaximumImageFilter<ImageType>;
+  auto minmax = MinMaxFilter::New();
+  minmax->SetInput(input);
+  minmax->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  minmax->Update();
+
+  m_Minimum = static_cast<double>(minmax->GetMinimum());
+  m_Maximum = static_cast<double>(minmax->GetMaximum());
+
+  // The bins of the integer values include their upper value, so that each
+  // value has the same number of bins.
+  const double range = m_Maximum - m_Minimum + (NumericTraits<PixelType>::is_integer ? 1.0 : 0.0);
+  m_BinScale = range > 0.0 ? m_NumberOfHistogramBins / range : 0.0;
+
+  // Divide the image in tiles of the same size, except for the last tile
+  // along each dimension, and compute the interpolation of the tiles at
+  // each position from the centers of the tiles.
+  const RegionType    region = input->GetLargestPossibleRegion();
+  SizeType            tileSize;
+  SizeType            numberOfTiles;
+  SizeValueType       totalNumberOfTiles = 1;
+  const SizeValueType numberOfBins = m_NumberOfHistogramBins;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    const SizeValueType size = region.GetSize(d);
+    const SizeValueType tiles = std::max<SizeValueType>(1, std::min(m_NumberOfTiles[d], size));
+    tileSize[d] = (size + tiles - 1) / tiles;
+    numberOfTiles[d] = (size + tileSize[d] - 1) / tileSize[d];
+    m_TileStrides[d] = totalNumberOfTiles;
+    totalNumberOfTiles *= numberOfTiles[d];
+
+    std::vector<double> centers(numberOfTiles[d]);
+    for (SizeValueType tile = 0; tile < numberOfTiles[d]; ++tile)
+    {
+      const SizeValueType length = std::min(tileSize[d], size - tile * tileSize[d]);
+      centers[tile] = tile * tileSize[d] + (length - 1) / 2.0;
+    }
+
+    m_TileInterpolations[d].resize(size);
+    SizeValueType tile = 0;
+    for (SizeValueType position = 0; position < size; ++position)
+    {
+      while (tile + 1 < numberOfTiles[d] && centers[tile + 1] <= position)
+      {
+        ++tile;
+      }
+      TileInterpolation & interpolation = m_TileInterpolations[d][position];
+      if (position <= centers[tile] || tile + 1 == numberOfTiles[d])
+      {
+        // before the first center or after the last one
+        interpolation = { tile, tile, 0.0 };
+      }
+      else
+      {
+        interpolation = { tile, tile + 1, (position - centers[tile]) / (centers[tile + 1] - centers[tile]) };
+      }
+    }
+  }
+
+  // Map the bins of each tile to the clipped cumulative distribution of the
+  // tile.
+  m_Mappings.assign(totalNumberOfTiles * numberOfBins, m_Minimum);
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    totalNumberOfTiles,
+    [&](SizeValueType tileNumber) {
+      RegionType    tileRegion;
+      SizeValueType remainder = tileNumber;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        const SizeValueType tile = remainder % numberOfTiles[d];
+        remainder /= numberOfTiles[d];
+        tileRegion.SetIndex(d, region.GetIndex(d) + static_cast<IndexValueType>(tile * tileSize[d]));
+        tileRegion.SetSize(d, std::min(tileSize[d], region.GetSize(d) - tile * tileSize[d]));
+      }
+
+      std::vector<double> histogram(numberOfBins, 0.0);
+      for (ImageRegionConstIterator<ImageType> it(input, tileRegion); !it.IsAtEnd(); ++it)
+      {
+        ++histogram[this->GetBin(it.Get())];
+      }
+
+      const double numberOfPixels = tileRegion.GetNumberOfPixels();
+      if (m_ClipLimit > 0.0)
+      {
+        const double limit = std::max(1.0, m_ClipLimit * numberOfPixels / numberOfBins);
+        double       excess = 0.0;
+        for (double & frequency : histogram)
+        {
+          if (frequency > limit)
+          {
+            excess += frequency - limit;
+            frequency = limit;
+          }
+        }
+        const double redistributed = excess / numberOfBins;
+        for (double & frequency : histogram)
+        {
+          frequency += redistributed;
+        }
+      }
+
+      double * mapping = m_Mappings.data() + tileNumber * numberOfBins;
+      double   cumulatedFrequency = 0.0;
+      for (SizeValueType bin = 0; bin < numberOfBins; ++bin)
+      {
+        cumulatedFrequency += histogram[bin];
+        mapping[bin] = m_Minimum + (m_Maximum - m_Minimum) * std::min(1.0, cumulatedFrequency / numberOfPixels);
+      }
+    },
+    nullptr);
+}
+
+template <typename TImage>
+SizeValueType
+ContrastLimitedAdaptiveHistogramEqualizationImageFilter<TImage>::GetBin(const PixelType & value) const
+{
+  // clamp before the conversion, which is undefined for NaN or for values
+  // which do not fit in SizeValueType
+  const double bin = std::floor((static_cast<double>(value) - m_Minimum) * m_BinScale);
+  if (!(bin > 0.0))
+  {
+    return 0;
+  }
+  if (bin >= static_cast<double>(m_NumberOfHistogramBins - 1))
+  {
+    return m_NumberOfHistogramBins - 1;
+  }
+  return static_cast<SizeValueType>(bin);
+}
+
+template <typename TImage>
+void
+ContrastLimitedAdaptiveHistogramEqualizationImageFilter<TImage>::DynamicThreadedGenerateData(
+  const RegionType & outputRegionForThread)
+{
+  const ImageType * input = this->GetInput();
+  ImageType *       output = this->GetOutput();
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  // The tiles surrounding a line are interpolated along the dimensions other
+  // than the first one once per line.
+  constexpr unsigned int NumberOfLineCorners = 1u << (ImageDimension - 1);
+  SizeValueType          lineTiles[NumberOfLineCorners];
+  double                 lineWeights[NumberOfLineCorners];
+
+  const IndexType     start = input->GetLargestPossibleRegion().GetIndex();
+  const SizeValueType numberOfBins = m_NumberOfHistogramBins;
+
+  ImageScanlineConstIterator<ImageType> inputIt(input, outputRegionForThread);
+  ImageScanlineIterator<ImageType>      outputIt(output, outputRegionForThread);
+  while (!inputIt.IsAtEnd())
+  {
+    const IndexType index = inputIt.GetIndex();
+    for (unsigned int corner = 0; corner < NumberOfLineCorners; ++corner)
+    {
+      lineTiles[corner] = 0;
+      lineWeights[corner] = 1.0;
+      for (unsigned int d = 1; d < ImageDimension; ++d)
+      {
+        const TileInterpolation & interpolation = m_TileInterpolations[d][index[d] - start[d]];
+        if (corner & (1u << (d - 1)))
+        {
+          lineTiles[corner] += interpolation.m_Tile1 * m_TileStrides[d];
+          lineWeights[corner] *= interpolation.m_Weight1;
+        }
+        else
+        {
+          lineTiles[corner] += interpolation.m_Tile0 * m_TileStrides[d];
+          lineWeights[corner] *= 1.0 - interpolation.m_Weight1;
+        }
+      }
+    }
+
+    for (SizeValueType position = index[0] - start[0]; !inputIt.IsAtEndOfLine(); ++inputIt, ++outputIt, ++position)
+    {
+      const TileInterpolation & interpolation = m_TileInterpolations[0][position];
+      const SizeValueType       bin = this->GetBin(inputIt.Get());
+
+      double value = 0.0;
+      for (unsigned int corner = 0; corner < NumberOfLineCorners; ++corner)
+      {
+        const double * mappings = m_Mappings.data() + lineTiles[corner] * numberOfBins + bin;
+        const double   value0 = mappings[interpolation.m_Tile0 * numberOfBins];
+        const double   value1 = mappings[interpolation.m_Tile1 * numberOfBins];
+        value += lineWeights[corner] * (value0 + interpolation.m_Weight1 * (value1 - value0));
+      }
+      if (NumericTraits<PixelType>::is_integer)
+      {
+        value = std::round(value);
+      }
+      outputIt.Set(static_cast<PixelType>(std::max(m_Minimum, std::min(m_Maximum, value))));
+    }
+    inputIt.NextLine();
+    outputIt.NextLine();
+    progress.Completed(outputRegionForThread.GetSize(0));
+  }
+}
+
+template <typename TImage>
+void
+ContrastLimitedAdaptiveHistogramEqualizationImageFilter<TImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfTiles: " << m_NumberOfTiles << std::endl;
+  os << indent << "ClipLimit: " << m_ClipLimit << std::endl;
+  os << indent << "NumberOfHistogramBins: " << m_NumberOfHistogramBins << std::endl;
+  os << indent << "Minimum: " << m_Minimum << std::endl;
+  os << indent << "Maximum: " << m_Maximum << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -254,6 +254,22 @@ public:
     return m_ValidLabelValues;
   }
 
+  /** Set/Get the range of the labels whose statistics are accumulated in
+   * arrays indexed by the label, rather than in a hash map. The arrays only
+   * grow up to the largest label found in the image, and the labels outside
+   * of the range are still accumulated in a hash map. The arrays of all the
+   * work units, including the histograms, are also bounded to about one byte
+   * per pixel of the image, beyond which the labels of the range are
+   * accumulated in the hash map as well. Defaults to all the
+   * values of the integer label types of 8 or 16 bits, and to [0, 65535]
+   * for the other integer label types. A range with a minimum greater than
+   * its maximum, like for the non integer label types, disables the arrays.
+   */
+  itkSetMacro(DenseLabelMinimum, LabelPixelType);
+  itkGetConstMacro(DenseLabelMinimum, LabelPixelType);
+  itkSetMacro(DenseLabelMaximum, LabelPixelType);
+  itkGetConstMacro(DenseLabelMaximum, LabelPixelType);
+
   /** Set the label image */
   itkSetInputMacro(LabelInput, TLabelImage);
   itkGetInputMacro(LabelInput, TLabelImage);
@@ -357,11 +373,7 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
   void
-  BeforeStreamedGenerateData() override
-  {
-    this->AllocateOutputs();
-    m_LabelStatistics.clear();
-  }
+  BeforeStreamedGenerateData() override;
 
   /** Do final mean and variance computation from data accumulated in threads.
    */
@@ -372,12 +384,55 @@ protected:
   ThreadedStreamedGenerateData(const RegionType &) override;
 
 private:
+  using AbsoluteFrequencyType = typename HistogramType::AbsoluteFrequencyType;
+
+  /** Statistics of the labels in the dense range, stored in an array per
+   * statistic and indexed by the label minus the minimum of the range, so
+   * that the pixels are accumulated without hashing their label. */
+  struct DenseStatisticsType
+  {
+    std::vector<IdentifierType>        m_Count;
+    std::vector<RealType>              m_Minimum;
+    std::vector<RealType>              m_Maximum;
+    std::vector<RealType>              m_Sum;
+    std::vector<RealType>              m_SumOfSquares;
+    std::vector<IndexValueType>        m_BoundingBox;
+    std::vector<AbsoluteFrequencyType> m_Frequencies;
+  };
+
   void
   MergeMap(MapType &, MapType &) const;
 
+  /** Return whether the label is in the dense range, and its index in the
+   * dense arrays. */
+  bool
+  GetDenseIndex(const LabelPixelType & label, SizeValueType & denseIndex) const
+  {
+    if (!m_UseDenseStatistics || label < m_DenseLabelMinimum || m_DenseLabelMaximum < label)
+    {
+      return false;
+    }
+    denseIndex = static_cast<SizeValueType>(label) - static_cast<SizeValueType>(m_DenseLabelMinimum);
+    return denseIndex < m_NumberOfDenseLabels;
+  }
+
+  /** Grow the dense arrays to hold at least the given number of labels. */
+  void
+  ResizeDenseStatistics(DenseStatisticsType & statistics, SizeValueType numberOfLabels) const;
+
+  void
+  MergeDenseStatistics(DenseStatisticsType & statistics, const DenseStatisticsType & other) const;
+
   MapType                       m_LabelStatistics;
   ValidLabelValuesContainerType m_ValidLabelValues;
 
+  LabelPixelType      m_DenseLabelMinimum;
+  LabelPixelType      m_DenseLabelMaximum;
+  bool                m_UseDenseStatistics{ false };
+  SizeValueType       m_NumberOfDenseLabels{ 0 };
+  DenseStatisticsType m_DenseStatistics;
+  HistogramPointer    m_HistogramTemplate;
+
   bool m_UseHistograms;
 
   typename HistogramType::SizeType m_NumBins;
@@ -18,7 +18,6 @@
 #ifndef itkLabelStatisticsImageFilter_hxx
 #define itkLabelStatisticsImageFilter_hxx
 
-#include "itkImageLinearConstIteratorWithIndex.h"
 #include "itkImageScanlineConstIterator.h"
 #include "itkTotalProgressReporter.h"
 
@@ -35,6 +34,123 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::LabelStatisticsImageFilter
   m_LowerBound = static_cast<RealType>(NumericTraits<PixelType>::NonpositiveMin());
   m_UpperBound = static_cast<RealType>(NumericTraits<PixelType>::max());
   m_ValidLabelValues.clear();
+
+  if (!NumericTraits<LabelPixelType>::IsInteger)
+  {
+    m_DenseLabelMinimum = NumericTraits<LabelPixelType>::OneValue();
+    m_DenseLabelMaximum = NumericTraits<LabelPixelType>::ZeroValue();
+  }
+  else if (sizeof(LabelPixelType) <= 2)
+  {
+    m_DenseLabelMinimum = NumericTraits<LabelPixelType>::NonpositiveMin();
+    m_DenseLabelMaximum = NumericTraits<LabelPixelType>::max();
+  }
+  else
+  {
+    m_DenseLabelMinimum = NumericTraits<LabelPixelType>::ZeroValue();
+    m_DenseLabelMaximum = static_cast<LabelPixelType>(65535);
+  }
+}
+
+template <typename TInputImage, typename TLabelImage>
+void
+LabelStatisticsImageFilter<TInputImage, TLabelImage>::BeforeStreamedGenerateData()
+{
+  this->AllocateOutputs();
+  m_LabelStatistics.clear();
+
+  m_UseDenseStatistics = NumericTraits<LabelPixelType>::IsInteger && !(m_DenseLabelMaximum < m_DenseLabelMinimum);
+  m_NumberOfDenseLabels = 0;
+  if (m_UseDenseStatistics)
+  {
+    m_NumberOfDenseLabels =
+      static_cast<SizeValueType>(m_DenseLabelMaximum) - static_cast<SizeValueType>(m_DenseLabelMinimum) + 1;
+    if (m_NumberOfDenseLabels == 0)
+    {
+      // the range covers all the values of a 64 bits type
+      m_NumberOfDenseLabels = NumericTraits<SizeValueType>::max();
+    }
+
+    // Every work unit may fill its own dense arrays, so their size is bounded
+    // by a budget shared by all the work units: about one byte per pixel of
+    // the image, and at least 512 KiB per work unit for the small images. The
+    // larger labels are accumulated in the hash maps.
+    const SizeValueType bytesPerWorkUnit =
+      std::max<SizeValueType>(SizeValueType{ 1 } << 19,
+                              this->GetInput()->GetLargestPossibleRegion().GetNumberOfPixels() /
+                                std::max(1u, this->GetNumberOfWorkUnits()));
+    const SizeValueType bytesPerLabel = sizeof(IdentifierType) + 4 * sizeof(RealType) +
+                                        2 * ImageDimension * sizeof(IndexValueType) +
+                                        (m_UseHistograms ? m_NumBins[0] * sizeof(AbsoluteFrequencyType) : 0);
+    m_NumberOfDenseLabels = std::min(m_NumberOfDenseLabels, bytesPerWorkUnit / bytesPerLabel);
+    m_UseDenseStatistics = m_NumberOfDenseLabels > 0;
+  }
+  m_DenseStatistics = DenseStatisticsType();
+
+  // the bins of the pixels with a label in the dense range are found with a
+  // shared histogram
+  m_HistogramTemplate = nullptr;
+  if (m_UseHistograms)
+  {
+    m_HistogramTemplate = LabelStatistics(m_NumBins[0], m_LowerBound, m_UpperBound).m_Histogram;
+  }
+}
+
+template <typename TInputImage, typename TLabelImage>
+void
+LabelStatisticsImageFilter<TInputImage, TLabelImage>::ResizeDenseStatistics(DenseStatisticsType & statistics,
+                                                                            SizeValueType numberOfLabels) const
+{
+  const SizeValueType oldSize = statistics.m_Count.size();
+  if (numberOfLabels <= oldSize)
+  {
+    return;
+  }
+  // grow geometrically, within the dense range
+  const SizeValueType newSize = std::max(numberOfLabels, std::min(2 * oldSize, m_NumberOfDenseLabels));
+
+  statistics.m_Count.resize(newSize, NumericTraits<IdentifierType>::ZeroValue());
+  statistics.m_Minimum.resize(newSize, NumericTraits<RealType>::max());
+  statistics.m_Maximum.resize(newSize, NumericTraits<RealType>::NonpositiveMin());
+  statistics.m_Sum.resize(newSize, NumericTraits<RealType>::ZeroValue());
+  statistics.m_SumOfSquares.resize(newSize, NumericTraits<RealType>::ZeroValue());
+  statistics.m_BoundingBox.resize(2 * ImageDimension * newSize);
+  for (SizeValueType i = 2 * ImageDimension * oldSize; i < statistics.m_BoundingBox.size(); i += 2)
+  {
+    statistics.m_BoundingBox[i] = NumericTraits<IndexValueType>::max();
+    statistics.m_BoundingBox[i + 1] = NumericTraits<IndexValueType>::NonpositiveMin();
+  }
+  if (m_UseHistograms)
+  {
+    statistics.m_Frequencies.resize(m_NumBins[0] * newSize, NumericTraits<AbsoluteFrequencyType>::ZeroValue());
+  }
+}
+
+template <typename TInputImage, typename TLabelImage>
+void
+LabelStatisticsImageFilter<TInputImage, TLabelImage>::MergeDenseStatistics(DenseStatisticsType &       statistics,
+                                                                           const DenseStatisticsType & other) const
+{
+  this->ResizeDenseStatistics(statistics, other.m_Count.size());
+
+  const SizeValueType numberOfLabels = other.m_Count.size();
+  for (SizeValueType i = 0; i < numberOfLabels; ++i)
+  {
+    statistics.m_Count[i] += other.m_Count[i];
+    statistics.m_Minimum[i] = std::min(statistics.m_Minimum[i], other.m_Minimum[i]);
+    statistics.m_Maximum[i] = std::max(statistics.m_Maximum[i], other.m_Maximum[i]);
+    statistics.m_Sum[i] += other.m_Sum[i];
+    statistics.m_SumOfSquares[i] += other.m_SumOfSquares[i];
+  }
+  for (SizeValueType i = 0; i < 2 * ImageDimension * numberOfLabels; i += 2)
+  {
+    statistics.m_BoundingBox[i] = std::min(statistics.m_BoundingBox[i], other.m_BoundingBox[i]);
+    statistics.m_BoundingBox[i + 1] = std::max(statistics.m_BoundingBox[i + 1], other.m_BoundingBox[i + 1]);
+  }
+  for (SizeValueType i = 0; i < other.m_Frequencies.size(); ++i)
+  {
+    statistics.m_Frequencies[i] += other.m_Frequencies[i];
+  }
 }
 
 template <typename TInputImage, typename TLabelImage>
@@ -118,6 +234,35 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::AfterStreamedGenerateData(
 {
   Superclass::AfterStreamedGenerateData();
 
+  // move the labels of the dense arrays to the map
+  const DenseStatisticsType & dense = m_DenseStatistics;
+  for (SizeValueType i = 0; i < dense.m_Count.size(); ++i)
+  {
+    if (dense.m_Count[i] == 0)
+    {
+      continue;
+    }
+    LabelStatistics labelStats =
+      m_UseHistograms ? LabelStatistics(m_NumBins[0], m_LowerBound, m_UpperBound) : LabelStatistics();
+    labelStats.m_Count = dense.m_Count[i];
+    labelStats.m_Minimum = dense.m_Minimum[i];
+    labelStats.m_Maximum = dense.m_Maximum[i];
+    labelStats.m_Sum = dense.m_Sum[i];
+    labelStats.m_SumOfSquares = dense.m_SumOfSquares[i];
+    std::copy_n(
+      dense.m_BoundingBox.begin() + 2 * ImageDimension * i, 2 * ImageDimension, labelStats.m_BoundingBox.begin());
+    if (m_UseHistograms)
+    {
+      for (unsigned int bin = 0; bin < m_NumBins[0]; ++bin)
+      {
+        labelStats.m_Histogram->IncreaseFrequency(bin, dense.m_Frequencies[m_NumBins[0] * i + bin]);
+      }
+    }
+    const auto label = static_cast<LabelPixelType>(static_cast<SizeValueType>(m_DenseLabelMinimum) + i);
+    m_LabelStatistics.emplace(label, std::move(labelStats));
+  }
+  m_DenseStatistics = DenseStatisticsType();
+
   // compute the remainder of the statistics
   for (auto & mapValue : m_LabelStatistics)
   {
@@ -165,7 +310,8 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::ThreadedStreamedGenerateDa
   const RegionType & outputRegionForThread)
 {
 
-  MapType localStatistics;
+  MapType             localStatistics;
+  DenseStatisticsType localDenseStatistics;
 
   typename HistogramType::IndexType             histogramIndex(1);
   typename HistogramType::MeasurementVectorType histogramMeasurement(1);
@@ -176,82 +322,150 @@ LabelStatisticsImageFilter<TInputImage, TLabelImage>::ThreadedStreamedGenerateDa
     return;
   }
 
-  ImageLinearConstIteratorWithIndex<TInputImage> it(this->GetInput(), outputRegionForThread);
+  ImageScanlineConstIterator<TInputImage> it(this->GetInput(), outputRegionForThread);
 
   ImageScanlineConstIterator<TLabelImage> labelIt(this->GetLabelInput(), outputRegionForThread);
 
-  auto mapIt = localStatistics.end();
-
   // do the work
   while (!it.IsAtEnd())
   {
+    IndexType index = it.GetIndex();
     while (!it.IsAtEndOfLine())
     {
-      const RealType & value = static_cast<RealType>(it.Get());
-
-      const LabelPixelType & label = labelIt.Get();
-
-      // is the label already in this thread?
-      mapIt = localStatistics.find(label);
-      if (mapIt == localStatistics.end())
+      // the pixels of a run with the same label are accumulated in local
+      // variables, and then in the dense arrays or in the map
+      const LabelPixelType label = labelIt.Get();
+
+      SizeValueType           denseIndex = 0;
+      const bool              isDense = this->GetDenseIndex(label, denseIndex);
+      AbsoluteFrequencyType * frequencies = nullptr;
+      LabelStatistics *       labelStatsPointer = nullptr;
+      if (isDense)
       {
-        // create a new statistics object
+        this->ResizeDenseStatistics(localDenseStatistics, denseIndex + 1);
         if (m_UseHistograms)
         {
-          mapIt = localStatistics.emplace(label, LabelStatistics(m_NumBins[0], m_LowerBound, m_UpperBound)).first;
+          frequencies = &localDenseStatistics.m_Frequencies[m_NumBins[0] * denseIndex];
         }
-        else
+      }
+      else
+      {
+        // is the label already in this thread?
+        auto mapIt = localStatistics.find(label);
+        if (mapIt == localStatistics.end())
         {
-          mapIt = localStatistics.emplace(label, LabelStatistics()).first;
+          // create a new statistics object
+          if (m_UseHistograms)
+          {
+            mapIt = localStatistics.emplace(label, LabelStatistics(m_NumBins[0], m_LowerBound, m_UpperBound)).first;
+          }
+          else
+          {
+            mapIt = localStatistics.emplace(label, LabelStatistics()).first;
+          }
         }
+        labelStatsPointer = &mapIt->second;
       }
 
-      typename MapType::mapped_type & labelStats = mapIt->second;
+      IdentifierType count = 0;
+      RealType       minimum = NumericTraits<RealType>::max();
+      RealType       maximum = NumericTraits<RealType>::NonpositiveMin();
+      RealType       sum = NumericTraits<RealType>::ZeroValue();
+      RealType       sumOfSquares = NumericTraits<RealType>::ZeroValue();
+      do
+      {
+        const auto value = static_cast<RealType>(it.Get());
+        if (value < minimum)
+        {
+          minimum = value;
+        }
+        if (value > maximum)
+        {
+          maximum = value;
+        }
+        sum += value;
+        sumOfSquares += value * value;
+        ++count;
+
+        // if enabled, update the histogram for this label
+        if (m_UseHistograms)
+        {
+          histogramMeasurement[0] = value;
+          if (isDense)
+          {
+            if (m_HistogramTemplate->GetIndex(histogramMeasurement, histogramIndex))
+            {
+              ++frequencies[histogramIndex[0]];
+            }
+          }
+          else
+          {
+            labelStatsPointer->m_Histogram->GetIndex(histogramMeasurement, histogramIndex);
+            labelStatsPointer->m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
+          }
+        }
+
+        ++labelIt;
+        ++it;
+      } while (!it.IsAtEndOfLine() && labelIt.Get() == label);
 
       // update the values for this label and this thread
-      if (value < labelStats.m_Minimum)
+      IdentifierType * countPointer = nullptr;
+      RealType *       minimumPointer = nullptr;
+      RealType *       maximumPointer = nullptr;
+      RealType *       sumPointer = nullptr;
+      RealType *       sumOfSquaresPointer = nullptr;
+      IndexValueType * boundingBox = nullptr;
+      if (isDense)
       {
-        labelStats.m_Minimum = value;
+        countPointer = &localDenseStatistics.m_Count[denseIndex];
+        minimumPointer = &localDenseStatistics.m_Minimum[denseIndex];
+        maximumPointer = &localDenseStatistics.m_Maximum[denseIndex];
+        sumPointer = &localDenseStatistics.m_Sum[denseIndex];
+        sumOfSquaresPointer = &localDenseStatistics.m_SumOfSquares[denseIndex];
+        boundingBox = &localDenseStatistics.m_BoundingBox[2 * ImageDimension * denseIndex];
       }
-      if (value > labelStats.m_Maximum)
+      else
       {
-        labelStats.m_Maximum = value;
+        countPointer = &labelStatsPointer->m_Count;
+        minimumPointer = &labelStatsPointer->m_Minimum;
+        maximumPointer = &labelStatsPointer->m_Maximum;
+        sumPointer = &labelStatsPointer->m_Sum;
+        sumOfSquaresPointer = &labelStatsPointer->m_SumOfSquares;
+        boundingBox = labelStatsPointer->m_BoundingBox.data();
       }
-
-      // bounding box is min,max pairs
-      for (unsigned int i = 0; i < (2 * TInputImage::ImageDimension); i += 2)
+      *countPointer += count;
+      *sumPointer += sum;
+      *sumOfSquaresPointer += sumOfSquares;
+      if (minimum < *minimumPointer)
       {
-        const IndexType & index = it.GetIndex();
-        if (labelStats.m_BoundingBox[i] > index[i / 2])
-        {
-          labelStats.m_BoundingBox[i] = index[i / 2];
-        }
-        if (labelStats.m_BoundingBox[i + 1] < index[i / 2])
-        {
-          labelStats.m_BoundingBox[i + 1] = index[i / 2];
-        }
+        *minimumPointer = minimum;
       }
-
-      labelStats.m_Sum += value;
-      labelStats.m_SumOfSquares += (value * value);
-      labelStats.m_Count++;
-
-      // if enabled, update the histogram for this label
-      if (m_UseHistograms)
+      if (maximum > *maximumPointer)
       {
-        histogramMeasurement[0] = value;
-        labelStats.m_Histogram->GetIndex(histogramMeasurement, histogramIndex);
-        labelStats.m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
+        *maximumPointer = maximum;
       }
 
-
-      ++labelIt;
-      ++it;
+      // bounding box is min,max pairs, the run spans count pixels along the
+      // first axis
+      boundingBox[0] = std::min(boundingBox[0], index[0]);
+      boundingBox[1] = std::max(boundingBox[1], index[0] + static_cast<IndexValueType>(count) - 1);
+      for (unsigned int i = 1; i < ImageDimension; ++i)
+      {
+        boundingBox[2 * i] = std::min(boundingBox[2 * i], index[i]);
+        boundingBox[2 * i + 1] = std::max(boundingBox[2 * i + 1], index[i]);
+      }
+      index[0] += static_cast<IndexValueType>(count);
     }
     labelIt.NextLine();
     it.NextLine();
   }
 
+  if (!localDenseStatistics.m_Count.empty())
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    this->MergeDenseStatistics(m_DenseStatistics, localDenseStatistics);
+  }
 
   // Merge localStatistics and m_LabelStatistics concurrently safe in a
   // local copy, this thread may do multiple merges.
@@ -528,6 +742,10 @@ LabelStatisticsImageFilter<TImage, TLabelImage>::PrintSelf(std::ostream & os, In
   os << indent << "Use Histograms: " << m_UseHistograms << std::endl;
   os << indent << "Histogram Lower Bound: " << m_LowerBound << std::endl;
   os << indent << "Histogram Upper Bound: " << m_UpperBound << std::endl;
+  os << indent << "DenseLabelMinimum: "
+     << static_cast<typename NumericTraits<LabelPixelType>::PrintType>(m_DenseLabelMinimum) << std::endl;
+  os << indent << "DenseLabelMaximum: "
+     << static_cast<typename NumericTraits<LabelPixelType>::PrintType>(m_DenseLabelMaximum) << std::endl;
 }
 } // end namespace itk
 #endif
@@ -21,6 +21,7 @@
 #include "itkImageSink.h"
 #include "itkSimpleDataObjectDecorator.h"
 #include <mutex>
+#include <type_traits>
 
 #include <vector>
 
@@ -38,6 +39,9 @@ namespace itk
  * input when NumberOfStreamDivisions is set to more than
  * 1. The extrema are independently computed for each streamed and
  * threaded region then merged.
+ * The scanlines of an Image of scalars are read directly from its buffer
+ * and reduced in several independent lanes, so that the compiler can
+ * vectorize the loop.
  *
  *
  * \ingroup Operators
@@ -140,6 +144,20 @@ protected:
   itkSetDecoratedOutputMacro(Maximum, PixelType);
 
 private:
+  /** Whether the pixels can be read as scalars from the buffer of the image. */
+  using IsBufferedScalarImageType =
+    std::integral_constant<bool,
+                           std::is_arithmetic<PixelType>::value &&
+                             std::is_same<TInputImage, Image<PixelType, InputImageDimension>>::value>;
+
+  /** Compute the extrema of the region from the buffer of the image, by scanlines. */
+  void
+  ThreadedStreamedGenerateData(const RegionType & regionForThread, std::true_type isBufferedScalarImage);
+
+  /** Compute the extrema of the region with an iterator. */
+  void
+  ThreadedStreamedGenerateData(const RegionType & regionForThread, std::false_type isBufferedScalarImage);
+
   PixelType m_ThreadMin;
   PixelType m_ThreadMax;
 
@@ -20,6 +20,8 @@
 
 
 #include "itkImageScanlineIterator.h"
+#include "itkIndexRange.h"
+#include <algorithm>
 #include <mutex>
 
 #include <vector>
@@ -67,6 +69,65 @@ MinimumMaximumImageFilter<TInputImage>::AfterStreamedGenerateData()
 template <typename TInputImage>
 void
 MinimumMaximumImageFilter<TInputImage>::ThreadedStreamedGenerateData(const RegionType & regionForThread)
+{
+  this->ThreadedStreamedGenerateData(regionForThread, IsBufferedScalarImageType());
+}
+
+template <typename TInputImage>
+void
+MinimumMaximumImageFilter<TInputImage>::ThreadedStreamedGenerateData(const RegionType & regionForThread,
+                                                                     std::true_type)
+{
+  if (regionForThread.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // independent lanes, so that the loop over the lanes can be vectorized
+  constexpr unsigned int NumberOfLanes = 16;
+
+  PixelType laneMin[NumberOfLanes];
+  PixelType laneMax[NumberOfLanes];
+  std::fill_n(laneMin, NumberOfLanes, NumericTraits<PixelType>::max());
+  std::fill_n(laneMax, NumberOfLanes, NumericTraits<PixelType>::NonpositiveMin());
+
+  const TInputImage * input = this->GetInput();
+  const PixelType *   buffer = input->GetBufferPointer();
+  const SizeValueType length = regionForThread.GetSize(0);
+
+  RegionType lines = regionForThread;
+  lines.SetSize(0, 1);
+  for (const IndexType & index : ImageRegionIndexRange<InputImageDimension>(lines))
+  {
+    const PixelType * line = buffer + input->ComputeOffset(index);
+    SizeValueType     i = 0;
+    for (; i + NumberOfLanes <= length; i += NumberOfLanes)
+    {
+      for (unsigned int lane = 0; lane < NumberOfLanes; ++lane)
+      {
+        laneMin[lane] = std::min(line[i + lane], laneMin[lane]);
+        laneMax[lane] = std::max(line[i + lane], laneMax[lane]);
+      }
+    }
+    for (; i < length; ++i)
+    {
+      laneMin[0] = std::min(line[i], laneMin[0]);
+      laneMax[0] = std::max(line[i], laneMax[0]);
+    }
+  }
+
+  std::lock_guard<std::mutex> mutexHolder(m_Mutex);
+  for (unsigned int lane = 0; lane < NumberOfLanes; ++lane)
+  {
+    m_ThreadMin = std::min(laneMin[lane], m_ThreadMin);
+    m_ThreadMax = std::max(laneMax[lane], m_ThreadMax);
+  }
+}
+
+template <typename TInputImage>
+void
+MinimumMaximumImageFilter<TInputImage>::ThreadedStreamedGenerateData(const RegionType & regionForThread,
+                                                                     std::false_type)
 {
   if (regionForThread.GetNumberOfPixels() == 0)
   {
@@ -19,6 +19,7 @@
 #define itkProjectionImageFilter_h
 
 #include "itkImageToImageFilter.h"
+#include "itkTotalProgressReporter.h"
 
 namespace itk
 {
@@ -38,6 +39,12 @@ namespace itk
  * latter case, the direction cosine of the output image is set to the
  * identity.
  *
+ * When the projection dimension is not the first dimension, the
+ * accumulators of the pixels of a segment of a line along the first
+ * dimension are kept in a buffer, and the input is read by lines along the
+ * first dimension, slice after slice, rather than by strided lines along the
+ * projection dimension.
+ *
  * This class is parameterized over the type of the input image and
  * the type of the output image.
  *
@@ -122,6 +129,18 @@ protected:
   virtual AccumulatorType NewAccumulator(SizeValueType) const;
 
 private:
+  /** Accumulate along a projection dimension other than the first one, with
+   * a buffer of accumulators for the pixels of a line segment along the first
+   * dimension, so that the input is read contiguously. */
+  void
+  AccumulateSlabs(const InputImageRegionType & inputRegionForThread,
+                  SizeValueType                projectionSize,
+                  TotalProgressReporter &      progress);
+
+  /** Return the index of the output pixel of a projection line. */
+  typename TOutputImage::IndexType
+  ComputeOutputIndex(const typename TInputImage::IndexType & inputIndex) const;
+
   unsigned int m_ProjectionDimension;
 };
 } // end namespace itk
@@ -22,6 +22,10 @@
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkTotalProgressReporter.h"
 #include "itkImageLinearConstIteratorWithIndex.h"
+#include "itkImageScanlineIterator.h"
+
+#include <algorithm>
+#include <vector>
 
 namespace itk
 {
@@ -271,6 +275,14 @@ ProjectionImageFilter<TInputImage, TOutputImage, TAccumulator>::DynamicThreadedG
 
   SizeValueType projectionSize = inputSize[m_ProjectionDimension];
 
+  TotalProgressReporter progress(this, outputImage->GetRequestedRegion().GetNumberOfPixels());
+
+  if (m_ProjectionDimension != 0)
+  {
+    this->AccumulateSlabs(inputRegionForThread, projectionSize, progress);
+    return;
+  }
+
   // create the iterators for input and output image
   using InputIteratorType = ImageLinearConstIteratorWithIndex<TInputImage>;
   InputIteratorType iIt(inputImage, inputRegionForThread);
@@ -280,8 +292,6 @@ ProjectionImageFilter<TInputImage, TOutputImage, TAccumulator>::DynamicThreadedG
   // instantiate the accumulator
   AccumulatorType accumulator = this->NewAccumulator(projectionSize);
 
-  TotalProgressReporter progress(this, outputImage->GetRequestedRegion().GetNumberOfPixels());
-
   // ok, everything is ready... lets the linear iterator do its job !
   while (!iIt.IsAtEnd())
   {
@@ -294,44 +304,120 @@ ProjectionImageFilter<TInputImage, TOutputImage, TAccumulator>::DynamicThreadedG
       ++iIt;
     }
 
-    // move the output iterator and set the output value
-    typename TOutputImage::IndexType oIdx;
-    typename TInputImage::IndexType  iIdx = iIt.GetIndex();
+    // set the output value
+    outputImage->SetPixel(this->ComputeOutputIndex(iIt.GetIndex()),
+                          static_cast<OutputPixelType>(accumulator.GetValue()));
 
-    if (static_cast<unsigned int>(InputImageDimension) == static_cast<unsigned int>(OutputImageDimension))
+    iIt.NextLine();
+    progress.CompletedPixel();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TAccumulator>
+void
+ProjectionImageFilter<TInputImage, TOutputImage, TAccumulator>::AccumulateSlabs(
+  const InputImageRegionType & inputRegionForThread,
+  SizeValueType                projectionSize,
+  TotalProgressReporter &      progress)
+{
+  using OutputPixelType = typename TOutputImage::PixelType;
+  using InputIndexType = typename TInputImage::IndexType;
+
+  const TInputImage * inputImage = this->GetInput();
+  TOutputImage *      outputImage = this->GetOutput();
+
+  // The accumulators of a segment of a line along the first dimension are
+  // kept in a buffer, and the lines of the input at the same position in
+  // the successive slices along the projection dimension are read one after
+  // the other. The accumulators receive the pixels in the same order as
+  // with a linear iterator along the projection dimension.
+  constexpr SizeValueType      maximumSegmentLength = 512;
+  const SizeValueType          lineLength = inputRegionForThread.GetSize(0);
+  const SizeValueType          segmentLength = std::min(lineLength, maximumSegmentLength);
+  std::vector<AccumulatorType> accumulators(segmentLength, this->NewAccumulator(projectionSize));
+
+  // the first index of the lines to accumulate
+  InputImageRegionType linesRegion = inputRegionForThread;
+  linesRegion.SetSize(0, 1);
+  linesRegion.SetSize(m_ProjectionDimension, 1);
+
+  InputImageRegionType segmentRegion;
+  segmentRegion.SetSize(TInputImage::SizeType::Filled(1));
+
+  for (ImageRegionConstIteratorWithIndex<TInputImage> lineIt(inputImage, linesRegion); !lineIt.IsAtEnd(); ++lineIt)
+  {
+    for (SizeValueType segmentStart = 0; segmentStart < lineLength; segmentStart += segmentLength)
     {
-      for (unsigned int i = 0; i < InputImageDimension; ++i)
+      const SizeValueType length = std::min(segmentLength, lineLength - segmentStart);
+      for (SizeValueType x = 0; x < length; ++x)
       {
-        if (i != m_ProjectionDimension)
-        {
-          oIdx[i] = iIdx[i];
-        }
-        else
-        {
-          oIdx[i] = 0;
-        }
+        accumulators[x].Initialize();
       }
-    }
-    else
-    {
-      for (unsigned int i = 0; i < OutputImageDimension; ++i)
+
+      InputIndexType segmentIndex = lineIt.GetIndex();
+      segmentIndex[0] += static_cast<IndexValueType>(segmentStart);
+      segmentRegion.SetSize(0, length);
+      for (SizeValueType slice = 0; slice < projectionSize; ++slice)
       {
-        if (i != m_ProjectionDimension)
+        segmentRegion.SetIndex(segmentIndex);
+        ImageScanlineConstIterator<TInputImage> it(inputImage, segmentRegion);
+        for (auto accumulatorIt = accumulators.begin(); !it.IsAtEndOfLine(); ++it, ++accumulatorIt)
         {
-          oIdx[i] = iIdx[i];
-        }
-        else
-        {
-          oIdx[i] = iIdx[InputImageDimension - 1];
+          (*accumulatorIt)(it.Get());
         }
+        ++segmentIndex[m_ProjectionDimension];
       }
+
+      // the projection dimension is not the first one, so the output pixels
+      // of the segment are contiguous along the first dimension
+      segmentIndex = lineIt.GetIndex();
+      segmentIndex[0] += static_cast<IndexValueType>(segmentStart);
+      typename TOutputImage::IndexType outputIndex = this->ComputeOutputIndex(segmentIndex);
+      for (SizeValueType x = 0; x < length; ++x, ++outputIndex[0])
+      {
+        outputImage->SetPixel(outputIndex, static_cast<OutputPixelType>(accumulators[x].GetValue()));
+      }
+      progress.Completed(length);
     }
+  }
+}
 
-    outputImage->SetPixel(oIdx, static_cast<OutputPixelType>(accumulator.GetValue()));
+template <typename TInputImage, typename TOutputImage, typename TAccumulator>
+auto
+ProjectionImageFilter<TInputImage, TOutputImage, TAccumulator>::ComputeOutputIndex(
+  const typename TInputImage::IndexType & inputIndex) const -> typename TOutputImage::IndexType
+{
+  typename TOutputImage::IndexType outputIndex;
 
-    iIt.NextLine();
-    progress.CompletedPixel();
+  if (static_cast<unsigned int>(InputImageDimension) == static_cast<unsigned int>(OutputImageDimension))
+  {
+    for (unsigned int i = 0; i < InputImageDimension; ++i)
+    {
+      if (i != m_ProjectionDimension)
+      {
+        outputIndex[i] = inputIndex[i];
+      }
+      else
+      {
+        outputIndex[i] = 0;
+      }
+    }
+  }
+  else
+  {
+    for (unsigned int i = 0; i < OutputImageDimension; ++i)
+    {
+      if (i != m_ProjectionDimension)
+      {
+        outputIndex[i] = inputIndex[i];
+      }
+      else
+      {
+        outputIndex[i] = inputIndex[InputImageDimension - 1];
+      }
+    }
   }
+  return outputIndex;
 }
 
 template <typename TInputImage, typename TOutputImage, typename TAccumulator>
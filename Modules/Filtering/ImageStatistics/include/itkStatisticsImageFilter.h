@@ -23,6 +23,7 @@
 #include "itkArray.h"
 #include "itkSimpleDataObjectDecorator.h"
 #include <mutex>
+#include <type_traits>
 #include "itkCompensatedSummation.h"
 
 namespace itk
@@ -43,6 +44,10 @@ namespace itk
  *
  * Internally a compensated summation algorithm is used for the
  * accumulation of intensities to improve accuracy for large images.
+ * The scanlines of an Image of scalars are read directly from its buffer
+ * and reduced in several independent lanes, so that the compiler can
+ * vectorize the loop; the 8 and 16 bits integer pixels are summed exactly
+ * in 64 bits integers along a scanline.
  *
  * \ingroup MathematicalStatisticsImageFilters
  * \ingroup ITKImageStatistics
@@ -164,6 +169,51 @@ protected:
   itkSetDecoratedOutputMacro(SumOfSquares, RealType);
 
 private:
+  /** Whether the pixels can be read as scalars from the buffer of the image. */
+  using IsBufferedScalarImageType =
+    std::integral_constant<bool,
+                           std::is_arithmetic<PixelType>::value &&
+                             std::is_same<TInputImage, Image<PixelType, ImageDimension>>::value>;
+
+  /** Whether the sums of a scanline can be computed exactly with integers. */
+  using IsSmallIntegerType = std::integral_constant<bool, std::is_integral<PixelType>::value && sizeof(PixelType) <= 2>;
+
+  /** Accumulate the region from the buffer of the image, by scanlines. */
+  void
+  ThreadedStreamedGenerateData(const RegionType & regionForThread, std::true_type isBufferedScalarImage);
+
+  /** Accumulate the region with an iterator. */
+  void
+  ThreadedStreamedGenerateData(const RegionType & regionForThread, std::false_type isBufferedScalarImage);
+
+  /** Accumulate a scanline in several lanes, with a compensated summation in
+   * each lane. */
+  static void
+  AccumulateScanline(const PixelType *                line,
+                     SizeValueType                    length,
+                     PixelType &                      minimum,
+                     PixelType &                      maximum,
+                     CompensatedSummation<RealType> & sum,
+                     CompensatedSummation<RealType> & sumOfSquares,
+                     std::false_type                  isSmallInteger);
+
+  /** Accumulate a scanline in several lanes, with exact integer sums. */
+  static void
+  AccumulateScanline(const PixelType *                line,
+                     SizeValueType                    length,
+                     PixelType &                      minimum,
+                     PixelType &                      maximum,
+                     CompensatedSummation<RealType> & sum,
+                     CompensatedSummation<RealType> & sumOfSquares,
+                     std::true_type                   isSmallInteger);
+
+  void
+  MergeThreadResults(const CompensatedSummation<RealType> & sum,
+                     const CompensatedSummation<RealType> & sumOfSquares,
+                     SizeValueType                          count,
+                     const PixelType &                      minimum,
+                     const PixelType &                      maximum);
+
   CompensatedSummation<RealType> m_ThreadSum{ 1 };
   CompensatedSummation<RealType> m_SumOfSquares{ 1 };
 
@@ -20,6 +20,9 @@
 
 
 #include "itkImageScanlineIterator.h"
+#include "itkIndexRange.h"
+#include <algorithm>
+#include <cstdint>
 #include <mutex>
 
 namespace itk
@@ -98,7 +101,42 @@ template <typename TInputImage>
 void
 StatisticsImageFilter<TInputImage>::ThreadedStreamedGenerateData(const RegionType & regionForThread)
 {
+  this->ThreadedStreamedGenerateData(regionForThread, IsBufferedScalarImageType());
+}
+
+template <typename TInputImage>
+void
+StatisticsImageFilter<TInputImage>::ThreadedStreamedGenerateData(const RegionType & regionForThread, std::true_type)
+{
+  const SizeValueType length = regionForThread.GetSize(0);
+  if (regionForThread.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
 
+  CompensatedSummation<RealType> sum = NumericTraits<RealType>::ZeroValue();
+  CompensatedSummation<RealType> sumOfSquares = NumericTraits<RealType>::ZeroValue();
+  PixelType                      min = NumericTraits<PixelType>::max();
+  PixelType                      max = NumericTraits<PixelType>::NonpositiveMin();
+
+  const TInputImage * input = this->GetInput();
+  const PixelType *   buffer = input->GetBufferPointer();
+
+  RegionType lines = regionForThread;
+  lines.SetSize(0, 1);
+  for (const IndexType & index : ImageRegionIndexRange<ImageDimension>(lines))
+  {
+    AccumulateScanline(
+      buffer + input->ComputeOffset(index), length, min, max, sum, sumOfSquares, IsSmallIntegerType());
+  }
+
+  this->MergeThreadResults(sum, sumOfSquares, regionForThread.GetNumberOfPixels(), min, max);
+}
+
+template <typename TInputImage>
+void
+StatisticsImageFilter<TInputImage>::ThreadedStreamedGenerateData(const RegionType & regionForThread, std::false_type)
+{
   CompensatedSummation<RealType> sum = NumericTraits<RealType>::ZeroValue();
   CompensatedSummation<RealType> sumOfSquares = NumericTraits<RealType>::ZeroValue();
   SizeValueType                  count = NumericTraits<SizeValueType>::ZeroValue();
@@ -125,12 +163,142 @@ StatisticsImageFilter<TInputImage>::ThreadedStreamedGenerateData(const RegionTyp
     it.NextLine();
   }
 
+  this->MergeThreadResults(sum, sumOfSquares, count, min, max);
+}
+
+template <typename TInputImage>
+void
+StatisticsImageFilter<TInputImage>::AccumulateScanline(const PixelType *                line,
+                                                       SizeValueType                    length,
+                                                       PixelType &                      minimum,
+                                                       PixelType &                      maximum,
+                                                       CompensatedSummation<RealType> & sum,
+                                                       CompensatedSummation<RealType> & sumOfSquares,
+                                                       std::false_type)
+{
+  // independent lanes, so that the loop over the lanes can be vectorized
+  constexpr unsigned int NumberOfLanes = 8;
+
+  PixelType laneMinimum[NumberOfLanes];
+  PixelType laneMaximum[NumberOfLanes];
+  RealType  laneSum[NumberOfLanes];
+  RealType  laneSumCompensation[NumberOfLanes];
+  RealType  laneSumOfSquares[NumberOfLanes];
+  RealType  laneSumOfSquaresCompensation[NumberOfLanes];
+  std::fill_n(laneMinimum, NumberOfLanes, minimum);
+  std::fill_n(laneMaximum, NumberOfLanes, maximum);
+  std::fill_n(laneSum, NumberOfLanes, NumericTraits<RealType>::ZeroValue());
+  std::fill_n(laneSumCompensation, NumberOfLanes, NumericTraits<RealType>::ZeroValue());
+  std::fill_n(laneSumOfSquares, NumberOfLanes, NumericTraits<RealType>::ZeroValue());
+  std::fill_n(laneSumOfSquaresCompensation, NumberOfLanes, NumericTraits<RealType>::ZeroValue());
+
+  SizeValueType i = 0;
+  for (; i + NumberOfLanes <= length; i += NumberOfLanes)
+  {
+    for (unsigned int lane = 0; lane < NumberOfLanes; ++lane)
+    {
+      const PixelType value = line[i + lane];
+      const auto      realValue = static_cast<RealType>(value);
+      laneMinimum[lane] = std::min(laneMinimum[lane], value);
+      laneMaximum[lane] = std::max(laneMaximum[lane], value);
+      CompensatedSummationAddElement(laneSumCompensation[lane], laneSum[lane], realValue);
+      CompensatedSummationAddElement(
+        laneSumOfSquaresCompensation[lane], laneSumOfSquares[lane], static_cast<RealType>(realValue * realValue));
+    }
+  }
+  for (; i < length; ++i)
+  {
+    const PixelType value = line[i];
+    const auto      realValue = static_cast<RealType>(value);
+    laneMinimum[0] = std::min(laneMinimum[0], value);
+    laneMaximum[0] = std::max(laneMaximum[0], value);
+    CompensatedSummationAddElement(laneSumCompensation[0], laneSum[0], realValue);
+    CompensatedSummationAddElement(
+      laneSumOfSquaresCompensation[0], laneSumOfSquares[0], static_cast<RealType>(realValue * realValue));
+  }
+
+  // the compensation of a lane is the opposite of its rounding error
+  for (unsigned int lane = 0; lane < NumberOfLanes; ++lane)
+  {
+    minimum = std::min(minimum, laneMinimum[lane]);
+    maximum = std::max(maximum, laneMaximum[lane]);
+    sum += laneSum[lane];
+    sum -= laneSumCompensation[lane];
+    sumOfSquares += laneSumOfSquares[lane];
+    sumOfSquares -= laneSumOfSquaresCompensation[lane];
+  }
+}
+
+template <typename TInputImage>
+void
+StatisticsImageFilter<TInputImage>::AccumulateScanline(const PixelType *                line,
+                                                       SizeValueType                    length,
+                                                       PixelType &                      minimum,
+                                                       PixelType &                      maximum,
+                                                       CompensatedSummation<RealType> & sum,
+                                                       CompensatedSummation<RealType> & sumOfSquares,
+                                                       std::true_type)
+{
+  // independent lanes, so that the loop over the lanes can be vectorized
+  constexpr unsigned int NumberOfLanes = 16;
+
+  PixelType    laneMinimum[NumberOfLanes];
+  PixelType    laneMaximum[NumberOfLanes];
+  std::int64_t laneSum[NumberOfLanes] = {};
+  std::int64_t laneSumOfSquares[NumberOfLanes] = {};
+  std::fill_n(laneMinimum, NumberOfLanes, minimum);
+  std::fill_n(laneMaximum, NumberOfLanes, maximum);
+
+  SizeValueType i = 0;
+  for (; i + NumberOfLanes <= length; i += NumberOfLanes)
+  {
+    for (unsigned int lane = 0; lane < NumberOfLanes; ++lane)
+    {
+      const PixelType    value = line[i + lane];
+      const std::int64_t integerValue = value;
+      laneMinimum[lane] = std::min(laneMinimum[lane], value);
+      laneMaximum[lane] = std::max(laneMaximum[lane], value);
+      laneSum[lane] += integerValue;
+      laneSumOfSquares[lane] += integerValue * integerValue;
+    }
+  }
+  for (; i < length; ++i)
+  {
+    const PixelType    value = line[i];
+    const std::int64_t integerValue = value;
+    laneMinimum[0] = std::min(laneMinimum[0], value);
+    laneMaximum[0] = std::max(laneMaximum[0], value);
+    laneSum[0] += integerValue;
+    laneSumOfSquares[0] += integerValue * integerValue;
+  }
+
+  std::int64_t lineSum = 0;
+  std::int64_t lineSumOfSquares = 0;
+  for (unsigned int lane = 0; lane < NumberOfLanes; ++lane)
+  {
+    minimum = std::min(minimum, laneMinimum[lane]);
+    maximum = std::max(maximum, laneMaximum[lane]);
+    lineSum += laneSum[lane];
+    lineSumOfSquares += laneSumOfSquares[lane];
+  }
+  sum += static_cast<RealType>(lineSum);
+  sumOfSquares += static_cast<RealType>(lineSumOfSquares);
+}
+
+template <typename TInputImage>
+void
+StatisticsImageFilter<TInputImage>::MergeThreadResults(const CompensatedSummation<RealType> & sum,
+                                                       const CompensatedSummation<RealType> & sumOfSquares,
+                                                       SizeValueType                          count,
+                                                       const PixelType &                      minimum,
+                                                       const PixelType &                      maximum)
+{
   std::lock_guard<std::mutex> mutexHolder(m_Mutex);
   m_ThreadSum += sum;
   m_SumOfSquares += sumOfSquares;
   m_Count += count;
-  m_ThreadMin = std::min(min, m_ThreadMin);
-  m_ThreadMax = std::max(max, m_ThreadMax);
+  m_ThreadMin = std::min(minimum, m_ThreadMin);
+  m_ThreadMax = std::max(maximum, m_ThreadMax);
 }
 
 template <typename TImage>
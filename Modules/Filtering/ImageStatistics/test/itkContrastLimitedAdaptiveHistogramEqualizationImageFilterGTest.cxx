@@ -0,0 +1,277 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkAdaptiveHistogramEqualizationImageFilter.h"
+#include "itkContrastLimitedAdaptiveHistogramEqualizationImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+#include <limits>
+#include <vector>
+
+
+namespace
+{
+
+// A smooth gradient with random noise, whose values range from
+// minimum to maximum.
+template <typename TImage>
+typename TImage::Pointer
+CreateImage(const typename TImage::SizeType & size, double minimum, double maximum)
+{
+  typename TImage::RegionType region;
+  region.SetSize(size);
+  region.SetIndex(0, 5);
+  auto image = TImage::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(97531);
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const double gradient = static_cast<double>(it.GetIndex()[0] - region.GetIndex(0)) / size[0];
+    const double noise = generator->GetVariateWithClosedRange();
+    const double value = minimum + (maximum - minimum) * (0.5 * gradient + 0.5 * noise);
+    it.Set(static_cast<typename TImage::PixelType>(value));
+  }
+  image->SetPixel(region.GetIndex(), static_cast<typename TImage::PixelType>(minimum));
+  image->SetPixel(region.GetUpperIndex(), static_cast<typename TImage::PixelType>(maximum));
+  return image;
+}
+
+template <typename TImage>
+void
+ExpectEqualImages(const TImage * image1, const TImage * image2)
+{
+  itk::ImageRegionConstIterator<TImage> it1(image1, image1->GetBufferedRegion());
+  itk::ImageRegionConstIterator<TImage> it2(image2, image2->GetBufferedRegion());
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    ASSERT_EQ(it1.Get(), it2.Get());
+  }
+}
+
+} // namespace
+
+
+TEST(ContrastLimitedAdaptiveHistogramEqualizationImageFilter, BasicObjectProperties)
+{
+  using ImageType = itk::Image<unsigned char, 2>;
+  using FilterType = itk::ContrastLimitedAdaptiveHistogramEqualizationImageFilter<ImageType>;
+  auto filter = FilterType::New();
+
+  EXPECT_STREQ(filter->GetNameOfClass(), "ContrastLimitedAdaptiveHistogramEqualizationImageFilter");
+  filter->Print(std::cout);
+
+  EXPECT_EQ(filter->GetNumberOfTiles(), ImageType::SizeType::Filled(8));
+  EXPECT_EQ(filter->GetClipLimit(), 4.0);
+  EXPECT_EQ(filter->GetNumberOfHistogramBins(), 256u);
+
+  filter->SetNumberOfHistogramBins(0);
+  EXPECT_EQ(filter->GetNumberOfHistogramBins(), 1u);
+}
+
+
+// With a single tile and no clipping, the filter is a global histogram
+// equalization.
+TEST(ContrastLimitedAdaptiveHistogramEqualizationImageFilter, GlobalEqualization)
+{
+  using ImageType = itk::Image<unsigned char, 2>;
+  using FilterType = itk::ContrastLimitedAdaptiveHistogramEqualizationImageFilter<ImageType>;
+
+  const auto image = CreateImage<ImageType>(ImageType::SizeType{ { 67, 45 } }, 0.0, 255.0);
+
+  std::vector<double> cumulatedFrequencies(256, 0.0);
+  for (itk::ImageRegionConstIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    ++cumulatedFrequencies[it.Get()];
+  }
+  for (unsigned int value = 1; value < 256; ++value)
+  {
+    cumulatedFrequencies[value] += cumulatedFrequencies[value - 1];
+  }
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetNumberOfTiles(ImageType::SizeType::Filled(1));
+  filter->SetClipLimit(0.0);
+  filter->Update();
+
+  itk::ImageRegionConstIterator<ImageType> inputIt(image, image->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> outputIt(filter->GetOutput(), image->GetBufferedRegion());
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++outputIt)
+  {
+    const double expected =
+      std::round(255.0 * cumulatedFrequencies[inputIt.Get()] / image->GetBufferedRegion().GetNumberOfPixels());
+    ASSERT_EQ(outputIt.Get(), expected);
+  }
+}
+
+
+TEST(ContrastLimitedAdaptiveHistogramEqualizationImageFilter, TilesAndWorkUnits)
+{
+  using ImageType = itk::Image<short, 3>;
+  using FilterType = itk::ContrastLimitedAdaptiveHistogramEqualizationImageFilter<ImageType>;
+
+  const auto image = CreateImage<ImageType>(ImageType::SizeType{ { 41, 30, 7 } }, -1000.0, 3000.0);
+
+  auto reference = FilterType::New();
+  reference->SetInput(image);
+  reference->SetNumberOfTiles(ImageType::SizeType{ { 5, 3, 8 } });
+  reference->SetClipLimit(2.0);
+  reference->SetNumberOfWorkUnits(1);
+  reference->Update();
+
+  // the output is within the range of the input
+  for (itk::ImageRegionConstIterator<ImageType> it(reference->GetOutput(), image->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    ASSERT_GE(it.Get(), -1000);
+    ASSERT_LE(it.Get(), 3000);
+  }
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetNumberOfTiles(ImageType::SizeType{ { 5, 3, 8 } });
+  filter->SetClipLimit(2.0);
+  filter->SetNumberOfWorkUnits(4);
+  filter->Update();
+  ExpectEqualImages<ImageType>(filter->GetOutput(), reference->GetOutput());
+
+  // A clip limit of 1 flattens the histograms, whose mapping is then closer
+  // to the identity, when the tiles have more pixels than bins.
+  filter->SetNumberOfHistogramBins(16);
+  filter->SetClipLimit(0.0);
+  filter->Update();
+  ImageType::Pointer unclipped = filter->GetOutput();
+  unclipped->DisconnectPipeline();
+  filter->SetClipLimit(1.0);
+  filter->Update();
+
+  double                                   variation = 0.0;
+  double                                   clippedVariation = 0.0;
+  itk::ImageRegionConstIterator<ImageType> it(unclipped, image->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> clippedIt(filter->GetOutput(), image->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> inputIt(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it, ++clippedIt, ++inputIt)
+  {
+    variation += std::abs(it.Get() - inputIt.Get());
+    clippedVariation += std::abs(clippedIt.Get() - inputIt.Get());
+  }
+  EXPECT_LT(clippedVariation, variation);
+}
+
+
+TEST(ContrastLimitedAdaptiveHistogramEqualizationImageFilter, ConstantImage)
+{
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = itk::ContrastLimitedAdaptiveHistogramEqualizationImageFilter<ImageType>;
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 13, 6 } });
+  image->Allocate();
+  image->FillBuffer(2.5f);
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->Update();
+  for (itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), image->GetBufferedRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    ASSERT_EQ(it.Get(), 2.5f);
+  }
+}
+
+
+// A NaN pixel is counted in the first bin, and does not change the output of
+// the other pixels beyond the range of the input.
+TEST(ContrastLimitedAdaptiveHistogramEqualizationImageFilter, NaNPixel)
+{
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = itk::ContrastLimitedAdaptiveHistogramEqualizationImageFilter<ImageType>;
+
+  const auto                 image = CreateImage<ImageType>(ImageType::SizeType{ { 23, 19 } }, -5.0, 5.0);
+  const ImageType::IndexType nanIndex{ { 16, 7 } };
+  image->SetPixel(nanIndex, std::numeric_limits<float>::quiet_NaN());
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetNumberOfTiles(ImageType::SizeType::Filled(3));
+  filter->Update();
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(filter->GetOutput(), image->GetBufferedRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    if (it.GetIndex() != nanIndex)
+    {
+      ASSERT_GE(it.Get(), -5.0f);
+      ASSERT_LE(it.Get(), 5.0f);
+    }
+  }
+}
+
+
+// The tabulated cumulative function of AdaptiveHistogramEqualizationImageFilter
+// gives the same result as the computation with floating point pixels.
+TEST(AdaptiveHistogramEqualizationImageFilter, CumulativeFunctionTable)
+{
+  using ImageType = itk::Image<short, 2>;
+  using RealImageType = itk::Image<double, 2>;
+  using FilterType = itk::AdaptiveHistogramEqualizationImageFilter<ImageType>;
+  using RealFilterType = itk::AdaptiveHistogramEqualizationImageFilter<RealImageType>;
+
+  const auto image = CreateImage<ImageType>(ImageType::SizeType{ { 31, 27 } }, -200.0, 400.0);
+  auto       realImage = RealImageType::New();
+  realImage->SetRegions(image->GetBufferedRegion());
+  realImage->Allocate();
+  itk::ImageRegionConstIterator<ImageType> it(image, image->GetBufferedRegion());
+  for (itk::ImageRegionIterator<RealImageType> realIt(realImage, image->GetBufferedRegion()); !realIt.IsAtEnd();
+       ++realIt, ++it)
+  {
+    realIt.Set(it.Get());
+  }
+
+  for (const float alpha : { 0.0f, 0.3f, 1.0f })
+  {
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetRadius(4);
+    filter->SetAlpha(alpha);
+    filter->SetBeta(0.4f);
+    filter->Update();
+
+    auto realFilter = RealFilterType::New();
+    realFilter->SetInput(realImage);
+    realFilter->SetRadius(4);
+    realFilter->SetAlpha(alpha);
+    realFilter->SetBeta(0.4f);
+    realFilter->Update();
+
+    itk::ImageRegionConstIterator<ImageType>     outputIt(filter->GetOutput(), image->GetBufferedRegion());
+    itk::ImageRegionConstIterator<RealImageType> realOutputIt(realFilter->GetOutput(), image->GetBufferedRegion());
+    for (; !outputIt.IsAtEnd(); ++outputIt, ++realOutputIt)
+    {
+      ASSERT_NEAR(outputIt.Get(), realOutputIt.Get(), 1.0);
+    }
+  }
+}
@@ -0,0 +1,191 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLabelStatisticsImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+#include <map>
+
+// Compare the statistics computed by LabelStatisticsImageFilter with the
+// labels accumulated in dense arrays, in the hash map, or in both, with
+// several work units and stream divisions, against a brute force
+// computation.
+
+namespace
+{
+template <typename TLabel>
+int
+TestDenseStatistics(const std::vector<TLabel> & labels)
+{
+  constexpr unsigned int Dimension = 3;
+  using ImageType = itk::Image<short, Dimension>;
+  using LabelImageType = itk::Image<TLabel, Dimension>;
+  using FilterType = itk::LabelStatisticsImageFilter<ImageType, LabelImageType>;
+  using RealType = typename FilterType::RealType;
+
+  ImageType::RegionType region;
+  region.SetSize({ { 37, 23, 11 } });
+  region.SetIndex({ { -4, 2, 0 } });
+
+  auto image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  auto labelImage = LabelImageType::New();
+  labelImage->SetRegions(region);
+  labelImage->Allocate();
+
+  // runs of random labels with random values
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(1357);
+  itk::ImageRegionIteratorWithIndex<LabelImageType> labelIt(labelImage, region);
+  TLabel                                            label = labels[0];
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it, ++labelIt)
+  {
+    if (generator->GetUniformVariate(0.0, 1.0) < 0.2)
+    {
+      label = labels[generator->GetIntegerVariate(static_cast<uint32_t>(labels.size() - 1))];
+    }
+    labelIt.Set(label);
+    it.Set(static_cast<short>(generator->GetIntegerVariate(2000)) - 1000);
+  }
+
+  std::map<TLabel, typename FilterType::LabelStatistics> expected;
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    auto &         stats = expected[labelImage->GetPixel(it.GetIndex())];
+    const RealType value = it.Get();
+    ++stats.m_Count;
+    stats.m_Minimum = std::min(stats.m_Minimum, value);
+    stats.m_Maximum = std::max(stats.m_Maximum, value);
+    stats.m_Sum += value;
+    stats.m_SumOfSquares += value * value;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      stats.m_BoundingBox[2 * d] = std::min(stats.m_BoundingBox[2 * d], it.GetIndex()[d]);
+      stats.m_BoundingBox[2 * d + 1] = std::max(stats.m_BoundingBox[2 * d + 1], it.GetIndex()[d]);
+    }
+  }
+
+  // the reference histograms, with the labels in the hash map
+  auto reference = FilterType::New();
+  reference->SetInput(image);
+  reference->SetLabelInput(labelImage);
+  reference->SetHistogramParameters(50, -900.0, 900.0);
+  reference->SetDenseLabelMinimum(itk::NumericTraits<TLabel>::OneValue());
+  reference->SetDenseLabelMaximum(itk::NumericTraits<TLabel>::ZeroValue());
+  ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetLabelInput(labelImage);
+  filter->SetHistogramParameters(50, -900.0, 900.0);
+
+  const TLabel defaultMinimum = filter->GetDenseLabelMinimum();
+  const TLabel defaultMaximum = filter->GetDenseLabelMaximum();
+  const TLabel middle = labels[labels.size() / 2];
+
+  const std::vector<std::pair<TLabel, TLabel>> ranges = { { defaultMinimum, defaultMaximum },
+                                                          { itk::NumericTraits<TLabel>::OneValue(),
+                                                            itk::NumericTraits<TLabel>::ZeroValue() },
+                                                          { middle, middle } };
+  for (const auto & range : ranges)
+  {
+    for (const unsigned int numberOfWorkUnits : { 1, 4 })
+    {
+      for (const unsigned int numberOfStreamDivisions : { 1, 3 })
+      {
+        filter->SetDenseLabelMinimum(range.first);
+        ITK_TEST_SET_GET_VALUE(range.first, filter->GetDenseLabelMinimum());
+        filter->SetDenseLabelMaximum(range.second);
+        ITK_TEST_SET_GET_VALUE(range.second, filter->GetDenseLabelMaximum());
+        filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+        filter->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+        ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+        ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfLabels(), expected.size());
+        for (const auto & labelStatistics : expected)
+        {
+          const TLabel   currentLabel = labelStatistics.first;
+          const auto &   stats = labelStatistics.second;
+          const RealType tolerance = 1e-6 * (1.0 + std::abs(stats.m_SumOfSquares));
+          const auto     histogram = filter->GetHistogram(currentLabel);
+          const auto     referenceHistogram = reference->GetHistogram(currentLabel);
+
+          bool valid = filter->HasLabel(currentLabel) && filter->GetCount(currentLabel) == stats.m_Count;
+          valid = valid && filter->GetMinimum(currentLabel) == stats.m_Minimum;
+          valid = valid && filter->GetMaximum(currentLabel) == stats.m_Maximum;
+          valid = valid && itk::Math::abs(filter->GetSum(currentLabel) - stats.m_Sum) < tolerance;
+          valid = valid && itk::Math::abs(filter->GetVariance(currentLabel) - reference->GetVariance(currentLabel)) <
+                             tolerance;
+          valid = valid && filter->GetBoundingBox(currentLabel) == stats.m_BoundingBox;
+          valid = valid && filter->GetMedian(currentLabel) == reference->GetMedian(currentLabel);
+          valid = valid && histogram->GetTotalFrequency() == referenceHistogram->GetTotalFrequency();
+          for (unsigned int bin = 0; valid && bin < histogram->GetSize(0); ++bin)
+          {
+            valid = histogram->GetFrequency(bin) == referenceHistogram->GetFrequency(bin);
+          }
+          if (!valid)
+          {
+            std::cerr << "Test failed!" << std::endl;
+            std::cerr << "Wrong statistics of label "
+                      << static_cast<typename itk::NumericTraits<TLabel>::PrintType>(currentLabel) << " with "
+                      << numberOfWorkUnits << " work units and " << numberOfStreamDivisions
+                      << " stream divisions, dense range ["
+                      << static_cast<typename itk::NumericTraits<TLabel>::PrintType>(range.first) << ", "
+                      << static_cast<typename itk::NumericTraits<TLabel>::PrintType>(range.second) << "]"
+                      << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkLabelStatisticsImageFilterDenseTest(int, char *[])
+{
+  if (TestDenseStatistics<unsigned char>({ 0, 1, 2, 7, 255 }) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  if (TestDenseStatistics<short>({ -32768, -7, 0, 3, 1000, 32767 }) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  // the largest labels exceed the memory budget of the dense arrays
+  if (TestDenseStatistics<unsigned short>({ 0, 5, 1000, 65535 }) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  if (TestDenseStatistics<int>({ -1000, -5, 0, 1, 9, 65535, 70000, 1 << 30 }) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  if (TestDenseStatistics<float>({ -1.5f, 0.0f, 2.0f, 3.25f }) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
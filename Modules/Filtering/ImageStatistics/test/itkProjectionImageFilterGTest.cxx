@@ -0,0 +1,169 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkBinaryProjectionImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkMaximumProjectionImageFilter.h"
+#include "itkMeanProjectionImageFilter.h"
+#include "itkMedianProjectionImageFilter.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkMinimumProjectionImageFilter.h"
+#include "itkStandardDeviationProjectionImageFilter.h"
+#include "itkSumProjectionImageFilter.h"
+
+
+namespace
+{
+
+using InputImageType = itk::Image<short, 3>;
+
+InputImageType::Pointer
+CreateImage()
+{
+  InputImageType::RegionType region;
+  region.SetSize({ { 601, 7, 5 } });
+  region.SetIndex({ { -3, 4, 1 } });
+  auto image = InputImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(8642);
+  for (itk::ImageRegionIterator<InputImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<short>(generator->GetIntegerVariate(40)) - 20);
+  }
+  return image;
+}
+
+// Compare the output of a projection filter along each dimension with
+// the accumulation of the pixels of each projection line.
+template <typename TFilter, typename TAccumulatorFactory>
+void
+CompareWithLines(TFilter * filter, const TAccumulatorFactory & newAccumulator)
+{
+  using OutputImageType = typename TFilter::OutputImageType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+
+  const auto image = CreateImage();
+  filter->SetInput(image);
+
+  for (unsigned int projectionDimension = 0; projectionDimension < 3; ++projectionDimension)
+  {
+    for (const unsigned int numberOfWorkUnits : { 1, 3 })
+    {
+      filter->SetProjectionDimension(projectionDimension);
+      filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      filter->UpdateLargestPossibleRegion();
+      const OutputImageType * output = filter->GetOutput();
+
+      const InputImageType::RegionType region = image->GetBufferedRegion();
+      const itk::SizeValueType         projectionSize = region.GetSize(projectionDimension);
+      auto                             accumulator = newAccumulator(projectionSize);
+
+      InputImageType::RegionType linesRegion = region;
+      linesRegion.SetSize(projectionDimension, 1);
+      for (itk::ImageRegionConstIteratorWithIndex<InputImageType> it(image, linesRegion); !it.IsAtEnd(); ++it)
+      {
+        InputImageType::IndexType index = it.GetIndex();
+        accumulator.Initialize();
+        for (itk::SizeValueType i = 0; i < projectionSize; ++i)
+        {
+          accumulator(image->GetPixel(index));
+          ++index[projectionDimension];
+        }
+        const auto expected = static_cast<OutputPixelType>(accumulator.GetValue());
+
+        typename OutputImageType::IndexType outputIndex;
+        for (unsigned int d = 0; d < OutputImageType::ImageDimension; ++d)
+        {
+          outputIndex[d] = d == projectionDimension ? (OutputImageType::ImageDimension == 3 ? 0 : it.GetIndex()[2])
+                                                    : it.GetIndex()[d];
+        }
+        ASSERT_NEAR(output->GetPixel(outputIndex), expected, 1e-5 * (1.0 + std::abs(expected)))
+          << "projection dimension " << projectionDimension << ", index " << it.GetIndex();
+      }
+    }
+  }
+}
+
+template <typename TFilter>
+void
+CompareWithLines()
+{
+  auto filter = TFilter::New();
+  CompareWithLines(filter.GetPointer(), [](itk::SizeValueType size) {
+    return typename TFilter::AccumulatorType(size);
+  });
+}
+
+} // namespace
+
+
+TEST(ProjectionImageFilter, Maximum)
+{
+  CompareWithLines<itk::MaximumProjectionImageFilter<InputImageType, InputImageType>>();
+  CompareWithLines<itk::MaximumProjectionImageFilter<InputImageType, itk::Image<short, 2>>>();
+}
+
+TEST(ProjectionImageFilter, Minimum)
+{
+  CompareWithLines<itk::MinimumProjectionImageFilter<InputImageType, InputImageType>>();
+  CompareWithLines<itk::MinimumProjectionImageFilter<InputImageType, itk::Image<short, 2>>>();
+}
+
+TEST(ProjectionImageFilter, Sum)
+{
+  CompareWithLines<itk::SumProjectionImageFilter<InputImageType, itk::Image<float, 3>>>();
+  CompareWithLines<itk::SumProjectionImageFilter<InputImageType, itk::Image<int, 2>>>();
+}
+
+TEST(ProjectionImageFilter, Mean)
+{
+  CompareWithLines<itk::MeanProjectionImageFilter<InputImageType, itk::Image<double, 3>>>();
+  CompareWithLines<itk::MeanProjectionImageFilter<InputImageType, itk::Image<float, 2>>>();
+}
+
+TEST(ProjectionImageFilter, StandardDeviation)
+{
+  CompareWithLines<itk::StandardDeviationProjectionImageFilter<InputImageType, itk::Image<double, 3>>>();
+  CompareWithLines<itk::StandardDeviationProjectionImageFilter<InputImageType, itk::Image<float, 2>>>();
+}
+
+TEST(ProjectionImageFilter, Median)
+{
+  CompareWithLines<itk::MedianProjectionImageFilter<InputImageType, InputImageType>>();
+  CompareWithLines<itk::MedianProjectionImageFilter<InputImageType, itk::Image<short, 2>>>();
+}
+
+TEST(ProjectionImageFilter, Binary)
+{
+  using FilterType = itk::BinaryProjectionImageFilter<InputImageType, itk::Image<unsigned char, 2>>;
+  auto filter = FilterType::New();
+  filter->SetForegroundValue(19);
+  filter->SetBackgroundValue(7);
+  CompareWithLines(filter.GetPointer(), [](itk::SizeValueType size) {
+    FilterType::AccumulatorType accumulator(size);
+    accumulator.m_ForegroundValue = 19;
+    accumulator.m_BackgroundValue = 7;
+    return accumulator;
+  });
+}
@@ -0,0 +1,143 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkMinimumMaximumImageFilter.h"
+#include "itkStatisticsImageFilter.h"
+
+#include <limits>
+
+
+namespace
+{
+
+// An image of random values, with lines whose length is not a multiple of
+// the number of lanes.
+template <typename TPixel>
+typename itk::Image<TPixel, 3>::Pointer
+CreateRandomImage(double minimum, double maximum)
+{
+  using ImageType = itk::Image<TPixel, 3>;
+
+  typename ImageType::RegionType region;
+  region.SetSize({ { 53, 7, 5 } });
+  region.SetIndex({ { -3, 2, 0 } });
+  auto image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(9753);
+  for (itk::ImageRegionIterator<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<TPixel>(generator->GetUniformVariate(minimum, maximum)));
+  }
+  return image;
+}
+
+template <typename TPixel>
+void
+CompareWithBruteForce(double minimum, double maximum)
+{
+  using ImageType = itk::Image<TPixel, 3>;
+  using FilterType = itk::StatisticsImageFilter<ImageType>;
+  using MinimumMaximumFilterType = itk::MinimumMaximumImageFilter<ImageType>;
+
+  const auto image = CreateRandomImage<TPixel>(minimum, maximum);
+
+  TPixel      expectedMinimum = std::numeric_limits<TPixel>::max();
+  TPixel      expectedMaximum = std::numeric_limits<TPixel>::lowest();
+  long double expectedSum = 0.0;
+  long double expectedSumOfSquares = 0.0;
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const long double value = it.Get();
+    expectedMinimum = std::min(expectedMinimum, it.Get());
+    expectedMaximum = std::max(expectedMaximum, it.Get());
+    expectedSum += value;
+    expectedSumOfSquares += value * value;
+  }
+  const auto        numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+  const long double expectedMean = expectedSum / numberOfPixels;
+  const long double expectedVariance =
+    (expectedSumOfSquares - expectedSum * expectedSum / numberOfPixels) / (numberOfPixels - 1);
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  auto minimumMaximumFilter = MinimumMaximumFilterType::New();
+  minimumMaximumFilter->SetInput(image);
+
+  for (const unsigned int numberOfWorkUnits : { 1, 3 })
+  {
+    for (const unsigned int numberOfStreamDivisions : { 1, 4 })
+    {
+      filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      filter->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+      filter->Update();
+
+      EXPECT_EQ(filter->GetMinimum(), expectedMinimum);
+      EXPECT_EQ(filter->GetMaximum(), expectedMaximum);
+      EXPECT_NEAR(filter->GetSum(), static_cast<double>(expectedSum), 1e-9 * std::abs(expectedSumOfSquares));
+      EXPECT_NEAR(filter->GetMean(), static_cast<double>(expectedMean), 1e-9 * (1.0 + std::abs(expectedMean)));
+      EXPECT_NEAR(filter->GetVariance(), static_cast<double>(expectedVariance), 1e-9 * expectedVariance);
+
+      minimumMaximumFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      minimumMaximumFilter->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+      minimumMaximumFilter->Update();
+
+      EXPECT_EQ(minimumMaximumFilter->GetMinimum(), expectedMinimum);
+      EXPECT_EQ(minimumMaximumFilter->GetMaximum(), expectedMaximum);
+    }
+  }
+}
+
+} // namespace
+
+
+TEST(StatisticsImageFilter, CompareWithBruteForce_UnsignedChar)
+{
+  CompareWithBruteForce<unsigned char>(0.0, 256.0);
+}
+
+
+TEST(StatisticsImageFilter, CompareWithBruteForce_Short)
+{
+  CompareWithBruteForce<short>(-32768.0, 32768.0);
+}
+
+
+TEST(StatisticsImageFilter, CompareWithBruteForce_Int)
+{
+  CompareWithBruteForce<int>(-1e9, 1e9);
+}
+
+
+TEST(StatisticsImageFilter, CompareWithBruteForce_Float)
+{
+  CompareWithBruteForce<float>(-1e3, 1e5);
+}
+
+
+TEST(StatisticsImageFilter, CompareWithBruteForce_Double)
+{
+  CompareWithBruteForce<double>(-1e6, 1e7);
+}
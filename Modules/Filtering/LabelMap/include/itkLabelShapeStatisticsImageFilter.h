@@ -0,0 +1,278 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLabelShapeStatisticsImageFilter_h
+#define itkLabelShapeStatisticsImageFilter_h
+
+#include "itkImageSink.h"
+#include "itkMatrix.h"
+#include "itkPoint.h"
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace itk
+{
+/** \class LabelShapeStatisticsImageFilter
+ * \brief Compute the shape attributes of the objects of a label image in a
+ * single streamed pass.
+ *
+ * LabelShapeStatisticsImageFilter computes for each label of a label
+ * image the number of pixels, the physical size, the bounding box, the
+ * centroid, the principal moments and axes, the elongation, the flatness,
+ * the equivalent spherical radius and perimeter, and optionally the
+ * perimeter, the roundness and the Feret diameter. The attributes have the
+ * same definition as in ShapeLabelMapFilter, but they are computed directly
+ * from the label image, without building a LabelMap: each work unit scans
+ * its region by runs of pixels with the same label and accumulates the
+ * moments of the runs, and the number of object pixels whose neighbor in
+ * each direction belongs to another object or to the background (the
+ * intercepts used to estimate the perimeter). The pixels outside the
+ * largest possible region are considered as background.
+ *
+ * The filter is multi-threaded and can stream its input when
+ * NumberOfStreamDivisions is set to more than 1: a margin of one pixel is
+ * then requested around each streamed region when the perimeter or the
+ * Feret diameter are computed. The per-thread results are merged by label.
+ *
+ * The Feret diameter is computed by comparing all the pairs of pixels on the
+ * border of an object, which is quadratic in the size of the border, and is
+ * disabled by default.
+ *
+ * \sa ShapeLabelMapFilter LabelImageToShapeLabelMapFilter LabelStatisticsImageFilter
+ * \ingroup ImageEnhancement MathematicalMorphologyImageFilters
+ * \ingroup ITKLabelMap
+ */
+template <typename TLabelImage>
+class ITK_TEMPLATE_EXPORT LabelShapeStatisticsImageFilter : public ImageSink<TLabelImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(LabelShapeStatisticsImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = LabelShapeStatisticsImageFilter;
+  using Superclass = ImageSink<TLabelImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(LabelShapeStatisticsImageFilter, ImageSink);
+
+  /** Label image related type alias. */
+  using LabelImageType = TLabelImage;
+  using RegionType = typename LabelImageType::RegionType;
+  using SizeType = typename LabelImageType::SizeType;
+  using IndexType = typename LabelImageType::IndexType;
+  using OffsetType = typename LabelImageType::OffsetType;
+  using LabelPixelType = typename LabelImageType::PixelType;
+
+  static constexpr unsigned int ImageDimension = TLabelImage::ImageDimension;
+
+  /** Shape attribute type alias. */
+  using PointType = Point<double, ImageDimension>;
+  using VectorType = Vector<double, ImageDimension>;
+  using MatrixType = Matrix<double, ImageDimension, ImageDimension>;
+
+  /** \class LabelShapeStatistics
+   * \brief Shape attributes of a label.
+   * \ingroup ITKLabelMap
+   */
+  class LabelShapeStatistics
+  {
+  public:
+    SizeValueType m_NumberOfPixels{ 0 };
+    double        m_PhysicalSize{ 0.0 };
+    RegionType    m_BoundingBox;
+    PointType     m_Centroid;
+    VectorType    m_PrincipalMoments;
+    MatrixType    m_PrincipalAxes;
+    double        m_Elongation{ 0.0 };
+    double        m_Flatness{ 0.0 };
+    double        m_EquivalentSphericalRadius{ 0.0 };
+    double        m_EquivalentSphericalPerimeter{ 0.0 };
+    double        m_Perimeter{ 0.0 };
+    double        m_Roundness{ 0.0 };
+    double        m_FeretDiameter{ 0.0 };
+  };
+
+  /** Type of the map used to store the attributes per label. */
+  using MapType = std::map<LabelPixelType, LabelShapeStatistics>;
+  using MapSizeType = IdentifierType;
+
+  /** Type of the container used to store the valid label values. */
+  using ValidLabelValuesContainerType = std::vector<LabelPixelType>;
+
+  /**
+   * Set/Get the value used as "background" in the label image.
+   * Defaults to NumericTraits<LabelPixelType>::NonpositiveMin().
+   */
+  itkSetMacro(BackgroundValue, LabelPixelType);
+  itkGetConstMacro(BackgroundValue, LabelPixelType);
+
+  /**
+   * Set/Get whether the perimeter and the roundness should be computed or
+   * not. Defaults to true.
+   */
+  itkSetMacro(ComputePerimeter, bool);
+  itkGetConstMacro(ComputePerimeter, bool);
+  itkBooleanMacro(ComputePerimeter);
+
+  /**
+   * Set/Get whether the Feret diameter should be computed or not. Defaults
+   * to false, because of the high computation time required.
+   */
+  itkSetMacro(ComputeFeretDiameter, bool);
+  itkGetConstMacro(ComputeFeretDiameter, bool);
+  itkBooleanMacro(ComputeFeretDiameter);
+
+  /** Return the labels found in the image, in increasing order. Can only be
+   * called after a call to Update(). */
+  virtual const ValidLabelValuesContainerType &
+  GetValidLabelValues() const
+  {
+    return m_ValidLabelValues;
+  }
+
+  /** Does the specified label exist? Can only be called after a call to
+   * Update(). */
+  bool
+  HasLabel(LabelPixelType label) const
+  {
+    return m_LabelShapeStatistics.find(label) != m_LabelShapeStatistics.end();
+  }
+
+  /** Get the number of labels found in the image. */
+  MapSizeType
+  GetNumberOfLabels() const
+  {
+    return static_cast<MapSizeType>(m_LabelShapeStatistics.size());
+  }
+
+  /** Return the attributes of a label. An exception is thrown if the label
+   * is not in the image. */
+  const LabelShapeStatistics &
+  GetLabelShapeStatistics(LabelPixelType label) const;
+
+  /** Return the attributes of all the labels. */
+  const MapType &
+  GetLabelShapeStatisticsMap() const
+  {
+    return m_LabelShapeStatistics;
+  }
+
+  // Change the access from protected to public to expose streaming option, a using statement can not be used due to
+  // limitations of wrapping.
+  void
+  SetNumberOfStreamDivisions(const unsigned int n) override
+  {
+    Superclass::SetNumberOfStreamDivisions(n);
+  }
+  unsigned int
+  GetNumberOfStreamDivisions() const override
+  {
+    return Superclass::GetNumberOfStreamDivisions();
+  }
+
+protected:
+  LabelShapeStatisticsImageFilter();
+  ~LabelShapeStatisticsImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Pad the streamed region by one pixel to find the neighbors of its
+   * object pixels. */
+  void
+  GenerateNthInputRequestedRegion(unsigned int inputRequestedRegionNumber) override;
+
+  void
+  BeforeStreamedGenerateData() override;
+
+  void
+  ThreadedStreamedGenerateData(const RegionType & regionForThread) override;
+
+  /** Compute the attributes of each label from the accumulated moments. */
+  void
+  AfterStreamedGenerateData() override;
+
+private:
+  /** The intercepts are counted for each class of neighbor offsets, the
+   * class of an offset being the set of its nonzero components. */
+  static constexpr unsigned int NumberOfInterceptClasses = (1u << ImageDimension) - 1;
+
+  using InterceptsType = std::array<SizeValueType, NumberOfInterceptClasses>;
+
+  /** Moments accumulated for a label, in index space. */
+  struct ShapeAccumulator
+  {
+    ShapeAccumulator()
+    {
+      m_Minimum.Fill(NumericTraits<IndexValueType>::max());
+      m_Maximum.Fill(NumericTraits<IndexValueType>::NonpositiveMin());
+    }
+
+    SizeValueType                                       m_NumberOfPixels{ 0 };
+    IndexType                                           m_Minimum;
+    IndexType                                           m_Maximum;
+    std::array<double, ImageDimension>                  m_IndexSum{};
+    std::array<double, ImageDimension * ImageDimension> m_IndexProductSum{};
+    InterceptsType                                      m_Intercepts{};
+    std::vector<IndexType>                              m_BorderIndices;
+  };
+
+  using AccumulatorMapType = std::unordered_map<LabelPixelType, ShapeAccumulator>;
+
+  /** Add a run of pixels along the first axis to an accumulator. */
+  static void
+  AddRun(ShapeAccumulator & accumulator, const IndexType & index, SizeValueType length);
+
+  static void
+  MergeAccumulator(ShapeAccumulator & accumulator, ShapeAccumulator & other);
+
+  /** Compute the final attributes of a label. */
+  void
+  ComputeShapeStatistics(const ShapeAccumulator & accumulator, LabelShapeStatistics & statistics) const;
+
+  static double
+  PerimeterFromIntercepts(const InterceptsType & intercepts, const VectorType & spacing);
+
+  LabelPixelType m_BackgroundValue;
+  bool           m_ComputePerimeter{ true };
+  bool           m_ComputeFeretDiameter{ false };
+
+  /** The offsets to the 3^N-1 neighbors of a pixel, and their class. */
+  std::vector<std::pair<OffsetType, unsigned int>> m_NeighborOffsets;
+
+  AccumulatorMapType            m_Accumulators;
+  MapType                       m_LabelShapeStatistics;
+  ValidLabelValuesContainerType m_ValidLabelValues;
+
+  std::mutex m_Mutex;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkLabelShapeStatisticsImageFilter.hxx"
+#endif
+
+#endif
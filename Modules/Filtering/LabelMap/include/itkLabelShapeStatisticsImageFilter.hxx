@@ -0,0 +1,510 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLabelShapeStatisticsImageFilter_hxx
+#define itkLabelShapeStatisticsImageFilter_hxx
+
+#include "itkContinuousIndex.h"
+#include "itkGeometryUtilities.h"
+#include "itkIndexRange.h"
+#include "itkMath.h"
+#include "vnl/algo/vnl_real_eigensystem.h"
+#include "vnl/algo/vnl_symmetric_eigensystem.h"
+
+namespace itk
+{
+template <typename TLabelImage>
+LabelShapeStatisticsImageFilter<TLabelImage>::LabelShapeStatisticsImageFilter()
+  : m_BackgroundValue(NumericTraits<LabelPixelType>::NonpositiveMin())
+{}
+
+template <typename TLabelImage>
+auto
+LabelShapeStatisticsImageFilter<TLabelImage>::GetLabelShapeStatistics(LabelPixelType label) const
+  -> const LabelShapeStatistics &
+{
+  const auto it = m_LabelShapeStatistics.find(label);
+  if (it == m_LabelShapeStatistics.end())
+  {
+    itkExceptionMacro("No label object with label " << static_cast<typename NumericTraits<LabelPixelType>::PrintType>(
+                        label) << ".");
+  }
+  return it->second;
+}
+
+template <typename TLabelImage>
+void
+LabelShapeStatisticsImageFilter<TLabelImage>::GenerateNthInputRequestedRegion(unsigned int inputRequestedRegionNumber)
+{
+  Superclass::GenerateNthInputRequestedRegion(inputRequestedRegionNumber);
+
+  if (m_ComputePerimeter || m_ComputeFeretDiameter)
+  {
+    auto *     input = const_cast<LabelImageType *>(this->GetInput());
+    RegionType requestedRegion = input->GetRequestedRegion();
+    requestedRegion.PadByRadius(1);
+    requestedRegion.Crop(input->GetLargestPossibleRegion());
+    input->SetRequestedRegion(requestedRegion);
+  }
+}
+
+template <typename TLabelImage>
+void
+LabelShapeStatisticsImageFilter<TLabelImage>::BeforeStreamedGenerateData()
+{
+  Superclass::BeforeStreamedGenerateData();
+
+  m_Accumulators.clear();
+  m_LabelShapeStatistics.clear();
+  m_ValidLabelValues.clear();
+
+  // the offsets to all the neighbors, with the set of their nonzero
+  // components as class
+  m_NeighborOffsets.clear();
+  SizeType neighborhoodSize;
+  neighborhoodSize.Fill(3);
+  for (const auto & neighborhoodIndex : ZeroBasedIndexRange<ImageDimension>(neighborhoodSize))
+  {
+    OffsetType   offset;
+    unsigned int mask = 0;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      offset[i] = neighborhoodIndex[i] - 1;
+      if (offset[i] != 0)
+      {
+        mask |= 1u << i;
+      }
+    }
+    if (mask != 0)
+    {
+      m_NeighborOffsets.emplace_back(offset, mask - 1);
+    }
+  }
+}
+
+template <typename TLabelImage>
+void
+LabelShapeStatisticsImageFilter<TLabelImage>::AddRun(ShapeAccumulator & accumulator,
+                                                     const IndexType &  index,
+                                                     SizeValueType      length)
+{
+  const auto   n = static_cast<double>(length);
+  const auto   x0 = static_cast<double>(index[0]);
+  const double sum0 = n * x0 + 0.5 * n * (n - 1.0);
+  const double sumOfSquares0 = n * x0 * x0 + x0 * n * (n - 1.0) + n * (n - 1.0) * (2.0 * n - 1.0) / 6.0;
+
+  accumulator.m_NumberOfPixels += length;
+  accumulator.m_IndexSum[0] += sum0;
+  accumulator.m_IndexProductSum[0] += sumOfSquares0;
+  for (unsigned int i = 1; i < ImageDimension; ++i)
+  {
+    const auto xi = static_cast<double>(index[i]);
+    accumulator.m_IndexSum[i] += n * xi;
+    accumulator.m_IndexProductSum[i] += sum0 * xi;
+    accumulator.m_IndexProductSum[i * ImageDimension] += sum0 * xi;
+    for (unsigned int j = 1; j < ImageDimension; ++j)
+    {
+      accumulator.m_IndexProductSum[i * ImageDimension + j] += n * xi * static_cast<double>(index[j]);
+    }
+  }
+
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    accumulator.m_Minimum[i] = std::min(accumulator.m_Minimum[i], index[i]);
+    accumulator.m_Maximum[i] = std::max(accumulator.m_Maximum[i], index[i]);
+  }
+  accumulator.m_Maximum[0] =
+    std::max(accumulator.m_Maximum[0], index[0] + static_cast<IndexValueType>(length) - 1);
+}
+
+template <typename TLabelImage>
+void
+LabelShapeStatisticsImageFilter<TLabelImage>::MergeAccumulator(ShapeAccumulator & accumulator,
+                                                               ShapeAccumulator & other)
+{
+  accumulator.m_NumberOfPixels += other.m_NumberOfPixels;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    accumulator.m_Minimum[i] = std::min(accumulator.m_Minimum[i], other.m_Minimum[i]);
+    accumulator.m_Maximum[i] = std::max(accumulator.m_Maximum[i], other.m_Maximum[i]);
+    accumulator.m_IndexSum[i] += other.m_IndexSum[i];
+  }
+  for (unsigned int i = 0; i < ImageDimension * ImageDimension; ++i)
+  {
+    accumulator.m_IndexProductSum[i] += other.m_IndexProductSum[i];
+  }
+  for (unsigned int i = 0; i < NumberOfInterceptClasses; ++i)
+  {
+    accumulator.m_Intercepts[i] += other.m_Intercepts[i];
+  }
+  accumulator.m_BorderIndices.insert(
+    accumulator.m_BorderIndices.end(), other.m_BorderIndices.begin(), other.m_BorderIndices.end());
+}
+
+template <typename TLabelImage>
+void
+LabelShapeStatisticsImageFilter<TLabelImage>::ThreadedStreamedGenerateData(const RegionType & regionForThread)
+{
+  const auto length = static_cast<OffsetValueType>(regionForThread.GetSize(0));
+  if (length == 0)
+  {
+    return;
+  }
+
+  const LabelImageType * input = this->GetInput();
+  const LabelPixelType * buffer = input->GetBufferPointer();
+  const RegionType &     largestRegion = input->GetLargestPossibleRegion();
+  const IndexValueType   firstIndex0 = largestRegion.GetIndex(0);
+  const IndexValueType   lastIndex0 = largestRegion.GetUpperIndex()[0];
+
+  const bool                          computeNeighbors = m_ComputePerimeter || m_ComputeFeretDiameter;
+  const size_t                        numberOfNeighbors = m_NeighborOffsets.size();
+  std::vector<const LabelPixelType *> neighborLines(numberOfNeighbors);
+
+  AccumulatorMapType localAccumulators;
+
+  RegionType lines = regionForThread;
+  lines.SetSize(0, 1);
+  for (const IndexType & lineIndex : ImageRegionIndexRange<ImageDimension>(lines))
+  {
+    const LabelPixelType * line = buffer + input->ComputeOffset(lineIndex);
+
+    // the lines of the neighbors, at the same position along the first axis,
+    // or null when they are outside of the image
+    if (computeNeighbors)
+    {
+      for (size_t k = 0; k < numberOfNeighbors; ++k)
+      {
+        IndexType neighborIndex = lineIndex + m_NeighborOffsets[k].first;
+        neighborIndex[0] = lineIndex[0];
+        neighborLines[k] =
+          largestRegion.IsInside(neighborIndex) ? buffer + input->ComputeOffset(neighborIndex) : nullptr;
+      }
+    }
+
+    // process the line by runs of pixels with the same label
+    OffsetValueType begin = 0;
+    while (begin < length)
+    {
+      const LabelPixelType label = line[begin];
+      OffsetValueType      end = begin + 1;
+      while (end < length && line[end] == label)
+      {
+        ++end;
+      }
+
+      if (label != m_BackgroundValue)
+      {
+        ShapeAccumulator & accumulator = localAccumulators[label];
+        IndexType          index = lineIndex;
+        index[0] += begin;
+        AddRun(accumulator, index, end - begin);
+
+        if (computeNeighbors)
+        {
+          for (OffsetValueType x = begin; x < end; ++x)
+          {
+            const IndexValueType index0 = lineIndex[0] + x;
+            bool                 onBorder = false;
+            for (size_t k = 0; k < numberOfNeighbors; ++k)
+            {
+              const OffsetValueType  offset0 = m_NeighborOffsets[k].first[0];
+              const LabelPixelType * neighborLine = neighborLines[k];
+              if (neighborLine == nullptr || index0 + offset0 < firstIndex0 || index0 + offset0 > lastIndex0 ||
+                  neighborLine[x + offset0] != label)
+              {
+                ++accumulator.m_Intercepts[m_NeighborOffsets[k].second];
+                onBorder = true;
+              }
+            }
+            if (onBorder && m_ComputeFeretDiameter)
+            {
+              index[0] = index0;
+              accumulator.m_BorderIndices.push_back(index);
+            }
+          }
+        }
+      }
+      begin = end;
+    }
+  }
+
+  // Merge localAccumulators and m_Accumulators concurrently safe in a
+  // local copy, this thread may do multiple merges.
+  while (true)
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    if (m_Accumulators.empty())
+    {
+      swap(m_Accumulators, localAccumulators);
+      break;
+    }
+
+    // copy the output map to thread local storage
+    AccumulatorMapType toMerge;
+    swap(m_Accumulators, toMerge);
+
+    // allow other threads to merge data
+    lock.unlock();
+
+    for (auto & labelAccumulator : toMerge)
+    {
+      auto it = localAccumulators.find(labelAccumulator.first);
+      if (it == localAccumulators.end())
+      {
+        localAccumulators.emplace(labelAccumulator.first, std::move(labelAccumulator.second));
+      }
+      else
+      {
+        MergeAccumulator(it->second, labelAccumulator.second);
+      }
+    }
+  }
+}
+
+template <typename TLabelImage>
+void
+LabelShapeStatisticsImageFilter<TLabelImage>::AfterStreamedGenerateData()
+{
+  Superclass::AfterStreamedGenerateData();
+
+  std::vector<std::pair<const ShapeAccumulator *, LabelShapeStatistics *>> labels;
+  labels.reserve(m_Accumulators.size());
+  for (const auto & labelAccumulator : m_Accumulators)
+  {
+    labels.emplace_back(&labelAccumulator.second, &m_LabelShapeStatistics[labelAccumulator.first]);
+  }
+
+  // the attributes of the labels are independent, and the Feret diameter may
+  // be expensive
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    labels.size(),
+    [this, &labels](SizeValueType i) { this->ComputeShapeStatistics(*labels[i].first, *labels[i].second); },
+    nullptr);
+
+  m_Accumulators.clear();
+
+  m_ValidLabelValues.reserve(m_LabelShapeStatistics.size());
+  for (const auto & labelStatistics : m_LabelShapeStatistics)
+  {
+    m_ValidLabelValues.push_back(labelStatistics.first);
+  }
+}
+
+template <typename TLabelImage>
+void
+LabelShapeStatisticsImageFilter<TLabelImage>::ComputeShapeStatistics(const ShapeAccumulator & accumulator,
+                                                                     LabelShapeStatistics &   statistics) const
+{
+  const LabelImageType *                     input = this->GetInput();
+  const typename LabelImageType::SpacingType spacing = input->GetSpacing();
+  const auto                                 numberOfPixels = static_cast<double>(accumulator.m_NumberOfPixels);
+
+  double sizePerPixel = 1.0;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    sizePerPixel *= spacing[i];
+  }
+
+  SizeType boundingBoxSize;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    boundingBoxSize[i] = static_cast<SizeValueType>(accumulator.m_Maximum[i] - accumulator.m_Minimum[i] + 1);
+  }
+
+  ContinuousIndex<double, ImageDimension> centroid;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    centroid[i] = accumulator.m_IndexSum[i] / numberOfPixels;
+  }
+  PointType physicalCentroid;
+  input->TransformContinuousIndexToPhysicalPoint(centroid, physicalCentroid);
+
+  // the central moments in index space, mapped to the physical space by the
+  // direction and the spacing of the image
+  MatrixType indexMoments;
+  MatrixType scaledDirection;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    for (unsigned int j = 0; j < ImageDimension; ++j)
+    {
+      indexMoments[i][j] =
+        accumulator.m_IndexProductSum[i * ImageDimension + j] / numberOfPixels - centroid[i] * centroid[j];
+      scaledDirection[i][j] = input->GetDirection()[i][j] * spacing[j];
+    }
+  }
+  const MatrixType centralMoments = scaledDirection * indexMoments * MatrixType(scaledDirection.GetTranspose());
+
+  // Compute principal moments and axes
+  VectorType                        principalMoments;
+  vnl_symmetric_eigensystem<double> eigen{ centralMoments.GetVnlMatrix().as_matrix() };
+  vnl_diag_matrix<double>           pm = eigen.D;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    principalMoments[i] = pm(i);
+  }
+  MatrixType principalAxes(eigen.V.transpose());
+
+  // Add a final reflection if needed for a proper rotation,
+  // by multiplying the last row by the determinant
+  vnl_real_eigensystem                  eigenrot{ principalAxes.GetVnlMatrix().as_matrix() };
+  vnl_diag_matrix<std::complex<double>> eigenval{ eigenrot.D };
+  std::complex<double>                  det(1.0, 0.0);
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    det *= eigenval(i);
+  }
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    principalAxes[ImageDimension - 1][i] *= std::real(det);
+  }
+
+  double elongation = 1.0;
+  double flatness = 1.0;
+  if (ImageDimension >= 2)
+  {
+    elongation = 0.0;
+    flatness = 0.0;
+    if (Math::NotAlmostEquals(principalMoments[0], 0.0))
+    {
+      const double flatnessRatio = principalMoments[1] / principalMoments[0];
+      if (flatnessRatio > 0.0)
+      {
+        flatness = std::sqrt(flatnessRatio);
+      }
+    }
+    if (Math::NotAlmostEquals(principalMoments[ImageDimension - 2], 0.0))
+    {
+      const double elongationRatio = principalMoments[ImageDimension - 1] / principalMoments[ImageDimension - 2];
+      if (elongationRatio > 0.0)
+      {
+        elongation = std::sqrt(elongationRatio);
+      }
+    }
+  }
+
+  const double physicalSize = numberOfPixels * sizePerPixel;
+  const double equivalentRadius = GeometryUtilities::HyperSphereRadiusFromVolume(ImageDimension, physicalSize);
+  const double equivalentPerimeter = GeometryUtilities::HyperSpherePerimeter(ImageDimension, equivalentRadius);
+
+  statistics.m_NumberOfPixels = accumulator.m_NumberOfPixels;
+  statistics.m_PhysicalSize = physicalSize;
+  statistics.m_BoundingBox = RegionType(accumulator.m_Minimum, boundingBoxSize);
+  statistics.m_Centroid = physicalCentroid;
+  statistics.m_PrincipalMoments = principalMoments;
+  statistics.m_PrincipalAxes = principalAxes;
+  statistics.m_Elongation = elongation;
+  statistics.m_Flatness = flatness;
+  statistics.m_EquivalentSphericalRadius = equivalentRadius;
+  statistics.m_EquivalentSphericalPerimeter = equivalentPerimeter;
+
+  if (m_ComputePerimeter)
+  {
+    VectorType spacingVector;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      spacingVector[i] = spacing[i];
+    }
+    statistics.m_Perimeter = PerimeterFromIntercepts(accumulator.m_Intercepts, spacingVector);
+    statistics.m_Roundness = equivalentPerimeter / statistics.m_Perimeter;
+  }
+
+  if (m_ComputeFeretDiameter)
+  {
+    const std::vector<IndexType> & borderIndices = accumulator.m_BorderIndices;
+    double                         feretDiameter = 0.0;
+    for (size_t i = 0; i < borderIndices.size(); ++i)
+    {
+      for (size_t j = i + 1; j < borderIndices.size(); ++j)
+      {
+        double length = 0.0;
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          length += Math::sqr(static_cast<double>(borderIndices[i][d] - borderIndices[j][d]) * spacing[d]);
+        }
+        feretDiameter = std::max(feretDiameter, length);
+      }
+    }
+    statistics.m_FeretDiameter = std::sqrt(feretDiameter);
+  }
+}
+
+template <typename TLabelImage>
+double
+LabelShapeStatisticsImageFilter<TLabelImage>::PerimeterFromIntercepts(const InterceptsType & intercepts,
+                                                                      const VectorType &     spacing)
+{
+  double pixelSize = 1.0;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    pixelSize *= spacing[i];
+  }
+
+  double perimeter = 0.0;
+  if (ImageDimension == 2 || ImageDimension == 3)
+  {
+    // Same estimate as ShapeLabelMapFilter: the intercepts in each direction
+    // are weighted by the area of the Voronoi partition of the unit sphere
+    // associated with that direction, which only depends on the number of
+    // nonzero components of the direction in 3D.
+    const double weights3D[] = { 0.0, 0.04577789120476 * 8, 0.03698062787608 * 8, 0.03519563978232 * 8 };
+    for (unsigned int c = 0; c < NumberOfInterceptClasses; ++c)
+    {
+      double       squaredLength = 0.0;
+      unsigned int numberOfAxes = 0;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        if ((c + 1) & (1u << i))
+        {
+          squaredLength += spacing[i] * spacing[i];
+          ++numberOfAxes;
+        }
+      }
+      const double weight = ImageDimension == 2 ? Math::pi / 4.0 : weights3D[numberOfAxes];
+      perimeter += weight * pixelSize / std::sqrt(squaredLength) * intercepts[c] / 2.0;
+    }
+    return perimeter;
+  }
+
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    perimeter += pixelSize / spacing[i] * intercepts[(1u << i) - 1] / 2.0;
+  }
+
+  // Crofton's constant
+  perimeter *= GeometryUtilities::HyperSphereVolume(ImageDimension, 1.0) /
+               GeometryUtilities::HyperSphereVolume(ImageDimension - 1, 1.0);
+  return perimeter;
+}
+
+template <typename TLabelImage>
+void
+LabelShapeStatisticsImageFilter<TLabelImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "BackgroundValue: "
+     << static_cast<typename NumericTraits<LabelPixelType>::PrintType>(m_BackgroundValue) << std::endl;
+  os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
+  os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
+  os << indent << "Number of labels: " << m_LabelShapeStatistics.size() << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,223 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGTest.h"
+
+#include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkLabelImageToShapeLabelMapFilter.h"
+#include "itkLabelShapeStatisticsImageFilter.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+
+namespace
+{
+
+// A label image with overlapping random ellipsoids, some of them touching
+// the border of the image.
+template <unsigned int VDimension>
+typename itk::Image<short, VDimension>::Pointer
+CreateLabelImage(const itk::Size<VDimension> & size, unsigned int numberOfObjects)
+{
+  using ImageType = itk::Image<short, VDimension>;
+
+  typename ImageType::RegionType region;
+  region.SetSize(size);
+  region.SetIndex(0, -3);
+  auto image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate(true);
+
+  typename ImageType::SpacingType spacing;
+  typename ImageType::PointType   origin;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    spacing[d] = 0.5 + 0.25 * d;
+    origin[d] = 1.0 - d;
+  }
+  image->SetSpacing(spacing);
+  image->SetOrigin(origin);
+
+  typename ImageType::DirectionType direction;
+  direction.SetIdentity();
+  const double angle = 0.3;
+  direction[0][0] = std::cos(angle);
+  direction[0][1] = -std::sin(angle);
+  direction[1][0] = std::sin(angle);
+  direction[1][1] = std::cos(angle);
+  image->SetDirection(direction);
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(2468);
+  for (unsigned int object = 0; object < numberOfObjects; ++object)
+  {
+    itk::Vector<double, VDimension> center;
+    itk::Vector<double, VDimension> radius;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      center[d] = region.GetIndex(d) + generator->GetUniformVariate(0.0, size[d]);
+      radius[d] = generator->GetUniformVariate(1.0, size[d] / 4.0);
+    }
+    const auto label = static_cast<short>(object % 7 + 1);
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+    {
+      double distance = 0.0;
+      for (unsigned int d = 0; d < VDimension; ++d)
+      {
+        distance += itk::Math::sqr((it.GetIndex()[d] - center[d]) / radius[d]);
+      }
+      if (distance <= 1.0)
+      {
+        it.Set(label);
+      }
+    }
+  }
+  return image;
+}
+
+template <unsigned int VDimension>
+void
+CompareWithShapeLabelMap(const itk::Size<VDimension> & size, unsigned int numberOfObjects)
+{
+  using ImageType = itk::Image<short, VDimension>;
+  using FilterType = itk::LabelShapeStatisticsImageFilter<ImageType>;
+  using LabelMapFilterType = itk::LabelImageToShapeLabelMapFilter<ImageType>;
+
+  const auto image = CreateLabelImage<VDimension>(size, numberOfObjects);
+
+  auto labelMapFilter = LabelMapFilterType::New();
+  labelMapFilter->SetInput(image);
+  labelMapFilter->SetBackgroundValue(0);
+  labelMapFilter->ComputePerimeterOn();
+  labelMapFilter->ComputeFeretDiameterOn();
+  labelMapFilter->Update();
+  const auto * labelMap = labelMapFilter->GetOutput();
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetBackgroundValue(0);
+  filter->ComputeFeretDiameterOn();
+
+  for (const unsigned int numberOfWorkUnits : { 1, 3 })
+  {
+    for (const unsigned int numberOfStreamDivisions : { 1, 4 })
+    {
+      filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      filter->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+      filter->Modified();
+      filter->Update();
+
+      ASSERT_EQ(filter->GetNumberOfLabels(), labelMap->GetNumberOfLabelObjects());
+      for (const auto label : filter->GetValidLabelValues())
+      {
+        ASSERT_TRUE(labelMap->HasLabel(label));
+        const auto * labelObject = labelMap->GetLabelObject(label);
+        const auto & statistics = filter->GetLabelShapeStatistics(label);
+
+        const double tolerance = 1e-6 * (1.0 + labelObject->GetPhysicalSize());
+        EXPECT_EQ(statistics.m_NumberOfPixels, labelObject->GetNumberOfPixels());
+        EXPECT_NEAR(statistics.m_PhysicalSize, labelObject->GetPhysicalSize(), tolerance);
+        EXPECT_EQ(statistics.m_BoundingBox, labelObject->GetBoundingBox());
+        for (unsigned int d = 0; d < VDimension; ++d)
+        {
+          EXPECT_NEAR(statistics.m_Centroid[d], labelObject->GetCentroid()[d], 1e-6);
+          EXPECT_NEAR(statistics.m_PrincipalMoments[d], labelObject->GetPrincipalMoments()[d], 1e-6);
+        }
+        EXPECT_NEAR(statistics.m_Elongation, labelObject->GetElongation(), 1e-6);
+        EXPECT_NEAR(statistics.m_Flatness, labelObject->GetFlatness(), 1e-6);
+        EXPECT_NEAR(statistics.m_EquivalentSphericalRadius, labelObject->GetEquivalentSphericalRadius(), 1e-6);
+        EXPECT_NEAR(
+          statistics.m_EquivalentSphericalPerimeter, labelObject->GetEquivalentSphericalPerimeter(), tolerance);
+        EXPECT_NEAR(statistics.m_Perimeter, labelObject->GetPerimeter(), tolerance);
+        EXPECT_NEAR(statistics.m_Roundness, labelObject->GetRoundness(), 1e-6);
+        EXPECT_NEAR(statistics.m_FeretDiameter, labelObject->GetFeretDiameter(), 1e-6);
+      }
+    }
+  }
+
+  EXPECT_FALSE(filter->HasLabel(0));
+  EXPECT_THROW(filter->GetLabelShapeStatistics(0), itk::ExceptionObject);
+}
+
+} // namespace
+
+
+TEST(LabelShapeStatisticsImageFilter, BasicObjectProperties)
+{
+  using ImageType = itk::Image<unsigned char, 2>;
+  using FilterType = itk::LabelShapeStatisticsImageFilter<ImageType>;
+  auto filter = FilterType::New();
+
+  EXPECT_STREQ(filter->GetNameOfClass(), "LabelShapeStatisticsImageFilter");
+  filter->Print(std::cout);
+
+  EXPECT_EQ(filter->GetBackgroundValue(), 0);
+  EXPECT_TRUE(filter->GetComputePerimeter());
+  EXPECT_FALSE(filter->GetComputeFeretDiameter());
+
+  filter->ComputePerimeterOff();
+  EXPECT_FALSE(filter->GetComputePerimeter());
+  filter->ComputeFeretDiameterOn();
+  EXPECT_TRUE(filter->GetComputeFeretDiameter());
+}
+
+
+TEST(LabelShapeStatisticsImageFilter, CompareWithShapeLabelMap_2D)
+{
+  CompareWithShapeLabelMap<2>(itk::Size<2>{ { 61, 47 } }, 12);
+}
+
+
+TEST(LabelShapeStatisticsImageFilter, CompareWithShapeLabelMap_3D)
+{
+  CompareWithShapeLabelMap<3>(itk::Size<3>{ { 23, 19, 17 } }, 9);
+}
+
+
+TEST(LabelShapeStatisticsImageFilter, WithoutPerimeter)
+{
+  using ImageType = itk::Image<short, 3>;
+  using FilterType = itk::LabelShapeStatisticsImageFilter<ImageType>;
+
+  const auto image = CreateLabelImage<3>(itk::Size<3>{ { 20, 21, 22 } }, 6);
+
+  // The moments do not need the margin around the streamed regions.
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetBackgroundValue(0);
+  filter->ComputePerimeterOff();
+  filter->SetNumberOfStreamDivisions(5);
+  filter->Update();
+
+  auto reference = FilterType::New();
+  reference->SetInput(image);
+  reference->SetBackgroundValue(0);
+  reference->Update();
+
+  ASSERT_EQ(filter->GetValidLabelValues(), reference->GetValidLabelValues());
+  for (const auto label : filter->GetValidLabelValues())
+  {
+    const auto & statistics = filter->GetLabelShapeStatistics(label);
+    const auto & expected = reference->GetLabelShapeStatistics(label);
+    EXPECT_EQ(statistics.m_NumberOfPixels, expected.m_NumberOfPixels);
+    EXPECT_EQ(statistics.m_BoundingBox, expected.m_BoundingBox);
+    EXPECT_NEAR(statistics.m_Elongation, expected.m_Elongation, 1e-9);
+    EXPECT_EQ(statistics.m_Perimeter, 0.0);
+    EXPECT_GT(expected.m_Perimeter, 0.0);
+  }
+}
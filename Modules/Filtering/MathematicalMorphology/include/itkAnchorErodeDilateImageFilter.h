@@ -79,9 +79,11 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
-  /** Multi-thread version GenerateData. */
+  /** Process the lines of the structuring element decomposition one
+   * after the other, each one in parallel over the lines of the image
+   * it is swept along. */
   void
-  DynamicThreadedGenerateData(const InputImageRegionType & outputRegionForThread) override;
+  GenerateData() override;
 
 
   // should be set by the meta filter
@@ -20,39 +20,43 @@
 
 
 #include "itkAnchorUtilities.h"
+#include "itkImageAlgorithm.h"
+#include "itkTotalProgressReporter.h"
 namespace itk
 {
 template <typename TImage, typename TKernel, typename TFunction1>
 AnchorErodeDilateImageFilter<TImage, TKernel, TFunction1>::AnchorErodeDilateImageFilter()
   : m_Boundary(NumericTraits<InputImagePixelType>::ZeroValue())
-{
-  this->DynamicMultiThreadingOn();
-}
+{}
 
 template <typename TImage, typename TKernel, typename TFunction1>
 void
-AnchorErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThreadedGenerateData(
-  const InputImageRegionType & outputRegionForThread)
+AnchorErodeDilateImageFilter<TImage, TKernel, TFunction1>::GenerateData()
 {
   // check that we are using a decomposable kernel
   if (!this->GetKernel().GetDecomposable())
   {
     itkExceptionMacro("Anchor morphology only works with decomposable structuring elements");
   }
+
+  this->AllocateOutputs();
+
   // TFunction1 will be < for erosions
   // TFunction2 will be <=
 
-  AnchorLineType AnchorLine;
-
   // the initial version will adopt the methodology of loading a line
   // at a time into a buffer vector, carrying out the opening or
   // closing, and then copy the result to the output. Hopefully this
   // will improve cache performance when working along non raster
-  // directions.
+  // directions. The lines swept along a face don't overlap, so the face
+  // is split between the threads, and the whole region is processed at
+  // once: the threads don't need to process overlapping regions padded
+  // by the kernel radius.
 
   InputImageConstPointer input = this->GetInput();
 
-  InputImageRegionType IReg = outputRegionForThread;
+  InputImageRegionType OReg = this->GetOutput()->GetRequestedRegion();
+  InputImageRegionType IReg = OReg;
   IReg.PadByRadius(this->GetKernel().GetRadius());
   IReg.Crop(this->GetInput()->GetRequestedRegion());
 
@@ -62,8 +66,6 @@ AnchorErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThreadedGenera
   internalbuffer->Allocate();
   InputImagePointer output = internalbuffer;
 
-  // get the region size
-  InputImageRegionType OReg = outputRegionForThread;
   // maximum buffer length is sum of dimensions
   unsigned int bufflength = 0;
   for (unsigned i = 0; i < TImage::ImageDimension; ++i)
@@ -74,13 +76,13 @@ AnchorErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThreadedGenera
   // compat
   bufflength += 2;
 
-  std::vector<InputImagePixelType> buffer(bufflength);
-  std::vector<InputImagePixelType> inbuffer(bufflength);
-
   // iterate over all the structuring elements
   typename KernelType::DecompType decomposition = this->GetKernel().GetLines();
   BresType                        BresLine;
 
+  TotalProgressReporter progress(this, decomposition.size() * IReg.GetNumberOfPixels());
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
   for (unsigned i = 0; i < decomposition.size(); ++i)
   {
     typename KernelType::LType     ThisLine = decomposition[i];
@@ -98,22 +100,25 @@ AnchorErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThreadedGenera
 
     InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
 
-    AnchorLine.SetSize(SELength);
+    this->GetMultiThreader()->template ParallelizeImageRegion<InputImageDimension>(
+      BigFace,
+      [&](const InputImageRegionType & face) {
+        AnchorLineType AnchorLine;
+        AnchorLine.SetSize(SELength);
+        std::vector<InputImagePixelType> buffer(bufflength);
+        std::vector<InputImagePixelType> inbuffer(bufflength);
+        DoAnchorFace<TImage, BresType, AnchorLineType, KernelLType>(
+          input, output, m_Boundary, ThisLine, AnchorLine, TheseOffsets, inbuffer, buffer, IReg, face);
+      },
+      nullptr);
 
-    DoAnchorFace<TImage, BresType, AnchorLineType, KernelLType>(
-      input, output, m_Boundary, ThisLine, AnchorLine, TheseOffsets, inbuffer, buffer, IReg, BigFace);
     // after the first pass the input will be taken from the output
     input = internalbuffer;
+    progress.Completed(IReg.GetNumberOfPixels());
   }
 
   // copy internal buffer to output
-  using IterType = ImageRegionIterator<InputImageType>;
-  IterType oit(this->GetOutput(), OReg);
-  IterType iit(internalbuffer, OReg);
-  for (oit.GoToBegin(), iit.GoToBegin(); !oit.IsAtEnd(); ++oit, ++iit)
-  {
-    oit.Set(iit.Get());
-  }
+  ImageAlgorithm::Copy(input.GetPointer(), this->GetOutput(), OReg, OReg);
 }
 
 template <typename TImage, typename TKernel, typename TFunction1>
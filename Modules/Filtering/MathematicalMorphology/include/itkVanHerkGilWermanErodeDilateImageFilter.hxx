@@ -18,7 +18,9 @@
 #ifndef itkVanHerkGilWermanErodeDilateImageFilter_hxx
 #define itkVanHerkGilWermanErodeDilateImageFilter_hxx
 
+#include "itkImageAlgorithm.h"
 #include "itkImageRegionIterator.h"
+#include "itkTotalProgressReporter.h"
 
 #include "itkVanHerkGilWermanUtilities.h"
 
@@ -27,15 +29,11 @@ namespace itk
 template <typename TImage, typename TKernel, typename TFunction1>
 VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::VanHerkGilWermanErodeDilateImageFilter()
   : m_Boundary(NumericTraits<InputImagePixelType>::ZeroValue())
-{
-  this->DynamicMultiThreadingOn();
-  this->ThreaderUpdateProgressOff();
-}
+{}
 
 template <typename TImage, typename TKernel, typename TFunction1>
 void
-VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThreadedGenerateData(
-  const InputImageRegionType & outputRegionForThread)
+VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::GenerateData()
 {
   // check that we are using a decomposable kernel
   if (!this->GetKernel().GetDecomposable())
@@ -43,23 +41,22 @@ VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThre
     itkExceptionMacro("VanHerkGilWerman morphology only works with decomposable structuring elements");
   }
 
+  this->AllocateOutputs();
+
   // TFunction1 will be < for erosions
 
-  // the initial version will adopt the methodology of loading a line
-  // at a time into a buffer vector, carrying out the opening or
-  // closing, and then copy the result to the output. Hopefully this
-  // will improve cache performance when working along non raster
-  // directions.
+  // the lines of the image are loaded in buffers, by bundles of
+  // neighbor lines, the opening or closing is carried out, and the
+  // result is copied to the internal buffer. The lines swept along a
+  // face don't overlap, so the face is split between the threads, and
+  // the whole region is processed at once: the threads don't need to
+  // process overlapping regions padded by the kernel radius.
 
   InputImageConstPointer input = this->GetInput();
 
-  SizeValueType totalPixels =
-    this->GetKernel().GetLines().size() * this->GetOutput()->GetRequestedRegion().GetNumberOfPixels();
-  TotalProgressReporter progress(this, totalPixels);
-
-  InputImageRegionType IReg = outputRegionForThread;
+  InputImageRegionType OReg = this->GetOutput()->GetRequestedRegion();
+  InputImageRegionType IReg = OReg;
   IReg.PadByRadius(this->GetKernel().GetRadius());
-  // IReg.PadByRadius( this->GetKernel().GetRadius() );
   IReg.Crop(this->GetInput()->GetRequestedRegion());
 
   // allocate an internal buffer
@@ -68,8 +65,6 @@ VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThre
   internalbuffer->Allocate();
   InputImagePointer output = internalbuffer;
 
-  // get the region size
-  InputImageRegionType OReg = outputRegionForThread;
   // maximum buffer length is sum of dimensions
   unsigned int bufflength = 0;
   for (unsigned i = 0; i < TImage::ImageDimension; ++i)
@@ -80,15 +75,15 @@ VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThre
   // compat
   bufflength += 2;
 
-  std::vector<InputImagePixelType> buffer(bufflength);
-  std::vector<InputImagePixelType> forward(bufflength);
-  std::vector<InputImagePixelType> reverse(bufflength);
   // iterate over all the structuring elements
   typename KernelType::DecompType decomposition = this->GetKernel().GetLines();
   BresType                        BresLine;
 
   using KernelLType = typename KernelType::LType;
 
+  TotalProgressReporter progress(this, decomposition.size() * IReg.GetNumberOfPixels());
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
   for (unsigned i = 0; i < decomposition.size(); ++i)
   {
     typename KernelType::LType     ThisLine = decomposition[i];
@@ -102,8 +97,13 @@ VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThre
 
     InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
 
-    DoFace<TImage, BresType, TFunction1, KernelLType>(
-      input, output, m_Boundary, ThisLine, TheseOffsets, SELength, buffer, forward, reverse, IReg, BigFace);
+    this->GetMultiThreader()->template ParallelizeImageRegion<InputImageDimension>(
+      BigFace,
+      [&](const InputImageRegionType & face) {
+        DoFace<TImage, BresType, TFunction1, KernelLType>(
+          input, output, m_Boundary, ThisLine, TheseOffsets, SELength, IReg, face);
+      },
+      nullptr);
 
     // after the first pass the input will be taken from the output
     input = internalbuffer;
@@ -45,19 +45,30 @@ FillForwardExt(std::vector<PixelType> & pixbuffer,
                const unsigned int       KernLen,
                unsigned                 len);
 
+/** Compute the erosion or dilation of VBundleSize interleaved lines of
+ * the given size, stored in pixbuffer, by a line of KernLen pixels. The
+ * result is stored in pixbuffer. */
+template <typename PixelType, typename TFunction, unsigned int VBundleSize>
+void
+ComputeBundleExtremes(PixelType *        pixbuffer,
+                      PixelType *        fExtBuffer,
+                      PixelType *        rExtBuffer,
+                      const unsigned int KernLen,
+                      const unsigned int size);
+
+/** Compute the erosion or dilation along the lines starting from the
+ * pixels of a face. The lines of the face are disjoint, so the faces may
+ * be split and processed in parallel, and the output may be the input. */
 template <typename TImage, typename TBres, typename TFunction, typename TLine>
 void
-DoFace(typename TImage::ConstPointer             input,
-       typename TImage::Pointer                  output,
-       typename TImage::PixelType                border,
-       TLine                                     line,
-       const typename TBres::OffsetArray         LineOffsets,
-       const unsigned int                        KernLen,
-       std::vector<typename TImage::PixelType> & pixbuffer,
-       std::vector<typename TImage::PixelType> & fExtBuffer,
-       std::vector<typename TImage::PixelType> & rExtBuffer,
-       const typename TImage::RegionType         AllImage,
-       const typename TImage::RegionType         face);
+DoFace(typename TImage::ConstPointer     input,
+       typename TImage::Pointer          output,
+       typename TImage::PixelType        border,
+       TLine                             line,
+       const typename TBres::OffsetArray LineOffsets,
+       const unsigned int                KernLen,
+       const typename TImage::RegionType AllImage,
+       const typename TImage::RegionType face);
 } // namespace itk
 
 #ifndef ITK_MANUAL_INSTANTIATION
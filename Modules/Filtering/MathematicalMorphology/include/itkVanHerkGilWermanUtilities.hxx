@@ -22,6 +22,9 @@
 #include "itkImageRegionConstIterator.h"
 #include "itkNeighborhoodAlgorithm.h"
 
+#include <algorithm>
+#include <memory>
+
 namespace itk
 {
 /**
@@ -112,20 +115,138 @@ FillReverseExt(std::vector<PixelType> & pixbuffer,
   }
 }
 
+template <typename PixelType, typename TFunction, unsigned int VBundleSize>
+void
+ComputeBundleExtremes(PixelType *        pixbuffer,
+                      PixelType *        fExtBuffer,
+                      PixelType *        rExtBuffer,
+                      const unsigned int KernLen,
+                      const unsigned int size)
+{
+  // The buffers hold VBundleSize interleaved lines: the value at
+  // position i of the line b is at i * VBundleSize + b. The lines are
+  // processed together, so that the innermost loops, over the lines, can
+  // be vectorized.
+  TFunction m_TF;
+
+  // forward extremes, restarted at each block of KernLen pixels
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    const PixelType * p = pixbuffer + i * VBundleSize;
+    PixelType *       f = fExtBuffer + i * VBundleSize;
+    if (i % KernLen == 0)
+    {
+      std::copy(p, p + VBundleSize, f);
+    }
+    else
+    {
+      const PixelType * previous = f - VBundleSize;
+      for (unsigned int b = 0; b < VBundleSize; ++b)
+      {
+        f[b] = m_TF(p[b], previous[b]);
+      }
+    }
+  }
+
+  // reverse extremes, restarted at the end of each block
+  for (unsigned int i = size; i-- > 0;)
+  {
+    const PixelType * p = pixbuffer + i * VBundleSize;
+    PixelType *       r = rExtBuffer + i * VBundleSize;
+    if (i == size - 1 || (i + 1) % KernLen == 0)
+    {
+      std::copy(p, p + VBundleSize, r);
+    }
+    else
+    {
+      const PixelType * next = r + VBundleSize;
+      for (unsigned int b = 0; b < VBundleSize; ++b)
+      {
+        r[b] = m_TF(p[b], next[b]);
+      }
+    }
+  }
+
+  // now compute result
+  const unsigned int half = KernLen / 2;
+  const auto         copyLine = [pixbuffer](unsigned int j, const PixelType * source) {
+    std::copy(source, source + VBundleSize, pixbuffer + j * VBundleSize);
+  };
+  if (size <= half)
+  {
+    for (unsigned int j = 0; j < size; ++j)
+    {
+      copyLine(j, fExtBuffer + (size - 1) * VBundleSize);
+    }
+  }
+  else if (size <= KernLen)
+  {
+    for (unsigned int j = 0; j < size - half; ++j)
+    {
+      copyLine(j, fExtBuffer + (j + half) * VBundleSize);
+    }
+    for (unsigned int j = size - half; j <= half; ++j)
+    {
+      copyLine(j, fExtBuffer + (size - 1) * VBundleSize);
+    }
+    for (unsigned int j = half + 1; j < size; ++j)
+    {
+      copyLine(j, rExtBuffer + (j - half) * VBundleSize);
+    }
+  }
+  else
+  {
+    // line beginning
+    for (unsigned int j = 0; j < half; ++j)
+    {
+      copyLine(j, fExtBuffer + (j + half) * VBundleSize);
+    }
+    for (unsigned int j = half; j < size - half; ++j)
+    {
+      const PixelType * f = fExtBuffer + (j + half) * VBundleSize;
+      const PixelType * r = rExtBuffer + (j - half) * VBundleSize;
+      PixelType *       p = pixbuffer + j * VBundleSize;
+      for (unsigned int b = 0; b < VBundleSize; ++b)
+      {
+        p[b] = m_TF(f[b], r[b]);
+      }
+    }
+    // line end -- involves reseting the end of the reverse
+    // extreme array
+    for (unsigned int j = size - 2; (j > 0) && (j >= (size - KernLen - 1)); j--)
+    {
+      const PixelType * next = rExtBuffer + (j + 1) * VBundleSize;
+      PixelType *       r = rExtBuffer + j * VBundleSize;
+      for (unsigned int b = 0; b < VBundleSize; ++b)
+      {
+        r[b] = m_TF(next[b], r[b]);
+      }
+    }
+    for (unsigned int j = size - half; j < size; ++j)
+    {
+      copyLine(j, rExtBuffer + (j - half) * VBundleSize);
+    }
+  }
+}
+
 template <typename TImage, typename TBres, typename TFunction, typename TLine>
 void
-DoFace(typename TImage::ConstPointer             input,
-       typename TImage::Pointer                  output,
-       typename TImage::PixelType                border,
-       TLine                                     line,
-       const typename TBres::OffsetArray         LineOffsets,
-       const unsigned int                        KernLen,
-       std::vector<typename TImage::PixelType> & pixbuffer,
-       std::vector<typename TImage::PixelType> & fExtBuffer,
-       std::vector<typename TImage::PixelType> & rExtBuffer,
-       const typename TImage::RegionType         AllImage,
-       const typename TImage::RegionType         face)
+DoFace(typename TImage::ConstPointer     input,
+       typename TImage::Pointer          output,
+       typename TImage::PixelType        border,
+       TLine                             line,
+       const typename TBres::OffsetArray LineOffsets,
+       const unsigned int                KernLen,
+       const typename TImage::RegionType AllImage,
+       const typename TImage::RegionType face)
 {
+  using PixelType = typename TImage::PixelType;
+  using IndexType = typename TImage::IndexType;
+
+  // Neighbor lines which intersect the image over the same range of line
+  // offsets are gathered in bundles, processed together.
+  constexpr unsigned int BundleSize = 8;
+
   // iterate over the face
 
   // we can't use an iterator with a region outside the image. All we need here
@@ -145,74 +266,90 @@ DoFace(typename TImage::ConstPointer             input,
   TLine NormLine = line;
   NormLine.Normalize();
   // set a generous tolerance
-  float     tol = 1.0 / LineOffsets.size();
-  TFunction m_TF;
-  for (unsigned int it = 0; it < face.GetNumberOfPixels(); ++it)
+  float tol = 1.0 / LineOffsets.size();
+
+  // offsets of the line pixels in the input and output buffers
+  std::vector<OffsetValueType> inputLineOffsets(LineOffsets.size(), 0);
+  std::vector<OffsetValueType> outputLineOffsets(LineOffsets.size(), 0);
+  const OffsetValueType *      inputOffsetTable = input->GetOffsetTable();
+  const OffsetValueType *      outputOffsetTable = output->GetOffsetTable();
+  for (unsigned int i = 0; i < LineOffsets.size(); ++i)
   {
-    typename TImage::IndexType Ind = dumbImg->ComputeIndex(it);
-    unsigned                   start, end;
-    if (FillLineBuffer<TImage, TBres, TLine>(input, Ind, NormLine, tol, LineOffsets, AllImage, pixbuffer, start, end))
-    {
-      const unsigned len = end - start + 1;
-      // compat
-      pixbuffer[0] = border;
-      pixbuffer[len + 1] = border;
-      FillForwardExt<typename TImage::PixelType, TFunction>(pixbuffer, fExtBuffer, KernLen, len + 2);
-      FillReverseExt<typename TImage::PixelType, TFunction>(pixbuffer, rExtBuffer, KernLen, len + 2);
-      // now compute result
-      unsigned int size = len + 2;
-      if (size <= KernLen / 2)
+    for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+    {
+      inputLineOffsets[i] += LineOffsets[i][d] * inputOffsetTable[d];
+      outputLineOffsets[i] += LineOffsets[i][d] * outputOffsetTable[d];
+    }
+  }
+
+  // the bundle buffers, with room for the border values at both ends. They
+  // are plain arrays because std::vector<bool> has no contiguous storage.
+  const size_t                 bundleBufferLength = (LineOffsets.size() + 2) * BundleSize;
+  std::unique_ptr<PixelType[]> pixbuffer(new PixelType[bundleBufferLength]);
+  std::unique_ptr<PixelType[]> fExtBuffer(new PixelType[bundleBufferLength]);
+  std::unique_ptr<PixelType[]> rExtBuffer(new PixelType[bundleBufferLength]);
+
+  const PixelType * inputBuffer = input->GetBufferPointer();
+  PixelType *       outputBuffer = output->GetBufferPointer();
+  IndexType         bundle[BundleSize];
+  unsigned int      bundleCount = 0;
+  unsigned int      bundleStart = 0;
+  unsigned int      bundleEnd = 0;
+
+  const auto processBundle = [&]() {
+    const unsigned int len = bundleEnd - bundleStart + 1;
+    PixelType *        p = pixbuffer.get();
+    // compat
+    std::fill(p, p + BundleSize, border);
+    std::fill(p + (len + 1) * BundleSize, p + (len + 2) * BundleSize, border);
+    for (unsigned int b = 0; b < bundleCount; ++b)
+    {
+      // start from the first pixel of the line inside the image, so that no
+      // pointer is formed outside of the buffer
+      const PixelType * linePixels = inputBuffer + input->ComputeOffset(bundle[b] + LineOffsets[bundleStart]);
+      for (unsigned int i = 0; i < len; ++i)
       {
-        for (unsigned j = 0; j < size; ++j)
-        {
-          pixbuffer[j] = fExtBuffer[size - 1];
-        }
+        p[(i + 1) * BundleSize + b] = linePixels[inputLineOffsets[bundleStart + i] - inputLineOffsets[bundleStart]];
       }
-      else if (size <= KernLen)
+    }
+    // the unused lines of the bundle are copies of the first one
+    for (unsigned int i = 1; i <= len; ++i)
+    {
+      std::fill(p + i * BundleSize + bundleCount, p + (i + 1) * BundleSize, p[i * BundleSize]);
+    }
+
+    ComputeBundleExtremes<PixelType, TFunction, BundleSize>(p, fExtBuffer.get(), rExtBuffer.get(), KernLen, len + 2);
+
+    for (unsigned int b = 0; b < bundleCount; ++b)
+    {
+      PixelType * linePixels = outputBuffer + output->ComputeOffset(bundle[b] + LineOffsets[bundleStart]);
+      for (unsigned int i = 0; i < len; ++i)
       {
-        for (unsigned j = 0; j < size - KernLen / 2; ++j)
-        {
-          pixbuffer[j] = fExtBuffer[j + KernLen / 2];
-        }
-        for (unsigned j = size - KernLen / 2; j <= KernLen / 2; ++j)
-        {
-          pixbuffer[j] = fExtBuffer[size - 1];
-        }
-        for (unsigned j = KernLen / 2 + 1; j < size; ++j)
-        {
-          pixbuffer[j] = rExtBuffer[j - KernLen / 2];
-        }
+        linePixels[outputLineOffsets[bundleStart + i] - outputLineOffsets[bundleStart]] = p[(i + 1) * BundleSize + b];
       }
-      else
+    }
+    bundleCount = 0;
+  };
+
+  for (unsigned int it = 0; it < face.GetNumberOfPixels(); ++it)
+  {
+    const IndexType Ind = dumbImg->ComputeIndex(it);
+    unsigned int    start, end;
+    if (ComputeStartEnd<TImage, TBres, TLine>(Ind, NormLine, tol, LineOffsets, AllImage, start, end))
+    {
+      if (bundleCount > 0 && (bundleCount == BundleSize || start != bundleStart || end != bundleEnd))
       {
-        // line beginning
-        for (unsigned j = 0; j < KernLen / 2; ++j)
-        {
-          pixbuffer[j] = fExtBuffer[j + KernLen / 2];
-        }
-        for (unsigned j = KernLen / 2, k = KernLen / 2 + KernLen / 2, l = KernLen / 2 - KernLen / 2;
-             j < size - KernLen / 2;
-             j++, k++, l++)
-        {
-
-          typename TImage::PixelType V1 = fExtBuffer[k];
-          typename TImage::PixelType V2 = rExtBuffer[l];
-          pixbuffer[j] = m_TF(V1, V2);
-        }
-        // line end -- involves reseting the end of the reverse
-        // extreme array
-        for (unsigned j = size - 2; (j > 0) && (j >= (size - KernLen - 1)); j--)
-        {
-          rExtBuffer[j] = m_TF(rExtBuffer[j + 1], rExtBuffer[j]);
-        }
-        for (unsigned j = size - KernLen / 2; j < size; ++j)
-        {
-          pixbuffer[j] = rExtBuffer[j - KernLen / 2];
-        }
+        processBundle();
       }
-      CopyLineToImage<TImage, TBres>(output, Ind, LineOffsets, pixbuffer, start, end);
+      bundleStart = start;
+      bundleEnd = end;
+      bundle[bundleCount++] = Ind;
     }
   }
+  if (bundleCount > 0)
+  {
+    processBundle();
+  }
 }
 
 } // namespace itk
@@ -0,0 +1,154 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFlatStructuringElement.h"
+#include "itkGrayscaleDilateImageFilter.h"
+#include "itkGrayscaleErodeImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+// Check that the anchor and van Herk/Gil-Werman algorithms, which
+// process the lines of the image in parallel, give the same results as a
+// reference algorithm run with a single work unit, with several numbers of
+// work units and stream divisions.
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+CreateImage(const typename TImage::SizeType & size)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+  unsigned int value = 1;
+  for (itk::ImageRegionIterator<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    value = (value * 37 + 11) % 251;
+    it.Set(static_cast<typename TImage::PixelType>(value));
+  }
+  return image;
+}
+
+template <typename TFilter>
+bool
+TestAlgorithms(const typename TFilter::InputImageType * image,
+               const typename TFilter::KernelType &     kernel,
+               typename TFilter::AlgorithmEnum          referenceAlgorithm,
+               unsigned int                             maximumNumberOfStreamDivisions,
+               const std::string &                      description)
+{
+  using ImageType = typename TFilter::InputImageType;
+
+  auto reference = TFilter::New();
+  reference->SetInput(image);
+  reference->SetKernel(kernel);
+  reference->SetAlgorithm(referenceAlgorithm);
+  reference->SetNumberOfWorkUnits(1);
+  reference->Update();
+  const ImageType * expected = reference->GetOutput();
+
+  bool success = true;
+  for (const auto algorithm : { TFilter::ANCHOR, TFilter::VHGW })
+  {
+    for (const unsigned int numberOfWorkUnits : { 1, 3 })
+    {
+      for (unsigned int numberOfStreamDivisions = 1; numberOfStreamDivisions <= maximumNumberOfStreamDivisions;
+           numberOfStreamDivisions += 3)
+      {
+        auto filter = TFilter::New();
+        filter->SetInput(image);
+        filter->SetKernel(kernel);
+        filter->SetAlgorithm(algorithm);
+        filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+
+        auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+        streamer->SetInput(filter->GetOutput());
+        streamer->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+        streamer->Update();
+
+        const ImageType * output = streamer->GetOutput();
+        for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(expected, expected->GetBufferedRegion());
+             !it.IsAtEnd();
+             ++it)
+        {
+          if (it.Get() != output->GetPixel(it.GetIndex()))
+          {
+            std::cerr << "Test failed for " << description << " with the " << algorithm << " algorithm, "
+                      << numberOfWorkUnits << " work units and " << numberOfStreamDivisions
+                      << " stream divisions, at index " << it.GetIndex() << ": expected "
+                      << static_cast<int>(it.Get()) << ", got " << static_cast<int>(output->GetPixel(it.GetIndex()))
+                      << std::endl;
+            success = false;
+            break;
+          }
+        }
+      }
+    }
+  }
+  return success;
+}
+
+template <unsigned int VDimension>
+bool
+TestDimension(const itk::Size<VDimension> & imageSize, const itk::Size<VDimension> & radius, unsigned int lines)
+{
+  using ImageType = itk::Image<unsigned char, VDimension>;
+  using KernelType = itk::FlatStructuringElement<VDimension>;
+  using DilateFilterType = itk::GrayscaleDilateImageFilter<ImageType, ImageType, KernelType>;
+  using ErodeFilterType = itk::GrayscaleErodeImageFilter<ImageType, ImageType, KernelType>;
+  constexpr auto BASIC = itk::MathematicalMorphologyEnums::Algorithm::BASIC;
+  constexpr auto ANCHOR = itk::MathematicalMorphologyEnums::Algorithm::ANCHOR;
+
+  const typename ImageType::Pointer image = CreateImage<ImageType>(imageSize);
+
+  const KernelType   box = KernelType::Box(radius);
+  const KernelType   polygon = KernelType::Polygon(radius, lines);
+  std::ostringstream boxDescription;
+  std::ostringstream polygonDescription;
+  boxDescription << VDimension << "-D box of radius " << radius;
+  polygonDescription << VDimension << "-D polygon of radius " << radius << " and " << lines << " lines";
+
+  bool success = true;
+  success &= TestAlgorithms<DilateFilterType>(image, box, BASIC, 4, "dilation by a " + boxDescription.str());
+  success &= TestAlgorithms<ErodeFilterType>(image, box, BASIC, 4, "erosion by a " + boxDescription.str());
+  // The buffer of a polygon, and the padding of the requested region, are
+  // clipped to its radius, while its decomposition in lines is not: the basic
+  // algorithm can't be used as reference, and the output can't be streamed.
+  success &= TestAlgorithms<DilateFilterType>(image, polygon, ANCHOR, 1, "dilation by a " + polygonDescription.str());
+  success &= TestAlgorithms<ErodeFilterType>(image, polygon, ANCHOR, 1, "erosion by a " + polygonDescription.str());
+  return success;
+}
+} // namespace
+
+int
+itkGrayscaleErodeDilateLineAlgorithmsTest(int, char *[])
+{
+  bool success = true;
+  success &= TestDimension<2>({ { 61, 47 } }, { { 5, 3 } }, 4);
+  success &= TestDimension<2>({ { 37, 40 } }, { { 9, 9 } }, 8);
+  success &= TestDimension<3>({ { 23, 19, 17 } }, { { 3, 2, 4 } }, 6);
+
+  if (!success)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -32,7 +32,13 @@ namespace itk
  * the Compute() method to run the algorithm.
  *
  * The thresholds are computed so that the between-class variance is
- * maximized.
+ * maximized. By default, the thresholds are found with dynamic programming:
+ * the criterion is a sum of terms which only depend on the bins of each
+ * class, so the best thresholds can be computed class by class in
+ * O(K L^2) operations for K thresholds and L bins, instead of enumerating
+ * the O(L^K) combinations of thresholds. Both searches find the same
+ * optimum. The exhaustive search can be selected with
+ * SetUseDynamicProgramming(false).
  *
  * This calculator also includes an option to use the valley emphasis algorithm from
  * H.F. Ng, "Automatic thresholding for defect detection", Pattern Recognition Letters, (27): 1644-1649, 2006.
@@ -40,7 +46,10 @@ namespace itk
  * See the following tests for examples:
  * itkOtsuMultipleThresholdsImageFilterTest3 and itkOtsuMultipleThresholdsImageFilterTest4
  * To use this algorithm, simple call the setter: SetValleyEmphasis(true)
- * It is turned off by default.
+ * It is turned off by default. The valley emphasis criterion is the product of
+ * the between-class variance and of a sum over the thresholds, which cannot be
+ * split into terms per class: the thresholds are then always found with the
+ * exhaustive search.
  *
  * \ingroup Calculators
  * \ingroup ITKThresholding
@@ -100,6 +109,11 @@ public:
   itkGetConstReferenceMacro(ReturnBinMidpoint, bool);
   itkBooleanMacro(ReturnBinMidpoint);
 
+  /** Set/Get whether the thresholds are searched with dynamic programming
+   * when the valley emphasis is off. Default is true. */
+  itkSetMacro(UseDynamicProgramming, bool);
+  itkGetConstReferenceMacro(UseDynamicProgramming, bool);
+  itkBooleanMacro(UseDynamicProgramming);
 
 protected:
   OtsuMultipleThresholdsCalculator();
@@ -114,10 +128,21 @@ protected:
                       MeanVectorType &               classMean,
                       FrequencyVectorType &          classFrequency);
 
+  /** Find the thresholds by enumerating all the combinations of thresholds. */
+  void
+  ComputeThresholdsByExhaustiveSearch(InstanceIdentifierVectorType & maxVarThresholdIndexes);
+
+  /** Find the thresholds with dynamic programming. Among equivalent
+   * thresholds, the first ones in the order of the exhaustive search are
+   * returned. */
+  void
+  ComputeThresholdsByDynamicProgramming(InstanceIdentifierVectorType & maxVarThresholdIndexes);
+
 private:
   SizeValueType m_NumberOfThresholds{ 1 };
   OutputType    m_Output;
   bool          m_ValleyEmphasis{ false };
+  bool          m_UseDynamicProgramming{ true };
 #if defined(ITKV4_COMPATIBILITY)
   bool m_ReturnBinMidpoint{ true };
 #else
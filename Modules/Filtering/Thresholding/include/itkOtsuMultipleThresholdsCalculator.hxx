@@ -146,6 +146,39 @@ OtsuMultipleThresholdsCalculator<TInputHistogram>::Compute()
     itkExceptionMacro(<< "Histogram must be 1-dimensional.");
   }
 
+  InstanceIdentifierVectorType maxVarThresholdIndexes;
+  if (m_UseDynamicProgramming && !m_ValleyEmphasis && histogram->GetSize(0) > m_NumberOfThresholds)
+  {
+    this->ComputeThresholdsByDynamicProgramming(maxVarThresholdIndexes);
+  }
+  else
+  {
+    this->ComputeThresholdsByExhaustiveSearch(maxVarThresholdIndexes);
+  }
+
+  // Copy corresponding bin max to threshold vector
+  m_Output.resize(m_NumberOfThresholds);
+
+  for (SizeValueType j = 0; j < m_NumberOfThresholds; ++j)
+  {
+    if (m_ReturnBinMidpoint)
+    {
+      m_Output[j] = histogram->GetMeasurement(maxVarThresholdIndexes[j], 0);
+    }
+    else
+    {
+      m_Output[j] = histogram->GetMaxs()[0][maxVarThresholdIndexes[j]];
+    }
+  }
+}
+
+template <typename TInputHistogram>
+void
+OtsuMultipleThresholdsCalculator<TInputHistogram>::ComputeThresholdsByExhaustiveSearch(
+  InstanceIdentifierVectorType & maxVarThresholdIndexes)
+{
+  typename TInputHistogram::ConstPointer histogram = this->GetInputHistogram();
+
   // Compute global mean
   typename TInputHistogram::ConstIterator iter = histogram->Begin();
   typename TInputHistogram::ConstIterator end = histogram->End();
@@ -170,7 +203,7 @@ OtsuMultipleThresholdsCalculator<TInputHistogram>::Compute()
     thresholdIndexes[j] = j;
   }
 
-  InstanceIdentifierVectorType maxVarThresholdIndexes = thresholdIndexes;
+  maxVarThresholdIndexes = thresholdIndexes;
 
   // Compute frequency and mean of initial classes
   FrequencyType       freqSum = NumericTraits<FrequencyType>::ZeroValue();
@@ -313,19 +346,99 @@ OtsuMultipleThresholdsCalculator<TInputHistogram>::Compute()
       maxVarThresholdIndexes = thresholdIndexes;
     }
   }
+}
 
-  // Copy corresponding bin max to threshold vector
-  m_Output.resize(m_NumberOfThresholds);
+template <typename TInputHistogram>
+void
+OtsuMultipleThresholdsCalculator<TInputHistogram>::ComputeThresholdsByDynamicProgramming(
+  InstanceIdentifierVectorType & maxVarThresholdIndexes)
+{
+  typename TInputHistogram::ConstPointer histogram = this->GetInputHistogram();
 
-  for (j = 0; j < m_NumberOfThresholds; ++j)
+  const SizeValueType histSize = histogram->GetSize(0);
+  const SizeValueType numberOfThresholds = m_NumberOfThresholds;
+
+  // Cumulated frequencies and moments of the bins, to compute the term
+  // \omega_k \mu_k^2 of a class of bins in constant time.
+  std::vector<MeanType> cumulatedFrequency(histSize + 1, NumericTraits<MeanType>::ZeroValue());
+  std::vector<MeanType> cumulatedMoment(histSize + 1, NumericTraits<MeanType>::ZeroValue());
+  for (SizeValueType j = 0; j < histSize; ++j)
   {
-    if (m_ReturnBinMidpoint)
+    const auto frequency = static_cast<MeanType>(histogram->GetFrequency(j));
+    cumulatedFrequency[j + 1] = cumulatedFrequency[j] + frequency;
+    cumulatedMoment[j + 1] =
+      cumulatedMoment[j] + static_cast<MeanType>(histogram->GetMeasurementVector(j)[0]) * frequency;
+  }
+
+  // the class made of the bins first to last
+  const auto classVariance = [&cumulatedFrequency, &cumulatedMoment](SizeValueType first, SizeValueType last) {
+    const MeanType frequency = cumulatedFrequency[last + 1] - cumulatedFrequency[first];
+    const MeanType moment = cumulatedMoment[last + 1] - cumulatedMoment[first];
+    return frequency > NumericTraits<MeanType>::ZeroValue() ? static_cast<VarianceType>(moment * moment / frequency)
+                                                            : NumericTraits<VarianceType>::ZeroValue();
+  };
+
+  // The threshold j is in [j, histSize - 1 - numberOfThresholds + j], as in
+  // the exhaustive search. bestVariance[j][t] is the largest sum of the terms
+  // of the classes above the threshold j when it is at the bin t, and
+  // bestNextThreshold[j][t] the position of the threshold j + 1 which gives
+  // it, the lowest one in case of equality.
+  const SizeValueType                       numberOfPositions = histSize - numberOfThresholds;
+  std::vector<std::vector<VarianceType>>    bestVariance(numberOfThresholds);
+  std::vector<InstanceIdentifierVectorType> bestNextThreshold(numberOfThresholds);
+
+  bestVariance[numberOfThresholds - 1].resize(numberOfPositions);
+  for (SizeValueType p = 0; p < numberOfPositions; ++p)
+  {
+    const SizeValueType t = numberOfThresholds - 1 + p;
+    bestVariance[numberOfThresholds - 1][p] = classVariance(t + 1, histSize - 1);
+  }
+
+  for (SizeValueType j = numberOfThresholds - 1; j > 0; --j)
+  {
+    // the threshold j - 1 at the position p is at the bin j - 1 + p, and the
+    // threshold j at the position q >= p at the bin j + q
+    bestVariance[j - 1].resize(numberOfPositions);
+    bestNextThreshold[j - 1].resize(numberOfPositions);
+    for (SizeValueType p = 0; p < numberOfPositions; ++p)
     {
-      m_Output[j] = histogram->GetMeasurement(maxVarThresholdIndexes[j], 0);
+      const SizeValueType t = j - 1 + p;
+      VarianceType        best = NumericTraits<VarianceType>::NonpositiveMin();
+      SizeValueType       bestPosition = p;
+      for (SizeValueType q = p; q < numberOfPositions; ++q)
+      {
+        const VarianceType variance = classVariance(t + 1, j + q) + bestVariance[j][q];
+        if (variance > best)
+        {
+          best = variance;
+          bestPosition = q;
+        }
+      }
+      bestVariance[j - 1][p] = best;
+      bestNextThreshold[j - 1][p] = bestPosition;
     }
-    else
+  }
+
+  // the first threshold, then the following ones from the best positions
+  VarianceType  best = NumericTraits<VarianceType>::NonpositiveMin();
+  SizeValueType position = 0;
+  for (SizeValueType p = 0; p < numberOfPositions; ++p)
+  {
+    const VarianceType variance = classVariance(0, p) + bestVariance[0][p];
+    if (variance > best)
     {
-      m_Output[j] = histogram->GetMaxs()[0][maxVarThresholdIndexes[j]];
+      best = variance;
+      position = p;
+    }
+  }
+
+  maxVarThresholdIndexes.resize(numberOfThresholds);
+  for (SizeValueType j = 0; j < numberOfThresholds; ++j)
+  {
+    maxVarThresholdIndexes[j] = j + position;
+    if (j + 1 < numberOfThresholds)
+    {
+      position = bestNextThreshold[j][position];
     }
   }
 }
@@ -344,6 +457,7 @@ OtsuMultipleThresholdsCalculator<TInputHistogram>::PrintSelf(std::ostream & os,
     os << m_Output[j] << " ";
   }
   os << std::endl;
+  os << indent << "UseDynamicProgramming: " << m_UseDynamicProgramming << std::endl;
 }
 } // end namespace itk
 
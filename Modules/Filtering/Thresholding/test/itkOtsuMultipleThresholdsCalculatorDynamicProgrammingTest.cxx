@@ -0,0 +1,110 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkOtsuMultipleThresholdsCalculator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+// Compare the thresholds found by OtsuMultipleThresholdsCalculator with
+// dynamic programming and with the exhaustive search, on random histograms
+// with empty bins, then run the dynamic programming on a large histogram.
+
+namespace
+{
+using HistogramType = itk::Statistics::Histogram<float>;
+using CalculatorType = itk::OtsuMultipleThresholdsCalculator<HistogramType>;
+
+HistogramType::Pointer
+CreateRandomHistogram(unsigned int numberOfBins, unsigned int seed)
+{
+  auto histogram = HistogramType::New();
+  histogram->SetMeasurementVectorSize(1);
+  HistogramType::SizeType              size(1);
+  HistogramType::MeasurementVectorType lowerBound(1);
+  HistogramType::MeasurementVectorType upperBound(1);
+  size.Fill(numberOfBins);
+  lowerBound.Fill(-100.0);
+  upperBound.Fill(300.0);
+  histogram->Initialize(size, lowerBound, upperBound);
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(seed);
+  for (unsigned int bin = 0; bin < numberOfBins; ++bin)
+  {
+    if (generator->GetUniformVariate(0.0, 1.0) > 0.2)
+    {
+      histogram->SetFrequency(bin, generator->GetIntegerVariate(1000));
+    }
+  }
+  return histogram;
+}
+} // namespace
+
+int
+itkOtsuMultipleThresholdsCalculatorDynamicProgrammingTest(int, char *[])
+{
+  auto calculator = CalculatorType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(calculator, OtsuMultipleThresholdsCalculator, HistogramAlgorithmBase);
+
+  ITK_TEST_EXPECT_TRUE(calculator->GetUseDynamicProgramming());
+
+  for (unsigned int seed = 1; seed <= 5; ++seed)
+  {
+    const auto histogram = CreateRandomHistogram(40, seed);
+    calculator->SetInputHistogram(histogram);
+
+    for (unsigned int numberOfThresholds = 1; numberOfThresholds <= 4; ++numberOfThresholds)
+    {
+      calculator->SetNumberOfThresholds(numberOfThresholds);
+
+      ITK_TEST_SET_GET_BOOLEAN(calculator, UseDynamicProgramming, false);
+      ITK_TRY_EXPECT_NO_EXCEPTION(calculator->Compute());
+      const CalculatorType::OutputType expected = calculator->GetOutput();
+
+      ITK_TEST_SET_GET_BOOLEAN(calculator, UseDynamicProgramming, true);
+      ITK_TRY_EXPECT_NO_EXCEPTION(calculator->Compute());
+      const CalculatorType::OutputType thresholds = calculator->GetOutput();
+
+      if (thresholds != expected)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Wrong thresholds with " << numberOfThresholds << " thresholds for the histogram " << seed
+                  << ":";
+        for (unsigned int j = 0; j < numberOfThresholds; ++j)
+        {
+          std::cerr << " " << thresholds[j] << " instead of " << expected[j];
+        }
+        std::cerr << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // many classes on a large histogram
+  calculator->SetInputHistogram(CreateRandomHistogram(4096, 11));
+  calculator->SetNumberOfThresholds(7);
+  ITK_TRY_EXPECT_NO_EXCEPTION(calculator->Compute());
+  const CalculatorType::OutputType thresholds = calculator->GetOutput();
+  for (unsigned int j = 1; j < thresholds.size(); ++j)
+  {
+    ITK_TEST_EXPECT_TRUE(thresholds[j - 1] < thresholds[j]);
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
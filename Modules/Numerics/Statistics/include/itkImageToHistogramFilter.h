@@ -19,6 +19,7 @@
 #define itkImageToHistogramFilter_h
 
 #include <mutex>
+#include <vector>
 
 #include "itkHistogram.h"
 #include "itkImageSink.h"
@@ -43,6 +44,12 @@ namespace Statistics
  * regions. A histogram is computed for each streamed and threaded
  * region then merged.
  *
+ * The bins of the histogram are uniform: the bin of each component of a
+ * pixel is computed arithmetically from the bounds of the histogram rather
+ * than searched with Histogram::GetIndex, and the frequencies of each work
+ * unit are accumulated in a flat array which is added to the output
+ * histogram at the end of the update.
+ *
  * \ingroup ITKStatistics
  */
 
@@ -76,6 +83,8 @@ public:
   using HistogramSizeType = typename HistogramType::SizeType;
   using HistogramMeasurementType = typename HistogramType::MeasurementType;
   using HistogramMeasurementVectorType = typename HistogramType::MeasurementVectorType;
+  using HistogramInstanceIdentifier = typename HistogramType::InstanceIdentifier;
+  using HistogramFrequencyType = typename HistogramType::AbsoluteFrequencyType;
 
 public:
   /** Return the output histogram. */
@@ -173,9 +182,32 @@ protected:
   virtual void
   ThreadedMergeHistogram(HistogramPointer && histogram);
 
+  /** Type of the flat arrays of frequencies, indexed by the instance
+   * identifiers of the output histogram. */
+  using FrequencyArrayType = std::vector<HistogramFrequencyType>;
+
+  /** Return the instance identifier of the bin of a pixel in the output
+   * histogram, or the number of bins of the histogram when the pixel is
+   * outside of the clipped histogram. */
+  HistogramInstanceIdentifier
+  GetPixelBin(const PixelType & pixel) const;
+
+  /** Return the number of bins of the output histogram. */
+  HistogramInstanceIdentifier
+  GetNumberOfBins() const
+  {
+    return m_NumberOfBins;
+  }
+
+  /** Add the frequencies computed by a work unit to the frequencies of the
+   * output histogram. */
+  void
+  ThreadedMergeFrequencies(FrequencyArrayType && frequencies);
+
   std::mutex m_Mutex;
 
-  HistogramPointer m_MergeHistogram;
+  HistogramPointer   m_MergeHistogram;
+  FrequencyArrayType m_MergeFrequencies;
 
   HistogramMeasurementVectorType m_Minimum;
   HistogramMeasurementVectorType m_Maximum;
@@ -185,6 +217,19 @@ private:
   ApplyMarginalScale(HistogramMeasurementVectorType & min,
                      HistogramMeasurementVectorType & max,
                      HistogramSizeType &              size);
+
+  /** Copy the bins of the output histogram used by GetPixelBin(). */
+  void
+  InitializeBins();
+
+  using BinBoundsType = std::vector<std::vector<HistogramMeasurementType>>;
+
+  BinBoundsType                            m_BinMinimums;
+  BinBoundsType                            m_BinMaximums;
+  std::vector<double>                      m_BinScales;
+  std::vector<HistogramInstanceIdentifier> m_BinOffsets;
+  HistogramInstanceIdentifier              m_NumberOfBins{ 0 };
+  bool                                     m_ClipBinsAtEnds{ true };
 };
 } // end of namespace Statistics
 } // end of namespace itk
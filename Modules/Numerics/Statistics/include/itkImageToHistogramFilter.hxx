@@ -19,6 +19,8 @@
 #define itkImageToHistogramFilter_hxx
 
 #include "itkImageRegionConstIterator.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include <cmath>
 
 namespace itk
 {
@@ -178,6 +180,97 @@ ImageToHistogramFilter<TImage>::InitializeOutputHistogram()
 
   outputHistogram->SetMeasurementVectorSize(nbOfComponents);
   outputHistogram->Initialize(size, m_Minimum, m_Maximum);
+
+  this->InitializeBins();
+  m_MergeFrequencies.clear();
+}
+
+
+template <typename TImage>
+void
+ImageToHistogramFilter<TImage>::InitializeBins()
+{
+  const HistogramType * outputHistogram = this->GetOutput();
+  const unsigned int    nbOfComponents = outputHistogram->GetMeasurementVectorSize();
+
+  m_BinMinimums = outputHistogram->GetMins();
+  m_BinMaximums = outputHistogram->GetMaxs();
+  m_BinScales.assign(nbOfComponents, 0.0);
+  m_BinOffsets.assign(nbOfComponents, 0);
+  m_ClipBinsAtEnds = outputHistogram->GetClipBinsAtEnds();
+  m_NumberOfBins = outputHistogram->Size();
+
+  HistogramInstanceIdentifier offset = 1;
+  for (unsigned int i = 0; i < nbOfComponents; ++i)
+  {
+    const SizeValueType size = outputHistogram->GetSize(i);
+    if (size > 0)
+    {
+      const double range = static_cast<double>(m_BinMaximums[i].back()) - static_cast<double>(m_BinMinimums[i][0]);
+      if (range > 0.0)
+      {
+        m_BinScales[i] = size / range;
+      }
+    }
+    m_BinOffsets[i] = offset;
+    offset *= size;
+  }
+}
+
+
+template <typename TImage>
+inline auto
+ImageToHistogramFilter<TImage>::GetPixelBin(const PixelType & pixel) const -> HistogramInstanceIdentifier
+{
+  // same bins as Histogram::GetIndex(), which searches the bins
+  HistogramInstanceIdentifier bin = 0;
+  for (unsigned int i = 0; i < m_BinOffsets.size(); ++i)
+  {
+    const auto value =
+      static_cast<HistogramMeasurementType>(DefaultConvertPixelTraits<PixelType>::GetNthComponent(i, pixel));
+    const std::vector<HistogramMeasurementType> & minimums = m_BinMinimums[i];
+    const std::vector<HistogramMeasurementType> & maximums = m_BinMaximums[i];
+    const auto                                    last = static_cast<IndexValueType>(minimums.size()) - 1;
+
+    IndexValueType index;
+    if (value < minimums[0])
+    {
+      if (m_ClipBinsAtEnds)
+      {
+        return m_NumberOfBins;
+      }
+      index = 0;
+    }
+    else if (value >= maximums[last])
+    {
+      if (m_ClipBinsAtEnds && !Math::AlmostEquals(value, maximums[last]))
+      {
+        return m_NumberOfBins;
+      }
+      index = last;
+    }
+    else if (std::isnan(static_cast<double>(value)))
+    {
+      // the first bin tested by the search of Histogram::GetIndex()
+      index = (last + 1) / 2;
+    }
+    else
+    {
+      // the estimated bin may be off by one because of the rounding of the
+      // bounds of the bins
+      index = std::min(static_cast<IndexValueType>((value - minimums[0]) * m_BinScales[i]), last);
+      while (value < minimums[index])
+      {
+        --index;
+      }
+      while (value >= maximums[index])
+      {
+        ++index;
+      }
+    }
+    bin += static_cast<HistogramInstanceIdentifier>(index) * m_BinOffsets[i];
+  }
+  return bin;
 }
 
 
@@ -188,8 +281,20 @@ ImageToHistogramFilter<TImage>::AfterStreamedGenerateData()
   Superclass::AfterStreamedGenerateData();
 
   HistogramType * outputHistogram = this->GetOutput();
-  outputHistogram->Graft(m_MergeHistogram);
-  m_MergeHistogram = nullptr;
+  if (m_MergeHistogram.IsNotNull())
+  {
+    outputHistogram->Graft(m_MergeHistogram);
+    m_MergeHistogram = nullptr;
+  }
+
+  for (HistogramInstanceIdentifier bin = 0; bin < m_MergeFrequencies.size(); ++bin)
+  {
+    if (m_MergeFrequencies[bin] != 0)
+    {
+      outputHistogram->IncreaseFrequency(bin, m_MergeFrequencies[bin]);
+    }
+  }
+  m_MergeFrequencies = FrequencyArrayType();
 }
 
 
@@ -231,30 +336,49 @@ template <typename TImage>
 void
 ImageToHistogramFilter<TImage>::ThreadedStreamedGenerateData(const RegionType & inputRegionForThread)
 {
-  const unsigned int    nbOfComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
-  const HistogramType * outputHistogram = this->GetOutput();
-
-  HistogramPointer histogram = HistogramType::New();
-  histogram->SetClipBinsAtEnds(outputHistogram->GetClipBinsAtEnds());
-  histogram->SetMeasurementVectorSize(nbOfComponents);
-  histogram->Initialize(outputHistogram->GetSize(), m_Minimum, m_Maximum);
-
+  const HistogramInstanceIdentifier numberOfBins = this->GetNumberOfBins();
+  FrequencyArrayType                frequencies(numberOfBins);
 
   ImageRegionConstIterator<TImage> inputIt(this->GetInput(), inputRegionForThread);
   inputIt.GoToBegin();
-  HistogramMeasurementVectorType m(nbOfComponents);
-
-  typename HistogramType::IndexType index;
   while (!inputIt.IsAtEnd())
   {
-    const PixelType & p = inputIt.Get();
-    NumericTraits<PixelType>::AssignToArray(p, m);
-    histogram->GetIndex(m, index);
-    histogram->IncreaseFrequencyOfIndex(index, 1);
+    const HistogramInstanceIdentifier bin = this->GetPixelBin(inputIt.Get());
+    if (bin < numberOfBins)
+    {
+      ++frequencies[bin];
+    }
     ++inputIt;
   }
 
-  this->ThreadedMergeHistogram(std::move(histogram));
+  this->ThreadedMergeFrequencies(std::move(frequencies));
+}
+
+template <typename TImage>
+void
+ImageToHistogramFilter<TImage>::ThreadedMergeFrequencies(FrequencyArrayType && frequencies)
+{
+  while (true)
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    if (m_MergeFrequencies.empty())
+    {
+      m_MergeFrequencies = std::move(frequencies);
+      return;
+    }
+
+    // take ownership of the current frequencies, and allow the other threads
+    // to merge data while they are added to the local frequencies
+    FrequencyArrayType toMergeFrequencies;
+    swap(m_MergeFrequencies, toMergeFrequencies);
+    lock.unlock();
+
+    for (HistogramInstanceIdentifier bin = 0; bin < frequencies.size(); ++bin)
+    {
+      frequencies[bin] += toMergeFrequencies[bin];
+    }
+  }
 }
 
 template <typename TImage>
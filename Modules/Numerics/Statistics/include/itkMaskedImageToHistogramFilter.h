@@ -72,6 +72,8 @@ public:
   using HistogramSizeType = typename HistogramType::SizeType;
   using HistogramMeasurementType = typename HistogramType::MeasurementType;
   using HistogramMeasurementVectorType = typename HistogramType::MeasurementVectorType;
+  using HistogramInstanceIdentifier = typename Superclass::HistogramInstanceIdentifier;
+  using FrequencyArrayType = typename Superclass::FrequencyArrayType;
 
   using MaskImageType = TMaskImage;
   using MaskPixelType = typename MaskImageType::PixelType;
@@ -78,37 +78,30 @@ template <typename TImage, typename TMaskImage>
 void
 MaskedImageToHistogramFilter<TImage, TMaskImage>::ThreadedStreamedGenerateData(const RegionType & inputRegionForThread)
 {
-  const unsigned int    nbOfComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
-  const HistogramType * outputHistogram = this->GetOutput();
-
-  HistogramPointer histogram = HistogramType::New();
-  histogram->SetClipBinsAtEnds(outputHistogram->GetClipBinsAtEnds());
-  histogram->SetMeasurementVectorSize(nbOfComponents);
-  histogram->Initialize(outputHistogram->GetSize(), this->m_Minimum, this->m_Maximum);
+  const HistogramInstanceIdentifier numberOfBins = this->GetNumberOfBins();
+  FrequencyArrayType                frequencies(numberOfBins);
 
   ImageRegionConstIterator<TImage>     inputIt(this->GetInput(), inputRegionForThread);
   ImageRegionConstIterator<TMaskImage> maskIt(this->GetMaskImage(), inputRegionForThread);
   inputIt.GoToBegin();
   maskIt.GoToBegin();
-  HistogramMeasurementVectorType m(nbOfComponents);
-  MaskPixelType                  maskValue = this->GetMaskValue();
+  const MaskPixelType maskValue = this->GetMaskValue();
 
-  typename HistogramType::IndexType index;
   while (!inputIt.IsAtEnd())
   {
     if (maskIt.Get() == maskValue)
     {
-      const PixelType & p = inputIt.Get();
-      NumericTraits<PixelType>::AssignToArray(p, m);
-      histogram->GetIndex(m, index);
-      histogram->IncreaseFrequencyOfIndex(index, 1);
+      const HistogramInstanceIdentifier bin = this->GetPixelBin(inputIt.Get());
+      if (bin < numberOfBins)
+      {
+        ++frequencies[bin];
+      }
     }
     ++inputIt;
     ++maskIt;
   }
 
-
-  this->ThreadedMergeHistogram(std::move(histogram));
+  this->ThreadedMergeFrequencies(std::move(frequencies));
 }
 
 } // end of namespace Statistics
@@ -0,0 +1,227 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageToHistogramFilter.h"
+#include "itkMaskedImageToHistogramFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkRGBPixel.h"
+#include "itkVectorImage.h"
+#include "itkTestingMacros.h"
+
+// Compare the frequencies computed by ImageToHistogramFilter and
+// MaskedImageToHistogramFilter with the bins found by Histogram::GetIndex,
+// for scalar and vector images, with and without clipping of the bins, with
+// several work units and stream divisions.
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+CreateRandomImage(double minimum, double maximum)
+{
+  using PixelType = typename TImage::PixelType;
+  using ComponentType = typename itk::NumericTraits<PixelType>::ValueType;
+
+  typename TImage::RegionType region;
+  region.SetSize({ { 41, 19 } });
+  region.SetIndex({ { -5, 3 } });
+  auto image = TImage::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(3);
+  image->Allocate();
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(8642);
+  const unsigned int nbOfComponents = image->GetNumberOfComponentsPerPixel();
+  PixelType          pixel;
+  itk::NumericTraits<PixelType>::SetLength(pixel, nbOfComponents);
+  for (itk::ImageRegionIterator<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    for (unsigned int i = 0; i < nbOfComponents; ++i)
+    {
+      itk::DefaultConvertPixelTraits<PixelType>::SetNthComponent(
+        i, pixel, static_cast<ComponentType>(generator->GetUniformVariate(minimum, maximum)));
+    }
+    it.Set(pixel);
+  }
+  return image;
+}
+
+template <typename TFilter>
+int
+CompareWithHistogramIndex(TFilter *                                     filter,
+                          const typename TFilter::ImageType *           image,
+                          const itk::Image<unsigned char, 2> *          mask,
+                          const std::string &                           name)
+{
+  using ImageType = typename TFilter::ImageType;
+  using PixelType = typename ImageType::PixelType;
+  using HistogramType = typename TFilter::HistogramType;
+
+  for (const unsigned int numberOfWorkUnits : { 1, 4 })
+  {
+    for (const unsigned int numberOfStreamDivisions : { 1, 3 })
+    {
+      filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      filter->SetNumberOfStreamDivisions(numberOfStreamDivisions);
+      ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+      const HistogramType * histogram = filter->GetOutput();
+
+      // the same bins, filled with Histogram::GetIndex
+      auto expected = HistogramType::New();
+      expected->SetMeasurementVectorSize(histogram->GetMeasurementVectorSize());
+      expected->Initialize(histogram->GetSize());
+      for (unsigned int i = 0; i < histogram->GetMeasurementVectorSize(); ++i)
+      {
+        for (unsigned int bin = 0; bin < histogram->GetSize(i); ++bin)
+        {
+          expected->SetBinMin(i, bin, histogram->GetBinMin(i, bin));
+          expected->SetBinMax(i, bin, histogram->GetBinMax(i, bin));
+        }
+      }
+      expected->SetClipBinsAtEnds(histogram->GetClipBinsAtEnds());
+
+      typename HistogramType::MeasurementVectorType measurement(histogram->GetMeasurementVectorSize());
+      typename HistogramType::IndexType             index;
+      for (itk::ImageRegionConstIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+      {
+        if (mask && mask->GetPixel(it.GetIndex()) != 255)
+        {
+          continue;
+        }
+        itk::NumericTraits<PixelType>::AssignToArray(it.Get(), measurement);
+        if (expected->GetIndex(measurement, index))
+        {
+          expected->IncreaseFrequencyOfIndex(index, 1);
+        }
+      }
+
+      bool valid = histogram->Size() == expected->Size() && histogram->GetTotalFrequency() > 0;
+      for (unsigned int bin = 0; valid && bin < histogram->Size(); ++bin)
+      {
+        valid = histogram->GetFrequency(bin) == expected->GetFrequency(bin);
+      }
+      if (!valid)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Wrong frequencies for " << name << " with " << numberOfWorkUnits << " work units and "
+                  << numberOfStreamDivisions << " stream divisions" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+template <typename TImage>
+int
+TestBins(double minimum, double maximum, const std::string & name)
+{
+  using FilterType = itk::Statistics::ImageToHistogramFilter<TImage>;
+  using MaskType = itk::Image<unsigned char, 2>;
+  using MaskedFilterType = itk::Statistics::MaskedImageToHistogramFilter<TImage, MaskType>;
+
+  const auto         image = CreateRandomImage<TImage>(minimum, maximum);
+  const unsigned int nbOfComponents = image->GetNumberOfComponentsPerPixel();
+
+  typename FilterType::HistogramSizeType size(nbOfComponents);
+  size.Fill(nbOfComponents == 1 ? 37 : 5);
+
+  // the default bins
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  if (CompareWithHistogramIndex(filter.GetPointer(), image.GetPointer(), nullptr, name + " (default)") ==
+      EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // bins computed from the extrema of the image
+  filter->SetHistogramSize(size);
+  filter->AutoMinimumMaximumOn();
+  if (CompareWithHistogramIndex(filter.GetPointer(), image.GetPointer(), nullptr, name + " (auto)") == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // bins covering a part of the values, which are clipped
+  typename FilterType::HistogramMeasurementVectorType binMinimum(nbOfComponents);
+  typename FilterType::HistogramMeasurementVectorType binMaximum(nbOfComponents);
+  binMinimum.Fill(minimum + 0.25 * (maximum - minimum));
+  binMaximum.Fill(maximum - 0.3 * (maximum - minimum));
+  filter->AutoMinimumMaximumOff();
+  filter->SetHistogramBinMinimum(binMinimum);
+  filter->SetHistogramBinMaximum(binMaximum);
+  if (CompareWithHistogramIndex(filter.GetPointer(), image.GetPointer(), nullptr, name + " (clipped)") ==
+      EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  auto mask = MaskType::New();
+  mask->SetRegions(image->GetLargestPossibleRegion());
+  mask->Allocate();
+  unsigned int count = 0;
+  for (itk::ImageRegionIterator<MaskType> it(mask, mask->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(++count % 3 == 0 ? 0 : 255);
+  }
+
+  auto maskedFilter = MaskedFilterType::New();
+  maskedFilter->SetInput(image);
+  maskedFilter->SetMaskImage(mask);
+  maskedFilter->SetMaskValue(255);
+  maskedFilter->SetHistogramSize(size);
+  maskedFilter->AutoMinimumMaximumOn();
+  if (CompareWithHistogramIndex(maskedFilter.GetPointer(), image.GetPointer(), mask.GetPointer(), name + " (masked)") ==
+      EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkImageToHistogramFilterBinsTest(int, char *[])
+{
+  if (TestBins<itk::Image<unsigned char, 2>>(0.0, 256.0, "unsigned char") == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  if (TestBins<itk::Image<short, 2>>(-3000.0, 3000.0, "short") == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  if (TestBins<itk::Image<float, 2>>(-1.0, 2.5, "float") == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  if (TestBins<itk::Image<itk::RGBPixel<unsigned char>, 2>>(0.0, 256.0, "RGB") == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  if (TestBins<itk::VectorImage<double, 2>>(-10.0, 10.0, "vector") == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
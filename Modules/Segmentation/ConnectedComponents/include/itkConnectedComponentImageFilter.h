@@ -41,11 +41,18 @@ namespace itk
  * component image filter which did not produce consecutive labels or
  * impose any particular ordering.
  *
+ * The runs of each line are extracted in parallel by blocks of lines. The
+ * runs of a block are labeled and merged with a union-find local to the
+ * block, then the blocks are merged with their neighbors across their borders
+ * with a lock-free union-find, and the equivalences are flattened and
+ * relabeled consecutively block by block. The union always keeps the
+ * smallest label as the representative of a set, so that the labels do not
+ * depend on the number of blocks.
+ *
  * After the filter is executed, ObjectCount holds the number of connected components.
  *
  * \sa ImageToImageFilter
  *
- * \ingroup SingleThreaded
  * \ingroup ITKConnectedComponents
  *
  * \sphinx
@@ -196,10 +203,50 @@ protected:
   using ConsecutiveVectorType = typename ScanlineFunctions::ConsecutiveVectorType;
   using WorkUnitData = typename ScanlineFunctions::WorkUnitData;
 
+  /** Label the runs of a block of lines, and merge them with the runs of the
+   * previous lines of the same block. */
+  void
+  LabelBlock(SizeValueType blockIndex);
+
+  /** Merge the runs of the first lines of a block with the runs of the
+   * previous blocks. */
+  void
+  MergeBlockBorder(SizeValueType blockIndex);
+
+  /** Flatten the equivalences of the labels of a block, and count its
+   * objects. */
+  void
+  FlattenBlock(SizeValueType blockIndex);
+
+  /** Assign the consecutive output values to the objects of a block. */
+  void
+  RelabelBlock(SizeValueType blockIndex);
+
 private:
+  using AtomicUnionFindType = std::vector<std::atomic<InternalLabelType>>;
+
+  /** Representative of the set of a label, halving the path to it. */
+  InternalLabelType
+  FindRoot(InternalLabelType label);
+
+  /** Lock-free union of the sets of two labels, keeping the smallest one. */
+  void
+  MergeLabels(InternalLabelType label1, InternalLabelType label2);
+
+  /** Merge the runs of a line with the runs of its previous neighbor lines
+   * which are before, or from, a given line. */
+  void
+  MergeLine(SizeValueType lineIndex, bool previousBlocks, SizeValueType blockFirstLine);
+
   OutputPixelType m_BackgroundValue = NumericTraits<OutputPixelType>::ZeroValue();
   LabelType       m_ObjectCount = 0;
 
+  // The first label and first object of each block, and the parents of the
+  // labels
+  std::vector<InternalLabelType> m_BlockFirstLabel;
+  std::vector<SizeValueType>     m_BlockFirstObject;
+  AtomicUnionFindType            m_LabelParents;
+
   typename TInputImage::ConstPointer m_Input;
 };
 } // end namespace itk
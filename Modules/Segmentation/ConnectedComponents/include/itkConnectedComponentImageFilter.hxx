@@ -26,6 +26,8 @@
 #include "itkConnectedComponentAlgorithm.h"
 #include "itkProgressTransformer.h"
 
+#include <algorithm>
+
 namespace itk
 {
 template <typename TInputImage, typename TOutputImage, typename TMaskImage>
@@ -111,29 +113,48 @@ ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::GenerateDa
     [this](const RegionType & lambdaRegion) { this->DynamicThreadedGenerateData(lambdaRegion); },
     progress1.GetProcessObject());
 
-  SizeValueType nbOfLabels = this->m_NumberOfLabels.load();
+  // the blocks of lines are in raster order, so are the labels of their runs
+  std::sort(this->m_WorkUnitResults.begin(),
+            this->m_WorkUnitResults.end(),
+            [](const WorkUnitData & a, const WorkUnitData & b) { return a.firstLine < b.firstLine; });
+  const SizeValueType numberOfBlocks = this->m_WorkUnitResults.size();
+  m_BlockFirstLabel.assign(numberOfBlocks + 1, 1);
+  for (SizeValueType block = 0; block < numberOfBlocks; ++block)
+  {
+    const WorkUnitData & lines = this->m_WorkUnitResults[block];
+    SizeValueType        numberOfRuns = 0;
+    for (SizeValueType line = lines.firstLine; line <= lines.lastLine; ++line)
+    {
+      numberOfRuns += this->m_LineMap[line].size();
+    }
+    m_BlockFirstLabel[block + 1] = m_BlockFirstLabel[block] + numberOfRuns;
+  }
+  const SizeValueType nbOfLabels = this->m_NumberOfLabels.load();
+  itkAssertOrThrowMacro(m_BlockFirstLabel[numberOfBlocks] == nbOfLabels + 1,
+                        "The blocks of lines must cover the whole requested region!");
+  AtomicUnionFindType(nbOfLabels + 1).swap(m_LabelParents);
+  m_LabelParents[0].store(0, std::memory_order_relaxed);
 
-  // insert all the labels into the structure -- an extra loop but
-  // saves complicating the ones that come later
-  this->InitUnion(nbOfLabels);
+  ProgressTransformer progress2(0.5f, 0.6f, this);
+  multiThreader->ParallelizeArray(
+    0, numberOfBlocks, [this](SizeValueType block) { this->LabelBlock(block); }, progress2.GetProcessObject());
 
-  ProgressTransformer progress2(0.55f, 0.6f, this);
+  ProgressTransformer progress3(0.6f, 0.65f, this);
   multiThreader->ParallelizeArray(
-    0,
-    this->m_WorkUnitResults.size(),
-    [this](SizeValueType index) { this->ComputeEquivalence(index, true); },
-    progress2.GetProcessObject());
+    1, numberOfBlocks, [this](SizeValueType block) { this->MergeBlockBorder(block); }, progress3.GetProcessObject());
 
-  ProgressTransformer progress3(0.6f, 0.75f, this);
+  ProgressTransformer progress4(0.65f, 0.7f, this);
+  m_BlockFirstObject.assign(numberOfBlocks + 1, 0);
   multiThreader->ParallelizeArray(
-    0,
-    this->m_WorkUnitResults.size(),
-    [this](SizeValueType index) { this->ComputeEquivalence(index, false); },
-    progress3.GetProcessObject());
+    0, numberOfBlocks, [this](SizeValueType block) { this->FlattenBlock(block); }, progress4.GetProcessObject());
 
-  // AfterThreadedGenerateData
-  SizeValueType numberOfObjects = this->CreateConsecutive(m_BackgroundValue);
-  itkAssertOrThrowMacro(numberOfObjects <= this->m_NumberOfLabels,
+  // the per-block object counts become the first object of each block
+  for (SizeValueType block = 0; block < numberOfBlocks; ++block)
+  {
+    m_BlockFirstObject[block + 1] += m_BlockFirstObject[block];
+  }
+  const SizeValueType numberOfObjects = m_BlockFirstObject[numberOfBlocks];
+  itkAssertOrThrowMacro(numberOfObjects <= nbOfLabels,
                         "Number of consecutive labels cannot be greater than the initial number of labels!");
   // check for overflow exception here
   if (numberOfObjects > static_cast<SizeValueType>(NumericTraits<OutputPixelType>::max()))
@@ -145,19 +166,27 @@ ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::GenerateDa
   }
   m_ObjectCount = numberOfObjects;
 
-  ProgressTransformer progress4(0.75f, 1.0f, this);
+  this->m_Consecutive = ConsecutiveVectorType(nbOfLabels + 1);
+  this->m_Consecutive[0] = m_BackgroundValue;
+  ProgressTransformer progress5(0.7f, 0.75f, this);
+  multiThreader->ParallelizeArray(
+    0, numberOfBlocks, [this](SizeValueType block) { this->RelabelBlock(block); }, progress5.GetProcessObject());
+
+  ProgressTransformer progress6(0.75f, 1.0f, this);
   multiThreader->template ParallelizeImageRegionRestrictDirection<TOutputImage::ImageDimension>(
     0,
     requestedRegion,
     [this](const RegionType & lambdaRegion) { this->ThreadedWriteOutput(lambdaRegion); },
-    progress4.GetProcessObject());
+    progress6.GetProcessObject());
 
   // clear and make sure memory is freed
   std::deque<WorkUnitData>().swap(this->m_WorkUnitResults);
   OffsetVectorType().swap(this->m_LineOffsets);
   LineMapType().swap(this->m_LineMap);
   ConsecutiveVectorType().swap(this->m_Consecutive);
-  UnionFindType().swap(this->m_UnionFind);
+  std::vector<InternalLabelType>().swap(m_BlockFirstLabel);
+  std::vector<SizeValueType>().swap(m_BlockFirstObject);
+  AtomicUnionFindType().swap(m_LabelParents);
   m_Input = nullptr;
 }
 
@@ -236,8 +265,7 @@ ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::ThreadedWr
   {
     for (LineEncodingConstIterator cIt = this->m_LineMap[thisIdx].begin(); cIt != this->m_LineMap[thisIdx].end(); ++cIt)
     {
-      const SizeValueType   Ilab = this->LookupSet(cIt->label);
-      const OutputPixelType lab = this->m_Consecutive[Ilab];
+      const OutputPixelType lab = this->m_Consecutive[m_LabelParents[cIt->label].load(std::memory_order_relaxed)];
       oit.SetIndex(cIt->where);
       // initialize the non labelled pixels
       for (; fstart != oit; ++fstart)
@@ -260,6 +288,166 @@ ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::ThreadedWr
   }
 }
 
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+auto
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::FindRoot(InternalLabelType label)
+  -> InternalLabelType
+{
+  InternalLabelType parent = m_LabelParents[label].load(std::memory_order_relaxed);
+  while (parent != label)
+  {
+    // the labels which are not roots are never linked again, so that any of
+    // their ancestors can be written concurrently as their parent
+    const InternalLabelType grandParent = m_LabelParents[parent].load(std::memory_order_relaxed);
+    if (grandParent != parent)
+    {
+      m_LabelParents[label].store(grandParent, std::memory_order_relaxed);
+    }
+    label = grandParent;
+    parent = m_LabelParents[label].load(std::memory_order_relaxed);
+  }
+  return label;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::MergeLabels(InternalLabelType label1,
+                                                                                  InternalLabelType label2)
+{
+  while (true)
+  {
+    label1 = this->FindRoot(label1);
+    label2 = this->FindRoot(label2);
+    if (label1 == label2)
+    {
+      return;
+    }
+    if (label1 < label2)
+    {
+      std::swap(label1, label2);
+    }
+    // link the larger root to the smaller one, unless another thread linked
+    // it in the meantime
+    InternalLabelType expected = label1;
+    if (m_LabelParents[label1].compare_exchange_weak(expected, label2, std::memory_order_relaxed))
+    {
+      return;
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::MergeLine(SizeValueType lineIndex,
+                                                                                bool          previousBlocks,
+                                                                                SizeValueType blockFirstLine)
+{
+  const OffsetValueType linecount = this->m_LineMap.size();
+  for (const OffsetValueType lineOffset : this->m_LineOffsets)
+  {
+    const OffsetValueType neighIdx = lineIndex + lineOffset;
+    const bool            inPreviousBlocks = neighIdx < static_cast<OffsetValueType>(blockFirstLine);
+    if (neighIdx < 0 || neighIdx >= linecount || inPreviousBlocks != previousBlocks ||
+        this->m_LineMap[neighIdx].empty())
+    {
+      continue;
+    }
+    // Now check whether they are really neighbors
+    if (this->CheckNeighbors(this->m_LineMap[lineIndex][0].where, this->m_LineMap[neighIdx][0].where))
+    {
+      this->CompareLines(this->m_LineMap[lineIndex],
+                         this->m_LineMap[neighIdx],
+                         false,
+                         false,
+                         0,
+                         [this](const LineEncodingConstIterator & currentRun,
+                                const LineEncodingConstIterator & neighborRun,
+                                OffsetValueType,
+                                OffsetValueType) { this->MergeLabels(neighborRun->label, currentRun->label); });
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::LabelBlock(SizeValueType blockIndex)
+{
+  const WorkUnitData & lines = this->m_WorkUnitResults[blockIndex];
+  InternalLabelType    label = m_BlockFirstLabel[blockIndex];
+  for (SizeValueType line = lines.firstLine; line <= lines.lastLine; ++line)
+  {
+    for (auto & run : this->m_LineMap[line])
+    {
+      run.label = label;
+      m_LabelParents[label].store(label, std::memory_order_relaxed);
+      ++label;
+    }
+    if (!this->m_LineMap[line].empty())
+    {
+      // only the labels of this block are linked, no other thread uses them
+      this->MergeLine(line, false, lines.firstLine);
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::MergeBlockBorder(SizeValueType blockIndex)
+{
+  const WorkUnitData & lines = this->m_WorkUnitResults[blockIndex];
+
+  // the previous lines are at most that far
+  OffsetValueType border = 0;
+  for (const OffsetValueType lineOffset : this->m_LineOffsets)
+  {
+    border = std::max(border, -lineOffset);
+  }
+  const SizeValueType lastLine = std::min<SizeValueType>(lines.lastLine, lines.firstLine + border - 1);
+  for (SizeValueType line = lines.firstLine; line <= lastLine; ++line)
+  {
+    if (!this->m_LineMap[line].empty())
+    {
+      this->MergeLine(line, true, lines.firstLine);
+    }
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::FlattenBlock(SizeValueType blockIndex)
+{
+  SizeValueType numberOfObjects = 0;
+  for (InternalLabelType label = m_BlockFirstLabel[blockIndex]; label < m_BlockFirstLabel[blockIndex + 1]; ++label)
+  {
+    const InternalLabelType root = this->FindRoot(label);
+    m_LabelParents[label].store(root, std::memory_order_relaxed);
+    numberOfObjects += (root == label);
+  }
+  m_BlockFirstObject[blockIndex + 1] = numberOfObjects;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::RelabelBlock(SizeValueType blockIndex)
+{
+  // the objects are numbered in the order of their first run, skipping the
+  // background value
+  SizeValueType object = m_BlockFirstObject[blockIndex];
+  for (InternalLabelType label = m_BlockFirstLabel[blockIndex]; label < m_BlockFirstLabel[blockIndex + 1]; ++label)
+  {
+    if (m_LabelParents[label].load(std::memory_order_relaxed) == label)
+    {
+      auto consecutiveLabel = static_cast<OutputPixelType>(object);
+      if (NumericTraits<OutputPixelType>::IsNonnegative(m_BackgroundValue) && consecutiveLabel >= m_BackgroundValue)
+      {
+        ++consecutiveLabel;
+      }
+      this->m_Consecutive[label] = consecutiveLabel;
+      ++object;
+    }
+  }
+}
+
 template <typename TInputImage, typename TOutputImage, typename TMaskImage>
 void
 ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::PrintSelf(std::ostream & os, Indent indent) const
@@ -20,6 +20,8 @@
 
 #include "itkInPlaceImageFilter.h"
 #include "itkImage.h"
+#include <deque>
+#include <map>
 #include <vector>
 #include <mutex>
 
@@ -62,6 +64,17 @@ namespace itk
  * GetOriginalNumberOfObjects method can be called to find out how
  * many objects were present before the small ones were discarded.
  *
+ * The bounding box and the centroid of each object can also be computed,
+ * in the same pass over the image as its size, with
+ * ComputeBoundingBoxesAndCentroidsOn().
+ *
+ * The objects are measured run by run along the scanlines by each thread.
+ * The labels which are non-negative integers smaller than a bound are
+ * counted in dense arrays, the other ones in a map, and the measures of the
+ * threads are merged at the end. The bound is chosen so that the dense
+ * arrays of all the threads take about one byte per pixel of the image. The
+ * relabeling uses a lookup table indexed by the same labels.
+ *
  * RelabelComponentImageFilter can be run as an "in place" filter,
  * where it will overwrite its output. The default is run out of
  * place (or generate a separate output). "In place" operation can be
@@ -70,7 +83,6 @@ namespace itk
  *
  * \sa ConnectedComponentImageFilter, BinaryThresholdImageFilter, ThresholdImageFilter
  *
- * \ingroup SingleThreaded
  * \ingroup ITKConnectedComponents
  *
  * \sphinx
@@ -144,6 +156,13 @@ public:
   using ObjectSizeInPixelsContainerType = std::vector<ObjectSizeType>;
   using ObjectSizeInPhysicalUnitsContainerType = std::vector<float>;
 
+  /** Type of the bounding box of an object, in index space, and of its
+   * centroid, in physical space. */
+  using BoundingBoxType = ImageRegion<ImageDimension>;
+  using CentroidType = Point<double, ImageDimension>;
+  using BoundingBoxContainerType = std::vector<BoundingBoxType>;
+  using CentroidContainerType = std::vector<CentroidType>;
+
   /** Get the original number of objects in the image before small
    * objects were discarded. This information is only valid after
    * the filter has executed. If the caller has not specified a
@@ -177,6 +196,12 @@ public:
   itkGetConstMacro(SortByObjectSize, bool);
   itkBooleanMacro(SortByObjectSize);
 
+  /** Controls whether the bounding box and the centroid of each object are
+   * computed along with its size. Default is false. */
+  itkSetMacro(ComputeBoundingBoxesAndCentroids, bool);
+  itkGetConstMacro(ComputeBoundingBoxesAndCentroids, bool);
+  itkBooleanMacro(ComputeBoundingBoxesAndCentroids);
+
   /** Get the size of each object in pixels. This information is only
    * valid after the filter has executed.  Size of the background is
    * not calculated.  Size of object #1 is
@@ -235,6 +260,54 @@ public:
     }
   }
 
+  /** Get the bounding box of each object, in the order of the relabeled
+   * objects. This information is only valid after the filter has executed
+   * with ComputeBoundingBoxesAndCentroids enabled. */
+  const BoundingBoxContainerType &
+  GetBoundingBoxesOfObjects() const
+  {
+    return this->m_BoundingBoxesOfObjects;
+  }
+
+  /** Get the centroid of each object in physical space, in the order of the
+   * relabeled objects. This information is only valid after the filter has
+   * executed with ComputeBoundingBoxesAndCentroids enabled. */
+  const CentroidContainerType &
+  GetCentroidsOfObjects() const
+  {
+    return this->m_CentroidsOfObjects;
+  }
+
+  /** Get the bounding box of a particular object. An empty region is
+   * returned for the background or a label without object. */
+  BoundingBoxType
+  GetBoundingBoxOfObject(LabelType obj) const
+  {
+    if (obj > 0 && static_cast<SizeValueType>(obj) <= m_BoundingBoxesOfObjects.size())
+    {
+      return m_BoundingBoxesOfObjects[obj - 1];
+    }
+    else
+    {
+      return BoundingBoxType();
+    }
+  }
+
+  /** Get the centroid of a particular object in physical space. The origin
+   * is returned for the background or a label without object. */
+  CentroidType
+  GetCentroidOfObject(LabelType obj) const
+  {
+    if (obj > 0 && static_cast<SizeValueType>(obj) <= m_CentroidsOfObjects.size())
+    {
+      return m_CentroidsOfObjects[obj - 1];
+    }
+    else
+    {
+      return CentroidType();
+    }
+  }
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(InputEqualityComparableCheck, (Concept::EqualityComparable<InputPixelType>));
@@ -268,32 +341,105 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Bounding box and sum of the indices of the pixels of an object. */
+  struct ObjectGeometryType
+  {
+    IndexType                      m_MinimumIndex;
+    IndexType                      m_MaximumIndex;
+    Vector<double, ImageDimension> m_IndexSum;
+
+    ObjectGeometryType()
+    {
+      m_MinimumIndex.Fill(NumericTraits<IndexValueType>::max());
+      m_MaximumIndex.Fill(NumericTraits<IndexValueType>::NonpositiveMin());
+      m_IndexSum.Fill(0.0);
+    }
+
+    /** Add a run of pixels along the first dimension. */
+    void
+    AddRun(const IndexType & runIndex, SizeValueType length)
+    {
+      const auto runLength = static_cast<double>(length);
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        m_MinimumIndex[d] = std::min(m_MinimumIndex[d], runIndex[d]);
+        m_MaximumIndex[d] = std::max(m_MaximumIndex[d], runIndex[d]);
+        m_IndexSum[d] += runLength * runIndex[d];
+      }
+      m_MaximumIndex[0] = std::max(m_MaximumIndex[0], runIndex[0] + static_cast<IndexValueType>(length) - 1);
+      m_IndexSum[0] += 0.5 * runLength * (runLength - 1.0);
+    }
+
+    ObjectGeometryType &
+    operator+=(const ObjectGeometryType & other)
+    {
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        m_MinimumIndex[d] = std::min(m_MinimumIndex[d], other.m_MinimumIndex[d]);
+        m_MaximumIndex[d] = std::max(m_MaximumIndex[d], other.m_MaximumIndex[d]);
+      }
+      m_IndexSum += other.m_IndexSum;
+      return *this;
+    }
+  };
+
   struct RelabelComponentObjectType
   {
-    ObjectSizeType m_SizeInPixels;
+    ObjectSizeType     m_SizeInPixels{ 0 };
+    ObjectGeometryType m_Geometry;
 
     RelabelComponentObjectType &
     operator+=(const RelabelComponentObjectType & other)
     {
       this->m_SizeInPixels += other.m_SizeInPixels;
+      this->m_Geometry += other.m_Geometry;
       return *this;
     }
   };
 
 private:
+  using MapType = std::map<LabelType, RelabelComponentObjectType>;
+
+  /** The objects measured by a thread: the labels smaller than the dense
+   * label bound are indices in the dense arrays, the geometries are only
+   * measured if requested. */
+  struct ObjectAccumulatorType
+  {
+    std::vector<ObjectSizeType>     m_DenseSizes;
+    std::vector<ObjectGeometryType> m_DenseGeometries;
+    MapType                         m_SparseObjects;
+  };
+
+  /** Index of a label in the dense arrays, if it is a non-negative integer
+   * smaller than the dense label bound. */
+  bool
+  GetDenseIndex(LabelType label, SizeValueType & denseIndex) const;
+
+  /** Add a run of pixels of an object to the measures of a thread. */
+  void
+  AddRun(ObjectAccumulatorType & accumulator, LabelType label, const IndexType & runIndex, SizeValueType length) const;
+
+  /** Merge the dense arrays of the threads into the first one, for the
+   * labels from first to last excluded. */
+  void
+  MergeDenseLabels(SizeValueType first, SizeValueType last);
+
   SizeValueType  m_NumberOfObjects{ 0 };
   SizeValueType  m_NumberOfObjectsToPrint{ 10 };
   SizeValueType  m_OriginalNumberOfObjects{ 0 };
   ObjectSizeType m_MinimumObjectSize{ 0 };
   bool           m_SortByObjectSize{ true };
+  bool           m_ComputeBoundingBoxesAndCentroids{ false };
 
   std::mutex m_Mutex;
 
-  using MapType = std::map<LabelType, RelabelComponentObjectType>;
-  MapType m_SizeMap;
+  SizeValueType                     m_DenseLabelBound{ 0 };
+  std::deque<ObjectAccumulatorType> m_Accumulators;
 
   ObjectSizeInPixelsContainerType        m_SizeOfObjectsInPixels;
   ObjectSizeInPhysicalUnitsContainerType m_SizeOfObjectsInPhysicalUnits;
+  BoundingBoxContainerType               m_BoundingBoxesOfObjects;
+  CentroidContainerType                  m_CentroidsOfObjects;
 };
 } // end namespace itk
 
@@ -23,7 +23,9 @@
 #include "itkProgressReporter.h"
 #include "itkProgressTransformer.h"
 #include "itkImageScanlineIterator.h"
+#include <algorithm>
 #include <map>
+#include <type_traits>
 #include <utility>
 #include "itkTotalProgressReporter.h"
 
@@ -52,73 +54,127 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRe
 }
 
 
+template <typename TInputImage, typename TOutputImage>
+bool
+RelabelComponentImageFilter<TInputImage, TOutputImage>::GetDenseIndex(LabelType       label,
+                                                                      SizeValueType & denseIndex) const
+{
+  if (!std::is_integral<LabelType>::value || !NumericTraits<LabelType>::IsNonnegative(label))
+  {
+    return false;
+  }
+  denseIndex = static_cast<SizeValueType>(label);
+  return denseIndex < m_DenseLabelBound;
+}
+
+
 template <typename TInputImage, typename TOutputImage>
 void
-RelabelComponentImageFilter<TInputImage, TOutputImage>::ParallelComputeLabels(const RegionType & inputRegionForThread)
+RelabelComponentImageFilter<TInputImage, TOutputImage>::AddRun(ObjectAccumulatorType & accumulator,
+                                                               LabelType               label,
+                                                               const IndexType &       runIndex,
+                                                               SizeValueType           length) const
 {
-  RelabelComponentObjectType initialSize;
-  initialSize.m_SizeInPixels = 0;
+  SizeValueType denseIndex;
+  if (this->GetDenseIndex(label, denseIndex))
+  {
+    if (denseIndex >= accumulator.m_DenseSizes.size())
+    {
+      // grow geometrically, up to the bound of the dense labels
+      const SizeValueType denseSize =
+        std::min(m_DenseLabelBound, std::max<SizeValueType>(denseIndex + 1, 2 * accumulator.m_DenseSizes.size()));
+      accumulator.m_DenseSizes.resize(denseSize, 0);
+      if (m_ComputeBoundingBoxesAndCentroids)
+      {
+        accumulator.m_DenseGeometries.resize(denseSize);
+      }
+    }
+    accumulator.m_DenseSizes[denseIndex] += length;
+    if (m_ComputeBoundingBoxesAndCentroids)
+    {
+      accumulator.m_DenseGeometries[denseIndex].AddRun(runIndex, length);
+    }
+  }
+  else
+  {
+    RelabelComponentObjectType & object = accumulator.m_SparseObjects[label];
+    object.m_SizeInPixels += length;
+    if (m_ComputeBoundingBoxesAndCentroids)
+    {
+      object.m_Geometry.AddRun(runIndex, length);
+    }
+  }
+}
+
 
+template <typename TInputImage, typename TOutputImage>
+void
+RelabelComponentImageFilter<TInputImage, TOutputImage>::ParallelComputeLabels(const RegionType & inputRegionForThread)
+{
   // walk the input
   ImageScanlineConstIterator<InputImageType> it(this->GetInput(), inputRegionForThread);
 
   auto                  inputRequestedRegion = this->GetInput()->GetRequestedRegion();
   TotalProgressReporter report(this, inputRequestedRegion.GetNumberOfPixels(), 100, 0.5f);
 
-  MapType localSizeMap;
+  ObjectAccumulatorType accumulator;
 
-  auto mapIt = localSizeMap.end();
+  const SizeValueType lineLength = inputRegionForThread.GetSize(0);
   while (!it.IsAtEnd())
   {
-    while (!it.IsAtEndOfLine())
+    IndexType            runIndex = it.GetIndex();
+    const IndexValueType lineStart = runIndex[0];
+
+    // the objects are measured by runs of pixels with the same label
+    for (SizeValueType x = 0; x < lineLength;)
     {
-      // Get the input pixel value
-      const auto inputValue = it.Get();
+      const LabelType label = it.Get();
+      SizeValueType   length = 1;
+      ++it;
+      while (x + length < lineLength && it.Get() == label)
+      {
+        ++length;
+        ++it;
+      }
 
       // if the input pixel is not the background
-      if (inputValue != NumericTraits<LabelType>::ZeroValue())
+      if (label != NumericTraits<LabelType>::ZeroValue())
       {
-        // label is not currently in the map
-        mapIt = localSizeMap.insert(mapIt, { inputValue, initialSize });
-
-        // label is already in the map, update the values
-        ++(mapIt->second.m_SizeInPixels);
+        runIndex[0] = lineStart + static_cast<IndexValueType>(x);
+        this->AddRun(accumulator, label, runIndex, length);
       }
-
-      // increment the iterator
-      ++it;
+      x += length;
     }
-    report.Completed(inputRequestedRegion.GetSize(0));
+    report.Completed(lineLength);
     it.NextLine();
   }
 
-  // Merge localStatistics and m_LabelStatistics concurrently safe in a
-  // local copy, this thread may do multiple merges.
-  while (true)
-  {
-    std::unique_lock<std::mutex> lock(m_Mutex);
+  // the measures of the threads are merged once they are all done
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Accumulators.push_back(std::move(accumulator));
+}
+
 
-    if (m_SizeMap.empty())
+template <typename TInputImage, typename TOutputImage>
+void
+RelabelComponentImageFilter<TInputImage, TOutputImage>::MergeDenseLabels(SizeValueType first, SizeValueType last)
+{
+  ObjectAccumulatorType & merged = m_Accumulators.front();
+  for (auto accumulatorIt = m_Accumulators.begin() + 1; accumulatorIt != m_Accumulators.end(); ++accumulatorIt)
+  {
+    const SizeValueType end = std::min<SizeValueType>(last, accumulatorIt->m_DenseSizes.size());
+    for (SizeValueType i = first; i < end; ++i)
     {
-      swap(m_SizeMap, localSizeMap);
-      break;
+      merged.m_DenseSizes[i] += accumulatorIt->m_DenseSizes[i];
     }
-    else
+    if (m_ComputeBoundingBoxesAndCentroids)
     {
-      // copy the output map to thread local storage
-      MapType toMerge;
-      swap(m_SizeMap, toMerge);
-
-      // allow other threads to merge data
-      lock.unlock();
-
-      // Merge toMerge into localSizeMap, locally
-      for (auto & sizePair : toMerge)
+      for (SizeValueType i = first; i < end; ++i)
       {
-        localSizeMap[sizePair.first] += sizePair.second;
+        merged.m_DenseGeometries[i] += accumulatorIt->m_DenseGeometries[i];
       }
     }
-  } // release lock
+  }
 }
 
 
@@ -139,18 +195,87 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
     physicalPixelSize *= input->GetSpacing()[i];
   }
 
+  // Every thread may fill its own dense arrays, so their bound is set from a
+  // budget shared by all the threads: about one byte per pixel of the image,
+  // and at least 512 KiB per thread for the small images. The larger labels
+  // are counted in the sparse maps.
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  const SizeValueType bytesPerThread =
+    std::max<SizeValueType>(SizeValueType{ 1 } << 19,
+                            input->GetRequestedRegion().GetNumberOfPixels() /
+                              std::max(1u, multiThreader->GetNumberOfWorkUnits()));
+  const SizeValueType bytesPerLabel =
+    sizeof(ObjectSizeType) + (m_ComputeBoundingBoxesAndCentroids ? sizeof(ObjectGeometryType) : 0);
+  m_DenseLabelBound = bytesPerThread / bytesPerLabel;
+
   // Walk the entire input image and compute used labels and the number of each label.
-  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+  multiThreader->template ParallelizeImageRegion<ImageDimension>(
     input->GetRequestedRegion(),
     [this](const RegionType & inputRegion) { this->ParallelComputeLabels(inputRegion); },
     nullptr);
+  if (m_Accumulators.empty())
+  {
+    m_Accumulators.emplace_back();
+  }
 
+  // Merge the measures of the threads into the first ones, in parallel by
+  // chunks of dense labels
+  ObjectAccumulatorType & merged = m_Accumulators.front();
+  SizeValueType           denseSize = 0;
+  for (const auto & accumulator : m_Accumulators)
+  {
+    denseSize = std::max<SizeValueType>(denseSize, accumulator.m_DenseSizes.size());
+  }
+  merged.m_DenseSizes.resize(denseSize, 0);
+  if (m_ComputeBoundingBoxesAndCentroids)
+  {
+    merged.m_DenseGeometries.resize(denseSize);
+  }
+  constexpr SizeValueType chunkSize = 4096;
+  multiThreader->ParallelizeArray(
+    0,
+    (denseSize + chunkSize - 1) / chunkSize,
+    [this, denseSize](SizeValueType chunk) {
+      this->MergeDenseLabels(chunk * chunkSize, std::min(denseSize, (chunk + 1) * chunkSize));
+    },
+    nullptr);
+  for (auto accumulatorIt = m_Accumulators.begin() + 1; accumulatorIt != m_Accumulators.end(); ++accumulatorIt)
+  {
+    for (const auto & sparseObject : accumulatorIt->m_SparseObjects)
+    {
+      merged.m_SparseObjects[sparseObject.first] += sparseObject.second;
+    }
+  }
 
-  // Construct an array of the label, component information pair to sort
-  auto sizeVector = std::vector<LabelComponentPairType>(m_SizeMap.begin(), m_SizeMap.end());
+  // Construct an array of the label, component information pair to sort,
+  // in the order of the labels
+  std::vector<LabelComponentPairType> sizeVector;
+  for (SizeValueType i = 0; i < denseSize; ++i)
+  {
+    if (merged.m_DenseSizes[i] > 0)
+    {
+      RelabelComponentObjectType object;
+      object.m_SizeInPixels = merged.m_DenseSizes[i];
+      if (m_ComputeBoundingBoxesAndCentroids)
+      {
+        object.m_Geometry = merged.m_DenseGeometries[i];
+      }
+      sizeVector.emplace_back(static_cast<LabelType>(i), object);
+    }
+  }
+  sizeVector.insert(sizeVector.end(), merged.m_SparseObjects.begin(), merged.m_SparseObjects.end());
+  if (!merged.m_SparseObjects.empty() && !m_SortByObjectSize)
+  {
+    std::sort(sizeVector.begin(),
+              sizeVector.end(),
+              [](const LabelComponentPairType & a, const LabelComponentPairType & b) -> bool {
+                return a.first < b.first;
+              });
+  }
 
   // free memory by swapping to a default constructed object.
-  MapType().swap(m_SizeMap);
+  std::deque<ObjectAccumulatorType>().swap(m_Accumulators);
 
   // Sort the objects by size by default, unless m_SortByObjectSize
   // is set to false.
@@ -165,9 +290,10 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
   }
 
 
-  // A map from the input pixel labels to the output labels
-  using RelabelMapType = std::map<LabelType, OutputPixelType>;
-  RelabelMapType relabelMap;
+  // A lookup table from the input pixel labels to the output labels, with
+  // a map for the labels which are not dense
+  std::vector<OutputPixelType>         denseRelabel(std::max<SizeValueType>(denseSize, 1), 0);
+  std::map<LabelType, OutputPixelType> sparseRelabel;
 
   // create a lookup table to map the input label to the output label.
   // cache the object sizes for later access by the user
@@ -175,16 +301,19 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
   m_OriginalNumberOfObjects = sizeVector.size();
   m_SizeOfObjectsInPixels.clear();
   m_SizeOfObjectsInPixels.resize(m_NumberOfObjects);
+  m_BoundingBoxesOfObjects.clear();
+  m_CentroidsOfObjects.clear();
   SizeValueType   NumberOfObjectsRemoved = 0;
   OutputPixelType outputLabel = 0;
   for (const auto & sizeVectorPair : sizeVector)
   {
+    OutputPixelType relabel = NumericTraits<OutputPixelType>::ZeroValue();
+
     // skip objects that are too small ( but don't increment the output label )
     if (m_MinimumObjectSize > 0 && sizeVectorPair.second.m_SizeInPixels < m_MinimumObjectSize)
     {
       // map small objects to the background
       ++NumberOfObjectsRemoved;
-      relabelMap.insert({ sizeVectorPair.first, NumericTraits<OutputPixelType>::ZeroValue() });
     }
     else
     {
@@ -194,11 +323,36 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
       }
       // map for input labels to output labels (Note we use i+1 in the
       // map since index 0 is the background)
-      relabelMap.insert({ sizeVectorPair.first, outputLabel + 1 });
+      relabel = outputLabel + 1;
 
       // cache object sizes for later access by the user
       m_SizeOfObjectsInPixels[outputLabel] = sizeVectorPair.second.m_SizeInPixels;
       ++outputLabel;
+
+      if (m_ComputeBoundingBoxesAndCentroids)
+      {
+        const ObjectGeometryType &              geometry = sizeVectorPair.second.m_Geometry;
+        BoundingBoxType                         boundingBox;
+        ContinuousIndex<double, ImageDimension> centroidIndex;
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          boundingBox.SetIndex(d, geometry.m_MinimumIndex[d]);
+          boundingBox.SetSize(d, geometry.m_MaximumIndex[d] - geometry.m_MinimumIndex[d] + 1);
+          centroidIndex[d] = geometry.m_IndexSum[d] / static_cast<double>(sizeVectorPair.second.m_SizeInPixels);
+        }
+        m_BoundingBoxesOfObjects.push_back(boundingBox);
+        m_CentroidsOfObjects.push_back(input->template TransformContinuousIndexToPhysicalPoint<double>(centroidIndex));
+      }
+    }
+
+    SizeValueType denseIndex;
+    if (this->GetDenseIndex(sizeVectorPair.first, denseIndex))
+    {
+      denseRelabel[denseIndex] = relabel;
+    }
+    else
+    {
+      sparseRelabel.insert({ sizeVectorPair.first, relabel });
     }
   }
 
@@ -218,8 +372,12 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
                  [physicalPixelSize](ObjectSizeType sizeInPixels) { return sizeInPixels * physicalPixelSize; });
 
 
-  // After the objects stats are computed add in the background label so the relabelMap can be directly applied.
-  relabelMap.insert({ NumericTraits<LabelType>::ZeroValue(), NumericTraits<OutputPixelType>::ZeroValue() });
+  // After the objects stats are computed add in the background label so the relabel table can be directly applied.
+  SizeValueType backgroundIndex;
+  if (!this->GetDenseIndex(NumericTraits<LabelType>::ZeroValue(), backgroundIndex))
+  {
+    sparseRelabel.insert({ NumericTraits<LabelType>::ZeroValue(), NumericTraits<OutputPixelType>::ZeroValue() });
+  }
 
   // Second pass: walk just the output requested region and relabel
   // the necessary pixels.
@@ -228,38 +386,48 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
   // Allocate the output
   this->AllocateOutputs();
 
-  // In parallel apply the relabling map
-  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+  // In parallel apply the relabling table
+  multiThreader->template ParallelizeImageRegion<ImageDimension>(
     output->GetRequestedRegion(),
-    [this, &relabelMap](const RegionType & outputRegionForThread) {
+    [this, &denseRelabel, &sparseRelabel](const RegionType & outputRegionForThread) {
       auto                  outputRequestedRegion = this->GetOutput()->GetRequestedRegion();
       TotalProgressReporter report(this, outputRequestedRegion.GetNumberOfPixels(), 100, 0.5f);
 
       ImageScanlineIterator<OutputImageType>     oit(this->GetOutput(), outputRegionForThread);
       ImageScanlineConstIterator<InputImageType> it(this->GetInput(), outputRegionForThread);
 
-      auto mapIt = relabelMap.cbegin();
+      auto mapIt = sparseRelabel.cbegin();
 
       while (!oit.IsAtEnd())
       {
         while (!oit.IsAtEndOfLine())
         {
-          const auto && inputValue = it.Get();
+          const LabelType inputValue = it.Get();
 
-          if (mapIt->first != inputValue)
+          SizeValueType denseIndex;
+          if (this->GetDenseIndex(inputValue, denseIndex))
           {
-            mapIt = relabelMap.find(inputValue);
+            // no new labels should be encountered in the input
+            assert(denseIndex < denseRelabel.size());
+            oit.Set(denseRelabel[denseIndex]);
           }
+          else
+          {
+            if (mapIt->first != inputValue)
+            {
+              mapIt = sparseRelabel.find(inputValue);
+            }
 
-          // no new labels should be encountered in the input
-          assert(mapIt != relabelMap.cend());
+            // no new labels should be encountered in the input
+            assert(mapIt != sparseRelabel.cend());
 
-          oit.Set(mapIt->second);
+            oit.Set(mapIt->second);
+          }
 
           ++oit;
           ++it;
         }
-        report.Completed(outputRequestedRegion.GetSize(0));
+        report.Completed(outputRegionForThread.GetSize(0));
         oit.NextLine();
         it.NextLine();
       }
@@ -278,6 +446,7 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream &
   os << indent << "NumberOfObjectsToPrint: " << m_NumberOfObjectsToPrint << std::endl;
   os << indent << "MinimumObjectSizes: " << m_MinimumObjectSize << std::endl;
   os << indent << "SortByObjectSize: " << m_SortByObjectSize << std::endl;
+  os << indent << "ComputeBoundingBoxesAndCentroids: " << m_ComputeBoundingBoxesAndCentroids << std::endl;
 
   typename ObjectSizeInPixelsContainerType::const_iterator it;
   ObjectSizeInPhysicalUnitsContainerType::const_iterator   fit;
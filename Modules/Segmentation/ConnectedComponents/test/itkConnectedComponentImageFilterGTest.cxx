@@ -23,8 +23,12 @@ using itk::print_helper::operator<<;
 #include "itkGTest.h"
 #include "itkImage.h"
 #include "itkConnectedComponentImageFilter.h"
+#include "itkImageBufferRange.h"
+#include "itkIndexRange.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
 
 #include <bitset>
+#include <queue>
 
 namespace
 {
@@ -50,6 +54,132 @@ CreateTestImageA()
 
   return image;
 }
+
+// Random binary image where about a given fraction of the pixels are objects
+template <unsigned int VDimension>
+typename itk::Image<unsigned char, VDimension>::Pointer
+CreateRandomImage(const itk::Size<VDimension> & size, double objectFraction, unsigned int seed)
+{
+  using ImageType = itk::Image<unsigned char, VDimension>;
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(seed);
+
+  auto image = ImageType::New();
+  image->SetRegions(typename ImageType::RegionType(size));
+  image->Allocate();
+  for (auto & pixel : itk::ImageBufferRange<ImageType>(*image))
+  {
+    pixel = generator->GetVariate() < objectFraction ? 1 : 0;
+  }
+  return image;
+}
+
+// Label the objects by flood filling them in raster order, numbering them
+// consecutively and skipping the background value
+template <typename TInputImage, typename TOutputImage>
+typename TOutputImage::Pointer
+FloodFillLabels(const TInputImage * image, bool fullyConnected, typename TOutputImage::PixelType background)
+{
+  constexpr unsigned int Dimension = TInputImage::ImageDimension;
+  using IndexType = itk::Index<Dimension>;
+  using OffsetType = itk::Offset<Dimension>;
+  using OutputPixelType = typename TOutputImage::PixelType;
+
+  const auto region = image->GetLargestPossibleRegion();
+  auto       labels = TOutputImage::New();
+  labels->SetRegions(region);
+  labels->Allocate();
+  labels->FillBuffer(background);
+
+  std::vector<OffsetType> offsets;
+  for (const auto & index : itk::ZeroBasedIndexRange<Dimension>(itk::Size<Dimension>::Filled(3)))
+  {
+    OffsetType   offset;
+    unsigned int numberOfNonZeros = 0;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      offset[d] = index[d] - 1;
+      numberOfNonZeros += (offset[d] != 0);
+    }
+    if (numberOfNonZeros > 0 && (fullyConnected || numberOfNonZeros == 1))
+    {
+      offsets.push_back(offset);
+    }
+  }
+
+  std::vector<bool> visited(region.GetNumberOfPixels(), false);
+  OutputPixelType   nextLabel = 0;
+  for (const auto & seed : itk::ImageRegionIndexRange<Dimension>(region))
+  {
+    if (image->GetPixel(seed) == 0 || visited[image->ComputeOffset(seed)])
+    {
+      continue;
+    }
+    if (nextLabel == background)
+    {
+      ++nextLabel;
+    }
+    std::queue<IndexType> front;
+    front.push(seed);
+    visited[image->ComputeOffset(seed)] = true;
+    while (!front.empty())
+    {
+      const IndexType index = front.front();
+      front.pop();
+      labels->SetPixel(index, nextLabel);
+      for (const auto & offset : offsets)
+      {
+        const IndexType neighbor = index + offset;
+        if (region.IsInside(neighbor) && image->GetPixel(neighbor) != 0 && !visited[image->ComputeOffset(neighbor)])
+        {
+          visited[image->ComputeOffset(neighbor)] = true;
+          front.push(neighbor);
+        }
+      }
+    }
+    ++nextLabel;
+  }
+  return labels;
+}
+
+template <unsigned int VDimension>
+void
+CheckAgainstFloodFill(const itk::Size<VDimension> & size)
+{
+  using InputImageType = itk::Image<unsigned char, VDimension>;
+  using OutputImageType = itk::Image<short, VDimension>;
+
+  for (const double objectFraction : { 0.3, 0.55 })
+  {
+    auto image = CreateRandomImage<VDimension>(size, objectFraction, 17);
+
+    auto connected = itk::ConnectedComponentImageFilter<InputImageType, OutputImageType>::New();
+    connected->SetInput(image);
+    for (const bool fullyConnected : { false, true })
+    {
+      for (const short background : { 0, 5, -1 })
+      {
+        const auto expected = FloodFillLabels<InputImageType, OutputImageType>(image, fullyConnected, background);
+        for (const unsigned int numberOfWorkUnits : { 1, 3, 8 })
+        {
+          connected->SetFullyConnected(fullyConnected);
+          connected->SetBackgroundValue(background);
+          connected->SetNumberOfWorkUnits(numberOfWorkUnits);
+          connected->Update();
+
+          const OutputImageType * output = connected->GetOutput();
+          SCOPED_TRACE(testing::Message() << "Fraction " << objectFraction << ", fully connected " << fullyConnected
+                                          << ", background " << background << ", " << numberOfWorkUnits
+                                          << " work units");
+          EXPECT_TRUE(std::equal(itk::ImageBufferRange<const OutputImageType>(*output).cbegin(),
+                                 itk::ImageBufferRange<const OutputImageType>(*output).cend(),
+                                 itk::ImageBufferRange<const OutputImageType>(*expected).cbegin()));
+        }
+      }
+    }
+  }
+}
 } // namespace
 
 
@@ -84,3 +214,15 @@ TEST(ConnectedComponentImageFilter, checkerboard_3D)
   ++it;
   EXPECT_TRUE(it.IsAtEnd());
 }
+
+
+TEST(ConnectedComponentImageFilter, same_labels_as_flood_fill_2D)
+{
+  CheckAgainstFloodFill<2>(itk::MakeSize(67u, 45u));
+}
+
+
+TEST(ConnectedComponentImageFilter, same_labels_as_flood_fill_3D)
+{
+  CheckAgainstFloodFill<3>(itk::MakeSize(23u, 17u, 19u));
+}
@@ -26,6 +26,11 @@ using itk::print_helper::operator<<;
 
 #include "itkSimpleFilterWatcher.h"
 #include "itkRandomImageSource.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+#include <array>
+#include <map>
 
 namespace
 {
@@ -56,6 +61,142 @@ CreateTestImageA()
 
   return image;
 }
+
+
+// Compare the relabeling, the sizes, the bounding boxes and the centroids
+// with the ones computed by brute force, for labels which are small, larger
+// than the dense label bound, or negative.
+template <unsigned int VDimension>
+void
+CheckAgainstBruteForce(const itk::Size<VDimension> & size)
+{
+  using ImageType = itk::Image<int, VDimension>;
+  using IndexType = typename ImageType::IndexType;
+  using FilterType = itk::RelabelComponentImageFilter<ImageType, ImageType>;
+
+  std::vector<int> labels = { 70000, 1 << 20, 1 << 30, -5, -1000 };
+  for (int label = 1; label <= 40; ++label)
+  {
+    labels.push_back(label);
+  }
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(2021);
+
+  auto image = ImageType::New();
+  image->SetRegions(typename ImageType::RegionType(size));
+  image->Allocate();
+  typename ImageType::SpacingType spacing;
+  typename ImageType::PointType   origin;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    spacing[d] = 0.5 + d;
+    origin[d] = 3.0 - d;
+  }
+  image->SetSpacing(spacing);
+  image->SetOrigin(origin);
+
+  // the pixels are grouped in short runs of the same label
+  struct Object
+  {
+    itk::SizeValueType             m_Size{ 0 };
+    IndexType                      m_Minimum{ IndexType::Filled(itk::NumericTraits<itk::IndexValueType>::max()) };
+    IndexType                      m_Maximum{ IndexType::Filled(itk::NumericTraits<itk::IndexValueType>::min()) };
+    std::array<double, VDimension> m_Sum{};
+  };
+  std::map<int, Object> objects;
+  int                   label = 0;
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (generator->GetVariate() < 0.4)
+    {
+      label = generator->GetVariate() < 0.3 ? 0 : labels[generator->GetIntegerVariate(labels.size() - 1)];
+    }
+    it.Set(label);
+    if (label != 0)
+    {
+      Object & object = objects[label];
+      ++object.m_Size;
+      for (unsigned int d = 0; d < VDimension; ++d)
+      {
+        object.m_Minimum[d] = std::min(object.m_Minimum[d], it.GetIndex()[d]);
+        object.m_Maximum[d] = std::max(object.m_Maximum[d], it.GetIndex()[d]);
+        object.m_Sum[d] += it.GetIndex()[d];
+      }
+    }
+  }
+
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->ComputeBoundingBoxesAndCentroidsOn();
+  for (const bool sortByObjectSize : { false, true })
+  {
+    for (const itk::SizeValueType minimumObjectSize : { 0, 20 })
+    {
+      // expected order of the objects
+      std::vector<std::pair<int, Object>> expected(objects.begin(), objects.end());
+      if (sortByObjectSize)
+      {
+        std::stable_sort(expected.begin(), expected.end(), [](const auto & a, const auto & b) {
+          return a.second.m_Size > b.second.m_Size;
+        });
+      }
+      const auto isTooSmall = [minimumObjectSize](const auto & a) { return a.second.m_Size < minimumObjectSize; };
+      expected.erase(std::remove_if(expected.begin(), expected.end(), isTooSmall), expected.end());
+      std::map<int, int> relabel;
+      for (unsigned int i = 0; i < expected.size(); ++i)
+      {
+        relabel[expected[i].first] = i + 1;
+      }
+
+      for (const unsigned int numberOfWorkUnits : { 1, 3, 8 })
+      {
+        SCOPED_TRACE(testing::Message() << "Sort " << sortByObjectSize << ", minimum size " << minimumObjectSize
+                                        << ", " << numberOfWorkUnits << " work units");
+        filter->SetSortByObjectSize(sortByObjectSize);
+        filter->SetMinimumObjectSize(minimumObjectSize);
+        filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+        filter->Update();
+
+        EXPECT_EQ(filter->GetOriginalNumberOfObjects(), objects.size());
+        ASSERT_EQ(filter->GetNumberOfObjects(), expected.size());
+        ASSERT_EQ(filter->GetBoundingBoxesOfObjects().size(), expected.size());
+        ASSERT_EQ(filter->GetCentroidsOfObjects().size(), expected.size());
+        for (unsigned int i = 0; i < expected.size(); ++i)
+        {
+          const Object & object = expected[i].second;
+          EXPECT_EQ(filter->GetSizeOfObjectsInPixels()[i], object.m_Size);
+
+          const auto & boundingBox = filter->GetBoundingBoxOfObject(i + 1);
+          EXPECT_EQ(boundingBox.GetIndex(), object.m_Minimum);
+          EXPECT_EQ(boundingBox.GetUpperIndex(), object.m_Maximum);
+
+          itk::ContinuousIndex<double, VDimension> centroidIndex;
+          for (unsigned int d = 0; d < VDimension; ++d)
+          {
+            centroidIndex[d] = object.m_Sum[d] / object.m_Size;
+          }
+          const auto centroid = image->template TransformContinuousIndexToPhysicalPoint<double>(centroidIndex);
+          ITK_EXPECT_VECTOR_NEAR(filter->GetCentroidOfObject(i + 1), centroid, 1e-9);
+        }
+
+        for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+             !it.IsAtEnd();
+             ++it)
+        {
+          const auto relabelIt = relabel.find(it.Get());
+          const int  expectedLabel = relabelIt == relabel.end() ? 0 : relabelIt->second;
+          if (filter->GetOutput()->GetPixel(it.GetIndex()) != expectedLabel)
+          {
+            ADD_FAILURE() << "Label " << filter->GetOutput()->GetPixel(it.GetIndex()) << " instead of "
+                          << expectedLabel << " at " << it.GetIndex();
+            break;
+          }
+        }
+      }
+    }
+  }
+}
 } // namespace
 
 TEST(RelabelComponentImageFilter, nosort_nosize)
@@ -173,3 +314,15 @@ TEST(RelabelComponentImageFilter, big_random)
 
   filter->Update();
 }
+
+
+TEST(RelabelComponentImageFilter, brute_force_2D)
+{
+  CheckAgainstBruteForce<2>(itk::MakeSize(61u, 47u));
+}
+
+
+TEST(RelabelComponentImageFilter, brute_force_3D)
+{
+  CheckAgainstBruteForce<3>(itk::MakeSize(19u, 13u, 11u));
+}